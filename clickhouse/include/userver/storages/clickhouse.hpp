@@ -6,7 +6,9 @@
 
 #include <userver/storages/clickhouse/cluster.hpp>
 #include <userver/storages/clickhouse/component.hpp>
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/inserter.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 #include <userver/storages/clickhouse/query.hpp>
 
@@ -22,6 +24,8 @@
 /// - Connection pooling;
 /// - Variadic template query parameter passing;
 /// - Query result extraction to C++ types;
+/// - Streaming of large query results block by block;
+/// - Streaming inserts with bounded memory;
 /// - Mapping C++ types to native ClickHouse types.
 ///
 /// @section info More information
@@ -11,9 +11,11 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
+#include <userver/storages/clickhouse/inserter.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 #include <userver/storages/clickhouse/query.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -60,6 +62,20 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, streaming the result block by block.
+  /// See storages::clickhouse::Cursor for details.
+  template <typename... Args>
+  Cursor ExecuteCursor(const Query& query, const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters,
+  /// streaming the result block by block.
+  /// See storages::clickhouse::Cursor for details.
+  template <typename... Args>
+  Cursor ExecuteCursor(OptionalCommandControl, const Query& query,
+                       const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -116,6 +132,29 @@ class Cluster final {
                   const std::vector<std::string_view>& column_names,
                   const Container& data) const;
 
+  /// @brief Create the streaming inserter at some host of the cluster;
+  /// `Row` is expected to be a clickhouse-mapped type.
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param settings inserter settings, including the block size
+  /// Unlike `InsertRows`, does not require the whole data set in memory.
+  /// See storages::clickhouse::Inserter for details.
+  template <typename Row>
+  Inserter<Row> MakeInserter(const std::string& table_name,
+                             const std::vector<std::string_view>& column_names,
+                             InserterSettings settings = {}) const;
+
+  /// @brief Create the streaming inserter with specified command control
+  /// settings, that are applied to each block insertion.
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param settings inserter settings, including the block size
+  template <typename Row>
+  Inserter<Row> MakeInserter(OptionalCommandControl,
+                             const std::string& table_name,
+                             const std::vector<std::string_view>& column_names,
+                             InserterSettings settings = {}) const;
+
   /// Write cluster statistics
   void WriteStatistics(
       USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
@@ -131,6 +170,8 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  Cursor DoExecuteCursor(OptionalCommandControl, const Query& query) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -175,6 +216,24 @@ void Cluster::InsertRows(OptionalCommandControl optional_cc,
   DoInsert(optional_cc, request);
 }
 
+template <typename Row>
+Inserter<Row> Cluster::MakeInserter(
+    const std::string& table_name,
+    const std::vector<std::string_view>& column_names,
+    InserterSettings settings) const {
+  return MakeInserter<Row>(OptionalCommandControl{}, table_name, column_names,
+                           settings);
+}
+
+template <typename Row>
+Inserter<Row> Cluster::MakeInserter(
+    OptionalCommandControl optional_cc, const std::string& table_name,
+    const std::vector<std::string_view>& column_names,
+    InserterSettings settings) const {
+  return Inserter<Row>{GetPool().AcquireInserterConnection(), optional_cc,
+                       table_name, column_names, settings};
+}
+
 template <typename... Args>
 ExecutionResult Cluster::Execute(const Query& query,
                                  const Args&... args) const {
@@ -189,6 +248,18 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+Cursor Cluster::ExecuteCursor(const Query& query, const Args&... args) const {
+  return ExecuteCursor(OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+Cursor Cluster::ExecuteCursor(OptionalCommandControl optional_cc,
+                              const Query& query, const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  return DoExecuteCursor(optional_cc, formatted_query);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
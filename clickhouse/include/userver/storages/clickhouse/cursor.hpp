@@ -0,0 +1,72 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/cursor.hpp
+/// @brief @copybrief storages::clickhouse::Cursor
+
+#include <memory>
+#include <optional>
+
+#include <userver/storages/clickhouse/execution_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+class CursorImpl;
+}
+
+// clang-format off
+
+/// @brief Streaming accessor of the query result, returned by
+/// storages::clickhouse::Cluster ExecuteCursor methods.
+///
+/// Yields the result block by block as they arrive from the server, so large
+/// results could be processed in constant memory and the first rows are
+/// available before the whole result is received. Only a couple of blocks are
+/// buffered ahead of the consumer.
+///
+/// The connection is held until the result is exhausted or the cursor is
+/// destroyed; destroying the cursor early cancels the query on the server.
+/// Note that the command control `execute` timeout covers the whole lifetime
+/// of the cursor, including the time spent processing the blocks.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/cursor_chtest.cpp  Sample Cursor usage
+
+// clang-format on
+class Cursor final {
+ public:
+  explicit Cursor(std::unique_ptr<impl::CursorImpl>&&);
+  Cursor(Cursor&&) noexcept;
+  ~Cursor();
+
+  /// @brief Waits for the next non-empty block of the result.
+  /// @returns std::nullopt once the result is exhausted.
+  /// @throws the same exceptions as storages::clickhouse::Cluster::Execute
+  /// if the query fails.
+  std::optional<ExecutionResult> Next();
+
+  /// @brief Waits for the next non-empty block of the result and converts it
+  /// to strongly-typed struct of vectors.
+  /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+  /// @returns std::nullopt once the result is exhausted.
+  template <typename T>
+  std::optional<T> NextAs();
+
+ private:
+  std::unique_ptr<impl::CursorImpl> impl_;
+};
+
+template <typename T>
+std::optional<T> Cursor::NextAs() {
+  auto block = Next();
+  if (!block.has_value()) return std::nullopt;
+
+  return std::move(*block).As<T>();
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+class PoolImpl;
+class ConnectionPtr;
+class InsertionRequest;
+
+/// @brief Connection acquired from the pool for the whole lifetime of
+/// storages::clickhouse::Inserter, so that all its blocks are sent over it.
+class InserterConnection final {
+ public:
+  InserterConnection(std::shared_ptr<PoolImpl> pool);
+  ~InserterConnection();
+
+  InserterConnection(InserterConnection&&) noexcept;
+
+  void Insert(OptionalCommandControl, const InsertionRequest& request) const;
+
+ private:
+  std::shared_ptr<PoolImpl> pool_;
+  std::unique_ptr<ConnectionPtr> connection_;
+};
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <userver/utils/assert.hpp>
@@ -36,6 +38,14 @@ class InsertionRequest final {
       const std::string& table_name,
       const std::vector<std::string_view>& column_names, const Container& data);
 
+  /// @brief Creates the request from the tuple of columns (vectors), which
+  /// are mapped the same way as `Row` fields.
+  template <typename Row, typename Columns>
+  static InsertionRequest CreateFromColumns(
+      const std::string& table_name,
+      const std::vector<std::string_view>& column_names,
+      const Columns& columns);
+
   const std::string& GetTableName() const;
 
   const impl::BlockWrapper& GetBlock() const;
@@ -92,6 +102,19 @@ class InsertionRequest final {
     const Container& data_;
   };
 
+  template <typename MappedType, typename Columns, size_t... Index>
+  static void AppendColumns(impl::BlockWrapper& block,
+                            const std::vector<std::string_view>& column_names,
+                            const Columns& columns,
+                            std::index_sequence<Index...>) {
+    (...,
+     io::columns::AppendWrappedColumn(
+         block,
+         std::tuple_element_t<Index, MappedType>::Serialize(
+             std::get<Index>(columns)),
+         column_names[Index], Index));
+  }
+
   const std::string& table_name_;
   const std::vector<std::string_view>& column_names_;
 
@@ -136,6 +159,22 @@ InsertionRequest InsertionRequest::CreateFromRows(
   return request;
 }
 
+template <typename Row, typename Columns>
+InsertionRequest InsertionRequest::CreateFromColumns(
+    const std::string& table_name,
+    const std::vector<std::string_view>& column_names,
+    const Columns& columns) {
+  io::impl::ValidateRowsMapping<Row>();
+  io::impl::ValidateColumnsCount<Row>(column_names.size());
+
+  InsertionRequest request{table_name, column_names};
+  using MappedType = typename io::CppToClickhouse<Row>::mapped_type;
+  AppendColumns<MappedType>(
+      *request.block_, request.column_names_, columns,
+      std::make_index_sequence<std::tuple_size_v<Columns>>{});
+  return request;
+}
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -2,7 +2,9 @@
 
 #include <memory>
 
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/impl/inserter_connection.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -29,8 +31,12 @@ class Pool final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query& query) const;
 
+  Cursor ExecuteCursor(OptionalCommandControl, const Query& query) const;
+
   void Insert(OptionalCommandControl, const InsertionRequest& request) const;
 
+  InserterConnection AcquireInserterConnection() const;
+
   void WriteStatistics(
       USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
 
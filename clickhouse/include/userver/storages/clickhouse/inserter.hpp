@@ -0,0 +1,216 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/inserter.hpp
+/// @brief @copybrief storages::clickhouse::Inserter
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/storages/clickhouse/impl/insertion_request.hpp>
+#include <userver/storages/clickhouse/impl/inserter_connection.hpp>
+#include <userver/storages/clickhouse/io/impl/validate.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// @brief Settings of storages::clickhouse::Inserter
+struct InserterSettings final {
+  /// Number of rows in each sent block
+  std::size_t block_size{65536};
+};
+
+namespace impl {
+
+template <typename Row, typename Seq = std::make_index_sequence<
+                            boost::pfr::tuple_size_v<Row>>>
+struct InserterColumns;
+
+template <typename Row, std::size_t... Index>
+struct InserterColumns<Row, std::index_sequence<Index...>> {
+  using type =
+      std::tuple<std::vector<boost::pfr::tuple_element_t<Index, Row>>...>;
+};
+
+}  // namespace impl
+
+/// @brief Streaming inserter, that accepts rows incrementally and inserts
+/// them by blocks of `InserterSettings::block_size` rows.
+///
+/// Usually retrieved from storages::clickhouse::Cluster::MakeInserter.
+///
+/// `Row` is expected to be a clickhouse-mapped type, same as
+/// `Container::value_type` of storages::clickhouse::Cluster::InsertRows.
+///
+/// Rows are appended to the columns buffers. Once `block_size` rows are
+/// appended, the buffers are serialized into the native block and sent in the
+/// background task, while the new rows are appended to the other buffers.
+/// Buffers are swapped and reused between blocks, so memory consumption
+/// is bounded by two blocks and does not depend on the total rows count.
+///
+/// All blocks are sent over the single connection, held by the inserter
+/// until its destruction. Each block is inserted as a separate INSERT
+/// statement, limited by the command control timeout.
+///
+/// @warning If some block fails to be inserted, the exception is thrown from
+/// the next `Append` or `Finish` call and the inserter must not be used
+/// anymore. Blocks inserted before are not rolled back.
+template <typename Row>
+class Inserter final {
+ public:
+  /// @cond
+  Inserter(impl::InserterConnection&& connection,
+           OptionalCommandControl optional_cc, std::string table_name,
+           const std::vector<std::string_view>& column_names,
+           InserterSettings settings);
+  /// @endcond
+
+  /// @brief Waits for the block being sent, its failure is logged and not
+  /// rethrown. Rows not sent with `Finish` are dropped.
+  ~Inserter();
+
+  Inserter(const Inserter&) = delete;
+  Inserter& operator=(const Inserter&) = delete;
+
+  /// @brief Appends the row, sending the block if `block_size` rows are
+  /// accumulated.
+  void Append(const Row& row);
+
+  /// @overload
+  void Append(Row&& row);
+
+  /// @brief Sends the accumulated rows and waits until all blocks are
+  /// inserted.
+  void Finish();
+
+ private:
+  using Columns = typename impl::InserterColumns<Row>::type;
+
+  void SendIfFull();
+  void SendBuffered();
+  void WaitSending();
+
+  impl::InserterConnection connection_;
+  const OptionalCommandControl optional_cc_;
+  const std::string table_name_;
+  const std::vector<std::string> column_names_storage_;
+  const std::vector<std::string_view> column_names_;
+  const std::size_t block_size_;
+
+  Columns appending_columns_;
+  Columns sending_columns_;
+  std::size_t appended_rows_{0};
+
+  engine::TaskWithResult<void> sending_task_;
+};
+
+template <typename Row>
+Inserter<Row>::Inserter(impl::InserterConnection&& connection,
+                        OptionalCommandControl optional_cc,
+                        std::string table_name,
+                        const std::vector<std::string_view>& column_names,
+                        InserterSettings settings)
+    : connection_{std::move(connection)},
+      optional_cc_{optional_cc},
+      table_name_{std::move(table_name)},
+      column_names_storage_{column_names.begin(), column_names.end()},
+      column_names_{column_names_storage_.begin(),
+                    column_names_storage_.end()},
+      block_size_{settings.block_size} {
+  io::impl::ValidateRowsMapping<Row>();
+  io::impl::ValidateColumnsCount<Row>(column_names_.size());
+  UINVARIANT(block_size_ > 0, "Block size must be positive");
+
+  const auto reserve = [this](auto&... columns) {
+    (..., columns.reserve(block_size_));
+  };
+  std::apply(reserve, appending_columns_);
+  std::apply(reserve, sending_columns_);
+}
+
+template <typename Row>
+Inserter<Row>::~Inserter() {
+  if (!sending_task_.IsValid()) return;
+
+  try {
+    sending_task_.Get();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to insert a block into " << table_name_ << ": "
+                << ex;
+  }
+}
+
+template <typename Row>
+void Inserter<Row>::Append(const Row& row) {
+  boost::pfr::for_each_field(row, [this](const auto& field, auto index) {
+    std::get<decltype(index)::value>(appending_columns_).push_back(field);
+  });
+  SendIfFull();
+}
+
+template <typename Row>
+void Inserter<Row>::Append(Row&& row) {
+  boost::pfr::for_each_field(row, [this](auto& field, auto index) {
+    std::get<decltype(index)::value>(appending_columns_)
+        .push_back(std::move(field));
+  });
+  SendIfFull();
+}
+
+template <typename Row>
+void Inserter<Row>::Finish() {
+  if (appended_rows_ != 0) {
+    SendBuffered();
+  }
+  WaitSending();
+}
+
+template <typename Row>
+void Inserter<Row>::SendIfFull() {
+  if (++appended_rows_ == block_size_) {
+    SendBuffered();
+  }
+}
+
+template <typename Row>
+void Inserter<Row>::SendBuffered() {
+  WaitSending();
+
+  // Previous block buffers are cleared, but keep their capacity
+  std::swap(appending_columns_, sending_columns_);
+  appended_rows_ = 0;
+
+  sending_task_ = USERVER_NAMESPACE::utils::Async(
+      "clickhouse_inserter_block", [this] {
+        const auto request = impl::InsertionRequest::CreateFromColumns<Row>(
+            table_name_, column_names_, sending_columns_);
+        std::apply([](auto&... columns) { (..., columns.clear()); },
+                   sending_columns_);
+
+        connection_.Insert(optional_cc_, request);
+      });
+}
+
+template <typename Row>
+void Inserter<Row>::WaitSending() {
+  if (sending_task_.IsValid()) {
+    sending_task_.Get();
+  }
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -22,6 +22,7 @@ namespace storages::clickhouse {
 
 namespace impl {
 class Pool;
+class CursorImpl;
 }
 
 class Cluster;
@@ -45,6 +46,7 @@ class Query final {
   friend class Cluster;
   friend class QueryTester;
   friend class impl::Pool;
+  friend class impl::CursorImpl;
 
  private:
   template <typename... Args>
@@ -54,6 +54,11 @@ ExecutionResult Cluster::DoExecute(OptionalCommandControl optional_cc,
   return GetPool().Execute(optional_cc, query);
 }
 
+Cursor Cluster::DoExecuteCursor(OptionalCommandControl optional_cc,
+                                const Query& query) const {
+  return GetPool().ExecuteCursor(optional_cc, query);
+}
+
 void Cluster::DoInsert(OptionalCommandControl optional_cc,
                        const impl::InsertionRequest& request) const {
   GetPool().Insert(optional_cc, request);
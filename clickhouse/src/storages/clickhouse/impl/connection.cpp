@@ -104,6 +104,33 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                  const Query& query,
+                                  const BlockConsumer& consumer) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  bool consumer_alive = true;
+  native_query.OnData(
+      [&consumer, &consumer_alive, &scope](const NativeBlock& data) {
+        scope.Reset(scopes::kExec);
+        if (!consumer_alive || data.GetRowCount() == 0) return;
+
+        // copying the block is cheap, columns are shared
+        consumer_alive =
+            consumer(BlockWrapperPtr{new BlockWrapper{NativeBlock{data}}});
+      });
+  native_query.OnDataCancelable(
+      [&consumer_alive]([[maybe_unused]] const auto& block) {
+        // cancels the query on the server, but drains the connection
+        return consumer_alive && !engine::current_task::ShouldCancel();
+      });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
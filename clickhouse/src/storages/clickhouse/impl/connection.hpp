@@ -2,6 +2,8 @@
 
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
+#include <functional>
+
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
@@ -23,11 +25,17 @@ class InsertionRequest;
 
 class Connection final {
  public:
+  /// Returns false if no more blocks are needed
+  using BlockConsumer = std::function<bool(BlockWrapperPtr&&)>;
+
   Connection(clients::dns::Resolver&, const EndpointSettings&,
              const AuthSettings&, const ConnectionSettings&);
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  void ExecuteStreaming(OptionalCommandControl, const Query&,
+                        const BlockConsumer& consumer);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
@@ -0,0 +1,80 @@
+#include "cursor_impl.hpp"
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/async.hpp>
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+#include <storages/clickhouse/impl/connection.hpp>
+#include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/pool_impl.hpp>
+#include <storages/clickhouse/impl/tracing_tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+namespace {
+
+// One block is being received and one is being processed by the consumer
+// in addition to these, so memory usage doesn't depend on the result size
+constexpr std::size_t kPrefetchedBlocksCount = 2;
+
+}  // namespace
+
+CursorImpl::CursorImpl(std::shared_ptr<PoolImpl> pool,
+                       OptionalCommandControl optional_cc, const Query& query)
+    : queue_{Queue::Create(kPrefetchedBlocksCount)},
+      consumer_{queue_->GetConsumer()} {
+  auto conn_ptr = pool->Acquire();
+
+  task_ = utils::Async(
+      scopes::kQuery,
+      [pool = std::move(pool), conn_ptr = std::move(conn_ptr), optional_cc,
+       query, producer = queue_->GetProducer()] {
+        auto& span = tracing::Span::CurrentSpan();
+        span.AddTag(tracing::kDatabaseInstance, pool->GetHostName());
+        query.FillSpanTags(span);
+
+        const auto timer = pool->GetExecuteTimer();
+        conn_ptr->ExecuteStreaming(
+            optional_cc, query, [&producer](BlockWrapperPtr&& block) {
+              return producer.Push(std::move(block));
+            });
+      });
+}
+
+CursorImpl::~CursorImpl() {
+  if (!task_.IsValid()) return;
+
+  // Without the consumer the producer stops on the next block and the query
+  // is gracefully cancelled on the server, keeping the connection reusable.
+  { [[maybe_unused]] const auto consumer = std::move(consumer_); }
+
+  if (engine::current_task::ShouldCancel()) {
+    task_.SyncCancel();
+    return;
+  }
+  try {
+    task_.Wait();
+  } catch (const engine::WaitInterruptedException&) {
+    task_.SyncCancel();
+  }
+}
+
+BlockWrapperPtr CursorImpl::Next() {
+  if (!task_.IsValid()) return nullptr;
+
+  BlockWrapperPtr block;
+  if (consumer_.Pop(block)) return block;
+
+  // producer is gone: either the result is exhausted or the query failed
+  task_.Get();
+  return nullptr;
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+class Query;
+
+namespace impl {
+
+class PoolImpl;
+
+/// Runs the query in a background task holding the connection, that feeds
+/// the received blocks into a bounded queue.
+class CursorImpl final {
+ public:
+  CursorImpl(std::shared_ptr<PoolImpl> pool, OptionalCommandControl,
+             const Query& query);
+  ~CursorImpl();
+
+  /// Returns nullptr once the result is exhausted, rethrows query errors.
+  BlockWrapperPtr Next();
+
+ private:
+  using Queue = concurrent::SpscQueue<BlockWrapperPtr>;
+
+  std::shared_ptr<Queue> queue_;
+  Queue::Consumer consumer_;
+  engine::TaskWithResult<void> task_;
+};
+
+}  // namespace impl
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,35 @@
+#include <userver/storages/clickhouse/impl/inserter_connection.hpp>
+
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+
+#include <storages/clickhouse/impl/connection.hpp>
+#include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/pool_impl.hpp>
+#include <storages/clickhouse/impl/tracing_tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+InserterConnection::InserterConnection(std::shared_ptr<PoolImpl> pool)
+    : pool_{std::move(pool)},
+      connection_{std::make_unique<ConnectionPtr>(pool_->Acquire())} {}
+
+InserterConnection::~InserterConnection() = default;
+
+InserterConnection::InserterConnection(InserterConnection&&) noexcept =
+    default;
+
+void InserterConnection::Insert(OptionalCommandControl optional_cc,
+                                const InsertionRequest& request) const {
+  tracing::Span span{scopes::kInsert};
+  span.AddTag(tracing::kDatabaseInstance, pool_->GetHostName());
+
+  const auto timer = pool_->GetInsertTimer();
+  (*connection_)->Insert(optional_cc, request);
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
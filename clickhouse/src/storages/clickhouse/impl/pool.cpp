@@ -7,6 +7,7 @@
 
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
 #include <storages/clickhouse/impl/pool_impl.hpp>
 #include <storages/clickhouse/impl/tracing_tags.hpp>
 #include <userver/formats/json/value_builder.hpp>
@@ -45,6 +46,11 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+Cursor Pool::ExecuteCursor(OptionalCommandControl optional_cc,
+                           const Query& query) const {
+  return Cursor{std::make_unique<CursorImpl>(impl_, optional_cc, query)};
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -55,6 +61,10 @@ void Pool::Insert(OptionalCommandControl optional_cc,
   conn_ptr->Insert(optional_cc, request);
 }
 
+InserterConnection Pool::AcquireInserterConnection() const {
+  return InserterConnection{impl_};
+}
+
 void Pool::WriteStatistics(
     USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
   writer.ValueWithLabels(impl_->GetStatistics(),
@@ -0,0 +1,106 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/cursor.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Data final {
+  std::vector<uint64_t> numbers;
+};
+
+struct RowData final {
+  uint64_t number;
+};
+
+constexpr std::size_t kRowsCount = 100'000;
+
+const storages::clickhouse::Query kQuery{
+    "SELECT number FROM numbers(0, {}) SETTINGS max_block_size = 1000"};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Data> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+template <>
+struct CppToClickhouse<RowData> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(Cursor, Works) {
+  ClusterWrapper cluster{};
+
+  /// [Sample Cursor usage]
+  auto cursor = cluster->ExecuteCursor(kQuery, kRowsCount);
+
+  std::size_t blocks_count = 0;
+  uint64_t sum = 0;
+  while (auto block = cursor.NextAs<Data>()) {
+    ++blocks_count;
+    for (const auto number : block->numbers) sum += number;
+  }
+  /// [Sample Cursor usage]
+
+  EXPECT_GT(blocks_count, 1);
+  EXPECT_EQ(sum, kRowsCount * (kRowsCount - 1) / 2);
+  EXPECT_FALSE(cursor.Next().has_value());
+}
+
+UTEST(Cursor, RowsMapping) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteCursor(kQuery, kRowsCount);
+
+  uint64_t expected = 0;
+  while (auto block = cursor.Next()) {
+    for (const auto& row : std::move(*block).AsRows<RowData>()) {
+      ASSERT_EQ(row.number, expected);
+      ++expected;
+    }
+  }
+  EXPECT_EQ(expected, kRowsCount);
+}
+
+UTEST(Cursor, EmptyResult) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteCursor(kQuery, 0);
+  EXPECT_FALSE(cursor.Next().has_value());
+}
+
+UTEST(Cursor, QueryErrorIsThrown) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteCursor(
+      storages::clickhouse::Query{"SELECT * FROM non_existing_table"});
+  EXPECT_ANY_THROW(cursor.Next());
+}
+
+UTEST(Cursor, DestroyedBeforeExhausted) {
+  ClusterWrapper cluster{};
+
+  {
+    auto cursor = cluster->ExecuteCursor(kQuery, kRowsCount * 100);
+    const auto block = cursor.NextAs<Data>();
+    ASSERT_TRUE(block.has_value());
+    EXPECT_EQ(block->numbers.front(), 0);
+  }
+
+  const auto result =
+      cluster->Execute(kQuery, kRowsCount).As<Data>().numbers.size();
+  EXPECT_EQ(result, kRowsCount);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/inserter.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kRowsCount = 10'000'000;
+constexpr std::size_t kWorkerThreads = 4;
+
+const storages::clickhouse::CommandControl kCommandControl{
+    std::chrono::seconds{60}};
+
+struct Row final {
+  uint64_t number;
+  std::string string;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Row> final {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+// Null engine discards the data, so only the client and the transport
+// are measured
+void PrepareTable(ClusterWrapper& cluster) {
+  cluster->Execute(
+      "CREATE TABLE IF NOT EXISTS inserter_benchmark "
+      "(number UInt64, string String) ENGINE = Null");
+}
+
+Row MakeRow(std::size_t index) { return Row{index, "some event payload"}; }
+
+}  // namespace
+
+void ClickhouseInsertRowsMaterialized(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&state] {
+    ClusterWrapper cluster{};
+    PrepareTable(cluster);
+
+    for (auto _ : state) {
+      std::vector<Row> rows;
+      rows.reserve(kRowsCount);
+      for (std::size_t i = 0; i < kRowsCount; ++i) {
+        rows.push_back(MakeRow(i));
+      }
+
+      cluster->InsertRows(kCommandControl, "inserter_benchmark",
+                          {"number", "string"}, rows);
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRowsCount);
+  });
+}
+BENCHMARK(ClickhouseInsertRowsMaterialized)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void ClickhouseInserterStreaming(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&state] {
+    ClusterWrapper cluster{};
+    PrepareTable(cluster);
+
+    const storages::clickhouse::InserterSettings settings{
+        static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+      auto inserter = cluster->MakeInserter<Row>(
+          kCommandControl, "inserter_benchmark", {"number", "string"},
+          settings);
+      for (std::size_t i = 0; i < kRowsCount; ++i) {
+        inserter.Append(MakeRow(i));
+      }
+      inserter.Finish();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRowsCount);
+  });
+}
+BENCHMARK(ClickhouseInserterStreaming)
+    ->RangeMultiplier(8)
+    ->Range(8192, 1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,127 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/inserter.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Row final {
+  uint64_t number;
+  std::string string;
+};
+
+struct Data final {
+  std::vector<uint64_t> numbers;
+  std::vector<std::string> strings;
+};
+
+struct Count final {
+  std::vector<uint64_t> count;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Row> final {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+template <>
+struct CppToClickhouse<Data> final {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+template <>
+struct CppToClickhouse<Count> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+// Inserter uses its own connection, so temporary tables are not visible to it
+void RecreateTable(ClusterWrapper& cluster) {
+  cluster->Execute(
+      "CREATE TABLE IF NOT EXISTS inserter_table "
+      "(number UInt64, string String) ENGINE = Memory");
+  cluster->Execute("TRUNCATE TABLE inserter_table");
+}
+
+}  // namespace
+
+UTEST(Inserter, Works) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  constexpr std::size_t kRowsCount = 1000;
+  auto inserter = cluster->MakeInserter<Row>(
+      "inserter_table", {"number", "string"},
+      storages::clickhouse::InserterSettings{/*block_size=*/64});
+  for (std::size_t i = 0; i < kRowsCount; ++i) {
+    if (i % 2 == 0) {
+      inserter.Append(Row{i, std::to_string(i)});
+    } else {
+      const Row row{i, std::to_string(i)};
+      inserter.Append(row);
+    }
+  }
+  inserter.Finish();
+
+  const auto data =
+      cluster
+          ->Execute("SELECT number, string FROM inserter_table ORDER BY number")
+          .As<Data>();
+  ASSERT_EQ(data.numbers.size(), kRowsCount);
+  for (std::size_t i = 0; i < kRowsCount; ++i) {
+    EXPECT_EQ(data.numbers[i], i);
+    EXPECT_EQ(data.strings[i], std::to_string(i));
+  }
+}
+
+UTEST(Inserter, FinishWithoutRows) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  auto inserter =
+      cluster->MakeInserter<Row>("inserter_table", {"number", "string"});
+  inserter.Finish();
+
+  const auto count =
+      cluster->Execute("SELECT count() FROM inserter_table").As<Count>();
+  ASSERT_EQ(count.count.size(), 1);
+  EXPECT_EQ(count.count.front(), 0);
+}
+
+UTEST(Inserter, DropsNotFinishedRows) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  {
+    auto inserter = cluster->MakeInserter<Row>(
+        "inserter_table", {"number", "string"},
+        storages::clickhouse::InserterSettings{/*block_size=*/10});
+    for (std::size_t i = 0; i < 10; ++i) {
+      inserter.Append(Row{i, "value"});
+    }
+    inserter.Append(Row{10, "value"});
+    inserter.Finish();
+
+    // not finished row is dropped on destruction
+    inserter.Append(Row{11, "value"});
+  }
+
+  const auto count =
+      cluster->Execute("SELECT count() FROM inserter_table").As<Count>();
+  ASSERT_EQ(count.count.size(), 1);
+  EXPECT_EQ(count.count.front(), 11);
+}
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/handlers/json_error_builder.hpp>
 #include <userver/server/http/http_response_body_stream.hpp>
@@ -46,6 +47,10 @@ class HttpServerHandler final : public server::handlers::HttpHandlerBase {
       return kDefaultAnswer;
     }
 
+    if (type == "task-priority") {
+      return std::string{ToString(engine::current_task::GetPriority())};
+    }
+
     UINVARIANT(false, "Unexpected request type");
   }
 
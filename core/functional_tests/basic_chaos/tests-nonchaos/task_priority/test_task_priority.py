@@ -0,0 +1,8 @@
+async def test_plain_handler_priority(service_client):
+    # Request tasks must not inherit the critical priority of the connection
+    # tasks that start them
+    response = await service_client.get(
+        '/chaos/httpserver', params={'type': 'task-priority'},
+    )
+    assert response.status == 200
+    assert response.text == 'normal'
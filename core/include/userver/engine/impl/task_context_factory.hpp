@@ -3,10 +3,12 @@
 #include <cstddef>
 #include <memory>
 #include <new>
+#include <optional>
 #include <utility>
 
 #include <userver/engine/impl/task_context_holder.hpp>
 #include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/impl/wrapped_call.hpp>
 
@@ -24,6 +26,8 @@ struct TaskConfig final {
   Task::Importance importance{Task::Importance::kNormal};
   Task::WaitMode wait_mode{Task::WaitMode::kSingleWaiter};
   engine::Deadline deadline;
+  // Inherited from the current task if not set, see engine::TaskPriority
+  std::optional<TaskPriority> priority{};
 };
 
 [[nodiscard]] TaskContext& PlacementNewTaskContext(
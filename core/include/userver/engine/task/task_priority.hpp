@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file userver/engine/task/task_priority.hpp
+/// @brief @copybrief engine::TaskPriority
+
+#include <cstddef>
+#include <string_view>
+
+#include <userver/formats/parse/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace yaml_config {
+class YamlConfig;
+}  // namespace yaml_config
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// @brief Scheduling lane of a task inside its engine::TaskProcessor
+///
+/// Each engine::TaskProcessor keeps a separate queue of ready tasks per
+/// priority and dequeues from them in a weighted fair manner, so that cheap
+/// high-priority tasks (health checks, cache hits) are not stuck behind
+/// a backlog of expensive ones during an overload. Lower priorities are never
+/// starved completely.
+///
+/// A new task inherits the priority of the task that started it. Tasks
+/// started with engine::Task::Importance::kCritical and tasks started outside
+/// of a coroutine with no explicit priority get kCritical and kNormal
+/// respectively.
+enum class TaskPriority {
+  kCritical,    ///< Health checks, monitoring, service-wide critical tasks
+  kNormal,      ///< The default
+  kBackground,  ///< Work that may wait while there are more important tasks
+};
+
+/// The number of engine::TaskPriority values
+inline constexpr std::size_t kTaskPriorityCount = 3;
+
+/// Returns the string representation of the priority, as used in configs
+/// and metrics
+std::string_view ToString(TaskPriority priority) noexcept;
+
+/// Parses "critical", "normal" or "background"
+TaskPriority Parse(const yaml_config::YamlConfig& value,
+                   formats::parse::To<TaskPriority>);
+
+namespace current_task {
+
+/// Returns the priority of the current task
+TaskPriority GetPriority() noexcept;
+
+}  // namespace current_task
+
+/// @brief Changes the priority of the current task for the lifetime of
+/// the scope.
+///
+/// The current task is itself rescheduled with the new priority, and the tasks
+/// started from it (e.g. by utils::Async) inherit it:
+/// @code
+/// {
+///   engine::TaskPriorityScope background{engine::TaskPriority::kBackground};
+///   auto task = utils::Async("cache-warmup", [] { /* ... */ });
+/// }
+/// @endcode
+class TaskPriorityScope final {
+ public:
+  explicit TaskPriorityScope(TaskPriority priority);
+  ~TaskPriorityScope();
+
+  TaskPriorityScope(const TaskPriorityScope&) = delete;
+  TaskPriorityScope(TaskPriorityScope&&) = delete;
+  TaskPriorityScope& operator=(const TaskPriorityScope&) = delete;
+  TaskPriorityScope& operator=(TaskPriorityScope&&) = delete;
+
+ private:
+  impl::TaskContext& context_;
+  const TaskPriority old_priority_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
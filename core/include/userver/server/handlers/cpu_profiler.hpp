@@ -0,0 +1,80 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <chrono>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that profiles the CPU usage of the task processors
+/// worker threads.
+///
+/// The profiler samples the stacks of the busy worker threads and attributes
+/// each sample to the HTTP handler that started the running task. The profile
+/// is returned in the pprof format, e.g. view it with
+/// `go tool pprof -http=: profile.pb`; `-tagfocus=handler=<name>`
+/// shows the samples of a single handler. There is no overhead
+/// between the requests to the handler. Only one profile may be collected at
+/// a time, concurrent requests get 409 Conflict. Works on Linux only.
+///
+/// The stacks are captured by walking the frame pointers, build the service
+/// and userver with `-fno-omit-frame-pointer` to get the full stacks.
+/// Otherwise the samples are truncated, often to the sampled function alone.
+///
+/// The handler is not a part of components::CommonServerComponentList, append
+/// it to the component list to enable.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// default-frequency | sampling frequency if not set in the request, in Hz | 99
+/// max-frequency | the upper limit for the sampling frequency, in Hz | 1000
+/// max-duration | the upper limit for the profiling duration | 60s
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_server_component_list_test.cpp  Sample handler cpu profiler component config
+///
+/// ## Scheme
+/// Accepts optional URL arguments:
+/// * `seconds` - profiling duration, 10 seconds by default
+/// * `frequency` - sampling frequency in Hz
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+ public:
+  CpuProfiler(const components::ComponentConfig&,
+              const components::ComponentContext&);
+
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::CpuProfiler
+  static constexpr std::string_view kName = "handler-cpu-profiler";
+
+  std::string HandleRequestThrow(const http::HttpRequest&,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const std::size_t default_frequency_;
+  const std::size_t max_frequency_;
+  const std::chrono::milliseconds max_duration_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> =
+    true;
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <variant>
 #include <vector>
 
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
 #include <userver/server/http/http_status.hpp>
@@ -29,6 +30,7 @@ enum class UrlTrailingSlashOption {
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
+  std::optional<engine::TaskPriority> task_priority;
   std::string method;
   request::HttpRequestConfig request_config{};
   size_t request_body_size_log_limit{0};
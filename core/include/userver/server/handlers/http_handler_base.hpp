@@ -207,6 +207,7 @@ class HttpHandlerBase : public HandlerBase {
   const dynamic_config::Source config_source_;
   const std::vector<http::HttpMethod> allowed_methods_;
   const std::string handler_name_;
+  const std::string& profiler_tag_;
   utils::statistics::Entry statistics_holder_;
   std::optional<logging::Level> log_level_;
   std::unordered_map<int, logging::Level> log_level_for_status_codes_;
@@ -3,6 +3,9 @@
 /// @file userver/server/handlers/jemalloc.hpp
 /// @brief @copybrief server::handlers::Jemalloc
 
+#include <string>
+
+#include <userver/engine/mutex.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -15,8 +18,10 @@ namespace server::handlers {
 ///
 /// @brief Handler that controls the jemalloc allocator.
 ///
-/// The component has no service configuration except the
-/// @ref userver_http_handlers "common handler options".
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// heap-profile-dir | directory for the heap profiles of `snapshot` and `diff` commands | /tmp
 ///
 /// ## Static configuration example:
 ///
@@ -28,6 +33,17 @@ namespace server::handlers {
 /// * `enable` - to start memory profiling
 /// * `disable` - to stop memory profiling
 /// * `dump` - to get jemalloc profiling dump
+/// * `snapshot` - to remember the current heap profile as a base for `diff`
+/// * `diff` - to get the stacks that allocated the live memory that appeared
+///   since the base heap profile, the largest growth first; the current heap
+///   profile becomes the new base. Optional URL argument `limit` sets
+///   the number of the stacks to show, 20 by default.
+///
+/// Memory profiling must be enabled for `snapshot` and `diff`, e.g. by
+/// `MALLOC_CONF=prof:true,prof_active:false` and the `enable` command.
+/// To find the HTTP handlers to look at, see the `http.handler.allocated-bytes`
+/// and `http.handler.deallocated-bytes` metrics of the per-handler HTTP
+/// statistics.
 
 // clang-format on
 
@@ -44,6 +60,17 @@ class Jemalloc final : public HttpHandlerBase {
                                  request::RequestContext&) const override;
 
   static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::string HandleSnapshot() const;
+  std::string HandleDiff(const http::HttpRequest&) const;
+  std::string MakeHeapProfilePath() const;
+
+  const std::string heap_profile_dir_;
+
+  mutable engine::Mutex base_profile_mutex_;
+  mutable std::string base_profile_path_;
+  mutable std::size_t dumps_count_{0};
 };
 
 }  // namespace server::handlers
@@ -5,6 +5,7 @@
 
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,6 +31,12 @@ enum class StatsFormat;
 ///   utils::statistics::ToPrometheusFormatUntyped, utils::statistics::ToGraphiteFormat, utils::statistics::ToJsonFormat,
 ///   utils::statistics::ToSolomonFormat, utils::statistics::ToPrettyFormat.
 ///
+/// The Prometheus formats are written by utils::statistics::PrometheusFormatter
+/// that caches the converted metric names between requests. With a large
+/// number of metrics set 'parallel-tasks' to visit the metric writers in
+/// multiple tasks, and 'response-body-stream: true' to send the output in
+/// chunks as soon as they are ready.
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
@@ -57,6 +64,10 @@ class ServerMonitor final : public HttpHandlerBase {
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext&) const override;
 
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext&,
+                           http::ResponseBodyStream& stream) const override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
@@ -64,11 +75,17 @@ class ServerMonitor final : public HttpHandlerBase {
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& response_data) const override;
 
+  std::string FormatMetrics(
+      impl::StatsFormat format,
+      const utils::statistics::Request& statistics_request) const;
+
   utils::statistics::Storage& statistics_storage_;
 
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
   const std::optional<impl::StatsFormat> default_format_;
+  const utils::statistics::PrometheusFormatter prometheus_formatter_;
+  const utils::statistics::PrometheusFormatter prometheus_untyped_formatter_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,149 @@
+#pragma once
+
+/// @file userver/tracing/otlp_exporter_component.hpp
+/// @brief Components that export the traces and the metrics over OTLP
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+class OtlpExporter;
+class OtlpMetricsExporter;
+}  // namespace tracing::impl
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that exports the finished tracing::Span of the service
+/// to an OpenTelemetry collector in the OTLP/HTTP protobuf format.
+///
+/// Unlike the "opentracing" logger of the components::Tracer, does not
+/// require parsing the traces out of the logs downstream.
+///
+/// The finished spans are put into per-thread lock-free buffers, which are
+/// drained by a background task every `export-interval`. The task samples the
+/// spans and sends them in batches of up to `max-batch-size` spans. The memory
+/// is bounded: the spans that do not fit into the buffers are dropped and
+/// accounted in the component metrics, same as the batches that the collector
+/// failed to accept.
+///
+/// Head sampling keeps `head-sampling-ratio` of all the traces, deciding by
+/// the trace id, so that the services with the same ratio keep the same
+/// traces. The spans of the other traces are dropped right away unless tail
+/// sampling is enabled. In that case they are buffered until the local root
+/// span of their trace (e.g. the request handling span) finishes, and
+/// the trace is exported if any of its spans failed or was slower than
+/// `latency-threshold`.
+///
+/// The spans disabled via @ref USERVER_NO_LOG_SPANS are not exported.
+///
+/// The metrics are exported by the components::OtlpMetricsExporter.
+///
+/// The component is not a part of components::CommonComponentList, append it
+/// to the component list to enable.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | OTLP/HTTP traces endpoint of the collector | -
+/// service-name | value of the `service.name` resource attribute | -
+/// http-client | name of the components::HttpClient to send the spans with | http-client
+/// head-sampling-ratio | fraction of the traces to export, from 0 to 1 | 1
+/// tail-sampling.enabled | export the interesting traces that were not head-sampled | false
+/// tail-sampling.errors | a trace with a failed span is interesting | true
+/// tail-sampling.latency-threshold | a trace with a span at least this slow is interesting, 0 to disable | 0
+/// tail-sampling.decision-wait | how long to wait for the local root span of a trace | 5s
+/// tail-sampling.max-pending-spans | limit of the spans waiting for the decision | 10000
+/// thread-buffer-size | capacity of each per-thread span buffer | 1024
+/// max-queue-size | limit of the spans sent per export-interval | 8192
+/// max-batch-size | limit of the spans per export request | 512
+/// export-interval | how often to send the spans | 1s
+/// export-timeout | timeout of a single export request | 1s
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_component_list_test.cpp  Sample otlp trace exporter component config
+
+// clang-format on
+class OtlpTraceExporter final : public LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of components::OtlpTraceExporter
+  static constexpr std::string_view kName = "otlp-trace-exporter";
+
+  OtlpTraceExporter(const ComponentConfig& config,
+                    const ComponentContext& context);
+  ~OtlpTraceExporter() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<tracing::impl::OtlpExporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <>
+inline constexpr bool kHasValidate<OtlpTraceExporter> = true;
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that exports the metrics of the
+/// components::StatisticsStorage to an OpenTelemetry collector in the
+/// OTLP/HTTP protobuf format.
+///
+/// Every `export-interval` the current values of all the metrics are sent in
+/// requests of up to `max-batch-size` metrics each. utils::statistics::Rate
+/// metrics are exported as cumulative monotonic sums, histograms as explicit
+/// bucket histograms and the other metrics as gauges. The metric labels become
+/// the attributes of the data points.
+///
+/// The component is not a part of components::CommonComponentList, append it
+/// to the component list to enable.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | OTLP/HTTP metrics endpoint of the collector | -
+/// service-name | value of the `service.name` resource attribute | -
+/// http-client | name of the components::HttpClient to send the metrics with | http-client
+/// max-batch-size | limit of the metrics per export request | 1000
+/// export-interval | how often to send the metrics | 10s
+/// export-timeout | timeout of a single export request | 1s
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_component_list_test.cpp  Sample otlp metrics exporter component config
+
+// clang-format on
+class OtlpMetricsExporter final : public LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of components::OtlpMetricsExporter
+  static constexpr std::string_view kName = "otlp-metrics-exporter";
+
+  OtlpMetricsExporter(const ComponentConfig& config,
+                      const ComponentContext& context);
+  ~OtlpMetricsExporter() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<tracing::impl::OtlpMetricsExporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <>
+inline constexpr bool kHasValidate<OtlpMetricsExporter> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -19,6 +19,10 @@ namespace tracing {
 
 class SpanBuilder;
 
+namespace impl {
+class TracerHandle;
+}  // namespace impl
+
 /// @brief Measures the execution time of the current code block, links it with
 /// the parent tracing::Spans and stores that info in the log.
 ///
@@ -232,6 +236,10 @@ class Span final {
 
   explicit Span(std::unique_ptr<Impl, OptionalDeleter>&& pimpl);
 
+  Span(impl::TracerHandle&& tracer, std::string name, const Impl* parent,
+       ReferenceType reference_type, logging::Level log_level,
+       utils::impl::SourceLocation source_location);
+
   std::string GetTag(std::string_view tag) const;
 
   std::unique_ptr<Impl, OptionalDeleter> pimpl_;
@@ -22,6 +22,8 @@ class Tracer : public std::enable_shared_from_this<Tracer> {
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  /// Sets the tracer for the new spans. The tracers that have been set are
+  /// kept alive until the process exit, so that spans do not need to own them.
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
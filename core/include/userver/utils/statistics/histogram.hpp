@@ -34,6 +34,8 @@ struct BoundsBlock;
 /// ## Histograms vs utils::statistics::Percentile
 ///
 /// @see utils::statistics::Percentile is a related metric type
+/// @see utils::statistics::LogLinearHistogram picks the bounds automatically
+/// for the values of any magnitude
 ///
 /// The trade-offs of histograms with `Percentile` are:
 ///
@@ -0,0 +1,117 @@
+#pragma once
+
+/// @file userver/utils/statistics/log_linear_histogram.hpp
+/// @brief @copybrief utils::statistics::LogLinearHistogram
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief A histogram of integer values (e.g. timings) with log-linear buckets
+/// and a bounded relative error.
+///
+/// Each power of two is split into 32 equal buckets, so a bucket is at most
+/// 1/32 (~3%) as wide as its lower bound, regardless of the magnitude of the
+/// values. Values below 32 are counted exactly. Unlike
+/// utils::statistics::Percentile, there is no upper limit on the values that
+/// are accounted precisely, and the histograms are summable: merging them
+/// via Add gives the same buckets as if all the values were accounted into
+/// a single histogram.
+///
+/// Recording is lock-free: the buckets are grouped into rows, one row per
+/// power of two, which are allocated on first use. Each row has several
+/// stripes of counters, and each thread increments its own stripe to avoid
+/// contention on the hot buckets.
+///
+/// ## Metric format
+///
+/// The histogram is written as a utils::statistics::HistogramView metric, so
+/// all the metric formats support it. To fit the limit of 50 buckets, the
+/// written buckets are coarser: each power of two up to `max_exported_value`
+/// is split into 2^P buckets for the largest P that fits, and the buckets
+/// left over split the largest powers of two into 2^(P+1) buckets. The larger
+/// values are written to the "infinity" bucket. The bounds depend only on
+/// `max_exported_value`, so histograms with the same `max_exported_value`
+/// written from multiple hosts can be summed by the metrics server.
+///
+/// A written bucket is up to 1/2^P as wide as its lower bound, so the
+/// percentiles computed from the written metric are that much less precise
+/// than GetPercentile. For example, for `max_exported_value` of 60000 the
+/// bounds are 1, 2, 3, 4, 6, 8, ..., 96, 128, 160, 192, 224, 256, 320, ...,
+/// 49152, 57344, 65536: the error is up to 50% below 128 and up to 25% above.
+///
+/// Values 0 and 1 share the first bucket.
+///
+/// Type is safe to read/write concurrently from different threads/coroutines.
+///
+/// Usage example:
+/// @snippet utils/statistics/log_linear_histogram_test.cpp  sample
+///
+/// @see utils::statistics::Histogram for arbitrary bucket bounds
+class LogLinearHistogram final {
+ public:
+  /// Each power of two is split into `2^kPrecisionBits` buckets.
+  static constexpr int kPrecisionBits = 5;
+
+  /// @param max_exported_value the largest value that should be distinguished
+  /// from the others in the written metric, must be positive
+  explicit LogLinearHistogram(std::uint64_t max_exported_value);
+
+  LogLinearHistogram(const LogLinearHistogram& other);
+  LogLinearHistogram& operator=(const LogLinearHistogram& other);
+  ~LogLinearHistogram();
+
+  /// Atomically adds `count` to the bucket of `value`.
+  void Account(std::uint64_t value, std::uint64_t count = 1) noexcept;
+
+  /// Adds the counters of `other`.
+  void Add(const LogLinearHistogram& other);
+
+  /// @brief Returns the upper bound of the bucket with the X percentile - the
+  /// bucket such that the buckets up to it contain more than X percent of all
+  /// the values.
+  ///
+  /// Never underestimates the percentile, overestimates it by no more than
+  /// 1/32 of it (by 1 for 0, as values 0 and 1 share a bucket).
+  ///
+  /// @param percent value in [0..100], 100 gives the upper bound of the last
+  /// non-empty bucket
+  std::uint64_t GetPercentile(double percent) const noexcept;
+
+  /// Returns the number of accounted values.
+  std::uint64_t GetTotalCount() const noexcept;
+
+  std::uint64_t GetMaxExportedValue() const noexcept {
+    return max_exported_value_;
+  }
+
+  /// Atomically resets all counters to zero.
+  friend void ResetMetric(LogLinearHistogram& histogram) noexcept;
+
+  /// Metric serialization support for LogLinearHistogram.
+  friend void DumpMetric(Writer& writer, const LogLinearHistogram& histogram);
+
+ private:
+  struct Row;
+
+  static constexpr std::size_t kRowsCount = 64 - kPrecisionBits + 1;
+
+  Row* GetOrCreateRow(std::size_t row_index) noexcept;
+
+  template <typename Func>
+  void VisitBuckets(Func func) const;
+
+  std::uint64_t max_exported_value_;
+  std::array<std::atomic<Row*>, kRowsCount> rows_{};
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
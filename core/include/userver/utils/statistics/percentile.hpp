@@ -60,6 +60,8 @@ namespace utils::statistics {
  * total timing percentiles.
  *
  * @see utils::statistics::Histogram for the summable equivalent
+ * @see utils::statistics::LogLinearHistogram for the summable equivalent with
+ * a bounded relative error
  */
 template <std::size_t M, typename Counter = std::uint32_t,
           std::size_t ExtraBuckets = 0, std::size_t ExtraBucketSize = 500>
@@ -3,6 +3,9 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <userver/utils/statistics/storage.hpp>
@@ -35,6 +38,47 @@ std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request = {});
 
+/// @brief Outputs the metrics of a utils::statistics::Storage in Prometheus
+/// format, same as ToPrometheusFormat and ToPrometheusFormatUntyped, for
+/// repeated scrapes of large storages.
+///
+/// * The metric and label names converted to Prometheus format are cached
+///   between the calls
+/// * The metrics writers may be visited in parallel tasks, see
+///   utils::statistics::Storage::VisitMetricsInParallel
+/// * The output may be consumed in chunks as they are ready instead of
+///   waiting for the whole output
+///
+/// Safe to use concurrently from multiple tasks.
+class PrometheusFormatter final {
+ public:
+  enum class Format {
+    kTyped,    ///< Same as ToPrometheusFormat
+    kUntyped,  ///< Same as ToPrometheusFormatUntyped
+  };
+
+  /// @param parallel_tasks the number of tasks to visit the writers with
+  PrometheusFormatter(const Storage& storage, Format format,
+                      std::size_t parallel_tasks);
+
+  PrometheusFormatter(const PrometheusFormatter&) = delete;
+  PrometheusFormatter& operator=(const PrometheusFormatter&) = delete;
+  ~PrometheusFormatter();
+
+  /// Returns the whole output.
+  std::string ToString(const Request& request = {}) const;
+
+  /// Passes the output to `consumer` in chunks, in order. The chunks of the
+  /// first writers are passed while the next ones are being visited.
+  void ToStream(const Request& request,
+                const std::function<void(std::string&& chunk)>& consumer) const;
+
+ private:
+  struct Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
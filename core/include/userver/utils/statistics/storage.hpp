@@ -4,6 +4,7 @@
 /// @brief @copybrief utils::statistics::Storage
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <initializer_list>
 #include <list>
@@ -15,6 +16,7 @@
 #include <userver/engine/shared_mutex.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/span.hpp>
 #include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/statistics/metric_value.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -132,6 +134,22 @@ class Storage final {
   /// Visits all the metrics and calls `out.HandleMetric` for each metric.
   void VisitMetrics(BaseFormatBuilder& out, const Request& request = {}) const;
 
+  /// @brief Visits all the metrics same as VisitMetrics, but splits the
+  /// writers into `builders.size()` consecutive parts. Each part is visited in
+  /// a separate critical task on the current task processor with its own
+  /// builder, a single part is visited in the current task. The deprecated
+  /// extenders are visited after the writers with the last builder.
+  ///
+  /// `on_part_visited(i)` is called in the current task for each part in
+  /// order, as soon as the i-th and all the preceding parts are visited. It
+  /// allows passing on the output of a part while the next ones are visited.
+  ///
+  /// @warning The writers must be safe to call concurrently with each other.
+  void VisitMetricsInParallel(
+      utils::span<BaseFormatBuilder* const> builders,
+      const std::function<void(std::size_t part)>& on_part_visited,
+      const Request& request = {}) const;
+
   /// @cond
   /// Must be called from StatisticsStorage only. Don't call it from user
   /// components.
@@ -61,6 +61,7 @@ void RequestStats::StoreTiming() noexcept {
   auto diff = now - start_time_;
   auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(diff).count();
   stats_->timings_percentile_.GetCurrentCounter().Account(ms);
+  stats_->timings_histogram_.Account(ms);
 }
 
 void RequestStats::StoreTimeToStart(
@@ -161,6 +162,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   const auto& stats = view.stats;
 
   writer["timings"] = stats.timings_percentile;
+  writer["timings-histogram"] = stats.timings_histogram;
 
   for (std::size_t i = 0; i < Statistics::kErrorGroupCount; i++) {
     const auto error_group = static_cast<Statistics::ErrorGroup>(i);
@@ -213,6 +215,7 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
     : easy_handles(other.easy_handles_.load()),
       last_time_to_start_us(other.last_time_to_start_us_.load()),
       timings_percentile(other.timings_percentile_.GetStatsForPeriod()),
+      timings_histogram(other.timings_histogram_),
       retries(other.retries_.Load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.Load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.Load()),
@@ -242,6 +245,7 @@ InstanceStatistics& InstanceStatistics::operator+=(
   last_time_to_start_us += stat.last_time_to_start_us;
 
   timings_percentile.Add(stat.timings_percentile);
+  timings_histogram.Add(stat.timings_histogram);
 
   for (size_t i = 0; i < Statistics::kErrorGroupCount; i++) {
     error_count[i] += stat.error_count[i];
@@ -6,12 +6,14 @@
 #include <vector>
 
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <utils/statistics/http_codes.hpp>
+#include <utils/statistics/timings_histogram.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -102,6 +104,8 @@ class Statistics {
   utils::statistics::RecentPeriod<Percentile, Percentile,
                                   utils::datetime::SteadyClock>
       timings_percentile_;
+  utils::statistics::LogLinearHistogram timings_histogram_{
+      utils::statistics::impl::kTimingsHistogramMaxMs};
   std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
   utils::statistics::RateCounter retries_;
   utils::statistics::RateCounter socket_open_{0};
@@ -129,6 +133,8 @@ struct InstanceStatistics {
   uint64_t easy_handles{0};
   uint64_t last_time_to_start_us{0};
   Percentile timings_percentile;
+  utils::statistics::LogLinearHistogram timings_histogram{
+      utils::statistics::impl::kTimingsHistogramMaxMs};
   std::array<utils::statistics::Rate, Statistics::kErrorGroupCount> error_count;
   utils::statistics::Rate retries{0};
 
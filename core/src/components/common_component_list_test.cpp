@@ -6,6 +6,7 @@
 #include <userver/dynamic_config/test_helpers.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/otlp_exporter_component.hpp>
 
 #include <components/component_list_test.hpp>
 #include <userver/utest/utest.hpp>
@@ -165,6 +166,23 @@ components_manager:
         service-name: config-service
         tracer: native
 # /// [Sample tracer component config]
+# /// [Sample otlp trace exporter component config]
+# yaml
+    otlp-trace-exporter:
+        endpoint: http://localhost:4318/v1/traces
+        service-name: config-service
+        head-sampling-ratio: 0.1
+        tail-sampling:
+            enabled: true
+            latency-threshold: 500ms
+# /// [Sample otlp trace exporter component config]
+# /// [Sample otlp metrics exporter component config]
+# yaml
+    otlp-metrics-exporter:
+        endpoint: http://localhost:4318/v1/metrics
+        service-name: config-service
+        export-interval: 30s
+# /// [Sample otlp metrics exporter component config]
 # /// [Sample statistics storage component config]
 # yaml
     statistics-storage:
@@ -210,7 +228,9 @@ TEST_F(ComponentList, Common) {
 
   components::RunOnce(
       components::InMemoryConfig{std::string{kStaticConfig} + config_vars_path},
-      components::CommonComponentList());
+      components::CommonComponentList()
+          .Append<components::OtlpTraceExporter>()
+          .Append<components::OtlpMetricsExporter>());
 }
 
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <userver/components/run.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>  // for fs::blocking::TempDirectory
 #include <userver/fs/blocking/write.hpp>  // for fs::blocking::RewriteFileContents
+#include <userver/server/handlers/cpu_profiler.hpp>
 #include <userver/server/handlers/ping.hpp>
 
 #include <components/component_list_test.hpp>
@@ -200,6 +201,13 @@ components_manager:
         method: POST
         task_processor: monitor-task-processor
 # /// [Sample handler jemalloc component config]
+# /// [Sample handler cpu profiler component config]
+# yaml
+    handler-cpu-profiler:
+        path: /service/cpu-profile
+        method: GET
+        task_processor: monitor-task-processor
+# /// [Sample handler cpu profiler component config]
 # /// [Sample handler dns client control component config]
 # yaml
     handler-dns-client-control:
@@ -284,7 +292,8 @@ TEST_F(CommonServerComponentList, Smoke) {
                                  GetConfigVarsPath()},
       components::CommonComponentList()
           .AppendComponentList(components::CommonServerComponentList())
-          .Append<server::handlers::Ping>());
+          .Append<server::handlers::Ping>()
+          .Append<server::handlers::CpuProfiler>());
 }
 
 TEST_F(CommonServerComponentList, TraceLogging) {
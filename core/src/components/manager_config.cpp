@@ -1,5 +1,6 @@
 #include <components/manager_config.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 #include <userver/components/static_config_validator.hpp>
@@ -103,6 +104,16 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            stack_reclaim_threshold:
+                type: integer
+                description: >
+                    if a coroutine returned to the pool has more than this
+                    amount of its stack backed by memory, the rest of the stack
+                    is released back to the OS, bytes; the idle part of the
+                    pool that grew above initial_size is also shrunk gradually.
+                    0 disables the reclamation and the stack-usage-kb
+                    metric, the minimum is 16 * 1024
+                defaultDescription: 0
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -125,6 +136,29 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            timer_wheel_resolution:
+                type: string
+                description: >
+                    utils::StringToDuration suitable positive duration string
+                    of at least 1ms, the granularity of the per-thread timer
+                    wheel that drives coroutine deadlines and sleeps
+                defaultDescription: 1ms
+            cpu_affinity:
+                type: string
+                description: >
+                    CPUs to bind the ev threads to, in the Linux cpulist format
+                    (e.g. 0-15,32-47)
+            numa_node:
+                type: integer
+                description: >
+                    NUMA node to bind the ev threads to. Only the threads are
+                    pinned to the CPUs of the node, their memory is not bound
+                    to it
+            bind_to_task_processor:
+                type: string
+                description: >
+                    bind the ev threads to the CPUs of this task processor, so
+                    that they are close to the workers they wake up
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -166,6 +200,18 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                cpu-affinity:
+                    type: string
+                    description: |
+                        CPUs to bind the worker threads to, in the Linux
+                        cpulist format (e.g. 0-15,32-47)
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to bind the worker threads to. Only the
+                        threads are pinned to the CPUs of the node, the memory
+                        is not: coroutine stacks come from the process-wide
+                        pool and allocator arenas are not per node
                 task-trace:
                     type: object
                     description: .
@@ -231,6 +277,23 @@ ManagerConfig Parse(const yaml_config::YamlConfig& value,
   config.default_task_processor =
       value["default_task_processor"].As<std::string>();
 
+  auto& ev_pool_config = config.event_thread_pool;
+  if (!ev_pool_config.bind_to_task_processor.empty()) {
+    const auto it = std::find_if(
+        config.task_processors.begin(), config.task_processors.end(),
+        [&](const engine::TaskProcessorConfig& task_processor_config) {
+          return task_processor_config.name ==
+                 ev_pool_config.bind_to_task_processor;
+        });
+    if (it == config.task_processors.end()) {
+      throw std::runtime_error(
+          "components_manager.event_thread_pool.bind_to_task_processor refers "
+          "to an unknown task processor '" +
+          ev_pool_config.bind_to_task_processor + "'");
+    }
+    ev_pool_config.cpu_affinity = it->cpu_affinity;
+  }
+
   config.validate_components_configs =
       value["static_config_validation"].As<ValidationMode>(
           ValidationMode::kAll);
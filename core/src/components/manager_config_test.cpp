@@ -1,5 +1,6 @@
 #include <components/manager_config.hpp>
 
+#include <engine/ev/thread_pool_config.hpp>
 #include <server/server_config.hpp>
 #include <userver/server/handlers/handler_config.hpp>
 
@@ -244,4 +245,10 @@ TEST(ManagerConfig, HandlerConfig) {
   EXPECT_EQ(conf.task_processor, "main-task-processor");
 }
 
+TEST(ManagerConfig, ZeroTimerWheelResolution) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString("timer_wheel_resolution: 0ms"), {}};
+  UEXPECT_THROW(config.As<engine::ev::ThreadPoolConfig>(), std::runtime_error);
+}
+
 USERVER_NAMESPACE_END
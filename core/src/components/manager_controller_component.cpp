@@ -7,7 +7,9 @@
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/logging/component.hpp>
+#include <userver/utils/statistics/rate.hpp>
 
 #include <components/manager.hpp>
 
@@ -48,6 +50,13 @@ void DumpMetric(utils::statistics::Writer& writer,
     context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor().value;
   }
 
+  for (std::size_t i = 0; i < kTaskPriorityCount; ++i) {
+    const auto priority = static_cast<TaskPriority>(i);
+    writer["queue-wait-time-us"].ValueWithLabels(
+        task_processor.GetQueueWaitTime(priority),
+        {{"task_priority", ToString(priority)}});
+  }
+
   writer["worker-threads"] = task_processor.GetWorkerCount();
 }
 
@@ -112,7 +121,13 @@ void ManagerControllerComponent::WriteStatistics(
           components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
       coro_stats["active"] = stats.active_coroutines;
       coro_stats["total"] = stats.total_coroutines;
+      coro_stats["reclaimed-stacks"] =
+          utils::statistics::Rate{stats.reclaimed_stacks};
+      coro_stats["shrunk"] = utils::statistics::Rate{stats.shrunk_coroutines};
     }
+    coro_pool["stack-usage-kb"] = components_manager_.GetTaskProcessorPools()
+                                      ->GetCoroPool()
+                                      .GetStackUsage();
   }
 
   // misc
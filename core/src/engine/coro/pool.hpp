@@ -11,9 +11,11 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
+#include "stack_allocator.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -35,17 +37,34 @@ class Pool final {
   PoolStats GetStats() const;
   std::size_t GetStackSize() const;
 
+  // Stack usage (in KiB) of the sampled coroutines returned to the pool,
+  // only sampled while the stack reclamation is enabled
+  utils::statistics::HistogramView GetStackUsage() const noexcept;
+
  private:
-  Coroutine CreateCoroutine(bool quiet = false);
+  // Only every kStackCheckPeriod-th coroutine returned to the pool from a
+  // thread has its stack measured and reclaimed, because it takes syscalls.
+  static constexpr std::size_t kStackCheckPeriod = 16;
+
+  struct CoroutineWithStack {
+    Coroutine coroutine;
+    boost::context::stack_context stack;
+  };
+
+  CoroutineWithStack CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
 
+  // Returns false if the coroutine should be dropped to shrink the pool
+  bool CheckStack(const boost::context::stack_context& stack) noexcept;
+
   template <typename Token>
   Token& GetUsedPoolToken();
 
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
+  StackAllocator stack_allocator_;
+  utils::statistics::Histogram stack_usage_;
 
   // We aim to reuse coroutines as much as possible,
   // because since coroutine stack is a mmap-ed chunk of memory and not actually
@@ -53,18 +72,20 @@ class Pool final {
   //
   // The same could've been achieved with some LIFO container, but apparently
   // we don't have a container handy enough to not just use 2 queues.
-  moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-  moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+  moodycamel::ConcurrentQueue<CoroutineWithStack> initial_coroutines_;
+  moodycamel::ConcurrentQueue<CoroutineWithStack> used_coroutines_;
 
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+  std::atomic<std::size_t> reclaimed_stacks_num_{0};
+  std::atomic<std::size_t> shrunk_coroutines_num_{0};
 };
 
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(CoroutineWithStack&& coro, Pool<Task>& pool) noexcept
+      : coro_(std::move(coro.coroutine)), stack_(coro.stack), pool_(&pool) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -79,13 +100,20 @@ class Pool<Task>::CoroutinePtr final {
     return coro_;
   }
 
+  const boost::context::stack_context& GetStack() const noexcept {
+    return stack_;
+  }
+
   void ReturnToPool() && {
     UASSERT(coro_);
     pool_->PutCoroutine(std::move(*this));
   }
 
  private:
+  friend class Pool;
+
   Coroutine coro_;
+  boost::context::stack_context stack_;
   Pool<Task>* pool_;
 };
 
@@ -94,10 +122,15 @@ Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
       stack_allocator_(config_.stack_size),
+      stack_usage_(MakeStackUsageBoundsKb(config_.stack_size)),
       initial_coroutines_(config_.initial_size),
       used_coroutines_(config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
+  UINVARIANT(config_.stack_reclaim_threshold == 0 ||
+                 config_.stack_reclaim_threshold >= kMinStackReclaimThreshold,
+             "coro_pool.stack_reclaim_threshold is too small to keep the "
+             "frames of an idle coroutine");
   moodycamel::ProducerToken token(initial_coroutines_);
   for (std::size_t i = 0; i < config_.initial_size; ++i) {
     bool ok =
@@ -112,15 +145,15 @@ Pool<Task>::~Pool() = default;
 template <typename Task>
 typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
   struct CoroutineMover {
-    std::optional<Coroutine>& result;
+    std::optional<CoroutineWithStack>& result;
 
-    CoroutineMover& operator=(Coroutine&& coro) {
+    CoroutineMover& operator=(CoroutineWithStack&& coro) {
       result.emplace(std::move(coro));
       return *this;
     }
   };
 
-  std::optional<Coroutine> coroutine;
+  std::optional<CoroutineWithStack> coroutine;
   CoroutineMover mover{coroutine};
 
   // First try to dequeue from 'working set': if we can get a coroutine
@@ -139,10 +172,20 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
   if (idle_coroutines_num_.load() >= config_.max_size) return;
+
+  thread_local std::size_t put_count = 0;
+  if (config_.stack_reclaim_threshold != 0 &&
+      ++put_count % kStackCheckPeriod == 0 &&
+      !CheckStack(coroutine_ptr.stack_)) {
+    return;
+  }
+
   auto& token = GetUsedPoolToken<moodycamel::ProducerToken>();
   const bool ok =
       // We only ever return coroutines into our 'working set'.
-      used_coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+      used_coroutines_.enqueue(
+          token, CoroutineWithStack{std::move(coroutine_ptr.Get()),
+                                    coroutine_ptr.stack_});
   if (ok) ++idle_coroutines_num_;
 }
 
@@ -154,19 +197,28 @@ PoolStats Pool<Task>::GetStats() const {
       (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
+  stats.reclaimed_stacks = reclaimed_stacks_num_.load();
+  stats.shrunk_coroutines = shrunk_coroutines_num_.load();
   return stats;
 }
 
 template <typename Task>
-typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
+utils::statistics::HistogramView Pool<Task>::GetStackUsage() const noexcept {
+  return stack_usage_.GetView();
+}
+
+template <typename Task>
+typename Pool<Task>::CoroutineWithStack Pool<Task>::CreateCoroutine(
+    bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
+    boost::context::stack_context stack;
+    Coroutine coroutine(stack_allocator_.RecordingTo(stack), executor_);
     const auto new_total = ++total_coroutines_num_;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
                   << config_.max_size;
     }
-    return coroutine;
+    return {std::move(coroutine), stack};
   } catch (const std::bad_alloc&) {
     if (errno == ENOMEM) {
       // It should be ok to allocate here (which LOG_ERROR might do),
@@ -189,6 +241,29 @@ void Pool<Task>::OnCoroutineDestruction() noexcept {
   --total_coroutines_num_;
 }
 
+template <typename Task>
+bool Pool<Task>::CheckStack(
+    const boost::context::stack_context& stack) noexcept {
+  // Resident pages of a stack are never released by the OS, so this is
+  // the high-water mark of the stack usage since the last reclamation.
+  UASSERT(config_.stack_reclaim_threshold != 0);
+  const auto resident_size = StackAllocator::GetResidentSize(stack);
+  stack_usage_.Account(static_cast<double>(resident_size) / 1024);
+
+  // The pool grew above its initial size during a load spike, shrink it
+  // gradually by not returning some of the coroutines into it.
+  if (idle_coroutines_num_.load() > config_.initial_size) {
+    ++shrunk_coroutines_num_;
+    return false;
+  }
+
+  if (resident_size > config_.stack_reclaim_threshold) {
+    StackAllocator::Reclaim(stack, config_.stack_reclaim_threshold);
+    ++reclaimed_stacks_num_;
+  }
+  return true;
+}
+
 template <typename Task>
 std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
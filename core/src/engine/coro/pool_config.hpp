@@ -13,8 +13,14 @@ struct PoolConfig {
   std::size_t initial_size = 1000;
   std::size_t max_size = 4000;
   std::size_t stack_size = 256 * 1024ULL;
+  // 0 disables the memory reclamation
+  std::size_t stack_reclaim_threshold = 0;
 };
 
+// The frames of an idle coroutine are at the top of its stack and must
+// never be reclaimed.
+inline constexpr std::size_t kMinStackReclaimThreshold = 16 * 1024ULL;
+
 PoolConfig Parse(const yaml_config::YamlConfig& value,
                  formats::parse::To<PoolConfig>);
 
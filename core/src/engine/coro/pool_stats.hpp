@@ -10,11 +10,15 @@ namespace engine::coro {
 struct PoolStats {
   size_t active_coroutines = 0;
   size_t total_coroutines = 0;
+  size_t reclaimed_stacks = 0;
+  size_t shrunk_coroutines = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
   lhs.active_coroutines += rhs.active_coroutines;
   lhs.total_coroutines += rhs.total_coroutines;
+  lhs.reclaimed_stacks += rhs.reclaimed_stacks;
+  lhs.shrunk_coroutines += rhs.shrunk_coroutines;
   return lhs;
 }
 
@@ -0,0 +1,136 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <new>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+constexpr std::size_t kMinUsageBoundKb = 4;
+
+#ifdef __APPLE__
+using MincoreVecType = char;
+#else
+using MincoreVecType = unsigned char;
+#endif
+
+std::size_t GetPageSize() noexcept {
+  static const auto page_size =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+// The usable part of the stack, without the guard page at the bottom
+char* GetStackBottom(const boost::context::stack_context& sctx) noexcept {
+  return static_cast<char*>(sctx.sp) - sctx.size + GetPageSize();
+}
+
+}  // namespace
+
+StackAllocator::StackAllocator(std::size_t stack_size) noexcept
+    : stack_size_(stack_size) {}
+
+StackAllocator StackAllocator::RecordingTo(
+    boost::context::stack_context& allocated) const noexcept {
+  StackAllocator result{*this};
+  result.allocated_ = &allocated;
+  return result;
+}
+
+boost::context::stack_context StackAllocator::allocate() {
+  const auto page_size = GetPageSize();
+  const auto pages = (stack_size_ + page_size - 1) / page_size;
+  // one more page at the bottom is the guard page
+  const auto size = (pages + 1) * page_size;
+
+  // MAP_NORESERVE: do not account the whole stack against the overcommit
+  // limits, most of it is never touched
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#ifdef MAP_STACK
+  flags |= MAP_STACK;
+#endif
+  void* vp = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (vp == MAP_FAILED) throw std::bad_alloc();
+
+  [[maybe_unused]] const int result = ::mprotect(vp, page_size, PROT_NONE);
+  UASSERT(result == 0);
+
+  boost::context::stack_context sctx;
+  sctx.size = size;
+  sctx.sp = static_cast<char*>(vp) + size;
+
+  if (allocated_) *allocated_ = sctx;
+  return sctx;
+}
+
+void StackAllocator::deallocate(boost::context::stack_context& sctx) noexcept {
+  UASSERT(sctx.sp);
+  ::munmap(static_cast<char*>(sctx.sp) - sctx.size, sctx.size);
+}
+
+std::size_t StackAllocator::GetResidentSize(
+    const boost::context::stack_context& sctx) noexcept {
+  const auto page_size = GetPageSize();
+  char* const top = static_cast<char*>(sctx.sp);
+  char* bottom = GetStackBottom(sctx);
+
+  // mincore() in chunks to avoid allocations
+  std::array<MincoreVecType, 256> residency{};
+  std::size_t resident_pages = 0;
+  while (bottom < top) {
+    const auto pages = std::min<std::size_t>((top - bottom) / page_size,
+                                             residency.size());
+    if (::mincore(bottom, pages * page_size, residency.data()) != 0) {
+      UASSERT_MSG(false, "mincore failed on a coroutine stack");
+      return 0;
+    }
+    for (std::size_t i = 0; i < pages; ++i) {
+      resident_pages += residency[i] & 1;
+    }
+    bottom += pages * page_size;
+  }
+
+  return resident_pages * page_size;
+}
+
+void StackAllocator::Reclaim(const boost::context::stack_context& sctx,
+                             std::size_t keep_size) noexcept {
+  const auto page_size = GetPageSize();
+  char* const bottom = GetStackBottom(sctx);
+  const auto top = reinterpret_cast<std::uintptr_t>(sctx.sp);
+  if (keep_size >= top - reinterpret_cast<std::uintptr_t>(bottom)) return;
+
+  // Round down, so that the kept part is at least `keep_size`
+  char* const reclaim_end =
+      reinterpret_cast<char*>((top - keep_size) / page_size * page_size);
+  if (reclaim_end <= bottom) return;
+
+  // MADV_FREE would leave the pages resident until there is a memory
+  // pressure, breaking the high-water mark measurement via mincore()
+  [[maybe_unused]] const int result =
+      ::madvise(bottom, reclaim_end - bottom, MADV_DONTNEED);
+  UASSERT(result == 0);
+}
+
+std::vector<double> MakeStackUsageBoundsKb(std::size_t stack_size) {
+  std::vector<double> bounds;
+  for (auto bound = kMinUsageBoundKb; bound * 1024 < stack_size; bound *= 2) {
+    bounds.push_back(bound);
+  }
+  bounds.push_back(static_cast<double>(stack_size) / 1024);
+  return bounds;
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <coroutines/coroutine.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+// Coroutine stack allocator, a drop-in replacement for
+// boost::coroutines2::protected_fixedsize_stack.
+//
+// The whole stack is only reserved in the address space: pages are committed
+// on the first touch and may be released back to the OS with Reclaim(), so
+// a large stack costs no memory unless it is actually used.
+class StackAllocator final {
+ public:
+  explicit StackAllocator(std::size_t stack_size) noexcept;
+
+  // Returns a copy of the allocator that additionally stores the context of
+  // each allocated stack into `allocated`.
+  StackAllocator RecordingTo(
+      boost::context::stack_context& allocated) const noexcept;
+
+  boost::context::stack_context allocate();
+  void deallocate(boost::context::stack_context& sctx) noexcept;
+
+  std::size_t GetStackSize() const noexcept { return stack_size_; }
+
+  // Amount of the stack memory that is backed by physical pages, i.e. the
+  // high-water mark of the stack usage since the last Reclaim().
+  static std::size_t GetResidentSize(
+      const boost::context::stack_context& sctx) noexcept;
+
+  // Releases the physical pages of the stack except for the topmost
+  // `keep_size` bytes. The stack must not be in use below that point.
+  static void Reclaim(const boost::context::stack_context& sctx,
+                      std::size_t keep_size) noexcept;
+
+ private:
+  std::size_t stack_size_;
+  boost::context::stack_context* allocated_{nullptr};
+};
+
+// Upper bounds (in KiB) of the stack usage histogram buckets for stacks of
+// the given size.
+std::vector<double> MakeStackUsageBoundsKb(std::size_t stack_size);
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,62 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStackSize = 256 * 1024;
+constexpr std::size_t kKeepSize = 32 * 1024;
+
+// Touches the stack memory as a stack of the given depth would do
+void TouchStack(const boost::context::stack_context& sctx, std::size_t depth) {
+  std::memset(static_cast<char*>(sctx.sp) - depth, 0x5a, depth);
+}
+
+}  // namespace
+
+TEST(CoroStackAllocator, CommittedLazily) {
+  engine::coro::StackAllocator allocator{kStackSize};
+  auto sctx = allocator.allocate();
+  EXPECT_GT(sctx.size, kStackSize);  // with the guard page
+
+  EXPECT_EQ(engine::coro::StackAllocator::GetResidentSize(sctx), 0);
+
+  TouchStack(sctx, 100 * 1024);
+  EXPECT_GE(engine::coro::StackAllocator::GetResidentSize(sctx), 100 * 1024);
+
+  allocator.deallocate(sctx);
+}
+
+TEST(CoroStackAllocator, ReclaimKeepsTop) {
+  boost::context::stack_context recorded;
+  const auto allocator =
+      engine::coro::StackAllocator{kStackSize}.RecordingTo(recorded);
+  auto sctx = engine::coro::StackAllocator{allocator}.allocate();
+  EXPECT_EQ(recorded.sp, sctx.sp);
+
+  TouchStack(sctx, kStackSize);
+  EXPECT_GE(engine::coro::StackAllocator::GetResidentSize(sctx), kStackSize);
+
+  engine::coro::StackAllocator::Reclaim(sctx, kKeepSize);
+  EXPECT_EQ(engine::coro::StackAllocator::GetResidentSize(sctx), kKeepSize);
+
+  // The kept part is intact, the reclaimed part is zeroed
+  const auto* top = static_cast<const unsigned char*>(sctx.sp);
+  EXPECT_EQ(*(top - 1), 0x5a);
+  EXPECT_EQ(*(top - kKeepSize), 0x5a);
+  EXPECT_EQ(*(top - kKeepSize - 1), 0);
+
+  engine::coro::StackAllocator{kStackSize}.deallocate(sctx);
+}
+
+TEST(CoroStackAllocator, UsageBounds) {
+  const auto bounds = engine::coro::MakeStackUsageBoundsKb(kStackSize);
+  const std::vector<double> expected{4, 8, 16, 32, 64, 128, 256};
+  EXPECT_EQ(bounds, expected);
+}
+
+USERVER_NAMESPACE_END
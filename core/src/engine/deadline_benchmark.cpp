@@ -1,9 +1,12 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -47,6 +50,60 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+using engine::ev::TimerWheel;
+using engine::ev::TimerWheelEntry;
+
+void NoopTimerCallback(TimerWheelEntry&) noexcept {}
+
+std::vector<std::unique_ptr<TimerWheelEntry>> MakeTimerEntries(
+    std::size_t count) {
+  std::vector<std::unique_ptr<TimerWheelEntry>> entries;
+  entries.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    entries.push_back(
+        std::make_unique<TimerWheelEntry>(&NoopTimerCallback, nullptr));
+  }
+  return entries;
+}
+
+// Timers that are armed and then cancelled long before they fire
+void timer_wheel_insert_remove(benchmark::State& state) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{std::chrono::milliseconds{1}, origin};
+  auto entries = MakeTimerEntries(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t i = 0;
+    for (auto& entry : entries) {
+      wheel.Insert(*entry, origin + std::chrono::milliseconds(++i * 7), origin);
+    }
+    for (auto& entry : entries) wheel.Remove(*entry);
+  }
+
+  state.SetItemsProcessed(state.iterations() * entries.size());
+}
+
+// Timers that are spread over a second and fired in batches once per tick
+void timer_wheel_advance(benchmark::State& state) {
+  auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{std::chrono::milliseconds{1}, now};
+  auto entries = MakeTimerEntries(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t i = 0;
+    for (auto& entry : entries) {
+      wheel.Insert(*entry, now + std::chrono::microseconds(++i * 997 % 1000000),
+                   now);
+    }
+    while (!wheel.Empty()) {
+      now += std::chrono::milliseconds{1};
+      wheel.Advance(now);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * entries.size());
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +113,7 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(timer_wheel_insert_remove)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK(timer_wheel_advance)->RangeMultiplier(8)->Range(8, 32768);
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "thread.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
 
@@ -63,19 +64,25 @@ constexpr std::size_t kCpuStatsThrottle{16};
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::chrono::milliseconds timer_wheel_resolution)
+    : Thread(thread_name, false, register_event_mode,
+             timer_wheel_resolution) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::chrono::milliseconds timer_wheel_resolution)
+    : Thread(thread_name, true, register_event_mode,
+             timer_wheel_resolution) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode,
+               std::chrono::milliseconds timer_wheel_resolution)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
+      timer_wheel_(timer_wheel_resolution, TimerWheel::Clock::now()),
       name_{thread_name},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
@@ -129,6 +136,27 @@ bool Thread::IsInEvThread() const {
   return (std::this_thread::get_id() == thread_.get_id());
 }
 
+void Thread::AddTimer(TimerWheelEntry& entry, Deadline deadline) noexcept {
+  UASSERT(IsInEvThread());
+  UASSERT(deadline.IsReachable());
+
+  const auto now = TimerWheel::Clock::now();
+  const auto expiry = now + deadline.TimeLeft();
+  timer_wheel_.Insert(entry, expiry, now);
+
+  // Later timers are picked up when the driver wakes up for the earlier ones
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  if (!ev_is_active(&timer_wheel_driver_) || expiry < timer_wheel_wakeup_) {
+    RearmTimerWheelDriver(now);
+  }
+}
+
+void Thread::RemoveTimer(TimerWheelEntry& entry) noexcept {
+  UASSERT(IsInEvThread());
+  // The driver is rearmed or stopped lazily on its next wakeup
+  timer_wheel_.Remove(entry);
+}
+
 std::uint8_t Thread::GetCurrentLoadPercent() const {
   return cpu_stats_storage_.GetCurrentLoadPercent();
 }
@@ -177,6 +205,9 @@ void Thread::Start() {
     ev_timer_start(loop_, &stats_timer_);
   }
 
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_timer_init(&timer_wheel_driver_, TimerWheelWatcher, 0.0, 0.0);
+
   if (use_ev_default_loop_) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     ev_child_init(&watch_child_, ChildWatcher, 0, 0);
@@ -218,6 +249,7 @@ void Thread::RunEvLoop() {
   } else {
     ev_timer_stop(loop_, &stats_timer_);
   }
+  ev_timer_stop(loop_, &timer_wheel_driver_);
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
 }
 
@@ -234,6 +266,35 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
   ev_thread->UpdateLoopWatcherImpl();
 }
 
+void Thread::TimerWheelWatcher(struct ev_loop* loop, ev_timer*,
+                               int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  ev_thread->TimerWheelWatcherImpl();
+}
+
+void Thread::TimerWheelWatcherImpl() noexcept {
+  const auto now = TimerWheel::Clock::now();
+  timer_wheel_.Advance(now);
+  RearmTimerWheelDriver(now);
+}
+
+void Thread::RearmTimerWheelDriver(TimerWheel::TimePoint now) noexcept {
+  // One-shot, armed for the next slot to fire or cascade instead of ticking
+  // at the wheel resolution, so that idle threads do not wake up
+  ev_timer_stop(loop_, &timer_wheel_driver_);
+  const auto wakeup = timer_wheel_.GetNextWakeup();
+  if (!wakeup) return;
+
+  timer_wheel_wakeup_ = *wakeup;
+  const auto after = std::max(*wakeup - now, TimerWheel::Clock::duration{0});
+  ev_now_update(loop_);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_timer_set(&timer_wheel_driver_,
+               std::chrono::duration_cast<LibEvDuration>(after).count(), 0.0);
+  ev_timer_start(loop_, &timer_wheel_driver_);
+}
+
 void Thread::UpdateLoopWatcherImpl() {
   while (AsyncPayloadBase* payload = func_queue_.TryPop()) {
     LOG_TRACE() << "Thread::UpdateLoopWatcherImpl(), "
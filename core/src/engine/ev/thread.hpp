@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -12,6 +13,7 @@
 
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,8 +36,14 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  static constexpr std::chrono::milliseconds kDefaultTimerWheelResolution{1};
+
+  Thread(const std::string& thread_name, RegisterEventMode,
+         std::chrono::milliseconds timer_wheel_resolution =
+             kDefaultTimerWheelResolution);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         std::chrono::milliseconds timer_wheel_resolution =
+             kDefaultTimerWheelResolution);
   ~Thread();
 
   struct ev_loop* GetEvLoop() const { return loop_; }
@@ -52,12 +60,22 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  // Schedules the entry on the timer wheel of this thread. The entry fires
+  // not earlier than the deadline, with the timer wheel resolution.
+  // Must be called from the ev thread.
+  void AddTimer(TimerWheelEntry& entry, Deadline deadline) noexcept;
+
+  // Does nothing for an entry that is not scheduled.
+  // Must be called from the ev thread.
+  void RemoveTimer(TimerWheelEntry& entry) noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         std::chrono::milliseconds timer_wheel_resolution);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -68,6 +86,9 @@ class Thread final {
 
   static void UpdateLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   static void UpdateTimersWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void TimerWheelWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  void TimerWheelWatcherImpl() noexcept;
+  void RearmTimerWheelDriver(TimerWheel::TimePoint now) noexcept;
   void UpdateLoopWatcherImpl();
   static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   void BreakLoopWatcherImpl();
@@ -89,7 +110,12 @@ class Thread final {
   std::mutex loop_mutex_;
   std::unique_lock<std::mutex> lock_;
 
+  TimerWheel timer_wheel_;
+  // When the armed timer_wheel_driver_ fires
+  TimerWheel::TimePoint timer_wheel_wakeup_{};
+
   ev_timer timers_driver_{};
+  ev_timer timer_wheel_driver_{};
   ev_timer stats_timer_{};
   ev_async watch_update_{};
   ev_async watch_break_{};
@@ -85,17 +85,30 @@ void ThreadControlBase::DoStop(ev_io& w) noexcept {
   ev_io_stop(GetEvLoop(), &w);
 }
 
-TimerThreadControl::TimerThreadControl(Thread& thread) noexcept
-    : ThreadControlBase{thread} {}
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ThreadControlBase::DoAddTimer(TimerWheelEntry& entry,
+                                   Deadline deadline) noexcept {
+  thread_.AddTimer(entry, deadline);
+}
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Start(ev_timer& w) noexcept { DoStart(w); }
+void ThreadControlBase::DoRemoveTimer(TimerWheelEntry& entry) noexcept {
+  thread_.RemoveTimer(entry);
+}
+
+TimerThreadControl::TimerThreadControl(Thread& thread) noexcept
+    : ThreadControlBase{thread} {}
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Stop(ev_timer& w) noexcept { DoStop(w); }
+void TimerThreadControl::AddTimer(TimerWheelEntry& entry,
+                                  Deadline deadline) noexcept {
+  DoAddTimer(entry, deadline);
+}
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Again(ev_timer& w) noexcept { DoAgain(w); }
+void TimerThreadControl::RemoveTimer(TimerWheelEntry& entry) noexcept {
+  DoRemoveTimer(entry);
+}
 
 ThreadControl::ThreadControl(Thread& thread) noexcept
     : ThreadControlBase{thread} {}
@@ -9,6 +9,7 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/single_use_event.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -147,6 +148,9 @@ class ThreadControlBase {
   void DoStart(ev_io& w) noexcept;
   void DoStop(ev_io& w) noexcept;
 
+  void DoAddTimer(TimerWheelEntry& entry, Deadline deadline) noexcept;
+  void DoRemoveTimer(TimerWheelEntry& entry) noexcept;
+
  private:
   Thread& thread_;
 };
@@ -212,9 +216,8 @@ class TimerThreadControl final : public ThreadControlBase {
  public:
   explicit TimerThreadControl(Thread& thread) noexcept;
 
-  void Start(ev_timer& w) noexcept;
-  void Stop(ev_timer& w) noexcept;
-  void Again(ev_timer& w) noexcept;
+  void AddTimer(TimerWheelEntry& entry, Deadline deadline) noexcept;
+  void RemoveTimer(TimerWheelEntry& entry) noexcept;
 };
 
 class ThreadControl final : public ThreadControlBase {
@@ -2,7 +2,9 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <utils/cpu_affinity.hpp>
 
 #include "thread.hpp"
 #include "thread_control.hpp"
@@ -18,6 +20,23 @@ Thread::RegisterEventMode GetRegisterEventMode(bool defer_timers) {
                       : Thread::RegisterEventMode::kImmediate;
 }
 
+template <typename ThreadControls>
+void BindToCpus(ThreadControls& thread_controls,
+                const std::vector<std::size_t>& cpus) {
+  if (cpus.empty()) return;
+
+  for (auto& thread_control : thread_controls) {
+    thread_control.RunInEvLoopBlocking([&thread_control, &cpus] {
+      try {
+        utils::SetCurrentThreadAffinity(cpus);
+      } catch (const std::exception& e) {
+        LOG_ERROR() << "Failed to bind ev thread " << thread_control.GetName()
+                    << " to its CPUs: " << e;
+      }
+    });
+  }
+}
+
 }  // namespace
 
 ThreadPool::ThreadPool(ThreadPoolConfig config)
@@ -38,8 +57,10 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
               fmt::format("{}_{}", config.thread_name, index);
           return (use_ev_default_loop && index == 0)
                      ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                              register_timer_event_mode)
-                     : Thread(thread_name, register_timer_event_mode);
+                              register_timer_event_mode,
+                              config.timer_wheel_resolution)
+                     : Thread(thread_name, register_timer_event_mode,
+                              config.timer_wheel_resolution);
         });
 
     default_threads_.thread_controls = utils::GenerateFixedArray(
@@ -50,9 +71,10 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
 
   {
     timer_threads_.threads = utils::GenerateFixedArray(
-        config.dedicated_timer_threads, [](std::size_t index) {
+        config.dedicated_timer_threads, [&config](std::size_t index) {
           return Thread{fmt::format("ev-timer_{}", index),
-                        Thread::RegisterEventMode::kDeferred};
+                        Thread::RegisterEventMode::kDeferred,
+                        config.timer_wheel_resolution};
         });
 
     // Although we expect to always have a dedicated timer thread[s]
@@ -68,6 +90,11 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
           return TimerThreadControl{threads_to_wrap[index]};
         });
   }
+
+  BindToCpus(default_threads_.thread_controls, config.cpu_affinity);
+  if (!timer_threads_.threads.empty()) {
+    BindToCpus(timer_threads_.thread_controls, config.cpu_affinity);
+  }
 }
 
 ThreadPool::~ThreadPool() {
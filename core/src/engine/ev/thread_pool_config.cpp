@@ -1,5 +1,9 @@
 #include "thread_pool_config.hpp"
 
+#include <stdexcept>
+
+#include <utils/cpu_affinity.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
@@ -13,6 +17,23 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
           config.dedicated_timer_threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.timer_wheel_resolution =
+      value["timer_wheel_resolution"].As<std::chrono::milliseconds>(
+          config.timer_wheel_resolution);
+  if (config.timer_wheel_resolution.count() <= 0) {
+    throw std::runtime_error("'timer_wheel_resolution' must be positive at '" +
+                             value.GetPath() + "'");
+  }
+  config.cpu_affinity =
+      utils::ParseCpuAffinity(value, "cpu_affinity", "numa_node");
+  config.bind_to_task_processor =
+      value["bind_to_task_processor"].As<std::string>({});
+  if (!config.cpu_affinity.empty() && !config.bind_to_task_processor.empty()) {
+    throw std::runtime_error(
+        "Only one of 'cpu_affinity', 'numa_node' and 'bind_to_task_processor' "
+        "may be set at '" +
+        value.GetPath() + "'");
+  }
   return config;
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -15,6 +17,11 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  std::chrono::milliseconds timer_wheel_resolution{1};
+  // CPUs the ev threads are bound to, empty for no binding
+  std::vector<std::size_t> cpu_affinity;
+  // Name of the task processor to take the cpu_affinity from
+  std::string bind_to_task_processor;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
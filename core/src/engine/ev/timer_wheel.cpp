@@ -0,0 +1,170 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+TimerWheelEntry::TimerWheelEntry(Callback callback, void* data) noexcept
+    : callback_(callback), data_(data) {
+  UASSERT(callback_);
+}
+
+TimerWheelEntry::~TimerWheelEntry() {
+  UASSERT_MSG(!IsLinked(), "Destroying a scheduled timer");
+}
+
+bool TimerWheelEntry::IsLinked() const noexcept { return hook_.is_linked(); }
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds resolution, TimePoint now)
+    : resolution_(resolution), origin_(now) {
+  UINVARIANT(resolution_.count() > 0, "Timer wheel resolution must be set");
+}
+
+TimerWheel::~TimerWheel() {
+  UASSERT_MSG(Empty(), "Destroying a timer wheel with scheduled timers");
+}
+
+void TimerWheel::Insert(TimerWheelEntry& entry, TimePoint expiry,
+                        TimePoint now) noexcept {
+  Remove(entry);
+
+  // Nobody advanced the idle wheel, there is nothing to fire on the way
+  if (Empty()) current_tick_ = std::max(current_tick_, ToTickFloor(now));
+
+  entry.expiry_tick_ = std::max(ToTickCeil(expiry), current_tick_ + 1);
+  Place(entry);
+  ++size_;
+}
+
+void TimerWheel::Remove(TimerWheelEntry& entry) noexcept {
+  if (!entry.IsLinked()) return;
+
+  UASSERT(size_ > 0);
+  entry.hook_.unlink();
+  --size_;
+}
+
+void TimerWheel::Advance(TimePoint now) noexcept {
+  const auto target_tick = ToTickFloor(now);
+
+  while (current_tick_ < target_tick) {
+    if (Empty()) {
+      current_tick_ = target_tick;
+      return;
+    }
+
+    // Ticks without timers to fire or cascade are skipped all at once
+    const auto next_tick = NextEventTick();
+    if (next_tick > target_tick) {
+      current_tick_ = target_tick;
+      return;
+    }
+
+    current_tick_ = next_tick;
+    for (std::size_t level = 1; level < kLevels; ++level) {
+      const auto level_span = std::uint64_t{1} << (kLevelBits * level);
+      if (current_tick_ % level_span != 0) break;
+      Cascade(level);
+    }
+    ExpireCurrentSlot();
+  }
+}
+
+std::optional<TimerWheel::TimePoint> TimerWheel::GetNextWakeup()
+    const noexcept {
+  if (Empty()) return std::nullopt;
+  return origin_ + resolution_ * NextEventTick();
+}
+
+std::uint64_t TimerWheel::NextEventTick() const noexcept {
+  UASSERT(!Empty());
+  auto next_tick = std::numeric_limits<std::uint64_t>::max();
+
+  // A slot of level 0 fires on its tick, a slot of any other level is
+  // cascaded on the first tick of its span. Every level holds the timers of
+  // the next kSlotsPerLevel spans after the current one.
+  for (std::size_t level = 0; level < kLevels; ++level) {
+    const auto shift = kLevelBits * level;
+    const auto current_span = current_tick_ >> shift;
+    for (std::uint64_t i = 1; i <= kSlotsPerLevel; ++i) {
+      const auto tick = (current_span + i) << shift;
+      if (tick >= next_tick) break;
+      if (!slots_[level][(current_span + i) & (kSlotsPerLevel - 1)].empty()) {
+        next_tick = tick;
+        break;
+      }
+    }
+  }
+
+  UASSERT(next_tick > current_tick_);
+  return next_tick;
+}
+
+std::uint64_t TimerWheel::ToTickFloor(TimePoint time_point) const noexcept {
+  if (time_point <= origin_) return 0;
+  return (time_point - origin_) / resolution_;
+}
+
+std::uint64_t TimerWheel::ToTickCeil(TimePoint time_point) const noexcept {
+  if (time_point <= origin_) return 0;
+  const auto since_origin = time_point - origin_;
+  const std::uint64_t tick = since_origin / resolution_;
+  return since_origin % resolution_ == Clock::duration::zero() ? tick
+                                                               : tick + 1;
+}
+
+void TimerWheel::Place(TimerWheelEntry& entry) noexcept {
+  UASSERT(entry.expiry_tick_ >= current_tick_);
+  auto expiry_tick = entry.expiry_tick_;
+  const auto delta = expiry_tick - current_tick_;
+
+  // Timers beyond the wheel span are parked in its last slot and get
+  // re-placed once they are cascaded from there.
+  if (delta >= kMaxDelta) expiry_tick = current_tick_ + kMaxDelta - 1;
+
+  std::size_t level = 0;
+  while (level + 1 < kLevels &&
+         delta >= (std::uint64_t{1} << (kLevelBits * (level + 1)))) {
+    ++level;
+  }
+
+  const auto slot =
+      (expiry_tick >> (kLevelBits * level)) & (kSlotsPerLevel - 1);
+  slots_[level][slot].push_back(entry);
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  const auto slot =
+      (current_tick_ >> (kLevelBits * level)) & (kSlotsPerLevel - 1);
+
+  Slot cascaded;
+  cascaded.swap(slots_[level][slot]);
+  while (!cascaded.empty()) {
+    auto& entry = cascaded.front();
+    cascaded.pop_front();
+    Place(entry);
+  }
+}
+
+void TimerWheel::ExpireCurrentSlot() noexcept {
+  Slot expired;
+  expired.swap(slots_[0][current_tick_ & (kSlotsPerLevel - 1)]);
+
+  while (!expired.empty()) {
+    auto& entry = expired.front();
+    UASSERT(entry.expiry_tick_ == current_tick_);
+    expired.pop_front();
+    --size_;
+
+    entry.callback_(entry);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
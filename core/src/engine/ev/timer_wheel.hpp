@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <boost/intrusive/list.hpp>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+class TimerWheel;
+
+// An intrusive timer, owned by the user. Must be removed from the wheel (or
+// fired) before destruction.
+class TimerWheelEntry final {
+ public:
+  using Callback = void (*)(TimerWheelEntry&) noexcept;
+
+  TimerWheelEntry(Callback callback, void* data) noexcept;
+  ~TimerWheelEntry();
+
+  TimerWheelEntry(const TimerWheelEntry&) = delete;
+  TimerWheelEntry& operator=(const TimerWheelEntry&) = delete;
+
+  bool IsLinked() const noexcept;
+
+  void* GetData() const noexcept { return data_; }
+
+ private:
+  friend class TimerWheel;
+
+  using Hook = boost::intrusive::list_member_hook<
+      boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
+  Hook hook_;
+  std::uint64_t expiry_tick_{0};
+  Callback callback_;
+  void* data_;
+};
+
+// Hierarchical timing wheel: kLevels levels of kSlotsPerLevel slots each,
+// a slot of level 0 spans a single tick (the resolution), a slot of every
+// next level spans the whole previous level. Inserting and removing a timer
+// is O(1), expired timers are fired in batches once per tick and never
+// earlier than their expiry.
+//
+// Not thread-safe, expected to be owned and driven by a single ev thread.
+class TimerWheel final {
+ public:
+  using Clock = Deadline::Clock;
+  using TimePoint = Clock::time_point;
+
+  TimerWheel(std::chrono::nanoseconds resolution, TimePoint now);
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Schedules the entry to fire on the first tick at or after `expiry`,
+  // reschedules an already scheduled entry.
+  void Insert(TimerWheelEntry& entry, TimePoint expiry, TimePoint now) noexcept;
+
+  // Does nothing for an entry that is not scheduled.
+  void Remove(TimerWheelEntry& entry) noexcept;
+
+  // Fires all the entries that expired by `now`. Fired entries are removed
+  // before their callback is called, so the callback may reschedule them.
+  void Advance(TimePoint now) noexcept;
+
+  // The earliest time point at which Advance() has anything to do: a slot with
+  // timers to fire or a cascade of timers down the levels. Empty slots and
+  // cascades are skipped, so the driver of an idle wheel sleeps until then.
+  // std::nullopt for an empty wheel.
+  std::optional<TimePoint> GetNextWakeup() const noexcept;
+
+  bool Empty() const noexcept { return size_ == 0; }
+
+  std::size_t Size() const noexcept { return size_; }
+
+  std::chrono::nanoseconds GetResolution() const noexcept {
+    return resolution_;
+  }
+
+ private:
+  static constexpr std::size_t kLevelBits = 6;
+  static constexpr std::size_t kSlotsPerLevel = 1 << kLevelBits;
+  static constexpr std::size_t kLevels = 4;
+  static constexpr std::uint64_t kMaxDelta = std::uint64_t{1}
+                                             << (kLevelBits * kLevels);
+
+  using Slot = boost::intrusive::list<
+      TimerWheelEntry,
+      boost::intrusive::member_hook<TimerWheelEntry, TimerWheelEntry::Hook,
+                                    &TimerWheelEntry::hook_>,
+      boost::intrusive::constant_time_size<false>>;
+
+  std::uint64_t ToTickFloor(TimePoint time_point) const noexcept;
+  std::uint64_t ToTickCeil(TimePoint time_point) const noexcept;
+
+  std::uint64_t NextEventTick() const noexcept;
+
+  void Place(TimerWheelEntry& entry) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  void ExpireCurrentSlot() noexcept;
+
+  const std::chrono::nanoseconds resolution_;
+  const TimePoint origin_;
+  std::uint64_t current_tick_{0};
+  std::size_t size_{0};
+  std::array<std::array<Slot, kSlotsPerLevel>, kLevels> slots_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,200 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::TimerWheel;
+using engine::ev::TimerWheelEntry;
+
+constexpr std::chrono::milliseconds kResolution{1};
+
+struct TestTimer final {
+  TestTimer() : entry(&OnFire, this) {}
+
+  static void OnFire(TimerWheelEntry& entry) noexcept {
+    auto& self = *static_cast<TestTimer*>(entry.GetData());
+    ++self.fired_count;
+    self.fired_at = self.now;
+  }
+
+  TimerWheel::TimePoint now{};
+  TimerWheel::TimePoint fired_at{};
+  std::size_t fired_count{0};
+  TimerWheelEntry entry;
+};
+
+}  // namespace
+
+TEST(TimerWheel, FiresNotEarlier) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  TestTimer timer;
+  wheel.Insert(timer.entry, origin + std::chrono::microseconds{2500}, origin);
+  EXPECT_EQ(wheel.Size(), 1);
+
+  wheel.Advance(origin + std::chrono::milliseconds{2});
+  EXPECT_EQ(timer.fired_count, 0);
+
+  wheel.Advance(origin + std::chrono::milliseconds{3});
+  EXPECT_EQ(timer.fired_count, 1);
+  EXPECT_FALSE(timer.entry.IsLinked());
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheel, ExpiredFireOnNextTick) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  TestTimer timer;
+  const auto now = origin + std::chrono::milliseconds{10};
+  wheel.Insert(timer.entry, origin, now);
+
+  wheel.Advance(now);
+  EXPECT_EQ(timer.fired_count, 0);
+
+  wheel.Advance(now + kResolution);
+  EXPECT_EQ(timer.fired_count, 1);
+}
+
+TEST(TimerWheel, RemoveAndReschedule) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  TestTimer removed;
+  TestTimer rescheduled;
+  wheel.Insert(removed.entry, origin + std::chrono::milliseconds{5}, origin);
+  wheel.Insert(rescheduled.entry, origin + std::chrono::milliseconds{5},
+               origin);
+  wheel.Insert(rescheduled.entry, origin + std::chrono::milliseconds{100},
+               origin);
+  wheel.Remove(removed.entry);
+  EXPECT_EQ(wheel.Size(), 1);
+
+  wheel.Advance(origin + std::chrono::milliseconds{99});
+  EXPECT_EQ(removed.fired_count, 0);
+  EXPECT_EQ(rescheduled.fired_count, 0);
+
+  wheel.Advance(origin + std::chrono::milliseconds{100});
+  EXPECT_EQ(removed.fired_count, 0);
+  EXPECT_EQ(rescheduled.fired_count, 1);
+}
+
+TEST(TimerWheel, RescheduleFromCallback) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  struct PeriodicTimer final {
+    static void OnFire(TimerWheelEntry& entry) noexcept {
+      auto& self = *static_cast<PeriodicTimer*>(entry.GetData());
+      if (++self.fired_count < 3) {
+        self.wheel.Insert(entry, self.now + std::chrono::milliseconds{10},
+                          self.now);
+      }
+    }
+
+    TimerWheel& wheel;
+    TimerWheel::TimePoint now{};
+    std::size_t fired_count{0};
+    TimerWheelEntry entry{&OnFire, this};
+  } timer{wheel};
+
+  wheel.Insert(timer.entry, origin + std::chrono::milliseconds{10}, origin);
+  for (int i = 1; i <= 100; ++i) {
+    timer.now = origin + std::chrono::milliseconds{i};
+    wheel.Advance(timer.now);
+  }
+
+  EXPECT_EQ(timer.fired_count, 3);
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheel, IdleWheelFastForwards) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  TestTimer timer;
+  const auto now = origin + std::chrono::hours{24 * 365};
+  wheel.Insert(timer.entry, now + std::chrono::milliseconds{1}, now);
+
+  timer.now = now + std::chrono::milliseconds{1};
+  wheel.Advance(timer.now);
+  EXPECT_EQ(timer.fired_count, 1);
+}
+
+TEST(TimerWheel, NextWakeup) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+  EXPECT_EQ(wheel.GetNextWakeup(), std::nullopt);
+
+  TestTimer near_timer;
+  wheel.Insert(near_timer.entry, origin + std::chrono::milliseconds{10}, origin);
+  EXPECT_EQ(wheel.GetNextWakeup(), origin + std::chrono::milliseconds{10});
+
+  // A timer of the upper levels needs a wakeup to cascade, not a wakeup per
+  // tick
+  wheel.Remove(near_timer.entry);
+  TestTimer far_timer;
+  wheel.Insert(far_timer.entry, origin + std::chrono::milliseconds{1000}, origin);
+  EXPECT_EQ(wheel.GetNextWakeup(), origin + std::chrono::milliseconds{960});
+
+  std::size_t wakeups = 0;
+  while (const auto wakeup = wheel.GetNextWakeup()) {
+    ++wakeups;
+    far_timer.now = *wakeup;
+    wheel.Advance(*wakeup);
+  }
+  EXPECT_EQ(far_timer.fired_count, 1);
+  EXPECT_EQ(far_timer.fired_at, origin + std::chrono::milliseconds{1000});
+  EXPECT_EQ(wakeups, 2);
+}
+
+TEST(TimerWheel, MatchesExactExpiries) {
+  const auto origin = TimerWheel::Clock::now();
+  TimerWheel wheel{kResolution, origin};
+
+  // covers all the levels and the timers beyond the wheel span
+  std::mt19937 rng{42};
+  std::vector<std::unique_ptr<TestTimer>> timers;
+  for (std::uint32_t i = 0; i < 500; ++i) {
+    const auto exponent = i % 26;
+    const std::chrono::microseconds delay{
+        std::uniform_int_distribution<std::int64_t>{1, 1000ll << exponent}(
+            rng)};
+
+    auto& timer = *timers.emplace_back(std::make_unique<TestTimer>());
+    timer.fired_at = origin + delay;  // expected expiry until fired
+    wheel.Insert(timer.entry, origin + delay, origin);
+  }
+
+  auto now = origin;
+  while (!wheel.Empty()) {
+    // jumps of varying length imitate a lagging ev thread
+    now += kResolution * std::uniform_int_distribution<int>{1, 10000}(rng);
+
+    std::vector<TimerWheel::TimePoint> expected;
+    expected.reserve(timers.size());
+    for (auto& timer : timers) {
+      timer->now = now;
+      expected.push_back(timer->fired_at);
+    }
+
+    wheel.Advance(now);
+
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+      const auto expected_fired_count = expected[i] <= now ? 1 : 0;
+      ASSERT_EQ(timers[i]->fired_count, expected_fired_count)
+          << "timer " << i << " fired at a wrong tick";
+    }
+  }
+}
+
+USERVER_NAMESPACE_END
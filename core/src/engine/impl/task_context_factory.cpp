@@ -12,10 +12,26 @@ std::size_t GetTaskContextSize() noexcept { return sizeof(TaskContext); }
 static_assert(kTaskContextAlignment >= alignof(TaskContext));
 static_assert(sizeof(TaskContext) % kTaskContextAlignment == 0);
 
+namespace {
+
+TaskPriority GetNewTaskPriority(const TaskConfig& config) noexcept {
+  if (config.priority) return *config.priority;
+  if (config.importance == Task::Importance::kCritical) {
+    return TaskPriority::kCritical;
+  }
+
+  const auto* const parent = current_task::GetCurrentTaskContextUnchecked();
+  return parent ? parent->GetPriority() : TaskPriority::kNormal;
+}
+
+}  // namespace
+
 TaskContext& PlacementNewTaskContext(std::byte* storage, TaskConfig config,
                                      utils::impl::WrappedCallBase& payload) {
-  return *new (storage) TaskContext{config.task_processor, config.importance,
-                                    config.wait_mode, config.deadline, payload};
+  const auto priority = GetNewTaskPriority(config);
+  return *new (storage)
+      TaskContext{config.task_processor, config.importance, config.wait_mode,
+                  config.deadline, priority, payload};
 }
 
 std::byte* AllocateFusedTaskContext(std::size_t total_size) {
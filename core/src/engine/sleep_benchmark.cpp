@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -45,6 +47,38 @@ BENCHMARK(run_in_ev_loop_benchmark);
 }
 BENCHMARK(successful_wait_for_benchmark);
 
+// Lots of coroutines waiting with a long timeout that are woken up early,
+// which is the usual fate of the deadline timers in a loaded service.
+void concurrent_early_wakeup_benchmark(benchmark::State& state) {
+  constexpr std::size_t kWaitsPerTask = 16;
+
+  engine::RunStandalone(4, [&] {
+    const auto waiters = static_cast<std::size_t>(state.range(0));
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(waiters);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < waiters; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {
+          for (std::size_t j = 0; j < kWaitsPerTask; ++j) {
+            auto task = engine::AsyncNoSpan([] { engine::Yield(); });
+            task.WaitFor(20s);
+            if (!task.IsFinished()) abort();
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * waiters * kWaitsPerTask);
+  });
+}
+BENCHMARK(concurrent_early_wakeup_benchmark)
+    ->RangeMultiplier(8)
+    ->Range(1, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
 void unreached_task_deadline_benchmark(benchmark::State& state,
                                        bool has_task_deadline) {
   engine::RunStandalone([&] {
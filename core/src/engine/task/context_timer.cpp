@@ -1,12 +1,13 @@
 #include <engine/task/context_timer.hpp>
 
-#include <chrono>
+#include <atomic>
 
 #include <engine/ev/async_payload_base.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <engine/ev/data_pipe_to_ev.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -62,29 +63,29 @@ class ContextTimer::Impl final : public TimerArmer<Impl>,
   void DoFinalizeInEvThread();
 
  private:
+  void ArmTimerInEvThread() noexcept;
   void StopTimerInEvThread() noexcept;
 
-  static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnTimer(ev::TimerWheelEntry& entry) noexcept;
   static void InvokeTimerFunction(const Params& params, TaskContext& context);
   void DoOnTimer();
 
   boost::intrusive_ptr<TaskContext> context_;
   ev::TimerThreadControl* thread_control_ = nullptr;
   Params params_;
-  ev_timer timer_{};
+  ev::TimerWheelEntry timer_{&OnTimer, this};
   ev::DataPipeToEv<Params> params_pipe_to_ev_;
+
+  // Deadline of the timer that is currently scheduled in the ev thread, an
+  // unreachable one if the timer is not scheduled. Allows Restart() with a
+  // later deadline to skip the round trip to the ev thread: the scheduled
+  // timer fires earlier and re-arms itself with the latest params.
+  std::atomic<Deadline> armed_deadline_{};
 };
 
-ContextTimer::Impl::Impl() {
-  timer_.data = this;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-  ev_init(&timer_, OnTimer);
-}
+ContextTimer::Impl::Impl() = default;
 
-ContextTimer::Impl::~Impl() {
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-  UASSERT(!ev_is_active(&timer_));
-}
+ContextTimer::Impl::~Impl() { UASSERT(!timer_.IsLinked()); }
 
 bool ContextTimer::Impl::WasStarted() const noexcept {
   return context_ && thread_control_;
@@ -109,10 +110,19 @@ void ContextTimer::Impl::Restart(Params params) {
     return;
   }
 
+  const auto deadline = params.deadline;
   params_pipe_to_ev_.Push(std::move(params));
+
+  // Pairs with the fence in OnTimer: either the ev thread picks up the
+  // params pushed above, or we see that the timer is not armed anymore.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto armed_deadline = armed_deadline_.load(std::memory_order_relaxed);
+  if (armed_deadline.IsReachable() && !(deadline < armed_deadline)) {
+    return;
+  }
+
   if (PrepareEnqueue()) {
-    thread_control_->RunPayloadInEvLoopDeferred(GetTimerArmer(),
-                                                params.deadline);
+    thread_control_->RunPayloadInEvLoopDeferred(GetTimerArmer(), deadline);
   }
 }
 
@@ -136,21 +146,19 @@ void ContextTimer::Impl::DoArmTimerInEvThread() {
 
   params_ = std::move(*params);
 
-  using LibEvDuration = std::chrono::duration<double>;
-  const auto time_left =
-      std::chrono::duration_cast<LibEvDuration>(params_.deadline.TimeLeft())
-          .count();
-
-  LOG_TRACE() << "time_left=" << time_left;
-  if (time_left <= 0.0) {
+  if (params_.deadline.IsReached()) {
     // Optimization for small deadlines or high load
     DoOnTimer();
     return;
   }
 
-  timer_.repeat = time_left;
+  ArmTimerInEvThread();
+}
+
+void ContextTimer::Impl::ArmTimerInEvThread() noexcept {
   UASSERT(thread_control_);
-  thread_control_->Again(timer_);
+  thread_control_->AddTimer(timer_, params_.deadline);
+  armed_deadline_.store(params_.deadline, std::memory_order_relaxed);
 }
 
 void ContextTimer::Impl::InvokeTimerFunction(const Params& params,
@@ -170,7 +178,8 @@ void ContextTimer::Impl::InvokeTimerFunction(const Params& params,
 
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
   UASSERT(!engine::current_task::IsTaskProcessorThread());
-  thread_control_->Stop(timer_);
+  thread_control_->RemoveTimer(timer_);
+  armed_deadline_.store(Deadline{}, std::memory_order_relaxed);
 }
 
 void ContextTimer::Impl::DoFinalizeInEvThread() {
@@ -185,12 +194,26 @@ void ContextTimer::Impl::DoFinalizeInEvThread() {
   // ContextTimer may be destroyed at this point
 }
 
-void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
+void ContextTimer::Impl::OnTimer(ev::TimerWheelEntry& entry) noexcept {
   UASSERT(!engine::current_task::IsTaskProcessorThread());
 
-  auto* ev_timer = static_cast<Impl*>(w->data);
-  UASSERT(ev_timer != nullptr);
-  ev_timer->DoOnTimer();
+  auto* self = static_cast<Impl*>(entry.GetData());
+  UASSERT(self != nullptr);
+
+  self->armed_deadline_.store(Deadline{}, std::memory_order_relaxed);
+  // Pairs with the fence in Restart()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // The timer could have been lazily restarted with a later deadline
+  if (auto params = self->params_pipe_to_ev_.TryPop()) {
+    self->params_ = std::move(*params);
+    if (!self->params_.deadline.IsReached()) {
+      self->ArmTimerInEvThread();
+      return;
+    }
+  }
+
+  self->DoOnTimer();
 }
 
 void ContextTimer::Impl::DoOnTimer() {
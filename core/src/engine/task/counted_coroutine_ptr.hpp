@@ -28,6 +28,10 @@ class CountedCoroutinePtr final {
 
   CoroPool::Coroutine& operator*();
 
+  const boost::context::stack_context& GetStack() const noexcept {
+    return coro_->GetStack();
+  }
+
   void ReturnToPool() &&;
 
  private:
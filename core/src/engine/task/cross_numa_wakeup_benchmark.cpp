@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <utils/cpu_affinity.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+enum class Placement { kSameNode, kCrossNode };
+
+std::optional<std::pair<std::size_t, std::size_t>> GetCpuPair(
+    Placement placement) {
+  try {
+    const auto node0 = utils::GetNumaNodeCpus(0);
+    switch (placement) {
+      case Placement::kSameNode:
+        if (node0.size() < 2) return std::nullopt;
+        return std::pair{node0[0], node0[1]};
+      case Placement::kCrossNode: {
+        const auto node1 = utils::GetNumaNodeCpus(1);
+        if (node0.empty() || node1.empty()) return std::nullopt;
+        return std::pair{node0[0], node1[0]};
+      }
+    }
+  } catch (const std::exception&) {
+    // no such NUMA node
+  }
+  return std::nullopt;
+}
+
+// Cache line transfer between the CPUs, as in a task handoff to a spinning
+// worker
+void SpinPingPong(benchmark::State& state, Placement placement) {
+  const auto cpus = GetCpuPair(placement);
+  if (!cpus) {
+    state.SkipWithError("The host has no CPUs for this placement");
+    return;
+  }
+
+  std::atomic<std::uint64_t> turn{0};
+  std::atomic<bool> stop{false};
+
+  std::thread peer([&] {
+    utils::SetCurrentThreadAffinity({cpus->second});
+    std::uint64_t expected = 1;
+    while (!stop.load(std::memory_order_relaxed)) {
+      if (turn.load(std::memory_order_acquire) == expected) {
+        turn.store(expected + 1, std::memory_order_release);
+        expected += 2;
+      }
+    }
+  });
+
+  utils::SetCurrentThreadAffinity({cpus->first});
+  std::uint64_t next = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    turn.store(next + 1, std::memory_order_release);
+    while (turn.load(std::memory_order_acquire) != next + 2) {
+    }
+    next += 2;
+  }
+
+  stop = true;
+  peer.join();
+}
+
+// OS-level wakeup of a sleeping thread, as in a task handoff to a sleeping
+// worker
+void SleepingPingPong(benchmark::State& state, Placement placement) {
+  const auto cpus = GetCpuPair(placement);
+  if (!cpus) {
+    state.SkipWithError("The host has no CPUs for this placement");
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::uint64_t turn = 0;
+  bool stop = false;
+
+  std::thread peer([&] {
+    utils::SetCurrentThreadAffinity({cpus->second});
+    std::uint64_t expected = 1;
+    std::unique_lock lock(mutex);
+    while (true) {
+      cv.wait(lock, [&] { return stop || turn == expected; });
+      if (stop) break;
+      turn = expected + 1;
+      expected += 2;
+      cv.notify_all();
+    }
+  });
+
+  utils::SetCurrentThreadAffinity({cpus->first});
+  std::uint64_t next = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    std::unique_lock lock(mutex);
+    turn = next + 1;
+    cv.notify_all();
+    cv.wait(lock, [&] { return turn == next + 2; });
+    next += 2;
+  }
+
+  {
+    const std::lock_guard lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  peer.join();
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(SpinPingPong, same_node, Placement::kSameNode);
+BENCHMARK_CAPTURE(SpinPingPong, cross_node, Placement::kCrossNode);
+BENCHMARK_CAPTURE(SleepingPingPong, same_node, Placement::kSameNode);
+BENCHMARK_CAPTURE(SleepingPingPong, cross_node, Placement::kCrossNode);
+
+USERVER_NAMESPACE_END
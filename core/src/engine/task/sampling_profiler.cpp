@@ -0,0 +1,542 @@
+#include <engine/task/sampling_profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+#include <csignal>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <ucontext.h>
+#endif
+
+#include <fmt/format.h>
+#include <boost/container_hash/hash.hpp>
+#include <boost/stacktrace/frame.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/impl/proto_writer.hpp>
+
+// glibc has no name for it until 2.35
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+constexpr std::size_t kMaxStackDepth = 64;
+// ~5 seconds of a fully busy thread at the default 99Hz
+constexpr std::size_t kRingSize = 512;
+
+struct RawSample final {
+  const std::string* tag;
+  std::size_t depth;
+  std::array<void*, kMaxStackDepth> frames;
+};
+
+}  // namespace
+
+struct ProfiledThreadState final {
+#ifdef __linux__
+  pid_t tid{};
+  clockid_t clock{};
+  timer_t timer{};
+#endif
+  bool has_timer{false};
+
+  // [low, high) address ranges of the stacks the frames are walked within.
+  // The coroutine stack is set by CoroutineStackScope, the signal handler
+  // only reads it.
+  std::uintptr_t thread_stack_low{0};
+  std::uintptr_t thread_stack_high{0};
+  std::atomic<std::uintptr_t> coro_stack_low{0};
+  std::atomic<std::uintptr_t> coro_stack_high{0};
+
+  // Allocated on the first session only
+  std::unique_ptr<RawSample[]> ring_storage;
+  std::atomic<RawSample*> ring{nullptr};
+
+  // The signal handler is the only writer, the session is the only reader
+  std::atomic<std::uint64_t> write_pos{0};
+  std::atomic<std::uint64_t> read_pos{0};
+  std::atomic<std::uint64_t> dropped{0};
+};
+
+namespace {
+
+struct Registry final {
+  std::mutex mutex;
+  std::vector<ProfiledThreadState*> threads;
+  bool is_handler_installed{false};
+  bool is_session_active{false};
+  std::chrono::nanoseconds period{};
+};
+
+Registry& GetRegistry() {
+  // Worker threads may outlive static destruction
+  static auto& registry = *new Registry();
+  return registry;
+}
+
+thread_local std::atomic<ProfiledThreadState*> current_thread_state{nullptr};
+
+#ifdef __linux__
+
+struct InterruptedRegisters final {
+  std::uintptr_t pc{0};
+  std::uintptr_t sp{0};
+  std::uintptr_t fp{0};
+};
+
+InterruptedRegisters GetInterruptedRegisters(void* ucontext) noexcept {
+  [[maybe_unused]] auto* const uc = static_cast<ucontext_t*>(ucontext);
+#if defined(__x86_64__)
+  const auto& regs = uc->uc_mcontext.gregs;
+  return {static_cast<std::uintptr_t>(regs[REG_RIP]),
+          static_cast<std::uintptr_t>(regs[REG_RSP]),
+          static_cast<std::uintptr_t>(regs[REG_RBP])};
+#elif defined(__aarch64__)
+  return {uc->uc_mcontext.pc, uc->uc_mcontext.sp, uc->uc_mcontext.regs[29]};
+#else
+  return {};
+#endif
+}
+
+
+void RecordSample(ProfiledThreadState& state, RawSample* ring,
+                  void* ucontext) noexcept {
+  const auto write_pos = state.write_pos.load(std::memory_order_relaxed);
+  if (write_pos - state.read_pos.load(std::memory_order_acquire) >=
+      kRingSize) {
+    state.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto& sample = ring[write_pos % kRingSize];
+  const auto* const context = current_task::GetCurrentTaskContextUnchecked();
+  sample.tag = context ? context->GetProfilerTag() : nullptr;
+
+  const auto regs = GetInterruptedRegisters(ucontext);
+  const auto coro_low = state.coro_stack_low.load(std::memory_order_relaxed);
+  const auto coro_high = state.coro_stack_high.load(std::memory_order_relaxed);
+  std::uintptr_t stack_high = 0;
+  if (regs.sp >= coro_low && regs.sp < coro_high) {
+    stack_high = coro_high;
+  } else if (regs.sp >= state.thread_stack_low &&
+             regs.sp < state.thread_stack_high) {
+    stack_high = state.thread_stack_high;
+  }
+  // Otherwise the stack is unknown, e.g. the sample is taken in the middle of
+  // a coroutine switch, only the interrupted instruction is recorded
+  sample.depth = WalkFramePointers(regs.pc, regs.sp, regs.fp, stack_high,
+                                   sample.frames.data(), kMaxStackDepth);
+
+  state.write_pos.store(write_pos + 1, std::memory_order_release);
+}
+
+void OnProfilingSignal(int, siginfo_t*, void* ucontext) {
+  const int saved_errno = errno;
+  auto* const state = current_thread_state.load(std::memory_order_relaxed);
+  if (state) {
+    if (auto* const ring = state->ring.load(std::memory_order_acquire)) {
+      RecordSample(*state, ring, ucontext);
+    }
+  }
+  errno = saved_errno;
+}
+
+void InstallSignalHandler(Registry& registry) {
+  if (registry.is_handler_installed) return;
+
+  struct sigaction action {};
+  action.sa_sigaction = &OnProfilingSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (::sigaction(SIGPROF, &action, nullptr) == -1) {
+    throw std::system_error(errno, std::generic_category(),
+                            "sigaction(SIGPROF)");
+  }
+  registry.is_handler_installed = true;
+}
+
+void ArmTimer(ProfiledThreadState& state, std::chrono::nanoseconds period) {
+  UASSERT(!state.has_timer);
+
+  if (!state.ring_storage) {
+    state.ring_storage = std::make_unique<RawSample[]>(kRingSize);
+    state.ring.store(state.ring_storage.get(), std::memory_order_release);
+  }
+  // Forget the late samples of the previous session
+  state.read_pos.store(state.write_pos.load(std::memory_order_acquire),
+                       std::memory_order_release);
+
+  struct sigevent event {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = state.tid;
+  if (::timer_create(state.clock, &event, &state.timer) == -1) {
+    throw std::system_error(errno, std::generic_category(), "timer_create");
+  }
+
+  struct itimerspec spec {};
+  spec.it_interval.tv_sec = period.count() / 1'000'000'000;
+  spec.it_interval.tv_nsec = period.count() % 1'000'000'000;
+  spec.it_value = spec.it_interval;
+  if (::timer_settime(state.timer, 0, &spec, nullptr) == -1) {
+    const auto error = errno;
+    ::timer_delete(state.timer);
+    throw std::system_error(error, std::generic_category(), "timer_settime");
+  }
+  state.has_timer = true;
+}
+
+void DisarmTimer(ProfiledThreadState& state) noexcept {
+  if (!state.has_timer) return;
+  ::timer_delete(state.timer);
+  state.has_timer = false;
+}
+
+#else
+
+void InstallSignalHandler(Registry&) {
+  throw std::system_error(std::make_error_code(std::errc::not_supported),
+                          "CPU profiling is only supported on Linux");
+}
+
+void ArmTimer(ProfiledThreadState&, std::chrono::nanoseconds) {}
+
+void DisarmTimer(ProfiledThreadState&) noexcept {}
+
+#endif
+
+using utils::impl::ProtoWriter;
+
+class StringTable final {
+ public:
+  StringTable() { Add({}); }
+
+  std::uint64_t Add(std::string_view str) {
+    const auto [it, inserted] = indices_.emplace(str, strings_.size());
+    if (inserted) strings_.emplace_back(str);
+    return it->second;
+  }
+
+  void WriteTo(ProtoWriter& writer) const {
+    // profile.proto: repeated string string_table = 6;
+    for (const auto& str : strings_) writer.WriteBytes(6, str);
+  }
+
+ private:
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, std::uint64_t> indices_;
+};
+
+std::string MakeValueType(StringTable& strings, std::string_view type,
+                          std::string_view unit) {
+  ProtoWriter writer;
+  writer.WriteInt(1, strings.Add(type));
+  writer.WriteInt(2, strings.Add(unit));
+  return std::move(writer).Extract();
+}
+
+std::string GetFunctionName(const void* address) {
+  auto name = boost::stacktrace::frame{address}.name();
+  if (name.empty()) name = fmt::format("{}", address);
+  return name;
+}
+
+class ThreadRegistration final {
+ public:
+  ThreadRegistration() : state_(std::make_unique<ProfiledThreadState>()) {
+#ifdef __linux__
+    state_->tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    const int res = ::pthread_getcpuclockid(::pthread_self(), &state_->clock);
+    if (res != 0) {
+      LOG_ERROR() << "Thread is not registered for CPU profiling: "
+                  << std::system_category().message(res);
+      state_.reset();
+      return;
+    }
+
+    pthread_attr_t attr;
+    if (::pthread_getattr_np(::pthread_self(), &attr) == 0) {
+      void* stack_low = nullptr;
+      std::size_t stack_size = 0;
+      if (::pthread_attr_getstack(&attr, &stack_low, &stack_size) == 0) {
+        state_->thread_stack_low = reinterpret_cast<std::uintptr_t>(stack_low);
+        state_->thread_stack_high = state_->thread_stack_low + stack_size;
+      }
+      ::pthread_attr_destroy(&attr);
+    }
+#endif
+
+    auto& registry = GetRegistry();
+    const std::lock_guard lock{registry.mutex};
+    registry.threads.push_back(state_.get());
+    current_thread_state.store(state_.get(), std::memory_order_relaxed);
+    if (registry.is_session_active) {
+      try {
+        ArmTimer(*state_, registry.period);
+      } catch (const std::exception& e) {
+        LOG_ERROR() << "Failed to start CPU profiling of a thread: " << e;
+      }
+    }
+  }
+
+  ~ThreadRegistration() {
+    if (!state_) return;
+
+    current_thread_state.store(nullptr, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    auto& registry = GetRegistry();
+    const std::lock_guard lock{registry.mutex};
+    DisarmTimer(*state_);
+    auto& threads = registry.threads;
+    threads.erase(std::find(threads.begin(), threads.end(), state_.get()));
+  }
+
+  ThreadRegistration(const ThreadRegistration&) = delete;
+  ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+ private:
+  std::unique_ptr<ProfiledThreadState> state_;
+};
+
+}  // namespace
+
+void RegisterThreadForCpuProfiling() {
+  thread_local ThreadRegistration registration;
+}
+
+// Frame records {previous frame pointer, return address} are the same on
+// x86_64 and aarch64
+std::size_t WalkFramePointers(std::uintptr_t pc, std::uintptr_t sp,
+                              std::uintptr_t fp, std::uintptr_t stack_high,
+                              void** frames, std::size_t max_depth) noexcept {
+  std::size_t depth = 0;
+  if (pc == 0 || max_depth == 0) return depth;
+  frames[depth++] = reinterpret_cast<void*>(pc);
+
+  constexpr auto kRecordSize = 2 * sizeof(std::uintptr_t);
+  auto low = sp;
+  while (depth < max_depth && fp >= low && fp % sizeof(std::uintptr_t) == 0 &&
+         fp < stack_high && stack_high - fp >= kRecordSize) {
+    const auto* const record = reinterpret_cast<const std::uintptr_t*>(fp);
+    const auto return_address = record[1];
+    if (return_address == 0) break;
+    frames[depth++] = reinterpret_cast<void*>(return_address);
+    low = fp + kRecordSize;
+    fp = record[0];
+  }
+  return depth;
+}
+
+CoroutineStackScope::CoroutineStackScope(void* top, std::size_t size) noexcept
+    : state_(current_thread_state.load(std::memory_order_relaxed)) {
+  if (!state_) return;
+  const auto high = reinterpret_cast<std::uintptr_t>(top);
+  // Reset first, so that the signal handler never sees mixed bounds
+  state_->coro_stack_high.store(0, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  state_->coro_stack_low.store(high - size, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  state_->coro_stack_high.store(high, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+CoroutineStackScope::~CoroutineStackScope() {
+  if (!state_) return;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  state_->coro_stack_high.store(0, std::memory_order_relaxed);
+}
+
+const std::string& InternProfilerTag(std::string_view tag) {
+  static std::mutex mutex;
+  // Never destroyed, the tags may be accessed by samples until the exit
+  static auto& tags = *new std::unordered_set<std::string>();
+
+  const std::lock_guard lock{mutex};
+  return *tags.emplace(tag).first;
+}
+
+void SetCurrentTaskProfilerTag(const std::string& interned_tag) noexcept {
+  current_task::GetCurrentTaskContext().SetProfilerTag(&interned_tag);
+}
+
+CpuProfilerBusyError::CpuProfilerBusyError()
+    : std::runtime_error("Another CPU profiling session is in progress") {}
+
+std::size_t CpuProfilingSession::StackKeyHash::operator()(
+    const StackKey& key) const noexcept {
+  auto seed = boost::hash_range(key.frames.begin(), key.frames.end());
+  boost::hash_combine(seed, key.tag);
+  return seed;
+}
+
+CpuProfilingSession::CpuProfilingSession(std::size_t frequency_hz)
+    : period_(std::chrono::nanoseconds{std::chrono::seconds{1}} /
+              std::max<std::size_t>(frequency_hz, 1)),
+      start_time_(std::chrono::system_clock::now()),
+      start_steady_time_(std::chrono::steady_clock::now()) {
+  UINVARIANT(frequency_hz > 0, "Invalid CPU profiling frequency");
+
+  auto& registry = GetRegistry();
+  const std::lock_guard lock{registry.mutex};
+  if (registry.is_session_active) throw CpuProfilerBusyError();
+
+  InstallSignalHandler(registry);
+  try {
+    for (auto* state : registry.threads) ArmTimer(*state, period_);
+  } catch (const std::exception&) {
+    for (auto* state : registry.threads) DisarmTimer(*state);
+    throw;
+  }
+  registry.is_session_active = true;
+  registry.period = period_;
+}
+
+CpuProfilingSession::~CpuProfilingSession() { Stop(); }
+
+void CpuProfilingSession::Collect() {
+  auto& registry = GetRegistry();
+  const std::lock_guard lock{registry.mutex};
+
+  for (auto* state : registry.threads) {
+    dropped_samples_ += state->dropped.exchange(0, std::memory_order_relaxed);
+
+    const auto* const ring = state->ring.load(std::memory_order_acquire);
+    if (!ring) continue;
+
+    const auto write_pos = state->write_pos.load(std::memory_order_acquire);
+    auto read_pos = state->read_pos.load(std::memory_order_relaxed);
+    for (; read_pos < write_pos; ++read_pos) {
+      const auto& sample = ring[read_pos % kRingSize];
+      StackKey key{sample.tag, {sample.frames.begin(),
+                                sample.frames.begin() + sample.depth}};
+      ++stacks_[std::move(key)];
+    }
+    state->read_pos.store(read_pos, std::memory_order_release);
+  }
+}
+
+CpuProfile CpuProfilingSession::Finish() {
+  Stop();
+  Collect();
+
+  CpuProfile profile;
+  profile.start_time = start_time_;
+  profile.duration = std::chrono::steady_clock::now() - start_steady_time_;
+  profile.period = period_;
+  profile.dropped_samples = dropped_samples_;
+  profile.samples.reserve(stacks_.size());
+  for (auto& [key, count] : stacks_) {
+    profile.samples.push_back({key.tag, std::move(key.frames), count});
+  }
+  stacks_.clear();
+  return profile;
+}
+
+void CpuProfilingSession::Stop() noexcept {
+  if (!is_running_) return;
+  is_running_ = false;
+
+  auto& registry = GetRegistry();
+  const std::lock_guard lock{registry.mutex};
+  for (auto* state : registry.threads) DisarmTimer(*state);
+  registry.is_session_active = false;
+}
+
+std::string ToPprof(const CpuProfile& profile) {
+  StringTable strings;
+  ProtoWriter writer;
+
+  // profile.proto: repeated ValueType sample_type = 1;
+  writer.WriteBytes(1, MakeValueType(strings, "samples", "count"));
+  writer.WriteBytes(1, MakeValueType(strings, "cpu", "nanoseconds"));
+
+  const auto handler_key = strings.Add("handler");
+  std::unordered_map<const void*, std::uint64_t> location_ids;
+  std::vector<std::uint64_t> location_stack;
+  for (const auto& sample : profile.samples) {
+    location_stack.clear();
+    for (const auto* frame : sample.frames) {
+      const auto [it, inserted] =
+          location_ids.emplace(frame, location_ids.size() + 1);
+      location_stack.push_back(it->second);
+    }
+
+    ProtoWriter sample_writer;
+    sample_writer.WritePacked(1, location_stack);
+    sample_writer.WritePacked(
+        2, {sample.count,
+            sample.count * static_cast<std::uint64_t>(profile.period.count())});
+    if (sample.tag) {
+      ProtoWriter label;
+      label.WriteInt(1, handler_key);
+      label.WriteInt(2, strings.Add(*sample.tag));
+      sample_writer.WriteBytes(3, std::move(label).Extract());
+    }
+    // profile.proto: repeated Sample sample = 2;
+    writer.WriteBytes(2, std::move(sample_writer).Extract());
+  }
+
+  std::unordered_map<std::string, std::uint64_t> function_ids;
+  for (const auto& [address, location_id] : location_ids) {
+    // Most of the frames are return addresses, which may point right past
+    // the end of the calling function
+    const auto* lookup_address = static_cast<const char*>(address) - 1;
+    const auto name = GetFunctionName(lookup_address);
+    const auto [it, inserted] =
+        function_ids.emplace(name, function_ids.size() + 1);
+    if (inserted) {
+      ProtoWriter function;
+      function.WriteUint(1, it->second);
+      function.WriteInt(2, strings.Add(name));
+      function.WriteInt(3, strings.Add(name));
+      // profile.proto: repeated Function function = 5;
+      writer.WriteBytes(5, std::move(function).Extract());
+    }
+
+    ProtoWriter line;
+    line.WriteUint(1, it->second);
+    ProtoWriter location;
+    location.WriteUint(1, location_id);
+    location.WriteUint(3, reinterpret_cast<std::uintptr_t>(address));
+    location.WriteBytes(4, std::move(line).Extract());
+    // profile.proto: repeated Location location = 4;
+    writer.WriteBytes(4, std::move(location).Extract());
+  }
+
+  // profile.proto: int64 time_nanos = 9; int64 duration_nanos = 10;
+  writer.WriteInt(9, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         profile.start_time.time_since_epoch())
+                         .count());
+  writer.WriteInt(10, profile.duration.count());
+  // profile.proto: ValueType period_type = 11; int64 period = 12;
+  writer.WriteBytes(11, MakeValueType(strings, "cpu", "nanoseconds"));
+  writer.WriteInt(12, profile.period.count());
+
+  strings.WriteTo(writer);
+  return std::move(writer).Extract();
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+// Embedded sampling CPU profiler.
+//
+// Each registered thread (TaskProcessor workers register themselves) gets
+// a timer on its own CPU time clock that delivers SIGPROF to that very thread.
+// The signal handler captures the stack of the interrupted code together with
+// the profiler tag of the current task and puts them into a lock-free
+// per-thread ring buffer, which is drained by CpuProfilingSession::Collect().
+// Idle threads consume no CPU time and thus are not sampled.
+//
+// The profiler only costs anything while a session is active. Stacks are
+// captured by walking the frame pointers, as the unwinders are not
+// async-signal-safe. Only the frames within the stack that is current at the
+// time of the signal, either the thread stack or the coroutine stack, are
+// walked, so a garbage frame pointer can not make the handler read unmapped
+// memory. Code built without frame pointers gives truncated stacks. Samples
+// are only taken on Linux, CpuProfilingSession throws elsewhere.
+
+// Registers the current thread for sampling until its exit.
+void RegisterThreadForCpuProfiling();
+
+// Writes `pc` and the return addresses of the frame pointer chain starting
+// at `fp` into `frames`, returns their number. Each frame record must lie
+// within [sp, stack_high) above the previous one, so nothing outside of the
+// stack is read whatever garbage `fp` contains.
+std::size_t WalkFramePointers(std::uintptr_t pc, std::uintptr_t sp,
+                              std::uintptr_t fp, std::uintptr_t stack_high,
+                              void** frames, std::size_t max_depth) noexcept;
+
+struct ProfiledThreadState;
+
+// Tells the profiler that the current thread may run on the coroutine stack
+// [top - size, top) for the scope lifetime.
+class CoroutineStackScope final {
+ public:
+  CoroutineStackScope(void* top, std::size_t size) noexcept;
+  ~CoroutineStackScope();
+
+  CoroutineStackScope(const CoroutineStackScope&) = delete;
+  CoroutineStackScope& operator=(const CoroutineStackScope&) = delete;
+
+ private:
+  struct ProfiledThreadState* const state_;
+};
+
+// Returns a string with the same contents that lives until the process exit.
+// Slow, expected to be called once per tag, e.g. at handler construction.
+const std::string& InternProfilerTag(std::string_view tag);
+
+// Attributes the CPU samples of the current task, and the tasks it starts
+// from now on, to the interned `tag`.
+void SetCurrentTaskProfilerTag(const std::string& interned_tag) noexcept;
+
+struct CpuProfile final {
+  struct Sample final {
+    // nullptr if the task had no tag or the sample is taken outside of a task
+    const std::string* tag{nullptr};
+    // Return addresses, the innermost frame first
+    std::vector<const void*> frames;
+    std::uint64_t count{0};
+  };
+
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::nanoseconds duration{};
+  std::chrono::nanoseconds period{};
+  std::vector<Sample> samples;
+  // Samples lost due to full ring buffers
+  std::uint64_t dropped_samples{0};
+};
+
+class CpuProfilerBusyError final : public std::runtime_error {
+ public:
+  CpuProfilerBusyError();
+};
+
+// Samples all the registered threads for the session lifetime. There may be
+// at most one session at a time in the process.
+class CpuProfilingSession final {
+ public:
+  // Throws CpuProfilerBusyError if another session is active and
+  // std::system_error if the sampling could not be set up.
+  explicit CpuProfilingSession(std::size_t frequency_hz);
+  ~CpuProfilingSession();
+
+  CpuProfilingSession(const CpuProfilingSession&) = delete;
+  CpuProfilingSession& operator=(const CpuProfilingSession&) = delete;
+
+  // Moves the samples from the per-thread buffers into the session, should be
+  // called often enough for the buffers not to overflow.
+  void Collect();
+
+  // Stops the sampling and returns the aggregated profile
+  CpuProfile Finish();
+
+  struct StackKey final {
+    const std::string* tag;
+    std::vector<const void*> frames;
+
+    bool operator==(const StackKey& other) const noexcept {
+      return tag == other.tag && frames == other.frames;
+    }
+  };
+
+  struct StackKeyHash final {
+    std::size_t operator()(const StackKey& key) const noexcept;
+  };
+
+ private:
+  void Stop() noexcept;
+
+  const std::chrono::nanoseconds period_;
+  const std::chrono::system_clock::time_point start_time_;
+  const std::chrono::steady_clock::time_point start_steady_time_;
+  std::unordered_map<StackKey, std::uint64_t, StackKeyHash> stacks_;
+  std::uint64_t dropped_samples_{0};
+  bool is_running_{true};
+};
+
+// Serializes the profile into the pprof protobuf format
+// (https://github.com/google/pprof/blob/main/proto/profile.proto),
+// symbolizing the frames in the current process.
+std::string ToPprof(const CpuProfile& profile);
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
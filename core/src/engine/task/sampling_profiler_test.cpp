@@ -0,0 +1,115 @@
+#include <engine/task/sampling_profiler.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+#ifdef __linux__
+
+namespace {
+
+void BurnCpu(std::chrono::milliseconds duration) {
+  std::atomic<std::uint64_t> sink{0};
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (int i = 0; i < 1000; ++i) sink.fetch_add(i, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+UTEST_MT(CpuProfiler, SamplesAreTagged, 2) {
+  const auto& tag = engine::impl::InternProfilerTag("test-handler");
+  EXPECT_EQ(&tag, &engine::impl::InternProfilerTag("test-handler"));
+
+  engine::impl::CpuProfilingSession session{1000};
+  auto task = engine::AsyncNoSpan([&tag] {
+    engine::impl::SetCurrentTaskProfilerTag(tag);
+    // the tag is inherited by the subtasks
+    engine::AsyncNoSpan([] { BurnCpu(std::chrono::milliseconds{300}); }).Get();
+  });
+  task.Get();
+  session.Collect();
+
+  const auto profile = session.Finish();
+  std::uint64_t tagged_samples = 0;
+  for (const auto& sample : profile.samples) {
+    EXPECT_FALSE(sample.frames.empty());
+    if (sample.tag == &tag) tagged_samples += sample.count;
+  }
+  EXPECT_GT(tagged_samples, 0);
+
+  const auto pprof = engine::impl::ToPprof(profile);
+  EXPECT_NE(pprof.find("test-handler"), std::string::npos);
+  EXPECT_NE(pprof.find("cpu"), std::string::npos);
+}
+
+UTEST(CpuProfiler, SingleSession) {
+  engine::impl::CpuProfilingSession session{100};
+  EXPECT_THROW(engine::impl::CpuProfilingSession{100},
+               engine::impl::CpuProfilerBusyError);
+  session.Finish();
+
+  // the profiler is free again
+  engine::impl::CpuProfilingSession{100}.Finish();
+}
+
+#endif
+
+TEST(CpuProfiler, WalkFramePointers) {
+  // A fake stack of 3 frame records, growing down from the end of the array
+  std::uintptr_t stack[16]{};
+  const auto address = [&stack](std::size_t i) {
+    return reinterpret_cast<std::uintptr_t>(&stack[i]);
+  };
+  stack[4] = address(8);
+  stack[5] = 0x1001;
+  stack[8] = address(12);
+  stack[9] = 0x1002;
+  stack[12] = 0xdeadbeef;  // garbage, outside of the stack
+  stack[13] = 0x1003;
+  const auto high = address(16);
+
+  std::array<void*, 8> frames{};
+  ASSERT_EQ(engine::impl::WalkFramePointers(0x1000, address(0), address(4),
+                                            high, frames.data(),
+                                            frames.size()),
+            4);
+  EXPECT_EQ(frames[0], reinterpret_cast<void*>(0x1000));
+  EXPECT_EQ(frames[3], reinterpret_cast<void*>(0x1003));
+
+  // The depth limit
+  EXPECT_EQ(engine::impl::WalkFramePointers(0x1000, address(0), address(4),
+                                            high, frames.data(), 2),
+            2);
+
+  // Frame pointers below the stack pointer, misaligned or beyond the stack
+  // are not followed
+  for (const auto fp : {address(2), address(4) + 1, high, std::uintptr_t{8}}) {
+    EXPECT_EQ(engine::impl::WalkFramePointers(0x1000, address(3), fp, high,
+                                              frames.data(), frames.size()),
+              1);
+  }
+
+  // A loop in the chain is not followed
+  stack[8] = address(4);
+  EXPECT_EQ(engine::impl::WalkFramePointers(0x1000, address(0), address(4),
+                                            high, frames.data(),
+                                            frames.size()),
+            3);
+}
+
+UTEST(CpuProfiler, EmptyProfileSerializes) {
+  engine::impl::CpuProfile profile;
+  profile.period = std::chrono::milliseconds{10};
+  EXPECT_FALSE(engine::impl::ToPprof(profile).empty());
+}
+
+USERVER_NAMESPACE_END
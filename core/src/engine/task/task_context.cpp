@@ -23,6 +23,7 @@
 #include <engine/impl/generic_wait_list.hpp>
 #include <engine/task/coro_unwinder.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
+#include <engine/task/sampling_profiler.hpp>
 #include <engine/task/task_processor.hpp>
 #include <utils/impl/assert_extra.hpp>
 
@@ -79,6 +80,12 @@ auto ReadableTaskId(const TaskContext* task) noexcept {
   return logging::HexShort(task ? task->GetTaskId() : 0);
 }
 
+// Tasks are attributed to the same profiler tag as their parent
+const std::string* GetCurrentProfilerTag() noexcept {
+  const auto* const parent = current_task::GetCurrentTaskContextUnchecked();
+  return parent ? parent->GetProfilerTag() : nullptr;
+}
+
 class CurrentTaskScope final {
  public:
   explicit CurrentTaskScope(TaskContext& context, EhGlobals& eh_store)
@@ -108,11 +115,13 @@ auto* const kFinishedDetachedToken =
 
 TaskContext::TaskContext(TaskProcessor& task_processor,
                          Task::Importance importance, Task::WaitMode wait_type,
-                         Deadline deadline,
+                         Deadline deadline, TaskPriority priority,
                          utils::impl::WrappedCallBase& payload)
     : task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(priority),
+      profiler_tag_(GetCurrentProfilerTag()),
       payload_(&payload),
       finish_waiters_(wait_type),
       cancel_deadline_(deadline),
@@ -197,6 +206,11 @@ void TaskContext::DoStep() {
 
   SleepState::Flags clear_flags{SleepFlags::kSleeping};
   if (!coro_) {
+    // The deadline has expired while the task was queued, there is no point
+    // in starting it
+    if (cancel_deadline_.IsReached()) {
+      RequestCancel(TaskCancellationReason::kDeadline);
+    }
     coro_ = task_processor_.GetCoroutine();
     clear_flags |= SleepFlags::kWakeupByBootstrap;
     ArmCancellationTimer();
@@ -210,6 +224,8 @@ void TaskContext::DoStep() {
     try {
       SetState(Task::State::kRunning);
       auto& coro_ref = *coro_;
+      const auto& stack = coro_.GetStack();
+      const CoroutineStackScope stack_scope{stack.sp, stack.size};
       TsanAcquireBarrier();
       coro_ref(this);
     } catch (...) {
@@ -673,7 +689,16 @@ void TaskContext::Schedule() {
   // NOTE: may be executed at this point
 }
 
+utils::jemalloc::Allocations TaskContext::GetAllocations() const noexcept {
+  UASSERT(IsCurrent());
+  auto result = allocations_;
+  result += utils::jemalloc::GetThreadAllocations() - slice_start_allocations_;
+  return result;
+}
+
 void TaskContext::ProfilerStartExecution() {
+  slice_start_allocations_ = utils::jemalloc::GetThreadAllocations();
+
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() > 0) {
     execute_started_ = std::chrono::steady_clock::now();
@@ -683,6 +708,9 @@ void TaskContext::ProfilerStartExecution() {
 }
 
 void TaskContext::ProfilerStopExecution() {
+  allocations_ +=
+      utils::jemalloc::GetThreadAllocations() - slice_start_allocations_;
+
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() <= 0) return;
 
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <ev.h>
@@ -23,9 +24,11 @@
 #include <userver/engine/impl/wait_list_fwd.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
 #include <userver/utils/impl/wrapped_call_base.hpp>
+#include <utils/jemalloc.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -80,7 +83,7 @@ class TaskContext final : public ContextAccessor {
   };
 
   TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-              utils::impl::WrappedCallBase& payload);
+              TaskPriority, utils::impl::WrappedCallBase& payload);
 
   ~TaskContext() noexcept;
 
@@ -101,6 +104,31 @@ class TaskContext final : public ContextAccessor {
   // exceeding these limits causes task to become cancelled
   bool IsCritical() const;
 
+  // the lane of the task processor queue the task is scheduled into
+  TaskPriority GetPriority() const noexcept {
+    return priority_.load(std::memory_order_relaxed);
+  }
+
+  // must only be called from this context
+  void SetPriority(TaskPriority priority) noexcept {
+    priority_.store(priority, std::memory_order_relaxed);
+  }
+
+  // the name the CPU profiler attributes the samples of the task to,
+  // nullptr if none
+  const std::string* GetProfilerTag() const noexcept {
+    return profiler_tag_.load(std::memory_order_relaxed);
+  }
+
+  // must only be called from this context
+  void SetProfilerTag(const std::string* tag) noexcept {
+    profiler_tag_.store(tag, std::memory_order_relaxed);
+  }
+
+  // bytes allocated and freed while executing the task, including
+  // the current slice; must only be called from this context
+  utils::jemalloc::Allocations GetAllocations() const noexcept;
+
   // whether task is allowed to be awaited from multiple coroutines
   // simultaneously
   bool IsSharedWaitAllowed() const;
@@ -219,6 +247,8 @@ class TaskContext final : public ContextAccessor {
   const bool is_critical_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
+  std::atomic<TaskPriority> priority_;
+  std::atomic<const std::string*> profiler_tag_;
   EhGlobals eh_globals_;
 
   utils::impl::WrappedCallBase* payload_;
@@ -235,6 +265,9 @@ class TaskContext final : public ContextAccessor {
   // {} if not defined
   std::chrono::steady_clock::time_point task_queue_wait_timepoint_;
   std::chrono::steady_clock::time_point execute_started_;
+  // worker thread jemalloc counters at the start of the current slice
+  utils::jemalloc::Allocations slice_start_allocations_;
+  utils::jemalloc::Allocations allocations_;
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
 
   std::size_t trace_csw_left_;
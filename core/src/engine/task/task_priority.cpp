@@ -0,0 +1,63 @@
+#include <userver/engine/task/task_priority.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/underlying_value.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <utils/impl/assert_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+std::string_view ToString(TaskPriority priority) noexcept {
+  switch (priority) {
+    case TaskPriority::kCritical:
+      return "critical";
+    case TaskPriority::kNormal:
+      return "normal";
+    case TaskPriority::kBackground:
+      return "background";
+  }
+
+  utils::impl::AbortWithStacktrace(fmt::format(
+      "Garbage task priority: {}", utils::UnderlyingValue(priority)));
+}
+
+TaskPriority Parse(const yaml_config::YamlConfig& value,
+                   formats::parse::To<TaskPriority>) {
+  const auto str = value.As<std::string>();
+  if (str == "critical") return TaskPriority::kCritical;
+  if (str == "normal") return TaskPriority::kNormal;
+  if (str == "background") return TaskPriority::kBackground;
+  throw std::runtime_error(fmt::format(
+      "can't parse TaskPriority from '{}' at {}", str, value.GetPath()));
+}
+
+namespace current_task {
+
+TaskPriority GetPriority() noexcept {
+  return GetCurrentTaskContext().GetPriority();
+}
+
+}  // namespace current_task
+
+TaskPriorityScope::TaskPriorityScope(TaskPriority priority)
+    : context_(current_task::GetCurrentTaskContext()),
+      old_priority_(context_.GetPriority()) {
+  context_.SetPriority(priority);
+}
+
+TaskPriorityScope::~TaskPriorityScope() {
+  UASSERT(context_.IsCurrent());
+  context_.SetPriority(old_priority_);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -13,9 +13,11 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/utils/threads.hpp>
+#include <utils/cpu_affinity.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
+#include <engine/task/sampling_profiler.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
 
@@ -41,6 +43,15 @@ constexpr OverloadActionAndValue<OverloadBitAndValue> GetOverloadActionAndValue(
   }
 }
 
+constexpr double kQueueWaitTimeBoundsUs[]{10,   50,    100,   500,   1000,
+                                          5000, 10000, 50000, 100000};
+
+std::array<utils::statistics::Histogram, kTaskPriorityCount>
+MakeQueueWaitTimeHistograms() {
+  const utils::statistics::Histogram histogram{kQueueWaitTimeBoundsUs};
+  return {histogram, histogram, histogram};
+}
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   static constexpr std::size_t kTaskTimestampInterval = 4;
   thread_local std::size_t task_count = 0;
@@ -87,6 +98,7 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_queue_(config),
       task_counter_(config.worker_threads),
+      queue_wait_time_(MakeQueueWaitTimeHistograms()),
       config_(std::move(config)),
       pools_(std::move(pools)) {
   utils::impl::FinishStaticRegistration();
@@ -282,9 +294,17 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
       break;
   }
 
+  try {
+    utils::SetCurrentThreadAffinity(config_.cpu_affinity);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Failed to bind worker thread #" << index << " of "
+                << Name() << " to its CPUs: " << e;
+  }
+
   utils::SetCurrentThreadName(fmt::format("{}_{}", config_.thread_name, index));
 
   impl::SetLocalTaskCounterData(task_counter_, index);
+  impl::RegisterThreadForCpuProfiling();
 
   TaskProcessorThreadStartedHook();
 }
@@ -311,7 +331,20 @@ void TaskProcessor::ProcessTasks() noexcept {
   }
 }
 
+utils::statistics::HistogramView TaskProcessor::GetQueueWaitTime(
+    TaskPriority priority) const noexcept {
+  return queue_wait_time_[static_cast<std::size_t>(priority)].GetView();
+}
+
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
+  const auto wait_timepoint = context.GetQueueWaitTimepoint();
+  const bool has_wait_time =
+      wait_timepoint != std::chrono::steady_clock::time_point();
+  const auto wait_time = has_wait_time
+                             ? std::chrono::steady_clock::now() - wait_timepoint
+                             : std::chrono::steady_clock::duration{};
+  if (has_wait_time) AccountQueueWaitTime(context.GetPriority(), wait_time);
+
   const auto [action, max_wait_time] =
       GetOverloadActionAndValue(action_bit_and_max_task_queue_wait_time_);
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
@@ -321,9 +354,7 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     return;
   }
 
-  const auto wait_timepoint = context.GetQueueWaitTimepoint();
-  if (wait_timepoint != std::chrono::steady_clock::time_point()) {
-    const auto wait_time = std::chrono::steady_clock::now() - wait_timepoint;
+  if (has_wait_time) {
     const auto wait_time_us =
         std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
     LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
@@ -347,6 +378,14 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
   }
 }
 
+void TaskProcessor::AccountQueueWaitTime(
+    TaskPriority priority, std::chrono::steady_clock::duration wait_time) {
+  const auto wait_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
+  queue_wait_time_[static_cast<std::size_t>(priority)].Account(
+      static_cast<double>(wait_time_us.count()));
+}
+
 void TaskProcessor::SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept {
   auto& atomic = overloaded_cache_->overloaded_by_wait_time;
   // The check helps to reduce contention.
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -16,7 +18,9 @@
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -61,6 +65,15 @@ class TaskProcessor final {
     return task_queue_.GetSizeApproximate();
   }
 
+  std::size_t GetTaskQueueSize(TaskPriority priority) const {
+    return task_queue_.GetSizeApproximate(priority);
+  }
+
+  // Queue wait time of the tasks of the given priority, in microseconds.
+  // Only a sample of the tasks is accounted.
+  utils::statistics::HistogramView GetQueueWaitTime(
+      TaskPriority priority) const noexcept;
+
   std::size_t GetWorkerCount() const { return workers_.size(); }
 
   void SetSettings(const TaskProcessorSettings& settings);
@@ -96,6 +109,9 @@ class TaskProcessor final {
 
   void CheckWaitTime(impl::TaskContext& context);
 
+  void AccountQueueWaitTime(TaskPriority priority,
+                            std::chrono::steady_clock::duration wait_time);
+
   void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
 
   void HandleOverload(impl::TaskContext& context,
@@ -112,6 +128,8 @@ class TaskProcessor final {
   concurrent::impl::InterferenceShield<OverloadedCache> overloaded_cache_;
   TaskQueue task_queue_;
   impl::TaskCounter task_counter_;
+  std::array<utils::statistics::Histogram, kTaskPriorityCount>
+      queue_wait_time_;
 
   const TaskProcessorConfig config_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
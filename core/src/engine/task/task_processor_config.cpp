@@ -9,6 +9,8 @@
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <utils/cpu_affinity.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine {
@@ -56,6 +58,8 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
   config.spinning_iterations =
       value["spinning-iterations"].As<int>(config.spinning_iterations);
+  config.cpu_affinity =
+      utils::ParseCpuAffinity(value, "cpu-affinity", "numa-node");
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
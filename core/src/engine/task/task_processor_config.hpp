@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
@@ -29,6 +30,8 @@ struct TaskProcessorConfig {
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{1000};
+  // CPUs the worker threads are bound to, empty for no binding
+  std::vector<std::size_t> cpu_affinity;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
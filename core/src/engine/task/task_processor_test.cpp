@@ -1,8 +1,13 @@
 #include <engine/task/task_processor.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/task/task_base.hpp>
+#include <userver/engine/task/task_priority.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -47,4 +52,79 @@ UTEST(TaskProcessor, Overload) {
   }
 }
 
+UTEST(TaskProcessor, PriorityIsInherited) {
+  const auto get_priority = [] { return engine::current_task::GetPriority(); };
+  const auto initial_priority = engine::current_task::GetPriority();
+
+  {
+    engine::TaskPriorityScope scope{engine::TaskPriority::kBackground};
+    EXPECT_EQ(engine::current_task::GetPriority(),
+              engine::TaskPriority::kBackground);
+    EXPECT_EQ(engine::AsyncNoSpan(get_priority).Get(),
+              engine::TaskPriority::kBackground);
+
+    auto nested = engine::AsyncNoSpan(
+        [&] { return engine::AsyncNoSpan(get_priority).Get(); });
+    EXPECT_EQ(nested.Get(), engine::TaskPriority::kBackground);
+
+    // critical tasks always go to the critical lane
+    EXPECT_EQ(engine::CriticalAsyncNoSpan(get_priority).Get(),
+              engine::TaskPriority::kCritical);
+  }
+
+  EXPECT_EQ(engine::current_task::GetPriority(), initial_priority);
+}
+
+UTEST(TaskProcessor, ExpiredWhileQueuedIsNotStarted) {
+  bool started = false;
+  auto task = engine::AsyncNoSpan(engine::Deadline::Passed(),
+                                  [&started] { started = true; });
+  task.Wait();
+
+  EXPECT_FALSE(started);
+  EXPECT_EQ(task.GetState(), engine::Task::State::kCancelled);
+  EXPECT_EQ(task.CancellationReason(),
+            engine::TaskCancellationReason::kDeadline);
+}
+
+UTEST(TaskProcessor, PriorityLanesAreWeighted) {
+  constexpr std::size_t kTasksPerLane = 40;
+  std::vector<engine::TaskPriority> execution_order;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasksPerLane * 2);
+
+  // The single worker thread is busy with the current task, so all the tasks
+  // are queued before any of them starts.
+  const auto start_tasks = [&](engine::TaskPriority priority) {
+    engine::TaskPriorityScope scope{priority};
+    for (std::size_t i = 0; i < kTasksPerLane; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&execution_order, priority] {
+        execution_order.push_back(priority);
+      }));
+    }
+  };
+  start_tasks(engine::TaskPriority::kBackground);
+  start_tasks(engine::TaskPriority::kCritical);
+
+  for (auto& task : tasks) task.Get();
+  ASSERT_EQ(execution_order.size(), kTasksPerLane * 2);
+
+  // Background tasks were queued first, yet they get only a small share of
+  // the turns while there are critical tasks, and are not starved.
+  const auto first_half = execution_order.begin() + kTasksPerLane;
+  const auto background_in_first_half = std::count(
+      execution_order.begin(), first_half, engine::TaskPriority::kBackground);
+  EXPECT_GT(background_in_first_half, 0);
+  EXPECT_LE(background_in_first_half, 8);
+
+  auto& task_processor = engine::current_task::GetTaskProcessor();
+  std::uint64_t accounted_wait_times = 0;
+  for (std::size_t i = 0; i < engine::kTaskPriorityCount; ++i) {
+    accounted_wait_times +=
+        task_processor.GetQueueWaitTime(static_cast<engine::TaskPriority>(i))
+            .GetTotalCount();
+  }
+  EXPECT_GT(accounted_wait_times, 0);
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <engine/task/task_queue.hpp>
 
+#include <cstdint>
+
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -7,59 +9,117 @@ USERVER_NAMESPACE_BEGIN
 namespace engine {
 
 namespace {
+
 constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Dequeue shares of the lanes, in TaskPriority order
+constexpr std::array<std::size_t, kTaskPriorityCount> kLaneWeights{8, 4, 1};
+
+constexpr std::size_t kLaneSchedulePeriod =
+    kLaneWeights[0] + kLaneWeights[1] + kLaneWeights[2];
+
+using LaneSchedule = std::array<std::size_t, kLaneSchedulePeriod>;
+
+// Smooth weighted round-robin: spreads the turns of each lane evenly over
+// the period instead of serving a lane kLaneWeights[i] times in a row.
+constexpr LaneSchedule MakeLaneSchedule() {
+  LaneSchedule schedule{};
+  std::array<std::int64_t, kTaskPriorityCount> current{};
+  for (auto& lane : schedule) {
+    std::size_t best = 0;
+    for (std::size_t i = 0; i < kTaskPriorityCount; ++i) {
+      current[i] += static_cast<std::int64_t>(kLaneWeights[i]);
+      if (current[i] > current[best]) best = i;
+    }
+    current[best] -= static_cast<std::int64_t>(kLaneSchedulePeriod);
+    lane = best;
+  }
+  return schedule;
 }
 
+constexpr LaneSchedule kLaneSchedule = MakeLaneSchedule();
+
+}  // namespace
+
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
     : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
 
 void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
   UASSERT(context);
-  DoPush(context.get());
+  DoPush(context->GetPriority(), context.get());
   context.detach();
 }
 
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
   // Current thread handles only a single TaskProcessor, so it's safe to store
-  // a token for the task processor in a thread-local variable.
-  thread_local moodycamel::ConsumerToken token(queue_);
-
-  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(token),
+  // tokens for the task processor in a thread-local variable.
+  thread_local ConsumerTokens tokens{
+      moodycamel::ConsumerToken{lanes_[0]},
+      moodycamel::ConsumerToken{lanes_[1]},
+      moodycamel::ConsumerToken{lanes_[2]},
+  };
+
+  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(tokens),
                                                   /* add_ref= */ false};
 
   if (!context) {
     // return "stop" token back
-    DoPush(nullptr);
+    DoPush(TaskPriority::kBackground, nullptr);
   }
 
   return context;
 }
 
-void TaskQueue::StopProcessing() { DoPush(nullptr); }
+// The least important lane, so that the stop token does not overtake tasks
+void TaskQueue::StopProcessing() { DoPush(TaskPriority::kBackground, nullptr); }
 
 std::size_t TaskQueue::GetSizeApproximate() const noexcept {
-  return queue_.size_approx();
+  std::size_t size = 0;
+  for (const auto& lane : lanes_) size += lane.size_approx();
+  return size;
 }
 
-void TaskQueue::DoPush(impl::TaskContext* context) {
+std::size_t TaskQueue::GetSizeApproximate(
+    TaskPriority priority) const noexcept {
+  return lanes_[static_cast<std::size_t>(priority)].size_approx();
+}
+
+void TaskQueue::DoPush(TaskPriority priority, impl::TaskContext* context) {
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::enqueue
-  queue_.enqueue(context);
+  GetLane(priority).enqueue(context);
   queue_semaphore_.signal();
 }
 
-impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
+impl::TaskContext* TaskQueue::DoPopBlocking(ConsumerTokens& tokens) {
+  thread_local std::size_t schedule_position = 0;
   impl::TaskContext* context{};
 
-  // This piece of code is copy-pasted from
-  // moodycamel::BlockingConcurrentQueue::wait_dequeue
+  // This piece of code is adapted from
+  // moodycamel::BlockingConcurrentQueue::wait_dequeue. The semaphore counts
+  // the tasks in all the lanes, so once it's acquired there is a task for us
+  // in one of them.
   queue_semaphore_.wait();
-  while (!queue_.try_dequeue(token, context)) {
+
+  const auto preferred = kLaneSchedule[schedule_position];
+  schedule_position = (schedule_position + 1) % kLaneSchedulePeriod;
+  if (lanes_[preferred].try_dequeue(tokens[preferred], context)) {
+    return context;
+  }
+
+  while (true) {
+    for (std::size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+      if (lanes_[lane].try_dequeue(tokens[lane], context)) return context;
+    }
     // Can happen when another consumer steals our item in exchange for another
     // item in a Moodycamel sub-queue that we have already passed.
   }
+}
 
-  return context;
+TaskQueue::Lane& TaskQueue::GetLane(TaskPriority priority) noexcept {
+  const auto index = static_cast<std::size_t>(priority);
+  UASSERT(index < kTaskPriorityCount);
+  return lanes_[index];
 }
 
 }  // namespace engine
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
+
 #include <moodycamel/blockingconcurrentqueue.h>
 #include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_processor_config.hpp>
+#include <userver/engine/task/task_priority.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,6 +17,9 @@ namespace impl {
 class TaskContext;
 }  // namespace impl
 
+// A queue of ready tasks with a separate lane per TaskPriority. Lanes are
+// dequeued in a weighted round-robin order, an empty lane passes its turn to
+// the next non-empty one, so the workers never idle while there are tasks.
 class TaskQueue final {
  public:
   explicit TaskQueue(const TaskProcessorConfig& config);
@@ -27,12 +33,20 @@ class TaskQueue final {
 
   std::size_t GetSizeApproximate() const noexcept;
 
+  std::size_t GetSizeApproximate(TaskPriority priority) const noexcept;
+
  private:
-  void DoPush(impl::TaskContext* context);
+  using Lane = moodycamel::ConcurrentQueue<impl::TaskContext*>;
+  using ConsumerTokens =
+      std::array<moodycamel::ConsumerToken, kTaskPriorityCount>;
+
+  void DoPush(TaskPriority priority, impl::TaskContext* context);
+
+  impl::TaskContext* DoPopBlocking(ConsumerTokens& tokens);
 
-  impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
+  Lane& GetLane(TaskPriority priority) noexcept;
 
-  moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
+  std::array<Lane, kTaskPriorityCount> lanes_;
   moodycamel::LightweightSemaphore queue_semaphore_;
 };
 
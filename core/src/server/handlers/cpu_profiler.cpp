@@ -0,0 +1,121 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <algorithm>
+#include <system_error>
+
+#include <engine/task/sampling_profiler.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::size_t kDefaultFrequency = 99;
+constexpr std::size_t kDefaultMaxFrequency = 1000;
+constexpr std::chrono::seconds kDefaultDuration{10};
+constexpr std::chrono::seconds kDefaultMaxDuration{60};
+
+// Per-thread sample buffers hold ~5s of samples at the default frequency
+constexpr std::chrono::milliseconds kCollectPeriod{100};
+
+template <typename T>
+T GetArgOr(const http::HttpRequest& request, const std::string& name,
+           T default_value) {
+  if (!request.HasArg(name)) return default_value;
+  return utils::FromString<T>(request.GetArg(name));
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(const components::ComponentConfig& config,
+                         const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      default_frequency_(
+          config["default-frequency"].As<std::size_t>(kDefaultFrequency)),
+      max_frequency_(
+          config["max-frequency"].As<std::size_t>(kDefaultMaxFrequency)),
+      max_duration_(config["max-duration"].As<std::chrono::milliseconds>(
+          kDefaultMaxDuration)) {}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request,
+                                            request::RequestContext&) const {
+  std::chrono::milliseconds duration{};
+  std::size_t frequency = 0;
+  try {
+    duration = std::chrono::seconds{
+        GetArgOr<std::int64_t>(request, "seconds", kDefaultDuration.count())};
+    frequency =
+        GetArgOr<std::size_t>(request, "frequency", default_frequency_);
+  } catch (const std::exception& ex) {
+    request.SetResponseStatus(http::HttpStatus::kBadRequest);
+    return std::string{"invalid argument: "} + ex.what();
+  }
+  if (duration.count() <= 0 || duration > max_duration_ || frequency == 0 ||
+      frequency > max_frequency_) {
+    request.SetResponseStatus(http::HttpStatus::kBadRequest);
+    return "'seconds' and 'frequency' must be positive and within the limits "
+           "of the static config";
+  }
+
+  try {
+    engine::impl::CpuProfilingSession session{frequency};
+    const auto deadline = engine::Deadline::FromDuration(duration);
+    while (!deadline.IsReached() && !engine::current_task::ShouldCancel()) {
+      engine::InterruptibleSleepUntil(
+          std::min(deadline, engine::Deadline::FromDuration(kCollectPeriod)));
+      session.Collect();
+    }
+
+    const auto profile = session.Finish();
+    if (profile.dropped_samples) {
+      LOG_WARNING() << "CPU profile lost " << profile.dropped_samples
+                    << " samples due to full buffers";
+    }
+
+    request.GetHttpResponse().SetContentType(
+        USERVER_NAMESPACE::http::content_type::kApplicationOctetStream);
+    return engine::impl::ToPprof(profile);
+  } catch (const engine::impl::CpuProfilerBusyError& ex) {
+    request.SetResponseStatus(http::HttpStatus::kConflict);
+    return ex.what();
+  } catch (const std::system_error& ex) {
+    LOG_ERROR() << "Failed to start CPU profiling: " << ex;
+    request.SetResponseStatus(http::HttpStatus::kNotImplemented);
+    return ex.what();
+  }
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cpu-profiler config
+additionalProperties: false
+properties:
+    default-frequency:
+        type: integer
+        description: sampling frequency if not set in the request, in Hz
+        defaultDescription: 99
+        minimum: 1
+    max-frequency:
+        type: integer
+        description: the upper limit for the sampling frequency, in Hz
+        defaultDescription: 1000
+        minimum: 1
+    max-duration:
+        type: string
+        description: the upper limit for the profiling duration
+        defaultDescription: 60s
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -40,6 +40,14 @@ properties:
     task_processor:
         type: string
         description: a task processor to execute the requests
+    task_priority:
+        type: string
+        description: priority lane of the task processor queue for the request tasks, inherited by the tasks they start
+        defaultDescription: critical for monitor handlers and the handlers with throttling disabled, normal otherwise
+        enum:
+          - critical
+          - normal
+          - background
     method:
         type: string
         description: comma-separated list of allowed methods
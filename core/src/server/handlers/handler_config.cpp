@@ -60,6 +60,8 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
   }
 
   config.task_processor = value["task_processor"].As<std::string>();
+  config.task_priority =
+      value["task_priority"].As<std::optional<engine::TaskPriority>>();
   config.method = value["method"].As<std::string>();
   config.request_config.max_request_size =
       value["max_request_size"].As<size_t>(handler_defaults.max_request_size);
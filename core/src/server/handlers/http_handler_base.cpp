@@ -4,6 +4,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/container/small_vector.hpp>
 
+#include <engine/task/sampling_profiler.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/http/http_request_impl.hpp>
 #include <server/middlewares/handler_adapter.hpp>
@@ -140,6 +141,7 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
           context.FindComponent<components::DynamicConfig>().GetSource()),
       allowed_methods_(InitAllowedMethods(GetConfig())),
       handler_name_(config.Name()),
+      profiler_tag_(engine::impl::InternProfilerTag(handler_name_)),
       log_level_(config["log-level"].As<std::optional<logging::Level>>()),
       log_level_for_status_codes_(ParseStatusCodesLogLevel(
           config["status-codes-log-level"]
@@ -276,6 +278,7 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   http::HttpRequest http_request(http_request_impl);
   auto& response = http_request.GetHttpResponse();
 
+  engine::impl::SetCurrentTaskProfilerTag(profiler_tag_);
   context.GetInternalContext().SetConfigSnapshot(config_source_.GetSnapshot());
   try {
     UASSERT(first_middleware_);
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include <engine/task/task_context.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,6 +26,13 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
   writer["timings"] = stats.timings;
+  writer["timings-histogram"] = stats.timings_histogram;
+  writer["allocated-bytes"] = stats.allocated_bytes;
+  writer["deallocated-bytes"] = stats.deallocated_bytes;
+}
+
+utils::jemalloc::Allocations GetCurrentTaskAllocations() noexcept {
+  return engine::current_task::GetCurrentTaskContext().GetAllocations();
 }
 
 }  // namespace
@@ -34,8 +42,13 @@ void HttpHandlerMethodStatistics::Account(
   reply_codes_.Account(
       static_cast<utils::statistics::HttpCodes::Code>(stats.code));
   timings_.GetCurrentCounter().Account(stats.timing.count());
+  timings_histogram_.Account(stats.timing.count());
   if (stats.deadline.IsReachable()) ++deadline_received_;
   if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
+  allocated_bytes_.Add(
+      utils::statistics::Rate{stats.allocations.allocated_bytes});
+  deallocated_bytes_.Add(
+      utils::statistics::Rate{stats.allocations.deallocated_bytes});
 }
 
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
@@ -53,17 +66,21 @@ void DumpMetric(utils::statistics::Writer& writer,
 HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
     const HttpHandlerMethodStatistics& stats)
     : timings(stats.timings_.GetStatsForPeriod()),
+      timings_histogram(stats.timings_histogram_),
       reply_codes(stats.reply_codes_),
       in_flight(stats.GetInFlight()),
       finished(stats.finished_.Load()),
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      allocated_bytes(stats.allocated_bytes_.Load()),
+      deallocated_bytes(stats.deallocated_bytes_.Load()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(
     const HttpHandlerStatisticsSnapshot& other) {
   timings.Add(other.timings);
+  timings_histogram.Add(other.timings_histogram);
   reply_codes += other.reply_codes;
   in_flight += other.in_flight;
   finished += other.finished;
@@ -71,6 +88,8 @@ void HttpHandlerStatisticsSnapshot::Add(
   rate_limit_reached += other.rate_limit_reached;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
+  allocated_bytes += other.allocated_bytes;
+  deallocated_bytes += other.deallocated_bytes;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -98,6 +117,7 @@ HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
     : stats_(stats),
       method_(method),
       start_time_(std::chrono::steady_clock::now()),
+      start_allocations_(GetCurrentTaskAllocations()),
       response_(response) {
   stats_.ForMethod(method).IncrementInFlight();
 }
@@ -112,6 +132,7 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
       finish_time - start_time_);
   stats.deadline = data ? data->deadline : engine::Deadline{};
   stats.cancelled_by_deadline = cancelled_by_deadline_;
+  stats.allocations = GetCurrentTaskAllocations() - start_allocations_;
   stats_.ForMethod(method_).Account(stats);
   stats_.ForMethod(method_).DecrementInFlight();
 }
@@ -3,17 +3,21 @@
 #include <array>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <utils/jemalloc.hpp>
 #include <utils/statistics/http_codes.hpp>
+#include <utils/statistics/timings_histogram.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -25,6 +29,8 @@ struct HttpHandlerStatisticsEntry final {
   std::chrono::milliseconds timing{};
   engine::Deadline deadline{};
   bool cancelled_by_deadline{false};
+  // by the request handling task itself, excluding the tasks it started
+  utils::jemalloc::Allocations allocations{};
 };
 
 struct HttpHandlerStatisticsSnapshot;
@@ -56,6 +62,8 @@ class HttpHandlerMethodStatistics final {
                                       utils::datetime::SteadyClock>;
 
   RecentPeriod timings_;
+  utils::statistics::LogLinearHistogram timings_histogram_{
+      utils::statistics::impl::kTimingsHistogramMaxMs};
   utils::statistics::HttpCodes reply_codes_;
   utils::statistics::RateCounter started_;
   utils::statistics::RateCounter finished_;
@@ -63,6 +71,8 @@ class HttpHandlerMethodStatistics final {
   utils::statistics::RateCounter rate_limit_reached_;
   utils::statistics::RateCounter deadline_received_;
   utils::statistics::RateCounter cancelled_by_deadline_;
+  utils::statistics::RateCounter allocated_bytes_;
+  utils::statistics::RateCounter deallocated_bytes_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -77,6 +87,8 @@ struct HttpHandlerStatisticsSnapshot final {
   void Add(const HttpHandlerStatisticsSnapshot& other);
 
   HttpHandlerMethodStatistics::Percentile timings;
+  utils::statistics::LogLinearHistogram timings_histogram{
+      utils::statistics::impl::kTimingsHistogramMaxMs};
   utils::statistics::HttpCodes::Snapshot reply_codes;
   std::size_t in_flight{0};
   utils::statistics::Rate finished;
@@ -84,6 +96,8 @@ struct HttpHandlerStatisticsSnapshot final {
   utils::statistics::Rate rate_limit_reached;
   utils::statistics::Rate deadline_received;
   utils::statistics::Rate cancelled_by_deadline;
+  utils::statistics::Rate allocated_bytes;
+  utils::statistics::Rate deallocated_bytes;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -154,6 +168,7 @@ class HttpHandlerStatisticsScope final {
   HttpHandlerStatistics& stats_;
   const http::HttpMethod method_;
   const std::chrono::steady_clock::time_point start_time_;
+  const utils::jemalloc::Allocations start_allocations_;
   server::http::HttpResponse& response_;
   bool cancelled_by_deadline_{false};
 };
@@ -1,9 +1,17 @@
 #include <userver/server/handlers/jemalloc.hpp>
 
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_config.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/from_string.hpp>
-#include <userver/yaml_config/schema.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
 #include <utils/jemalloc.hpp>
+#include <utils/jemalloc_heap_profile.hpp>
 #include <utils/strerror.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -11,17 +19,30 @@ USERVER_NAMESPACE_BEGIN
 namespace server::handlers {
 
 namespace {
+
+constexpr std::size_t kDefaultDiffLimit = 20;
+
 std::string HandleRc(std::error_code ec) {
   if (ec)
     return "mallctl() returned error: " + ec.message() + "\n";
   else
     return "OK\n";
 }
+
+void RemoveHeapProfile(const std::string& path) {
+  try {
+    fs::blocking::RemoveSingleFile(path);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to remove the heap profile: " << ex;
+  }
+}
+
 }  // namespace
 
 Jemalloc::Jemalloc(const components::ComponentConfig& config,
                    const components::ComponentContext& component_context)
-    : HttpHandlerBase(config, component_context, /*is_monitor = */ true) {}
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      heap_profile_dir_(config["heap-profile-dir"].As<std::string>("/tmp")) {}
 
 std::string Jemalloc::HandleRequestThrow(const http::HttpRequest& request,
                                          request::RequestContext&) const {
@@ -34,6 +55,10 @@ std::string Jemalloc::HandleRequestThrow(const http::HttpRequest& request,
     return utils::jemalloc::Stats();
   } else if (command == "dump") {
     return HandleRc(utils::jemalloc::ProfDump());
+  } else if (command == "snapshot") {
+    return HandleSnapshot();
+  } else if (command == "diff") {
+    return HandleDiff(request);
   } else if (command == "bg_threads_set_max") {
     size_t num_threads = 0;
     if (!request.HasArg("count")) {
@@ -56,10 +81,73 @@ std::string Jemalloc::HandleRequestThrow(const http::HttpRequest& request,
   }
 }
 
+std::string Jemalloc::HandleSnapshot() const {
+  const std::lock_guard lock{base_profile_mutex_};
+  auto path = MakeHeapProfilePath();
+  const auto ec = utils::jemalloc::ProfDump(path);
+  if (ec) return HandleRc(ec);
+
+  if (!base_profile_path_.empty()) RemoveHeapProfile(base_profile_path_);
+  base_profile_path_ = std::move(path);
+  return "OK\n";
+}
+
+std::string Jemalloc::HandleDiff(const http::HttpRequest& request) const {
+  std::size_t limit = kDefaultDiffLimit;
+  if (request.HasArg("limit")) {
+    try {
+      limit = utils::FromString<std::size_t>(request.GetArg("limit"));
+    } catch (const std::exception& ex) {
+      request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+      return std::string{"invalid 'limit' value: "} + ex.what();
+    }
+  }
+
+  const std::lock_guard lock{base_profile_mutex_};
+  if (base_profile_path_.empty()) {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+    return "no base heap profile, call 'snapshot' first\n";
+  }
+
+  auto path = MakeHeapProfilePath();
+  const auto ec = utils::jemalloc::ProfDump(path);
+  if (ec) return HandleRc(ec);
+
+  std::string result;
+  try {
+    const auto base = utils::jemalloc::ParseHeapProfile(
+        fs::blocking::ReadFileContents(base_profile_path_));
+    const auto current =
+        utils::jemalloc::ParseHeapProfile(fs::blocking::ReadFileContents(path));
+    result = utils::jemalloc::FormatHeapProfileDiff(
+        utils::jemalloc::DiffHeapProfiles(base, current), limit);
+  } catch (const std::exception&) {
+    // The base profile is kept, the new one is of no use without a diff
+    RemoveHeapProfile(path);
+    throw;
+  }
+
+  RemoveHeapProfile(base_profile_path_);
+  base_profile_path_ = std::move(path);
+  return result;
+}
+
+std::string Jemalloc::MakeHeapProfilePath() const {
+  return fmt::format("{}/userver-heap.{}.{}.heap", heap_profile_dir_,
+                     ::getpid(), dumps_count_++);
+}
+
 yaml_config::Schema Jemalloc::GetStaticConfigSchema() {
-  auto schema = HttpHandlerBase::GetStaticConfigSchema();
-  schema.UpdateDescription("handler-jemalloc config");
-  return schema;
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-jemalloc config
+additionalProperties: false
+properties:
+    heap-profile-dir:
+        type: string
+        description: directory for the heap profiles of snapshot and diff
+        defaultDescription: /tmp
+)");
 }
 
 }  // namespace server::handlers
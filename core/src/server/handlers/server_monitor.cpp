@@ -3,7 +3,9 @@
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -58,20 +60,26 @@ std::optional<StatsFormat> ParseFormat(std::string_view format) {
                   format, kToFormat.DescribeFirst())});
 }
 
-}  // namespace
+std::string_view GetContentType(StatsFormat format) {
+  switch (format) {
+    case StatsFormat::kJson:
+    case StatsFormat::kSolomon:
+    case StatsFormat::kInternal:
+      return "application/json";
+    default:
+      return "text/plain; charset=utf-8";
+  }
+}
 
-ServerMonitor::ServerMonitor(
-    const components::ComponentConfig& config,
-    const components::ComponentContext& component_context)
-    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
-      statistics_storage_(
-          component_context.FindComponent<components::StatisticsStorage>()
-              .GetStorage()),
-      common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
+struct ParsedRequest {
+  StatsFormat format;
+  utils::statistics::Request statistics_request;
+};
 
-std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
-                                              request::RequestContext&) const {
+ParsedRequest ParseRequest(
+    const http::HttpRequest& request,
+    const std::optional<StatsFormat>& default_format,
+    const std::unordered_map<std::string, std::string>& common_labels) {
   const auto& prefix = request.GetArg("prefix");
   const auto& path = request.GetArg("path");
   if (!path.empty() && !prefix.empty() && path != prefix) {
@@ -90,39 +98,105 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
 
   const auto arg_format = ParseFormat(request.GetArg("format"));
 
-  if (!default_format_.has_value() && !arg_format.has_value()) {
+  if (!default_format.has_value() && !arg_format.has_value()) {
     throw handlers::ClientError(
         handlers::ExternalBody{"No format was provided"});
   }
 
   const auto format =
-      arg_format.has_value() ? arg_format.value() : default_format_.value();
+      arg_format.has_value() ? arg_format.value() : default_format.value();
 
   using utils::statistics::Request;
-  auto common_labels =
-      format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-  const auto statistics_request =
-      (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels),
-                                              std::move(labels))
-                    : Request::MakeWithPath(path, std::move(common_labels),
-                                            std::move(labels)));
-
-  request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
+  auto request_labels =
+      format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels;
+  return {format,
+          path.empty() ? Request::MakeWithPrefix(prefix,
+                                                 std::move(request_labels),
+                                                 std::move(labels))
+                       : Request::MakeWithPath(path, std::move(request_labels),
+                                               std::move(labels))};
+}
+
+utils::statistics::PrometheusFormatter::Format ToFormatterFormat(
+    StatsFormat format) {
+  return format == StatsFormat::kPrometheus
+             ? utils::statistics::PrometheusFormatter::Format::kTyped
+             : utils::statistics::PrometheusFormatter::Format::kUntyped;
+}
+
+}  // namespace
+
+ServerMonitor::ServerMonitor(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      statistics_storage_(
+          component_context.FindComponent<components::StatisticsStorage>()
+              .GetStorage()),
+      common_labels_{config["common-labels"].As<CommonLabels>({})},
+      default_format_{ParseFormat(config["format"].As<std::string>({}))},
+      prometheus_formatter_{statistics_storage_,
+                            ToFormatterFormat(StatsFormat::kPrometheus),
+                            config["parallel-tasks"].As<std::size_t>(1)},
+      prometheus_untyped_formatter_{
+          statistics_storage_,
+          ToFormatterFormat(StatsFormat::kPrometheusUntyped),
+          config["parallel-tasks"].As<std::size_t>(1)} {}
+
+std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
+                                              request::RequestContext&) const {
+  const auto [format, statistics_request] =
+      ParseRequest(request, default_format_, common_labels_);
+
+  request.GetHttpResponse().SetContentType(
+      std::string{GetContentType(format)});
+  return FormatMetrics(format, statistics_request);
+}
+
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& stream) const {
+  const auto [format, statistics_request] =
+      ParseRequest(request, default_format_, common_labels_);
+
+  stream.SetStatusCode(200);
+  stream.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                   std::string{GetContentType(format)});
+  stream.SetEndOfHeaders();
+
+  const auto push_chunk = [&stream](std::string&& chunk) {
+    stream.PushBodyChunk(std::move(chunk), engine::Deadline{});
+  };
+  switch (format) {
+    case StatsFormat::kPrometheus:
+      prometheus_formatter_.ToStream(statistics_request, push_chunk);
+      return;
+
+    case StatsFormat::kPrometheusUntyped:
+      prometheus_untyped_formatter_.ToStream(statistics_request, push_chunk);
+      return;
+
+    default:
+      push_chunk(FormatMetrics(format, statistics_request));
+      return;
+  }
+}
+
+std::string ServerMonitor::FormatMetrics(
+    StatsFormat format,
+    const utils::statistics::Request& statistics_request) const {
   switch (format) {
     case StatsFormat::kGraphite:
       return utils::statistics::ToGraphiteFormat(statistics_storage_,
                                                  statistics_request);
 
     case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
+      return prometheus_formatter_.ToString(statistics_request);
 
     case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
+      return prometheus_untyped_formatter_.ToString(statistics_request);
 
     case StatsFormat::kJson:
-      request.GetHttpResponse().SetContentType("application/json");
       return utils::statistics::ToJsonFormat(statistics_storage_,
                                              statistics_request);
 
@@ -131,12 +205,10 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                                statistics_request);
 
     case StatsFormat::kSolomon:
-      request.GetHttpResponse().SetContentType("application/json");
       return utils::statistics::ToSolomonFormat(
           statistics_storage_, common_labels_, statistics_request);
 
     case StatsFormat::kInternal:
-      request.GetHttpResponse().SetContentType("application/json");
       const auto json = statistics_storage_.GetAsJson();
       UASSERT(utils::statistics::AreAllMetricsNumbers(json));
       return formats::json::ToString(json);
@@ -176,6 +248,14 @@ properties:
           - pretty
           - solomon
           - internal
+    parallel-tasks:
+        type: integer
+        description: |
+            Number of tasks to visit the metric writers with for the
+            Prometheus formats. Metric writers must be safe to call
+            concurrently if more than 1.
+        defaultDescription: 1
+        minimum: 1
   )");
 }
 
@@ -178,11 +178,18 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     request->GetResponse().SetReady(now);
   };
 
-  if (!is_monitor_ && throttling_enabled) {
-    return engine::AsyncNoSpan(*task_processor, std::move(payload));
-  } else {
-    return engine::CriticalAsyncNoSpan(*task_processor, std::move(payload));
-  }
+  const bool is_critical = is_monitor_ || !throttling_enabled;
+  const auto importance = is_critical ? engine::Task::Importance::kCritical
+                                      : engine::Task::Importance::kNormal;
+  // Not inherited: the request tasks are started from the critical
+  // connection tasks
+  const auto priority = handler->GetConfig().task_priority.value_or(
+      is_critical ? engine::TaskPriority::kCritical
+                  : engine::TaskPriority::kNormal);
+  return engine::TaskWithResult<void>{engine::impl::MakeTask(
+      {*task_processor, importance, engine::TaskWithResult<void>::kWaitMode,
+       engine::Deadline{}, priority},
+      std::move(payload))};
 }  // namespace http
 
 void HttpRequestHandler::DisableAddHandler() {
@@ -0,0 +1,103 @@
+#include <tracing/hex_id.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+constexpr std::string_view kHexDigits = "0123456789abcdef";
+
+constexpr std::array<std::int8_t, 256> MakeHexValues() {
+  std::array<std::int8_t, 256> values{};
+  for (auto& value : values) value = -1;
+  for (std::size_t i = 0; i < kHexDigits.size(); ++i) {
+    values[static_cast<unsigned char>(kHexDigits[i])] =
+        static_cast<std::int8_t>(i);
+  }
+  return values;
+}
+
+constexpr auto kHexValues = MakeHexValues();
+
+enum RenderState : std::uint8_t { kNotRendered, kRendering, kRendered };
+
+}  // namespace
+
+void ToHex(const std::uint8_t* data, std::size_t size, char* out) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    *out++ = kHexDigits[data[i] >> 4];
+    *out++ = kHexDigits[data[i] & 0xf];
+  }
+}
+
+bool FromHex(std::string_view hex, std::uint8_t* data,
+             std::size_t size) noexcept {
+  if (hex.size() != size * 2) return false;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto high = kHexValues[static_cast<unsigned char>(hex[i * 2])];
+    const auto low = kHexValues[static_cast<unsigned char>(hex[i * 2 + 1])];
+    if (high < 0 || low < 0) return false;
+    data[i] = static_cast<std::uint8_t>((high << 4) | low);
+  }
+  return true;
+}
+
+void HashToBytes(std::string_view str, std::uint8_t* data,
+                 std::size_t size) noexcept {
+  // FNV-1a, a different offset basis per 8 bytes of output
+  constexpr std::uint64_t kPrime = 0x100000001b3;
+  std::uint64_t basis = 0xcbf29ce484222325;
+  while (size != 0) {
+    std::uint64_t hash = basis;
+    for (const char c : str) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= kPrime;
+    }
+    const auto chunk = std::min(size, sizeof(hash));
+    std::memcpy(data, &hash, chunk);
+    data += chunk;
+    size -= chunk;
+    basis = hash * kPrime;
+  }
+}
+
+void GenerateRandomBytes(std::uint8_t* data, std::size_t size) noexcept {
+  std::uniform_int_distribution<std::uint64_t> dist;
+  while (size != 0) {
+    const auto random_value = utils::WithDefaultRandom(dist);
+    const auto chunk = std::min(size, sizeof(random_value));
+    std::memcpy(data, &random_value, chunk);
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+void RenderHexOnce(std::atomic<std::uint8_t>& state, const std::uint8_t* data,
+                   std::size_t size, std::string& out) noexcept {
+  auto current = state.load(std::memory_order_acquire);
+  if (current == kRendered) return;
+
+  if (current == kNotRendered &&
+      state.compare_exchange_strong(current, kRendering,
+                                    std::memory_order_relaxed)) {
+    out.resize(size * 2);
+    ToHex(data, size, out.data());
+    state.store(kRendered, std::memory_order_release);
+    return;
+  }
+
+  // Rendering takes nanoseconds, no point in sleeping
+  while (state.load(std::memory_order_acquire) != kRendered) {
+  }
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
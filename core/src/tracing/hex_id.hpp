@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+// Lowercase hex of `size` bytes into `out`, which must have 2 * size chars
+void ToHex(const std::uint8_t* data, std::size_t size, char* out) noexcept;
+
+// Parses exactly 2 * size lowercase hex digits, false on any mismatch
+bool FromHex(std::string_view hex, std::uint8_t* data,
+             std::size_t size) noexcept;
+
+// Deterministically derives the bytes from a string, for the received ids
+// that are not hex of the expected size
+void HashToBytes(std::string_view str, std::uint8_t* data,
+                 std::size_t size) noexcept;
+
+// Fills the bytes with random values
+void GenerateRandomBytes(std::uint8_t* data, std::size_t size) noexcept;
+
+// Renders the bytes into `out` once, concurrent callers wait for the first one
+void RenderHexOnce(std::atomic<std::uint8_t>& state, const std::uint8_t* data,
+                   std::size_t size, std::string& out) noexcept;
+
+// Trace or span id. The ids generated by userver and the received ones that
+// look the same are kept in binary and only rendered to hex when logged or
+// propagated. Other ids received from outside are kept as is.
+template <std::size_t Bytes>
+class HexId final {
+ public:
+  static constexpr std::size_t kHexSize = Bytes * 2;
+
+  // Storage for the rendering without allocations
+  using Buffer = std::array<char, kHexSize>;
+
+  HexId() = default;
+
+  explicit HexId(std::string&& id) {
+    if (FromHex(id, value_.data(), Bytes)) {
+      is_binary_ = true;
+    } else {
+      string_ = std::move(id);
+    }
+  }
+
+  HexId(const HexId& other)
+      : value_(other.value_),
+        is_binary_(other.is_binary_),
+        string_(other.is_binary_ ? std::string{} : other.string_) {}
+
+  HexId(HexId&& other) noexcept
+      : value_(other.value_),
+        is_binary_(other.is_binary_),
+        string_(other.is_binary_ ? std::string{} : std::move(other.string_)) {}
+
+  // Must not race with the readers, as any other modification
+  HexId& operator=(HexId&& other) noexcept {
+    value_ = other.value_;
+    is_binary_ = other.is_binary_;
+    string_ = is_binary_ ? std::string{} : std::move(other.string_);
+    render_state_.store(0, std::memory_order_relaxed);
+    return *this;
+  }
+
+  HexId& operator=(const HexId&) = delete;
+
+  static HexId Generate() noexcept {
+    HexId result;
+    GenerateRandomBytes(result.value_.data(), Bytes);
+    result.is_binary_ = true;
+    return result;
+  }
+
+  bool IsEmpty() const noexcept { return !is_binary_ && string_.empty(); }
+
+  // Binary form for the binary protocols. Received ids that are not hex are
+  // hashed, so that all the spans of a trace still get the same value.
+  std::array<std::uint8_t, Bytes> ToBytes() const noexcept {
+    if (is_binary_) return value_;
+    std::array<std::uint8_t, Bytes> result{};
+    HashToBytes(string_, result.data(), Bytes);
+    return result;
+  }
+
+  // The result points either into the `buffer` or into *this
+  std::string_view ToStringView(Buffer& buffer) const noexcept {
+    if (!is_binary_) return string_;
+    ToHex(value_.data(), Bytes, buffer.data());
+    return {buffer.data(), buffer.size()};
+  }
+
+  // Renders the binary id once, thread-safe
+  const std::string& ToString() const {
+    if (is_binary_) RenderHexOnce(render_state_, value_.data(), Bytes, string_);
+    return string_;
+  }
+
+ private:
+  std::array<std::uint8_t, Bytes> value_{};
+  bool is_binary_{false};
+  mutable std::atomic<std::uint8_t> render_state_{0};
+  // The id if it is not binary, the rendered id cache otherwise
+  mutable std::string string_;
+};
+
+using TraceId = HexId<16>;
+using SpanId = HexId<8>;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#include <tracing/hex_id.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(TracingHexId, Generate) {
+  const auto first = tracing::impl::TraceId::Generate();
+  const auto second = tracing::impl::TraceId::Generate();
+  EXPECT_FALSE(first.IsEmpty());
+  EXPECT_EQ(first.ToString().size(), 32);
+  EXPECT_NE(first.ToString(), second.ToString());
+
+  tracing::impl::TraceId::Buffer buffer;
+  EXPECT_EQ(first.ToStringView(buffer), first.ToString());
+
+  EXPECT_EQ(tracing::impl::SpanId::Generate().ToString().size(), 16);
+}
+
+TEST(TracingHexId, Empty) {
+  const tracing::impl::SpanId id;
+  EXPECT_TRUE(id.IsEmpty());
+  EXPECT_EQ(id.ToString(), "");
+
+  tracing::impl::SpanId::Buffer buffer;
+  EXPECT_EQ(id.ToStringView(buffer), "");
+}
+
+TEST(TracingHexId, ReceivedIdsRoundTrip) {
+  for (std::string id : {"0123456789abcdef", "0123456789ABCDEF", "123",
+                         "0123456789abcdeg", "some-request-id"}) {
+    const tracing::impl::SpanId span_id{std::string{id}};
+    EXPECT_FALSE(span_id.IsEmpty());
+    EXPECT_EQ(span_id.ToString(), id);
+
+    tracing::impl::SpanId::Buffer buffer;
+    EXPECT_EQ(span_id.ToStringView(buffer), id);
+  }
+}
+
+TEST(TracingHexId, ToBytes) {
+  const tracing::impl::SpanId hex{std::string{"0123456789abcdef"}};
+  const std::array<std::uint8_t, 8> expected{0x01, 0x23, 0x45, 0x67,
+                                             0x89, 0xab, 0xcd, 0xef};
+  EXPECT_EQ(hex.ToBytes(), expected);
+
+  const tracing::impl::TraceId foreign{std::string{"some-request-id"}};
+  EXPECT_EQ(foreign.ToBytes(),
+            tracing::impl::TraceId{std::string{"some-request-id"}}.ToBytes());
+  EXPECT_NE(foreign.ToBytes(),
+            tracing::impl::TraceId{std::string{"other-request-id"}}.ToBytes());
+  EXPECT_NE(foreign.ToBytes(), (std::array<std::uint8_t, 16>{}));
+}
+
+TEST(TracingHexId, CopyAndAssign) {
+  auto id = tracing::impl::TraceId::Generate();
+  const auto rendered = id.ToString();
+
+  const auto copy = id;
+  EXPECT_EQ(copy.ToString(), rendered);
+
+  id = tracing::impl::TraceId{std::string{"ffffffffffffffffffffffffffffffff"}};
+  EXPECT_EQ(id.ToString(), "ffffffffffffffffffffffffffffffff");
+  EXPECT_EQ(copy.ToString(), rendered);
+}
+
+USERVER_NAMESPACE_END
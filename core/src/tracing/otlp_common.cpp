@@ -0,0 +1,128 @@
+#include <tracing/otlp_common.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <variant>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/overloaded.hpp>
+
+#include <utils/impl/proto_writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+using utils::impl::ProtoWriter;
+
+// Field numbers of opentelemetry/proto/common/v1/common.proto and
+// opentelemetry/proto/resource/v1/resource.proto
+namespace proto {
+
+constexpr int kResourceAttributes = 1;
+
+constexpr int kScopeName = 1;
+
+constexpr int kKeyValueKey = 1;
+constexpr int kKeyValueValue = 2;
+
+constexpr int kAnyValueString = 1;
+constexpr int kAnyValueInt = 3;
+constexpr int kAnyValueDouble = 4;
+
+}  // namespace proto
+
+constexpr std::string_view kScopeName = "userver";
+constexpr std::string_view kContentTypeProtobuf = "application/x-protobuf";
+
+}  // namespace
+
+std::uint64_t ToOtlpTime(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+std::string SerializeOtlpAttribute(std::string_view key,
+                                   const logging::LogExtra::Value& value) {
+  ProtoWriter any_value;
+  std::visit(utils::Overloaded{
+                 [&any_value](const std::string& str) {
+                   any_value.WriteBytes(proto::kAnyValueString, str);
+                 },
+                 [&any_value](float number) {
+                   any_value.WriteDouble(proto::kAnyValueDouble, number);
+                 },
+                 [&any_value](double number) {
+                   any_value.WriteDouble(proto::kAnyValueDouble, number);
+                 },
+                 [&any_value](auto number) {
+                   any_value.WriteInt(proto::kAnyValueInt,
+                                      static_cast<std::int64_t>(number));
+                 }},
+             value);
+
+  ProtoWriter key_value;
+  key_value.WriteBytes(proto::kKeyValueKey, key);
+  key_value.WriteBytes(proto::kKeyValueValue, std::move(any_value).Extract());
+  return std::move(key_value).Extract();
+}
+
+std::string SerializeOtlpResource(std::string_view service_name) {
+  ProtoWriter resource;
+  resource.WriteBytes(proto::kResourceAttributes,
+                      SerializeOtlpAttribute("service.name",
+                                             std::string{service_name}));
+  return std::move(resource).Extract();
+}
+
+std::string SerializeOtlpScope() {
+  ProtoWriter scope;
+  scope.WriteBytes(proto::kScopeName, kScopeName);
+  return std::move(scope).Extract();
+}
+
+std::vector<bool> SendOtlpRequests(clients::http::Client& http_client,
+                                   const std::string& endpoint,
+                                   std::vector<std::string>&& bodies,
+                                   std::chrono::milliseconds timeout) {
+  std::vector<bool> accepted(bodies.size(), false);
+  std::vector<std::optional<clients::http::ResponseFuture>> responses;
+  responses.reserve(bodies.size());
+  for (auto& body : bodies) {
+    try {
+      responses.emplace_back(
+          http_client.CreateRequest()
+              .post(endpoint, std::move(body))
+              .headers({{http::headers::kContentType, kContentTypeProtobuf}})
+              .timeout(timeout)
+              .async_perform());
+    } catch (const std::exception& ex) {
+      LOG_LIMITED_WARNING() << "Failed to send an OTLP export request to "
+                            << endpoint << ": " << ex;
+      responses.emplace_back();
+    }
+  }
+
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    if (!responses[i]) continue;
+    try {
+      responses[i]->Get()->raise_for_status();
+      accepted[i] = true;
+    } catch (const std::exception& ex) {
+      LOG_LIMITED_WARNING() << "OTLP export request to " << endpoint
+                            << " failed: " << ex;
+    }
+  }
+  return accepted;
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
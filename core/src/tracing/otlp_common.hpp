@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
+namespace tracing::impl {
+
+// Converts the time to the OTLP nanoseconds since the Unix epoch
+std::uint64_t ToOtlpTime(std::chrono::system_clock::time_point time);
+
+// Serializes an OTLP KeyValue attribute
+std::string SerializeOtlpAttribute(std::string_view key,
+                                   const logging::LogExtra::Value& value);
+
+// Serializes an OTLP Resource with the `service.name` attribute
+std::string SerializeOtlpResource(std::string_view service_name);
+
+// Serializes the OTLP InstrumentationScope of the exported data
+std::string SerializeOtlpScope();
+
+// Sends the serialized OTLP export requests to the collector concurrently, so
+// that an unresponsive collector delays the export by a single timeout.
+// Returns whether each of the requests was accepted.
+std::vector<bool> SendOtlpRequests(clients::http::Client& http_client,
+                                   const std::string& endpoint,
+                                   std::vector<std::string>&& bodies,
+                                   std::chrono::milliseconds timeout);
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
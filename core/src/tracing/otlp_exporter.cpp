@@ -0,0 +1,319 @@
+#include <tracing/otlp_exporter.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <variant>
+
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <tracing/otlp_common.hpp>
+#include <utils/impl/proto_writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+using utils::impl::ProtoWriter;
+
+// Field numbers of opentelemetry/proto/collector/trace/v1/trace_service.proto
+// and the messages it refers to
+namespace proto {
+
+constexpr int kRequestResourceSpans = 1;
+
+constexpr int kResourceSpansResource = 1;
+constexpr int kResourceSpansScopeSpans = 2;
+
+constexpr int kScopeSpansScope = 1;
+constexpr int kScopeSpansSpans = 2;
+
+constexpr int kSpanTraceId = 1;
+constexpr int kSpanSpanId = 2;
+constexpr int kSpanParentSpanId = 4;
+constexpr int kSpanName = 5;
+constexpr int kSpanKind = 6;
+constexpr int kSpanStartTime = 7;
+constexpr int kSpanEndTime = 8;
+constexpr int kSpanAttributes = 9;
+constexpr int kSpanStatus = 15;
+
+constexpr int kSpanKindInternal = 1;
+constexpr int kSpanKindServer = 2;
+
+constexpr int kStatusMessage = 2;
+constexpr int kStatusCode = 3;
+constexpr int kStatusCodeError = 2;
+
+}  // namespace proto
+
+template <std::size_t Size>
+std::string_view AsBytes(const std::array<std::uint8_t, Size>& id) {
+  return {reinterpret_cast<const char*>(id.data()), id.size()};
+}
+
+template <std::size_t Size>
+bool IsZero(const std::array<std::uint8_t, Size>& id) {
+  return std::all_of(id.begin(), id.end(), [](auto byte) { return byte == 0; });
+}
+
+std::string SerializeSpan(const ExportedSpan& span) {
+  ProtoWriter writer;
+  writer.WriteBytes(proto::kSpanTraceId, AsBytes(span.trace_id));
+  writer.WriteBytes(proto::kSpanSpanId, AsBytes(span.span_id));
+  const bool has_parent = !IsZero(span.parent_span_id);
+  if (has_parent) {
+    writer.WriteBytes(proto::kSpanParentSpanId, AsBytes(span.parent_span_id));
+  }
+  writer.WriteBytes(proto::kSpanName, span.name);
+  // A local root with a remote parent is a request handling span
+  writer.WriteUint(proto::kSpanKind, span.is_local_root && has_parent
+                                         ? proto::kSpanKindServer
+                                         : proto::kSpanKindInternal);
+
+  const auto start_time = ToOtlpTime(span.start_time);
+  writer.WriteFixed64(proto::kSpanStartTime, start_time);
+  writer.WriteFixed64(proto::kSpanEndTime,
+                      start_time + static_cast<std::uint64_t>(
+                                       std::max(span.duration.count(),
+                                                std::int64_t{0})));
+
+  const std::string* error_message = nullptr;
+  for (const auto& [key, value] : span.attributes) {
+    writer.WriteBytes(proto::kSpanAttributes, SerializeOtlpAttribute(key, value));
+    if (key == kErrorMessage) error_message = std::get_if<std::string>(&value);
+  }
+
+  if (span.is_error) {
+    ProtoWriter status;
+    if (error_message) status.WriteBytes(proto::kStatusMessage, *error_message);
+    status.WriteUint(proto::kStatusCode, proto::kStatusCodeError);
+    writer.WriteBytes(proto::kSpanStatus, std::move(status).Extract());
+  }
+  return std::move(writer).Extract();
+}
+
+}  // namespace
+
+std::string SerializeOtlpTraces(std::string_view service_name,
+                                const std::vector<ExportedSpan>& spans) {
+  ProtoWriter scope_spans;
+  scope_spans.WriteBytes(proto::kScopeSpansScope, SerializeOtlpScope());
+  for (const auto& span : spans) {
+    scope_spans.WriteBytes(proto::kScopeSpansSpans, SerializeSpan(span));
+  }
+
+  ProtoWriter resource_spans;
+  resource_spans.WriteBytes(proto::kResourceSpansResource,
+                            SerializeOtlpResource(service_name));
+  resource_spans.WriteBytes(proto::kResourceSpansScopeSpans,
+                            std::move(scope_spans).Extract());
+
+  ProtoWriter request;
+  request.WriteBytes(proto::kRequestResourceSpans,
+                     std::move(resource_spans).Extract());
+  return std::move(request).Extract();
+}
+
+std::size_t OtlpExporter::TraceKeyHash::operator()(
+    const TraceKey& key) const noexcept {
+  // The trace ids are random
+  std::size_t result = 0;
+  std::memcpy(&result, key.data() + key.size() - sizeof(result),
+              sizeof(result));
+  return result;
+}
+
+OtlpExporter::OtlpExporter(OtlpExporterSettings settings,
+                           clients::http::Client& http_client)
+    : settings_(std::move(settings)),
+      http_client_(http_client),
+      sink_(std::make_shared<SpanExportSink>(settings_.span_export)) {
+  UINVARIANT(settings_.max_batch_size != 0,
+             "OTLP export batch size must be positive");
+  SetSpanExportSink(sink_);
+
+  export_task_.Start("otlp-exporter", settings_.export_interval, [this] {
+    DisableCurrentSpanExport();
+    Flush();
+  });
+}
+
+OtlpExporter::~OtlpExporter() {
+  export_task_.Stop();
+  SetSpanExportSink(nullptr);
+  Flush();
+}
+
+void OtlpExporter::Flush() {
+  // The spans of the export requests themselves are not exported
+  const tracing::Span export_span{"otlp_export", ReferenceType::kChild,
+                                  logging::Level::kTrace};
+  DisableCurrentSpanExport();
+
+  std::unique_lock lock{mutex_};
+
+  sink_->Drain(drained_);
+  const auto now = std::chrono::steady_clock::now();
+  for (auto& span : drained_) {
+    if (span.is_head_sampled) {
+      Enqueue(std::move(span));
+    } else {
+      ProcessTailCandidate(std::move(span), now);
+    }
+  }
+  drained_.clear();
+
+  ExpirePendingTraces(now);
+  stats_.pending_spans.store(pending_spans_, std::memory_order_relaxed);
+
+  auto queue = std::exchange(queue_, {});
+  lock.unlock();
+
+  SendSpans(std::move(queue));
+}
+
+void OtlpExporter::WriteStatistics(utils::statistics::Writer& writer) const {
+  writer["exported-spans"] = stats_.exported;
+
+  auto dropped = writer["dropped-spans"];
+  dropped.ValueWithLabels(utils::statistics::Rate{sink_->GetDroppedCount()},
+                          {"reason", "buffer-full"});
+  dropped.ValueWithLabels(stats_.dropped_queue_full,
+                          {"reason", "queue-full"});
+  dropped.ValueWithLabels(stats_.dropped_pending_full,
+                          {"reason", "tail-buffer-full"});
+  dropped.ValueWithLabels(stats_.dropped_export_failed,
+                          {"reason", "export-failed"});
+
+  writer["tail-discarded-spans"] = stats_.tail_discarded;
+  writer["tail-pending-spans"] =
+      stats_.pending_spans.load(std::memory_order_relaxed);
+
+  auto requests = writer["export-requests"];
+  requests.ValueWithLabels(stats_.requests_ok, {"status", "ok"});
+  requests.ValueWithLabels(stats_.requests_failed, {"status", "error"});
+}
+
+void OtlpExporter::ProcessTailCandidate(
+    ExportedSpan&& span, std::chrono::steady_clock::time_point now) {
+  // A span that finished after its local root, e.g. of a detached task
+  if (exported_traces_.count(span.trace_id)) {
+    Enqueue(std::move(span));
+    return;
+  }
+
+  if (pending_spans_ >= settings_.max_pending_spans) {
+    ++stats_.dropped_pending_full;
+    return;
+  }
+
+  auto [it, inserted] = pending_.try_emplace(span.trace_id);
+  auto& trace = it->second;
+  if (inserted) trace.deadline = now + settings_.tail_decision_wait;
+
+  trace.is_interesting = trace.is_interesting || IsInteresting(span);
+  const bool is_local_root = span.is_local_root;
+  trace.spans.push_back(std::move(span));
+  ++pending_spans_;
+
+  if (is_local_root) {
+    DecideTrace(trace, now, it->first);
+    pending_.erase(it);
+  }
+}
+
+void OtlpExporter::DecideTrace(PendingTrace& trace,
+                               std::chrono::steady_clock::time_point now,
+                               const TraceKey& trace_id) {
+  pending_spans_ -= trace.spans.size();
+  if (!trace.is_interesting) {
+    stats_.tail_discarded += utils::statistics::Rate{trace.spans.size()};
+    return;
+  }
+
+  Enqueue(std::move(trace.spans));
+  if (exported_traces_.size() < settings_.max_pending_spans) {
+    exported_traces_.emplace(trace_id, now + settings_.tail_decision_wait);
+  }
+}
+
+void OtlpExporter::ExpirePendingTraces(
+    std::chrono::steady_clock::time_point now) {
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (it->second.deadline > now) {
+      ++it;
+      continue;
+    }
+
+    // The local root has not finished in time, decide by what we have
+    DecideTrace(it->second, now, it->first);
+    it = pending_.erase(it);
+  }
+
+  for (auto it = exported_traces_.begin(); it != exported_traces_.end();) {
+    if (it->second > now) {
+      ++it;
+    } else {
+      it = exported_traces_.erase(it);
+    }
+  }
+}
+
+bool OtlpExporter::IsInteresting(const ExportedSpan& span) const noexcept {
+  if (settings_.tail_sample_errors && span.is_error) return true;
+  return settings_.tail_latency_threshold.count() != 0 &&
+         span.duration >= settings_.tail_latency_threshold;
+}
+
+void OtlpExporter::Enqueue(ExportedSpan&& span) {
+  if (queue_.size() >= settings_.max_queue_size) {
+    ++stats_.dropped_queue_full;
+    return;
+  }
+  queue_.push_back(std::move(span));
+}
+
+void OtlpExporter::Enqueue(std::vector<ExportedSpan>&& spans) {
+  for (auto& span : spans) Enqueue(std::move(span));
+}
+
+void OtlpExporter::SendSpans(std::vector<ExportedSpan>&& spans) {
+  std::vector<std::size_t> batch_sizes;
+  std::vector<std::string> requests;
+  for (auto begin = spans.begin(); begin != spans.end();) {
+    const auto end =
+        begin + std::min<std::ptrdiff_t>(settings_.max_batch_size,
+                                         std::distance(begin, spans.end()));
+    const std::vector<ExportedSpan> batch{std::make_move_iterator(begin),
+                                          std::make_move_iterator(end)};
+    batch_sizes.push_back(batch.size());
+    requests.push_back(SerializeOtlpTraces(settings_.service_name, batch));
+    begin = end;
+  }
+
+  const auto accepted =
+      SendOtlpRequests(http_client_, settings_.endpoint, std::move(requests),
+                       settings_.export_timeout);
+  for (std::size_t i = 0; i < accepted.size(); ++i) {
+    const utils::statistics::Rate size{batch_sizes[i]};
+    if (accepted[i]) {
+      ++stats_.requests_ok;
+      stats_.exported += size;
+    } else {
+      ++stats_.requests_failed;
+      stats_.dropped_export_failed += size;
+    }
+  }
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+#include <tracing/span_export.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
+namespace tracing::impl {
+
+struct OtlpExporterSettings final {
+  // OTLP/HTTP traces endpoint, e.g. http://localhost:4318/v1/traces
+  std::string endpoint;
+  std::string service_name;
+  SpanExportSettings span_export;
+
+  // Tail sampling rules, applied to the traces that were not head-sampled:
+  // the trace is exported if any of its spans is an error...
+  bool tail_sample_errors{true};
+  // ...or takes at least this long, 0 disables the rule
+  std::chrono::milliseconds tail_latency_threshold{0};
+  // How long to keep the spans of a trace waiting for its local root span
+  std::chrono::milliseconds tail_decision_wait{5000};
+  std::size_t max_pending_spans{10000};
+
+  std::size_t max_queue_size{8192};
+  std::size_t max_batch_size{512};
+  std::chrono::milliseconds export_interval{1000};
+  std::chrono::milliseconds export_timeout{1000};
+};
+
+// Serializes the spans into an OTLP ExportTraceServiceRequest protobuf
+// (https://github.com/open-telemetry/opentelemetry-proto)
+std::string SerializeOtlpTraces(std::string_view service_name,
+                                const std::vector<ExportedSpan>& spans);
+
+// Exports the finished spans of the whole process to an OpenTelemetry
+// collector over OTLP/HTTP in batches from a background task. Installs its
+// impl::SpanExportSink for its lifetime, so there may be only one instance.
+//
+// Memory is bounded: spans that do not fit into the thread buffers, the send
+// queue or the tail sampling buffer are dropped and counted, and so are the
+// batches the collector failed to accept.
+class OtlpExporter final {
+ public:
+  OtlpExporter(OtlpExporterSettings settings,
+               clients::http::Client& http_client);
+  ~OtlpExporter();
+
+  OtlpExporter(const OtlpExporter&) = delete;
+  OtlpExporter& operator=(const OtlpExporter&) = delete;
+
+  // Collects the finished spans, samples them and sends them to the
+  // collector. Called periodically, may be called manually to export the
+  // spans finished so far.
+  void Flush();
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  using TraceKey = std::array<std::uint8_t, 16>;
+
+  struct TraceKeyHash final {
+    std::size_t operator()(const TraceKey& key) const noexcept;
+  };
+
+  struct PendingTrace final {
+    std::vector<ExportedSpan> spans;
+    std::chrono::steady_clock::time_point deadline;
+    bool is_interesting{false};
+  };
+
+  struct Statistics final {
+    utils::statistics::RateCounter exported;
+    utils::statistics::RateCounter dropped_queue_full;
+    utils::statistics::RateCounter dropped_pending_full;
+    utils::statistics::RateCounter dropped_export_failed;
+    utils::statistics::RateCounter tail_discarded;
+    utils::statistics::RateCounter requests_ok;
+    utils::statistics::RateCounter requests_failed;
+    std::atomic<std::size_t> pending_spans{0};
+  };
+
+  void ProcessTailCandidate(ExportedSpan&& span,
+                            std::chrono::steady_clock::time_point now);
+  void DecideTrace(PendingTrace& trace,
+                   std::chrono::steady_clock::time_point now,
+                   const TraceKey& trace_id);
+  void ExpirePendingTraces(std::chrono::steady_clock::time_point now);
+  bool IsInteresting(const ExportedSpan& span) const noexcept;
+  void Enqueue(ExportedSpan&& span);
+  void Enqueue(std::vector<ExportedSpan>&& spans);
+  // Sends the spans in batches, concurrently and without the lock, so that an
+  // unresponsive collector delays the export by a single timeout
+  void SendSpans(std::vector<ExportedSpan>&& spans);
+
+  const OtlpExporterSettings settings_;
+  clients::http::Client& http_client_;
+  const std::shared_ptr<SpanExportSink> sink_;
+
+  engine::Mutex mutex_;
+  std::vector<ExportedSpan> drained_;
+  std::vector<ExportedSpan> queue_;
+  // The traces waiting for their local root, at most max_pending_spans spans
+  std::unordered_map<TraceKey, PendingTrace, TraceKeyHash> pending_;
+  std::size_t pending_spans_{0};
+  // The exported traces, remembered until their decision wait expires to
+  // export the spans that finish after the local root, e.g. of detached tasks.
+  // The spans of the discarded traces that finish late are sampled anew.
+  std::unordered_map<TraceKey, std::chrono::steady_clock::time_point,
+                     TraceKeyHash>
+      exported_traces_;
+
+  Statistics stats_;
+  utils::PeriodicTask export_task_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
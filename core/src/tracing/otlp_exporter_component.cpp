@@ -0,0 +1,242 @@
+#include <userver/tracing/otlp_exporter_component.hpp>
+
+#include <stdexcept>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/tracing/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <tracing/otlp_exporter.hpp>
+#include <tracing/otlp_metrics_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+tracing::impl::OtlpExporterSettings ParseSettings(
+    const ComponentConfig& config) {
+  tracing::impl::OtlpExporterSettings settings;
+  settings.endpoint = config["endpoint"].As<std::string>();
+  settings.service_name = config["service-name"].As<std::string>();
+
+  settings.span_export.head_sampling_ratio =
+      config["head-sampling-ratio"].As<double>(1.0);
+  if (settings.span_export.head_sampling_ratio < 0.0 ||
+      settings.span_export.head_sampling_ratio > 1.0) {
+    throw std::runtime_error("head-sampling-ratio must be within [0, 1]");
+  }
+  settings.span_export.thread_buffer_size =
+      config["thread-buffer-size"].As<std::size_t>(
+          settings.span_export.thread_buffer_size);
+
+  const auto tail_sampling = config["tail-sampling"];
+  settings.span_export.tail_sampling =
+      tail_sampling["enabled"].As<bool>(false);
+  settings.tail_sample_errors =
+      tail_sampling["errors"].As<bool>(settings.tail_sample_errors);
+  settings.tail_latency_threshold =
+      tail_sampling["latency-threshold"].As<std::chrono::milliseconds>(
+          settings.tail_latency_threshold);
+  settings.tail_decision_wait =
+      tail_sampling["decision-wait"].As<std::chrono::milliseconds>(
+          settings.tail_decision_wait);
+  settings.max_pending_spans =
+      tail_sampling["max-pending-spans"].As<std::size_t>(
+          settings.max_pending_spans);
+
+  settings.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(settings.max_queue_size);
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  settings.export_interval =
+      config["export-interval"].As<std::chrono::milliseconds>(
+          settings.export_interval);
+  settings.export_timeout =
+      config["export-timeout"].As<std::chrono::milliseconds>(
+          settings.export_timeout);
+  return settings;
+}
+
+tracing::impl::OtlpMetricsExporterSettings ParseMetricsSettings(
+    const ComponentConfig& config) {
+  tracing::impl::OtlpMetricsExporterSettings settings;
+  settings.endpoint = config["endpoint"].As<std::string>();
+  settings.service_name = config["service-name"].As<std::string>();
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  settings.export_interval =
+      config["export-interval"].As<std::chrono::milliseconds>(
+          settings.export_interval);
+  settings.export_timeout =
+      config["export-timeout"].As<std::chrono::milliseconds>(
+          settings.export_timeout);
+  return settings;
+}
+
+}  // namespace
+
+OtlpTraceExporter::OtlpTraceExporter(const ComponentConfig& config,
+                                     const ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  // Spans are created by the tracer
+  context.FindComponent<Tracer>();
+  auto& http_client =
+      context
+          .FindComponent<HttpClient>(
+              config["http-client"].As<std::string>(HttpClient::kName))
+          .GetHttpClient();
+
+  exporter_ = std::make_unique<tracing::impl::OtlpExporter>(
+      ParseSettings(config), http_client);
+
+  auto& storage = context.FindComponent<StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      "tracing.otlp", [this](utils::statistics::Writer& writer) {
+        exporter_->WriteStatistics(writer);
+      });
+}
+
+OtlpTraceExporter::~OtlpTraceExporter() {
+  statistics_holder_.Unregister();
+  exporter_.reset();
+}
+
+yaml_config::Schema OtlpTraceExporter::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: |
+    Component that exports the finished spans to an OpenTelemetry collector
+    in the OTLP/HTTP protobuf format.
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: OTLP/HTTP traces endpoint of the collector
+    service-name:
+        type: string
+        description: value of the `service.name` resource attribute
+    http-client:
+        type: string
+        description: name of the HttpClient component to send the spans with
+        defaultDescription: http-client
+    head-sampling-ratio:
+        type: number
+        description: fraction of the traces to export, from 0 to 1
+        defaultDescription: 1
+    tail-sampling:
+        type: object
+        description: rules to export the interesting traces that were not head-sampled
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: whether the tail sampling is enabled
+                defaultDescription: false
+            errors:
+                type: boolean
+                description: a trace with a failed span is interesting
+                defaultDescription: true
+            latency-threshold:
+                type: string
+                description: a trace with a span at least this slow is interesting, 0 to disable
+                defaultDescription: 0
+            decision-wait:
+                type: string
+                description: how long to wait for the local root span of a trace
+                defaultDescription: 5s
+            max-pending-spans:
+                type: integer
+                description: limit of the spans waiting for the decision
+                defaultDescription: 10000
+                minimum: 1
+    thread-buffer-size:
+        type: integer
+        description: capacity of each per-thread span buffer
+        defaultDescription: 1024
+        minimum: 1
+    max-queue-size:
+        type: integer
+        description: limit of the spans sent per export-interval
+        defaultDescription: 8192
+        minimum: 1
+    max-batch-size:
+        type: integer
+        description: limit of the spans per export request
+        defaultDescription: 512
+        minimum: 1
+    export-interval:
+        type: string
+        description: how often to send the spans
+        defaultDescription: 1s
+    export-timeout:
+        type: string
+        description: timeout of a single export request
+        defaultDescription: 1s
+)");
+}
+
+OtlpMetricsExporter::OtlpMetricsExporter(const ComponentConfig& config,
+                                         const ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  auto& http_client =
+      context
+          .FindComponent<HttpClient>(
+              config["http-client"].As<std::string>(HttpClient::kName))
+          .GetHttpClient();
+  auto& storage = context.FindComponent<StatisticsStorage>().GetStorage();
+
+  exporter_ = std::make_unique<tracing::impl::OtlpMetricsExporter>(
+      ParseMetricsSettings(config), storage, http_client);
+
+  statistics_holder_ = storage.RegisterWriter(
+      "otlp-metrics", [this](utils::statistics::Writer& writer) {
+        exporter_->WriteStatistics(writer);
+      });
+}
+
+OtlpMetricsExporter::~OtlpMetricsExporter() {
+  statistics_holder_.Unregister();
+  exporter_.reset();
+}
+
+yaml_config::Schema OtlpMetricsExporter::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: |
+    Component that exports the metrics to an OpenTelemetry collector
+    in the OTLP/HTTP protobuf format.
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: OTLP/HTTP metrics endpoint of the collector
+    service-name:
+        type: string
+        description: value of the `service.name` resource attribute
+    http-client:
+        type: string
+        description: name of the HttpClient component to send the metrics with
+        defaultDescription: http-client
+    max-batch-size:
+        type: integer
+        description: limit of the metrics per export request
+        defaultDescription: 1000
+        minimum: 1
+    export-interval:
+        type: string
+        description: how often to send the metrics
+        defaultDescription: 10s
+    export-timeout:
+        type: string
+        description: timeout of a single export request
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
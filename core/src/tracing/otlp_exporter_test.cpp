@@ -0,0 +1,474 @@
+#include <tracing/otlp_exporter.hpp>
+#include <tracing/otlp_metrics_exporter.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct ProtoField final {
+  int number{0};
+  std::uint64_t varint{0};
+  std::string_view bytes;
+};
+
+std::uint64_t ReadVarint(std::string_view& data) {
+  std::uint64_t result = 0;
+  for (int shift = 0; !data.empty(); shift += 7) {
+    const auto byte = static_cast<unsigned char>(data.front());
+    data.remove_prefix(1);
+    result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) break;
+  }
+  return result;
+}
+
+std::vector<ProtoField> ParseMessage(std::string_view data) {
+  std::vector<ProtoField> fields;
+  while (!data.empty()) {
+    const auto key = ReadVarint(data);
+    ProtoField field;
+    field.number = static_cast<int>(key >> 3);
+    switch (key & 7) {
+      case 0:
+        field.varint = ReadVarint(data);
+        break;
+      case 1:
+        field.bytes = data.substr(0, 8);
+        data.remove_prefix(8);
+        break;
+      case 2: {
+        const auto size = ReadVarint(data);
+        field.bytes = data.substr(0, size);
+        data.remove_prefix(size);
+        break;
+      }
+      default:
+        ADD_FAILURE() << "Unexpected wire type " << (key & 7);
+        return fields;
+    }
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+std::vector<std::string_view> GetFields(std::string_view message, int number) {
+  std::vector<std::string_view> result;
+  for (const auto& field : ParseMessage(message)) {
+    if (field.number == number) result.push_back(field.bytes);
+  }
+  return result;
+}
+
+std::uint64_t ParseFixed64(std::string_view bytes) {
+  std::uint64_t result = 0;
+  EXPECT_EQ(bytes.size(), sizeof(result));
+  std::memcpy(&result, bytes.data(), std::min(bytes.size(), sizeof(result)));
+  return result;
+}
+
+struct ReceivedSpan final {
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_span_id;
+  std::string name;
+  bool is_error{false};
+};
+
+// Stand-in for an OpenTelemetry collector, decodes just enough of OTLP
+class TestCollector final {
+ public:
+  TestCollector()
+      : server_([this](const utest::HttpServerMock::HttpRequest& request) {
+          return Handle(request);
+        }) {}
+
+  std::string GetEndpoint() const {
+    return server_.GetBaseUrl() + "/v1/traces";
+  }
+
+  std::size_t GetRequestsCount() const { return requests_count_; }
+  const std::vector<std::string>& GetServiceNames() const {
+    return service_names_;
+  }
+  const std::vector<ReceivedSpan>& GetSpans() const { return spans_; }
+
+  std::vector<std::string> GetSpanNames() const {
+    std::vector<std::string> names;
+    for (const auto& span : spans_) names.push_back(span.name);
+    return names;
+  }
+
+ private:
+  utest::HttpServerMock::HttpResponse Handle(
+      const utest::HttpServerMock::HttpRequest& request) {
+    ++requests_count_;
+    EXPECT_EQ(request.path, "/v1/traces");
+    EXPECT_EQ(request.method, clients::http::HttpMethod::kPost);
+
+    for (const auto resource_spans : GetFields(request.body, 1)) {
+      for (const auto resource : GetFields(resource_spans, 1)) {
+        for (const auto attribute : GetFields(resource, 1)) {
+          if (GetFields(attribute, 1).at(0) != "service.name") continue;
+          const auto value = GetFields(attribute, 2).at(0);
+          service_names_.emplace_back(GetFields(value, 1).at(0));
+        }
+      }
+      for (const auto scope_spans : GetFields(resource_spans, 2)) {
+        for (const auto span : GetFields(scope_spans, 2)) AddSpan(span);
+      }
+    }
+    return {200, {}, {}};
+  }
+
+  void AddSpan(std::string_view message) {
+    ReceivedSpan span;
+    for (const auto& field : ParseMessage(message)) {
+      switch (field.number) {
+        case 1:
+          span.trace_id = field.bytes;
+          break;
+        case 2:
+          span.span_id = field.bytes;
+          break;
+        case 4:
+          span.parent_span_id = field.bytes;
+          break;
+        case 5:
+          span.name = field.bytes;
+          break;
+        case 15:
+          for (const auto& status : ParseMessage(field.bytes)) {
+            if (status.number == 3 && status.varint == 2) span.is_error = true;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    spans_.push_back(std::move(span));
+  }
+
+  std::size_t requests_count_{0};
+  std::vector<std::string> service_names_;
+  std::vector<ReceivedSpan> spans_;
+  utest::HttpServerMock server_;
+};
+
+tracing::impl::OtlpExporterSettings MakeSettings(
+    const TestCollector& collector) {
+  tracing::impl::OtlpExporterSettings settings;
+  settings.endpoint = collector.GetEndpoint();
+  settings.service_name = "test-service";
+  // Only the explicit Flush() calls export the spans
+  settings.export_interval = std::chrono::hours{1};
+  settings.export_timeout = utest::kMaxTestWaitTime;
+  return settings;
+}
+
+}  // namespace
+
+UTEST(OtlpExporter, ExportsSpans) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  tracing::impl::OtlpExporter exporter{MakeSettings(collector), *http_client};
+
+  {
+    tracing::Span parent{"parent"};
+    const tracing::Span child{"child"};
+  }
+  exporter.Flush();
+
+  ASSERT_EQ(collector.GetRequestsCount(), 1);
+  EXPECT_EQ(collector.GetServiceNames(),
+            std::vector<std::string>{"test-service"});
+  ASSERT_EQ(collector.GetSpanNames(),
+            (std::vector<std::string>{"child", "parent"}));
+
+  const auto& child = collector.GetSpans()[0];
+  const auto& parent = collector.GetSpans()[1];
+  EXPECT_EQ(child.trace_id.size(), 16);
+  EXPECT_EQ(child.trace_id, parent.trace_id);
+  EXPECT_EQ(child.parent_span_id, parent.span_id);
+  EXPECT_EQ(parent.parent_span_id, "");
+  EXPECT_FALSE(child.is_error);
+
+  // The spans of the export request itself are not exported
+  exporter.Flush();
+  EXPECT_EQ(collector.GetSpans().size(), 2);
+}
+
+UTEST(OtlpExporter, Batches) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  auto settings = MakeSettings(collector);
+  settings.max_batch_size = 2;
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  for (int i = 0; i < 5; ++i) {
+    const tracing::Span span{"span"};
+  }
+  exporter.Flush();
+
+  EXPECT_EQ(collector.GetRequestsCount(), 3);
+  EXPECT_EQ(collector.GetSpans().size(), 5);
+}
+
+UTEST(OtlpExporter, SendsBatchesConcurrently) {
+  constexpr std::size_t kBatches = 3;
+
+  // Each request waits for the others, so the requests sent one by one are
+  // each held for the whole wait
+  std::size_t requests_count = 0;
+  std::size_t max_concurrent_requests = 0;
+  utest::HttpServerMock collector{
+      [&](const utest::HttpServerMock::HttpRequest&) {
+        ++requests_count;
+        const auto deadline = engine::Deadline::FromDuration(
+            std::chrono::milliseconds{500});
+        while (requests_count < kBatches && !deadline.IsReached()) {
+          engine::SleepFor(std::chrono::milliseconds{1});
+        }
+        max_concurrent_requests =
+            std::max(max_concurrent_requests, requests_count);
+        return utest::HttpServerMock::HttpResponse{200, {}, {}};
+      }};
+
+  const auto http_client = utest::CreateHttpClient();
+  tracing::impl::OtlpExporterSettings settings;
+  settings.endpoint = collector.GetBaseUrl() + "/v1/traces";
+  settings.service_name = "test-service";
+  settings.export_interval = std::chrono::hours{1};
+  settings.export_timeout = utest::kMaxTestWaitTime;
+  settings.max_batch_size = 1;
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  for (std::size_t i = 0; i < kBatches; ++i) {
+    const tracing::Span span{"span"};
+  }
+  exporter.Flush();
+
+  EXPECT_EQ(requests_count, kBatches);
+  EXPECT_EQ(max_concurrent_requests, kBatches);
+}
+
+UTEST(OtlpExporter, HeadSampling) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  auto settings = MakeSettings(collector);
+  settings.span_export.head_sampling_ratio = 0.0;
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  {
+    tracing::Span span{"not-sampled"};
+    span.AddTag(tracing::kErrorFlag, true);
+  }
+  exporter.Flush();
+
+  EXPECT_EQ(collector.GetRequestsCount(), 0);
+}
+
+UTEST(OtlpExporter, TailSampling) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  auto settings = MakeSettings(collector);
+  settings.span_export.head_sampling_ratio = 0.0;
+  settings.span_export.tail_sampling = true;
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  {
+    const tracing::Span root{"failed-root"};
+    tracing::Span child{"failed-child"};
+    child.AddTag(tracing::kErrorFlag, true);
+  }
+  {
+    const tracing::Span root{"ok-root"};
+    const tracing::Span child{"ok-child"};
+  }
+  exporter.Flush();
+
+  EXPECT_EQ(collector.GetSpanNames(),
+            (std::vector<std::string>{"failed-child", "failed-root"}));
+  ASSERT_EQ(collector.GetSpans().size(), 2);
+  EXPECT_TRUE(collector.GetSpans()[0].is_error);
+  EXPECT_FALSE(collector.GetSpans()[1].is_error);
+}
+
+UTEST(OtlpExporter, TailBufferLimit) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  auto settings = MakeSettings(collector);
+  settings.span_export.head_sampling_ratio = 0.0;
+  settings.span_export.tail_sampling = true;
+  settings.max_pending_spans = 2;
+  // Decide the traces without the local root on the first Flush()
+  settings.tail_decision_wait = std::chrono::milliseconds{0};
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "otlp", [&exporter](utils::statistics::Writer& writer) {
+        exporter.WriteStatistics(writer);
+      });
+
+  // The decided traces do not occupy the buffer
+  for (int i = 0; i < 3; ++i) {
+    const tracing::Span root{"ok-root"};
+  }
+  {
+    const tracing::Span root{"failed-root"};
+    const tracing::Span first{"first-child"};
+    tracing::Span second{"second-child"};
+    second.AddTag(tracing::kErrorFlag, true);
+  }
+  exporter.Flush();
+
+  // The buffer is limited in spans, not in traces
+  EXPECT_EQ(collector.GetSpanNames(),
+            (std::vector<std::string>{"second-child", "first-child"}));
+
+  const utils::statistics::Snapshot snapshot{storage, "otlp"};
+  EXPECT_EQ(snapshot.SingleMetric("tail-discarded-spans").AsRate(), 3);
+  EXPECT_EQ(
+      snapshot.SingleMetric("dropped-spans", {{"reason", "tail-buffer-full"}})
+          .AsRate(),
+      1);
+}
+
+UTEST(OtlpExporter, DropsOnFullBuffer) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  auto settings = MakeSettings(collector);
+  settings.span_export.thread_buffer_size = 2;
+  tracing::impl::OtlpExporter exporter{std::move(settings), *http_client};
+
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "otlp", [&exporter](utils::statistics::Writer& writer) {
+        exporter.WriteStatistics(writer);
+      });
+
+  for (int i = 0; i < 5; ++i) {
+    const tracing::Span span{"span"};
+  }
+  exporter.Flush();
+  EXPECT_EQ(collector.GetSpans().size(), 2);
+
+  const utils::statistics::Snapshot snapshot{storage, "otlp"};
+  EXPECT_EQ(snapshot.SingleMetric("exported-spans").AsRate(), 2);
+  EXPECT_EQ(
+      snapshot.SingleMetric("dropped-spans", {{"reason", "buffer-full"}})
+          .AsRate(),
+      3);
+  EXPECT_EQ(snapshot.SingleMetric("export-requests", {{"status", "ok"}})
+                .AsRate(),
+            1);
+}
+
+UTEST(OtlpExporter, DisabledAfterDestruction) {
+  TestCollector collector;
+  const auto http_client = utest::CreateHttpClient();
+  {
+    tracing::impl::OtlpExporter exporter{MakeSettings(collector),
+                                         *http_client};
+    const tracing::Span span{"exported-on-destruction"};
+  }
+  EXPECT_EQ(collector.GetSpanNames(),
+            std::vector<std::string>{"exported-on-destruction"});
+
+  const tracing::Span span{"not-exported"};
+  EXPECT_FALSE(tracing::impl::IsSpanExportEnabled());
+}
+
+UTEST(OtlpMetricsExporter, ExportsMetrics) {
+  std::vector<std::string> bodies;
+  utest::HttpServerMock collector{
+      [&bodies](const utest::HttpServerMock::HttpRequest& request) {
+        EXPECT_EQ(request.path, "/v1/metrics");
+        bodies.push_back(request.body);
+        return utest::HttpServerMock::HttpResponse{200, {}, {}};
+      }};
+
+  utils::statistics::Histogram histogram{std::vector<double>{1, 2}};
+  histogram.Account(1.5);
+  histogram.Account(10);
+
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "test", [&histogram](utils::statistics::Writer& writer) {
+        writer["gauge"] = 42;
+        writer["rate"].ValueWithLabels(utils::statistics::Rate{5},
+                                       {"label", "value"});
+        writer["histogram"] = histogram;
+      });
+
+  const auto http_client = utest::CreateHttpClient();
+  tracing::impl::OtlpMetricsExporterSettings settings;
+  settings.endpoint = collector.GetBaseUrl() + "/v1/metrics";
+  settings.service_name = "test-service";
+  settings.export_interval = std::chrono::hours{1};
+  settings.export_timeout = utest::kMaxTestWaitTime;
+  tracing::impl::OtlpMetricsExporter exporter{std::move(settings), storage,
+                                              *http_client};
+  exporter.Export();
+
+  ASSERT_EQ(bodies.size(), 1);
+  // metric name -> the data field number and the single data point
+  std::map<std::string, std::pair<int, std::string_view>> metrics;
+  for (const auto resource_metrics : GetFields(bodies[0], 1)) {
+    for (const auto scope_metrics : GetFields(resource_metrics, 2)) {
+      for (const auto metric : GetFields(scope_metrics, 2)) {
+        const auto fields = ParseMessage(metric);
+        ASSERT_EQ(fields.size(), 2);
+        const auto data_points = GetFields(fields[1].bytes, 1);
+        ASSERT_EQ(data_points.size(), 1);
+        metrics.emplace(std::string{fields[0].bytes},
+                        std::pair{fields[1].number, data_points[0]});
+      }
+    }
+  }
+  ASSERT_EQ(metrics.size(), 3);
+
+  // Gauge with as_int value
+  const auto [gauge_type, gauge] = metrics.at("test.gauge");
+  EXPECT_EQ(gauge_type, 5);
+  EXPECT_EQ(ParseFixed64(GetFields(gauge, 6).at(0)), 42);
+
+  // Sum with as_int value and the label attribute
+  const auto [rate_type, rate] = metrics.at("test.rate");
+  EXPECT_EQ(rate_type, 7);
+  EXPECT_EQ(ParseFixed64(GetFields(rate, 6).at(0)), 5);
+  const auto attribute = GetFields(rate, 7).at(0);
+  EXPECT_EQ(GetFields(attribute, 1).at(0), "label");
+  EXPECT_EQ(GetFields(GetFields(attribute, 2).at(0), 1).at(0), "value");
+
+  // Histogram with the count and the packed bucket counts
+  const auto [histogram_type, histogram_point] = metrics.at("test.histogram");
+  EXPECT_EQ(histogram_type, 9);
+  EXPECT_EQ(ParseFixed64(GetFields(histogram_point, 4).at(0)), 2);
+  const auto buckets = GetFields(histogram_point, 6).at(0);
+  ASSERT_EQ(buckets.size(), 3 * sizeof(std::uint64_t));
+  EXPECT_EQ(ParseFixed64(buckets.substr(0, 8)), 0);
+  EXPECT_EQ(ParseFixed64(buckets.substr(8, 8)), 1);
+  EXPECT_EQ(ParseFixed64(buckets.substr(16, 8)), 1);
+}
+
+USERVER_NAMESPACE_END
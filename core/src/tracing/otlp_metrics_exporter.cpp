@@ -0,0 +1,296 @@
+#include <tracing/otlp_metrics_exporter.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/overloaded.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <tracing/otlp_common.hpp>
+#include <tracing/span_export.hpp>
+#include <utils/impl/proto_writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+using utils::impl::ProtoWriter;
+
+// Field numbers of
+// opentelemetry/proto/collector/metrics/v1/metrics_service.proto
+// and the messages it refers to
+namespace proto {
+
+constexpr int kRequestResourceMetrics = 1;
+
+constexpr int kResourceMetricsResource = 1;
+constexpr int kResourceMetricsScopeMetrics = 2;
+
+constexpr int kScopeMetricsScope = 1;
+constexpr int kScopeMetricsMetrics = 2;
+
+constexpr int kMetricName = 1;
+constexpr int kMetricGauge = 5;
+constexpr int kMetricSum = 7;
+constexpr int kMetricHistogram = 9;
+
+constexpr int kDataPoints = 1;
+constexpr int kAggregationTemporality = 2;
+constexpr int kSumIsMonotonic = 3;
+
+constexpr int kTemporalityCumulative = 2;
+
+constexpr int kNumberStartTime = 2;
+constexpr int kNumberTime = 3;
+constexpr int kNumberAsDouble = 4;
+constexpr int kNumberAsInt = 6;
+constexpr int kNumberAttributes = 7;
+
+constexpr int kHistogramStartTime = 2;
+constexpr int kHistogramTime = 3;
+constexpr int kHistogramCount = 4;
+constexpr int kHistogramBucketCounts = 6;
+constexpr int kHistogramExplicitBounds = 7;
+constexpr int kHistogramAttributes = 9;
+
+}  // namespace proto
+
+// Groups the data points by the metric name and serializes them into the OTLP
+// Metric messages
+class MetricsBuilder final : public utils::statistics::BaseFormatBuilder {
+ public:
+  MetricsBuilder(std::uint64_t start_time, std::uint64_t time)
+      : start_time_(start_time), time_(time) {}
+
+  void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
+                    const utils::statistics::MetricValue& value) override {
+    auto& data_points = GetDataPoints(path);
+    value.Visit(utils::Overloaded{
+        [&](std::int64_t number) {
+          auto point = MakeNumberPoint(labels, false);
+          point.WriteFixed64(proto::kNumberAsInt,
+                             static_cast<std::uint64_t>(number));
+          data_points.gauge.push_back(std::move(point).Extract());
+        },
+        [&](double number) {
+          auto point = MakeNumberPoint(labels, false);
+          point.WriteDouble(proto::kNumberAsDouble, number);
+          data_points.gauge.push_back(std::move(point).Extract());
+        },
+        [&](utils::statistics::Rate rate) {
+          auto point = MakeNumberPoint(labels, true);
+          point.WriteFixed64(proto::kNumberAsInt, rate.value);
+          data_points.sum.push_back(std::move(point).Extract());
+        },
+        [&](utils::statistics::HistogramView histogram) {
+          data_points.histogram.push_back(
+              SerializeHistogramPoint(labels, histogram));
+        }});
+  }
+
+  std::vector<std::string> ExtractMetrics() && {
+    std::vector<std::string> metrics;
+    for (const auto& [name, data_points] : data_points_) {
+      if (!data_points.gauge.empty()) {
+        metrics.push_back(SerializeMetric(
+            name, proto::kMetricGauge,
+            SerializeData(data_points.gauge, false)));
+      }
+      if (!data_points.sum.empty()) {
+        metrics.push_back(SerializeMetric(
+            name, proto::kMetricSum, SerializeData(data_points.sum, true)));
+      }
+      if (!data_points.histogram.empty()) {
+        metrics.push_back(SerializeMetric(
+            name, proto::kMetricHistogram,
+            SerializeData(data_points.histogram, true)));
+      }
+    }
+    return metrics;
+  }
+
+ private:
+  // A metric path may have values of different types with different labels
+  struct DataPoints final {
+    std::vector<std::string> gauge;
+    std::vector<std::string> sum;
+    std::vector<std::string> histogram;
+  };
+
+  DataPoints& GetDataPoints(std::string_view path) {
+    if (auto* const data_points =
+            utils::impl::FindTransparentOrNullptr(data_points_, path)) {
+      return *data_points;
+    }
+    return data_points_.emplace(std::string{path}, DataPoints{}).first->second;
+  }
+
+  ProtoWriter MakeNumberPoint(utils::statistics::LabelsSpan labels,
+                              bool is_cumulative) const {
+    ProtoWriter point;
+    for (const auto& label : labels) {
+      point.WriteBytes(proto::kNumberAttributes,
+                       SerializeOtlpAttribute(label.Name(),
+                                              std::string{label.Value()}));
+    }
+    if (is_cumulative) point.WriteFixed64(proto::kNumberStartTime, start_time_);
+    point.WriteFixed64(proto::kNumberTime, time_);
+    return point;
+  }
+
+  std::string SerializeHistogramPoint(
+      utils::statistics::LabelsSpan labels,
+      utils::statistics::HistogramView histogram) const {
+    const auto bucket_count = histogram.GetBucketCount();
+    std::vector<std::uint64_t> counts;
+    std::vector<double> bounds;
+    counts.reserve(bucket_count + 1);
+    bounds.reserve(bucket_count);
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts.push_back(histogram.GetValueAt(i));
+      bounds.push_back(histogram.GetUpperBoundAt(i));
+    }
+    counts.push_back(histogram.GetValueAtInf());
+
+    ProtoWriter point;
+    for (const auto& label : labels) {
+      point.WriteBytes(proto::kHistogramAttributes,
+                       SerializeOtlpAttribute(label.Name(),
+                                              std::string{label.Value()}));
+    }
+    point.WriteFixed64(proto::kHistogramStartTime, start_time_);
+    point.WriteFixed64(proto::kHistogramTime, time_);
+    point.WriteFixed64(proto::kHistogramCount, histogram.GetTotalCount());
+    point.WritePackedFixed64(proto::kHistogramBucketCounts, counts);
+    point.WritePackedDouble(proto::kHistogramExplicitBounds, bounds);
+    return std::move(point).Extract();
+  }
+
+  static std::string SerializeData(const std::vector<std::string>& data_points,
+                                   bool is_cumulative) {
+    ProtoWriter data;
+    for (const auto& point : data_points) {
+      data.WriteBytes(proto::kDataPoints, point);
+    }
+    if (is_cumulative) {
+      data.WriteUint(proto::kAggregationTemporality,
+                     proto::kTemporalityCumulative);
+    }
+    return std::move(data).Extract();
+  }
+
+  static std::string SerializeMetric(std::string_view name, int data_field,
+                                     std::string_view data) {
+    ProtoWriter metric;
+    metric.WriteBytes(proto::kMetricName, name);
+    metric.WriteBytes(data_field, data);
+    return std::move(metric).Extract();
+  }
+
+  const std::uint64_t start_time_;
+  const std::uint64_t time_;
+  utils::impl::TransparentMap<std::string, DataPoints> data_points_;
+};
+
+std::string SerializeOtlpMetrics(std::string_view service_name,
+                                 std::vector<std::string>::const_iterator begin,
+                                 std::vector<std::string>::const_iterator end) {
+  ProtoWriter scope_metrics;
+  scope_metrics.WriteBytes(proto::kScopeMetricsScope, SerializeOtlpScope());
+  for (auto it = begin; it != end; ++it) {
+    scope_metrics.WriteBytes(proto::kScopeMetricsMetrics, *it);
+  }
+
+  ProtoWriter resource_metrics;
+  resource_metrics.WriteBytes(proto::kResourceMetricsResource,
+                              SerializeOtlpResource(service_name));
+  resource_metrics.WriteBytes(proto::kResourceMetricsScopeMetrics,
+                              std::move(scope_metrics).Extract());
+
+  ProtoWriter request;
+  request.WriteBytes(proto::kRequestResourceMetrics,
+                     std::move(resource_metrics).Extract());
+  return std::move(request).Extract();
+}
+
+}  // namespace
+
+OtlpMetricsExporter::OtlpMetricsExporter(
+    OtlpMetricsExporterSettings settings,
+    const utils::statistics::Storage& storage,
+    clients::http::Client& http_client)
+    : settings_(std::move(settings)),
+      storage_(storage),
+      http_client_(http_client),
+      start_time_(std::chrono::system_clock::now()) {
+  UINVARIANT(settings_.max_batch_size != 0,
+             "OTLP export batch size must be positive");
+
+  export_task_.Start("otlp-metrics-exporter", settings_.export_interval,
+                     [this] { Export(); });
+}
+
+OtlpMetricsExporter::~OtlpMetricsExporter() { export_task_.Stop(); }
+
+void OtlpMetricsExporter::Export() {
+  // The spans of the export requests are not exported
+  const tracing::Span export_span{"otlp_metrics_export", ReferenceType::kChild,
+                                  logging::Level::kTrace};
+  DisableCurrentSpanExport();
+
+  MetricsBuilder builder{ToOtlpTime(start_time_),
+                         ToOtlpTime(std::chrono::system_clock::now())};
+  storage_.VisitMetrics(builder);
+  const auto metrics = std::move(builder).ExtractMetrics();
+
+  std::vector<std::size_t> batch_sizes;
+  std::vector<std::string> requests;
+  for (auto begin = metrics.begin(); begin != metrics.end();) {
+    const auto end =
+        begin + std::min<std::ptrdiff_t>(settings_.max_batch_size,
+                                         std::distance(begin, metrics.end()));
+    batch_sizes.push_back(std::distance(begin, end));
+    requests.push_back(
+        SerializeOtlpMetrics(settings_.service_name, begin, end));
+    begin = end;
+  }
+
+  const auto accepted =
+      SendOtlpRequests(http_client_, settings_.endpoint, std::move(requests),
+                       settings_.export_timeout);
+  for (std::size_t i = 0; i < accepted.size(); ++i) {
+    const utils::statistics::Rate size{batch_sizes[i]};
+    if (accepted[i]) {
+      ++stats_.requests_ok;
+      stats_.exported += size;
+    } else {
+      ++stats_.requests_failed;
+      stats_.dropped_export_failed += size;
+    }
+  }
+}
+
+void OtlpMetricsExporter::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  writer["exported-metrics"] = stats_.exported;
+  writer["dropped-metrics"].ValueWithLabels(stats_.dropped_export_failed,
+                                            {"reason", "export-failed"});
+
+  auto requests = writer["export-requests"];
+  requests.ValueWithLabels(stats_.requests_ok, {"status", "ok"});
+  requests.ValueWithLabels(stats_.requests_failed, {"status", "error"});
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
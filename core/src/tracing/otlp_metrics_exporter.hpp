@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+class Client;
+}  // namespace clients::http
+
+namespace utils::statistics {
+class Storage;
+class Writer;
+}  // namespace utils::statistics
+
+namespace tracing::impl {
+
+struct OtlpMetricsExporterSettings final {
+  // OTLP/HTTP metrics endpoint, e.g. http://localhost:4318/v1/metrics
+  std::string endpoint;
+  std::string service_name;
+
+  // Limit of the metrics (names) per export request
+  std::size_t max_batch_size{1000};
+  std::chrono::milliseconds export_interval{10000};
+  std::chrono::milliseconds export_timeout{1000};
+};
+
+// Exports the metrics of utils::statistics::Storage to an OpenTelemetry
+// collector over OTLP/HTTP from a background task.
+//
+// utils::statistics::Rate metrics are exported as cumulative monotonic sums,
+// histograms as explicit bucket histograms, other metrics as gauges. The
+// metric labels become the data point attributes.
+class OtlpMetricsExporter final {
+ public:
+  OtlpMetricsExporter(OtlpMetricsExporterSettings settings,
+                      const utils::statistics::Storage& storage,
+                      clients::http::Client& http_client);
+  ~OtlpMetricsExporter();
+
+  OtlpMetricsExporter(const OtlpMetricsExporter&) = delete;
+  OtlpMetricsExporter& operator=(const OtlpMetricsExporter&) = delete;
+
+  // Sends the current values of the metrics to the collector. Called
+  // periodically, may be called manually.
+  void Export();
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  struct Statistics final {
+    utils::statistics::RateCounter exported;
+    utils::statistics::RateCounter dropped_export_failed;
+    utils::statistics::RateCounter requests_ok;
+    utils::statistics::RateCounter requests_failed;
+  };
+
+  const OtlpMetricsExporterSettings settings_;
+  const utils::statistics::Storage& storage_;
+  clients::http::Client& http_client_;
+  // The start of the cumulative sums
+  const std::chrono::system_clock::time_point start_time_;
+
+  Statistics stats_;
+  utils::PeriodicTask export_task_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -7,14 +7,14 @@
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <tracing/span_export.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/encoding/hex.hpp>
-#include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 #include <utils/internal_tag.hpp>
 
@@ -62,34 +62,74 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
-std::string GenerateSpanId() {
-  std::uniform_int_distribution<std::uint64_t> dist;
-  const auto random_value = utils::WithDefaultRandom(dist);
+// Span::Impl is large due to the inline storage of LogExtra, and the spans
+// are created and destroyed at a high rate, mostly on the same thread
+class ImplPool final {
+ public:
+  ImplPool() = default;
+  ImplPool(ImplPool&&) = delete;
+  ImplPool& operator=(ImplPool&&) = delete;
+
+  ~ImplPool() {
+    while (free_list_) {
+      auto* const next = free_list_->next;
+      ::operator delete(free_list_);
+      free_list_ = next;
+    }
+  }
 
-  static_assert(sizeof(random_value) == 8);
-  return utils::encoding::ToHex(&random_value, 8);
-}
+  void* Allocate() {
+    if (!free_list_) return ::operator new(sizeof(Span::Impl));
+    auto* const block = free_list_;
+    free_list_ = block->next;
+    --size_;
+    return block;
+  }
+
+  void Deallocate(void* ptr) noexcept {
+    if (size_ == kMaxSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    free_list_ = new (ptr) FreeBlock{free_list_};
+    ++size_;
+  }
+
+ private:
+  static constexpr std::size_t kMaxSize = 64;
+
+  struct FreeBlock final {
+    FreeBlock* next;
+  };
+
+  FreeBlock* free_list_{nullptr};
+  std::size_t size_{0};
+};
+
+compiler::ThreadLocal local_impl_pool = [] { return ImplPool{}; };
 
 }  // namespace
 
 Span::Impl::Impl(std::string name, ReferenceType reference_type,
                  logging::Level log_level,
                  utils::impl::SourceLocation source_location)
-    : Impl(tracing::Tracer::GetTracer(), std::move(name), GetParentSpanImpl(),
+    : Impl(impl::TracerHandle::Global(), std::move(name), GetParentSpanImpl(),
            reference_type, log_level, source_location) {}
 
-Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
-                 ReferenceType reference_type, logging::Level log_level,
+Span::Impl::Impl(impl::TracerHandle tracer, std::string name,
+                 const Span::Impl* parent, ReferenceType reference_type,
+                 logging::Level log_level,
                  utils::impl::SourceLocation source_location)
     : name_(std::move(name)),
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
+      is_local_root_(parent == nullptr),
+      is_export_suppressed_(parent && parent->is_export_suppressed_),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
-      span_id_(GenerateSpanId()),
+      trace_id_(parent ? parent->trace_id_ : impl::TraceId::Generate()),
+      span_id_(impl::SpanId::Generate()),
       parent_id_(GetParentIdForLogging(parent)),
       reference_type_(reference_type),
       source_location_(source_location) {
@@ -99,7 +139,28 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
   }
 }
 
+void* Span::Impl::operator new(std::size_t size) {
+  UASSERT(size == sizeof(Span::Impl));
+  auto pool = local_impl_pool.Use();
+  return pool->Allocate();
+}
+
+void Span::Impl::operator delete(void* ptr) noexcept {
+  auto pool = local_impl_pool.Use();
+  pool->Deallocate(ptr);
+}
+
 Span::Impl::~Impl() {
+  if (!is_no_log_span_ && !is_export_suppressed_ &&
+      impl::IsSpanExportEnabled()) {
+    try {
+      PushForExport();
+    } catch (const std::exception& ex) {
+      const DetachLocalSpansScope ignore_local_span;
+      LOG_LIMITED_ERROR() << "Failed to export span '" << name_ << "': " << ex;
+    }
+  }
+
   if (!ShouldLog()) {
     return;
   }
@@ -153,11 +214,11 @@ void Span::Impl::AttachToCoroStack() {
   task_local_spans->push_back(*this);
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::SpanId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   if (!parent) return {};
 
   if (!parent->is_linked()) {
-    return parent->GetSpanId();
+    return parent->span_id_;
   }
 
   const auto* spans_ptr = task_local_spans.GetOptional();
@@ -170,9 +231,9 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   // orphaned. It's still possible for chaining to break in case parent span
   // becomes non-loggable after child span is created, but that we can't control
   for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-    if (current->GetParentId().empty() /* won't find better candidate */ ||
+    if (current->parent_id_.IsEmpty() /* won't find better candidate */ ||
         current->ShouldLog()) {
-      return current->GetSpanId();
+      return current->span_id_;
     }
     if (current == spans_ptr->begin()) break;
   }
@@ -203,29 +264,31 @@ Span::OptionalDeleter Span::OptionalDeleter::ShouldDelete() noexcept {
   return OptionalDeleter(true);
 }
 
-Span::Span(TracerPtr tracer, std::string name, const Span* parent,
+Span::Span(impl::TracerHandle&& tracer, std::string name, const Impl* parent,
            ReferenceType reference_type, logging::Level log_level,
            utils::impl::SourceLocation source_location)
-    : pimpl_(AllocateImpl(std::move(tracer), std::move(name),
-                          parent ? parent->pimpl_.get() : nullptr,
+    : pimpl_(AllocateImpl(std::move(tracer), std::move(name), parent,
                           reference_type, log_level, source_location),
              Span::OptionalDeleter{Span::OptionalDeleter::ShouldDelete()}) {
   AttachToCoroStack();
   pimpl_->span_ = this;
 }
 
+Span::Span(TracerPtr tracer, std::string name, const Span* parent,
+           ReferenceType reference_type, logging::Level log_level,
+           utils::impl::SourceLocation source_location)
+    : Span(impl::TracerHandle{std::move(tracer)}, std::move(name),
+           parent ? parent->pimpl_.get() : nullptr, reference_type, log_level,
+           source_location) {}
+
 Span::Span(std::string name, ReferenceType reference_type,
            logging::Level log_level,
            utils::impl::SourceLocation source_location)
-    : pimpl_(AllocateImpl(tracing::Tracer::GetTracer(), std::move(name),
-                          GetParentSpanImpl(), reference_type, log_level,
-                          source_location),
-             Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}) {
-  AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+    : Span(impl::TracerHandle::Global(), std::move(name), GetParentSpanImpl(),
+           reference_type, log_level, source_location) {
+  if (pimpl_->GetParentIdValue().IsEmpty()) {
     SetLink(utils::generators::GenerateUuid());
   }
-  pimpl_->span_ = this;
 }
 
 Span::Span(Span::Impl& impl)
@@ -278,8 +341,9 @@ Span Span::MakeSpan(std::string name, std::string_view trace_id,
 
 Span Span::MakeSpan(std::string name, std::string_view trace_id,
                     std::string_view parent_span_id, std::string link) {
-  Span span(Tracer::GetTracer(), std::move(name), nullptr,
-            ReferenceType::kChild);
+  Span span(impl::TracerHandle::Global(), std::move(name), nullptr,
+            ReferenceType::kChild, logging::Level::kInfo,
+            utils::impl::SourceLocation::Current());
   span.SetLink(std::move(link));
   if (!trace_id.empty()) span.pimpl_->SetTraceId(std::string{trace_id});
   span.pimpl_->SetParentId(std::string{parent_span_id});
@@ -287,22 +351,23 @@ Span Span::MakeSpan(std::string name, std::string_view trace_id,
 }
 
 Span Span::MakeRootSpan(std::string name, logging::Level log_level) {
-  Span span(Tracer::GetTracer(), std::move(name), nullptr,
-            ReferenceType::kChild, log_level);
+  Span span(impl::TracerHandle::Global(), std::move(name), nullptr,
+            ReferenceType::kChild, log_level,
+            utils::impl::SourceLocation::Current());
   span.SetLink(utils::generators::GenerateUuid());
   return span;
 }
 
 Span Span::CreateChild(std::string name) const {
-  auto span = pimpl_->tracer_->CreateSpan(std::move(name), *this,
-                                          ReferenceType::kChild);
-  return span;
+  return Span(impl::TracerHandle{pimpl_->tracer_}, std::move(name),
+              pimpl_.get(), ReferenceType::kChild, logging::Level::kInfo,
+              utils::impl::SourceLocation::Current());
 }
 
 Span Span::CreateFollower(std::string name) const {
-  auto span = pimpl_->tracer_->CreateSpan(std::move(name), *this,
-                                          ReferenceType::kReference);
-  return span;
+  return Span(impl::TracerHandle{pimpl_->tracer_}, std::move(name),
+              pimpl_.get(), ReferenceType::kReference, logging::Level::kInfo,
+              utils::impl::SourceLocation::Current());
 }
 
 tracing::ScopeTime Span::CreateScopeTime() {
@@ -421,6 +486,17 @@ const Span::Impl* GetParentSpanImpl() {
   return !spans_ptr || spans_ptr->empty() ? nullptr : &spans_ptr->back();
 }
 
+namespace impl {
+
+void DisableCurrentSpanExport() noexcept {
+  if (!engine::current_task::IsTaskProcessorThread()) return;
+
+  auto* const spans_ptr = task_local_spans.GetOptional();
+  if (spans_ptr && !spans_ptr->empty()) spans_ptr->back().DisableExport();
+}
+
+}  // namespace impl
+
 DetachLocalSpansScope::DetachLocalSpansScope() noexcept {
   if (engine::current_task::IsTaskProcessorThread()) {
     if (auto* const spans_ptr = task_local_spans.GetOptional()) {
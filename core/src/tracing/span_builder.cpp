@@ -11,12 +11,12 @@ namespace tracing {
 
 SpanBuilder::SpanBuilder(std::string name,
                          const utils::impl::SourceLocation& location)
-    : pimpl_(AllocateImpl(tracing::Tracer::GetTracer(), std::move(name),
+    : pimpl_(AllocateImpl(impl::TracerHandle::Global(), std::move(name),
                           GetParentSpanImpl(), ReferenceType::kChild,
                           logging::Level::kInfo, location),
              Span::OptionalDeleter{Span::OptionalDeleter::ShouldDelete()}) {
   pimpl_->AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+  if (pimpl_->GetParentIdValue().IsEmpty()) {
     AddTagFrozen(kLinkTag, utils::generators::GenerateUuid());
   }
 }
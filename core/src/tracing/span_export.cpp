@@ -0,0 +1,173 @@
+#include <tracing/span_export.hpp>
+
+#include <variant>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/overloaded.hpp>
+
+#include <tracing/span_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace impl {
+
+namespace {
+
+struct GlobalExportState final {
+  std::mutex mutex;
+  std::shared_ptr<SpanExportSink> sink;
+  std::uint64_t last_generation{0};
+  // 0 if there is no sink, changes on each SetSpanExportSink call
+  std::atomic<std::uint64_t> generation{0};
+};
+
+GlobalExportState& GetGlobalExportState() {
+  // Spans may be finished by threads that outlive static destruction
+  static auto& state = *new GlobalExportState();
+  return state;
+}
+
+struct ThreadExportState final {
+  std::uint64_t generation{0};
+  SpanExportSettings settings;
+  std::shared_ptr<SpanRingBuffer> buffer;
+
+  // Returns false if the export is disabled
+  bool Refresh() {
+    auto& global = GetGlobalExportState();
+    if (generation == global.generation.load(std::memory_order_acquire)) {
+      return buffer != nullptr;
+    }
+
+    const std::lock_guard lock{global.mutex};
+    generation = global.generation.load(std::memory_order_relaxed);
+    if (!global.sink) {
+      buffer.reset();
+      return false;
+    }
+    settings = global.sink->GetSettings();
+    buffer = global.sink->AddThreadBuffer();
+    return true;
+  }
+};
+
+compiler::ThreadLocal local_export_state = [] { return ThreadExportState{}; };
+
+bool IsTruthy(const logging::LogExtra::Value& value) {
+  return std::visit(
+      utils::Overloaded{
+          [](const std::string& str) { return str == "true" || str == "1"; },
+          [](const auto& number) { return number != 0; }},
+      value);
+}
+
+}  // namespace
+
+SpanRingBuffer::SpanRingBuffer(std::size_t capacity) : slots_(capacity) {
+  UINVARIANT(capacity != 0, "Span buffer capacity must be positive");
+}
+
+void SpanRingBuffer::PopAll(std::vector<ExportedSpan>& out) {
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  const auto head = head_.load(std::memory_order_acquire);
+  for (auto i = tail; i != head; ++i) {
+    out.push_back(std::move(slots_[i % slots_.size()]));
+  }
+  tail_.store(head, std::memory_order_release);
+}
+
+SpanExportSink::SpanExportSink(SpanExportSettings settings)
+    : settings_(settings) {}
+
+std::shared_ptr<SpanRingBuffer> SpanExportSink::AddThreadBuffer() {
+  auto buffer = std::make_shared<SpanRingBuffer>(settings_.thread_buffer_size);
+  const std::lock_guard lock{mutex_};
+  buffers_.push_back(buffer);
+  return buffer;
+}
+
+void SpanExportSink::Drain(std::vector<ExportedSpan>& out) {
+  const std::lock_guard lock{mutex_};
+  for (const auto& buffer : buffers_) buffer->PopAll(out);
+}
+
+std::uint64_t SpanExportSink::GetDroppedCount() const {
+  const std::lock_guard lock{mutex_};
+  std::uint64_t dropped = 0;
+  for (const auto& buffer : buffers_) dropped += buffer->GetDroppedCount();
+  return dropped;
+}
+
+void SetSpanExportSink(std::shared_ptr<SpanExportSink> sink) {
+  auto& global = GetGlobalExportState();
+  const std::lock_guard lock{global.mutex};
+  global.generation.store(sink ? ++global.last_generation : 0,
+                          std::memory_order_release);
+  global.sink = std::move(sink);
+}
+
+bool IsSpanExportEnabled() noexcept {
+  return GetGlobalExportState().generation.load(std::memory_order_relaxed) !=
+         0;
+}
+
+bool IsHeadSampled(const std::array<std::uint8_t, 16>& trace_id,
+                   double ratio) noexcept {
+  if (ratio >= 1.0) return true;
+  if (ratio <= 0.0) return false;
+
+  // The trailing bytes are random both in the userver and in the W3C ids
+  std::uint64_t value = 0;
+  for (std::size_t i = 8; i < trace_id.size(); ++i) {
+    value = (value << 8) | trace_id[i];
+  }
+  constexpr double kTwoPow64 = 18446744073709551616.0;
+  return value < static_cast<std::uint64_t>(ratio * kTwoPow64);
+}
+
+}  // namespace impl
+
+void Span::Impl::PushForExport() const {
+  auto state = impl::local_export_state.Use();
+  if (!state->Refresh()) return;
+
+  auto trace_id = trace_id_.ToBytes();
+  const bool is_head_sampled =
+      impl::IsHeadSampled(trace_id, state->settings.head_sampling_ratio);
+  if (!is_head_sampled && !state->settings.tail_sampling) return;
+
+  state->buffer->Push([&] {
+    impl::ExportedSpan span;
+    span.trace_id = trace_id;
+    span.span_id = span_id_.ToBytes();
+    if (!parent_id_.IsEmpty()) span.parent_span_id = parent_id_.ToBytes();
+    span.name = name_;
+    span.start_time = start_system_time_;
+    span.duration = std::chrono::steady_clock::now() - start_steady_time_;
+    span.is_local_root = is_local_root_;
+    span.is_head_sampled = is_head_sampled;
+
+    const auto add_attributes = [&span](const logging::LogExtra& log_extra) {
+      for (const auto& [key, value] : *log_extra.extra_) {
+        if (key == kErrorFlag) {
+          span.is_error = span.is_error || impl::IsTruthy(value.GetValue());
+        } else {
+          span.attributes.emplace_back(key, value.GetValue());
+        }
+      }
+    };
+    add_attributes(log_extra_inheritable_);
+    if (log_extra_local_) add_attributes(*log_extra_local_);
+    return span;
+  });
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+// A finished span in the form suitable for the binary export protocols
+struct ExportedSpan final {
+  std::array<std::uint8_t, 16> trace_id{};
+  std::array<std::uint8_t, 8> span_id{};
+  // All zeroes if the span has no parent
+  std::array<std::uint8_t, 8> parent_span_id{};
+  std::string name;
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::nanoseconds duration{};
+  std::vector<logging::LogExtra::Pair> attributes;
+  // The span has no parent in this process, e.g. a request handling span
+  bool is_local_root{false};
+  bool is_error{false};
+  bool is_head_sampled{false};
+};
+
+struct SpanExportSettings final {
+  // Fraction of the traces that are exported as a whole, the decision is
+  // made by the trace id, so all the services with the same ratio export
+  // the same traces
+  double head_sampling_ratio{1.0};
+  // Pass the spans of the traces that are not head-sampled to the exporter,
+  // so that it could pick the interesting traces after they finish
+  bool tail_sampling{false};
+  // Capacity of each per-thread span buffer
+  std::size_t thread_buffer_size{1024};
+};
+
+// Bounded single producer single consumer queue of the finished spans. The
+// producer is the thread that owns the buffer, the consumer is the exporter.
+class SpanRingBuffer final {
+ public:
+  explicit SpanRingBuffer(std::size_t capacity);
+
+  // Producer side. Calls `factory` only if there is room for one more span,
+  // otherwise counts the span as dropped.
+  template <typename Factory>
+  void Push(Factory&& factory) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= slots_.size()) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    slots_[head % slots_.size()] = factory();
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Consumer side. Moves all the buffered spans into `out`.
+  void PopAll(std::vector<ExportedSpan>& out);
+
+  std::uint64_t GetDroppedCount() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::vector<ExportedSpan> slots_;
+  alignas(64) std::atomic<std::uint64_t> head_{0};
+  alignas(64) std::atomic<std::uint64_t> tail_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+};
+
+// Collects the finished spans of all the threads while installed via
+// SetSpanExportSink
+class SpanExportSink final {
+ public:
+  explicit SpanExportSink(SpanExportSettings settings);
+
+  const SpanExportSettings& GetSettings() const noexcept { return settings_; }
+
+  // Called once per thread and sink, thread-safe
+  std::shared_ptr<SpanRingBuffer> AddThreadBuffer();
+
+  // Moves the spans from all the thread buffers into `out`, must not be
+  // called concurrently
+  void Drain(std::vector<ExportedSpan>& out);
+
+  // Spans lost due to full thread buffers
+  std::uint64_t GetDroppedCount() const;
+
+ private:
+  const SpanExportSettings settings_;
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<SpanRingBuffer>> buffers_;
+};
+
+// Installs the sink for the spans finished from now on, nullptr disables the
+// export. The spans are not exported at all by default.
+void SetSpanExportSink(std::shared_ptr<SpanExportSink> sink);
+
+// Cheap check for the span destructor
+bool IsSpanExportEnabled() noexcept;
+
+// Whether the trace falls into the `ratio` of the head-sampled traces
+bool IsHeadSampled(const std::array<std::uint8_t, 16>& trace_id,
+                   double ratio) noexcept;
+
+// The current span of the current task and the spans created under it are not
+// exported, e.g. for the exporter not to export its own requests
+void DisableCurrentSpanExport() noexcept;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -18,7 +18,9 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/impl/source_location.hpp>
 
+#include <tracing/hex_id.hpp>
 #include <tracing/time_storage.hpp>
+#include <tracing/tracer_handle.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -37,7 +39,7 @@ class Span::Impl
                 utils::impl::SourceLocation source_location =
                     utils::impl::SourceLocation::Current());
 
-  Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
+  Impl(impl::TracerHandle tracer, std::string name, const Span::Impl* parent,
        ReferenceType reference_type, logging::Level log_level,
        utils::impl::SourceLocation source_location);
 
@@ -45,6 +47,10 @@ class Span::Impl
 
   ~Impl();
 
+  // Recycled through a per-thread pool
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   impl::TimeStorage& GetTimeStorage() { return time_storage_; }
   const impl::TimeStorage& GetTimeStorage() const { return time_storage_; }
 
@@ -54,38 +60,51 @@ class Span::Impl
   // Add the context of this Span a non-Span-specific log record
   void LogTo(logging::impl::TagWriter writer);
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
-  const std::string& GetSpanId() const& noexcept { return span_id_; }
-  const std::string& GetParentId() const& noexcept { return parent_id_; }
+  // Render the ids on the first call
+  const std::string& GetTraceId() const { return trace_id_.ToString(); }
+  const std::string& GetSpanId() const { return span_id_.ToString(); }
+  const std::string& GetParentId() const { return parent_id_.ToString(); }
 
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-  std::string GetSpanId() && noexcept { return std::move(span_id_); }
-  std::string GetParentId() && noexcept { return std::move(parent_id_); }
+  const impl::TraceId& GetTraceIdValue() const noexcept { return trace_id_; }
+  const impl::SpanId& GetSpanIdValue() const noexcept { return span_id_; }
+  const impl::SpanId& GetParentIdValue() const noexcept { return parent_id_; }
 
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-  void SetSpanId(std::string&& id) noexcept { span_id_ = std::move(id); }
-  void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+  void SetTraceId(std::string&& id) {
+    trace_id_ = impl::TraceId{std::move(id)};
+  }
+  void SetSpanId(std::string&& id) { span_id_ = impl::SpanId{std::move(id)}; }
+  void SetParentId(std::string&& id) {
+    parent_id_ = impl::SpanId{std::move(id)};
+  }
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
   void DetachFromCoroStack();
   void AttachToCoroStack();
 
+  // Inherited by the child spans created afterwards
+  void DisableExport() noexcept { is_export_suppressed_ = true; }
+
  private:
   void LogOpenTracing() const;
   void DoLogOpenTracing(logging::impl::TagWriter writer) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
 
-  static std::string GetParentIdForLogging(const Span::Impl* parent);
+  // Hands the finished span over to the installed impl::SpanExportSink
+  void PushForExport() const;
+
+  static impl::SpanId GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
   const std::string name_;
   const bool is_no_log_span_;
+  const bool is_local_root_;
+  bool is_export_suppressed_;
   logging::Level log_level_;
   std::optional<logging::Level> local_log_level_;
 
-  std::shared_ptr<Tracer> tracer_;
+  impl::TracerHandle tracer_;
   logging::LogExtra log_extra_inheritable_;
 
   Span* span_{nullptr};
@@ -96,9 +115,9 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
-  std::string span_id_;
-  std::string parent_id_;
+  impl::TraceId trace_id_;
+  impl::SpanId span_id_;
+  impl::SpanId parent_id_;
   const ReferenceType reference_type_;
   utils::impl::SourceLocation source_location_;
 
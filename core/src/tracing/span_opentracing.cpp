@@ -104,9 +104,12 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
   if (tracer_) {
     writer.PutTag(jaeger::kServiceName, tracer_->GetServiceName());
   }
-  writer.PutTag(jaeger::kTraceId, trace_id_);
-  writer.PutTag(jaeger::kParentId, parent_id_);
-  writer.PutTag(jaeger::kSpanId, span_id_);
+  impl::TraceId::Buffer trace_id_buffer;
+  impl::SpanId::Buffer span_id_buffer;
+  impl::SpanId::Buffer parent_id_buffer;
+  writer.PutTag(jaeger::kTraceId, trace_id_.ToStringView(trace_id_buffer));
+  writer.PutTag(jaeger::kParentId, parent_id_.ToStringView(parent_id_buffer));
+  writer.PutTag(jaeger::kSpanId, span_id_.ToStringView(span_id_buffer));
   writer.PutTag(jaeger::kStartTime, start_time);
   writer.PutTag(jaeger::kStartTimeMillis, start_time / 1000);
   writer.PutTag(jaeger::kDuration, duration_microseconds);
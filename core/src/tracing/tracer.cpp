@@ -1,6 +1,8 @@
 #include <userver/tracing/tracer.hpp>
 
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -8,6 +10,7 @@
 
 #include <tracing/no_log_spans.hpp>
 #include <tracing/span_impl.hpp>
+#include <tracing/tracer_handle.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,9 +33,15 @@ class NoopTracer final : public Tracer {
 
 void NoopTracer::LogSpanContextTo(const Span::Impl& span,
                                   logging::impl::TagWriter writer) const {
-  writer.PutTag(kTraceIdName, span.GetTraceId());
-  writer.PutTag(kSpanIdName, span.GetSpanId());
-  writer.PutTag(kParentIdName, span.GetParentId());
+  impl::TraceId::Buffer trace_id_buffer;
+  impl::SpanId::Buffer span_id_buffer;
+  impl::SpanId::Buffer parent_id_buffer;
+  writer.PutTag(kTraceIdName,
+                span.GetTraceIdValue().ToStringView(trace_id_buffer));
+  writer.PutTag(kSpanIdName,
+                span.GetSpanIdValue().ToStringView(span_id_buffer));
+  writer.PutTag(kParentIdName,
+                span.GetParentIdValue().ToStringView(parent_id_buffer));
 }
 
 auto& GlobalNoLogSpans() {
@@ -40,9 +49,20 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
-auto& GlobalTracer() {
-  static rcu::Variable<TracerPtr> tracer(tracing::MakeTracer({}, {}));
-  return tracer;
+// Tracers that have ever been set globally are never destroyed
+struct GlobalTracers final {
+  GlobalTracers() : tracers{tracing::MakeTracer({}, {})} {
+    current.store(tracers.back().get());
+  }
+
+  std::mutex mutex;
+  std::vector<TracerPtr> tracers;
+  std::atomic<Tracer*> current{nullptr};
+};
+
+GlobalTracers& GetGlobalTracers() {
+  static auto& tracers = *new GlobalTracers();
+  return tracers;
 }
 
 template <class T>
@@ -84,11 +104,17 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
 }
 
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
-  GlobalTracer().Assign(std::move(tracer));
+  UINVARIANT(tracer, "Global tracer must not be null");
+  auto& global = GetGlobalTracers();
+  const std::lock_guard lock{global.mutex};
+  global.tracers.push_back(std::move(tracer));
+  global.current.store(global.tracers.back().get(), std::memory_order_release);
 }
 
 std::shared_ptr<Tracer> Tracer::GetTracer() {
-  return GlobalTracer().ReadCopy();
+  return GetGlobalTracers()
+      .current.load(std::memory_order_acquire)
+      ->shared_from_this();
 }
 
 const std::string& Tracer::GetServiceName() const {
@@ -120,6 +146,21 @@ tracing::TracerPtr MakeTracer(std::string_view service_name,
   return std::make_shared<tracing::NoopTracer>(service_name, std::move(logger));
 }
 
+namespace impl {
+
+TracerHandle TracerHandle::Global() noexcept {
+  return {GetGlobalTracers().current.load(std::memory_order_acquire), nullptr};
+}
+
+TracerHandle::TracerHandle(TracerPtr&& tracer) noexcept
+    : TracerHandle(tracer.get(), std::move(tracer)) {
+  if (tracer_ == GetGlobalTracers().current.load(std::memory_order_acquire)) {
+    holder_.reset();
+  }
+}
+
+}  // namespace impl
+
 }  // namespace tracing
 
 USERVER_NAMESPACE_END
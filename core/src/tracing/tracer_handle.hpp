@@ -0,0 +1,34 @@
+#pragma once
+
+#include <userver/tracing/tracer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+// Reference to a tracer that only owns it if the tracer has never been set
+// globally. The global tracers are never destroyed, which lets the spans skip
+// the reference counting on the hot path.
+class TracerHandle final {
+ public:
+  // The current global tracer
+  static TracerHandle Global() noexcept;
+
+  explicit TracerHandle(TracerPtr&& tracer) noexcept;
+
+  Tracer* operator->() const noexcept { return tracer_; }
+  Tracer& operator*() const noexcept { return *tracer_; }
+  explicit operator bool() const noexcept { return tracer_ != nullptr; }
+
+ private:
+  TracerHandle(Tracer* tracer, TracerPtr&& holder) noexcept
+      : tracer_(tracer), holder_(std::move(holder)) {}
+
+  Tracer* tracer_;
+  // nullptr for the global tracers
+  TracerPtr holder_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
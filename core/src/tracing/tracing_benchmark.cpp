@@ -14,6 +14,7 @@ void tracing_noop_ctr(benchmark::State& state) {
 
     for ([[maybe_unused]] auto _ : state)
       benchmark::DoNotOptimize(tracer->CreateSpanWithoutParent("name"));
+    state.SetItemsProcessed(state.iterations());
   });
 }
 BENCHMARK(tracing_noop_ctr);
@@ -29,6 +30,7 @@ void tracing_happy_log(benchmark::State& state) {
 
     for ([[maybe_unused]] auto _ : state)
       benchmark::DoNotOptimize(tracer->CreateSpanWithoutParent("name"));
+    state.SetItemsProcessed(state.iterations());
   });
 }
 BENCHMARK(tracing_happy_log);
@@ -48,10 +50,25 @@ void tracing_opentracing_ctr(benchmark::State& state) {
     for ([[maybe_unused]] auto _ : state) {
       benchmark::DoNotOptimize(GetSpanWithOpentracingHttpTags(tracer));
     }
+    state.SetItemsProcessed(state.iterations());
   });
 }
 BENCHMARK(tracing_opentracing_ctr);
 
+// The typical case: nested spans of a request with the global tracer
+void tracing_nested_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"root"};
+
+    for ([[maybe_unused]] auto _ : state) {
+      tracing::Span span{"name"};
+      benchmark::DoNotOptimize(span.CreateChild("child"));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+  });
+}
+BENCHMARK(tracing_nested_ctr);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
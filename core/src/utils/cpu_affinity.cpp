@@ -0,0 +1,142 @@
+#include <utils/cpu_affinity.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+constexpr std::string_view kSysfsNodePath = "/sys/devices/system/node";
+
+std::size_t ParseCpu(std::string_view cpu, std::string_view cpu_list) {
+  try {
+    return utils::FromString<std::size_t>(cpu);
+  } catch (const std::exception& e) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU list '{}': {}", cpu_list, e.what()));
+  }
+}
+
+}  // namespace
+
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> cpus;
+
+  for (const auto& range : utils::text::Split(cpu_list, ",")) {
+    const auto trimmed = utils::text::Trim(std::string{range});
+    if (trimmed.empty()) continue;
+
+    const auto dash = trimmed.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(ParseCpu(trimmed, cpu_list));
+      continue;
+    }
+
+    const auto first = ParseCpu(trimmed.substr(0, dash), cpu_list);
+    const auto last = ParseCpu(trimmed.substr(dash + 1), cpu_list);
+    if (first > last) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU list '{}': reversed range", cpu_list));
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node) {
+  const auto path = fmt::format("{}/node{}/cpulist", kSysfsNodePath, numa_node);
+  if (!fs::blocking::FileExists(path)) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} does not exist on this host", numa_node));
+  }
+  return ParseCpuList(fs::blocking::ReadFileContents(path));
+}
+
+std::size_t GetCpuNumaNode(std::size_t cpu) {
+  for (std::size_t node = 0;; ++node) {
+    const auto path = fmt::format("{}/node{}/cpulist", kSysfsNodePath, node);
+    if (!fs::blocking::FileExists(path)) return 0;
+
+    const auto cpus = ParseCpuList(fs::blocking::ReadFileContents(path));
+    if (std::binary_search(cpus.begin(), cpus.end(), cpu)) return node;
+  }
+}
+
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+  if (cpus.empty()) return;
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                              fmt::format("CPU {} is out of range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  const int ret =
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    throw std::system_error(std::error_code(ret, std::system_category()),
+                            "Error while setting the thread CPU affinity");
+  }
+#else
+  throw std::system_error(
+      std::make_error_code(std::errc::function_not_supported),
+      "Setting the thread CPU affinity is not supported on this platform");
+#endif
+}
+
+std::vector<std::size_t> ParseCpuAffinity(const yaml_config::YamlConfig& value,
+                                          std::string_view cpu_list_key,
+                                          std::string_view numa_node_key) {
+  const auto cpu_list = value[cpu_list_key];
+  const auto numa_node = value[numa_node_key];
+
+  if (!cpu_list.IsMissing() && !numa_node.IsMissing()) {
+    throw std::runtime_error(fmt::format(
+        "Only one of '{}' and '{}' may be set at '{}'", cpu_list_key,
+        numa_node_key, value.GetPath()));
+  }
+
+  if (!numa_node.IsMissing()) {
+    return GetNumaNodeCpus(numa_node.As<std::size_t>());
+  }
+
+  if (!cpu_list.IsMissing()) {
+    auto cpus = ParseCpuList(cpu_list.As<std::string>());
+    if (cpus.empty()) {
+      throw std::runtime_error(
+          fmt::format("Empty CPU list at '{}'", cpu_list.GetPath()));
+    }
+    return cpus;
+  }
+
+  return {};
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// Parses the Linux cpulist format, e.g. "0-3,8,10-11". The result is sorted
+/// and has no duplicates.
+/// @throws std::runtime_error on malformed input
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// CPUs of the NUMA node, as reported by sysfs.
+/// @throws std::runtime_error if the node does not exist
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node);
+
+/// NUMA node of the CPU, as reported by sysfs. Returns 0 on non-NUMA systems.
+std::size_t GetCpuNumaNode(std::size_t cpu);
+
+/// Binds the current OS thread to the CPUs. Empty `cpus` do nothing.
+/// @throws std::system_error
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
+
+/// Parses the CPU set of a thread pool from a config that has either
+/// a `cpu_list` option with a CPU list or a `numa_node` option.
+/// A NUMA node is turned into its CPUs, no memory policy is applied.
+/// Returns an empty vector if none of the options is set.
+std::vector<std::size_t> ParseCpuAffinity(const yaml_config::YamlConfig& value,
+                                          std::string_view cpu_list_key,
+                                          std::string_view numa_node_key);
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
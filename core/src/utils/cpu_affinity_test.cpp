@@ -0,0 +1,36 @@
+#include <utils/cpu_affinity.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <userver/fs/blocking/read.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(CpuAffinity, ParseCpuList) {
+  using Cpus = std::vector<std::size_t>;
+
+  EXPECT_EQ(utils::ParseCpuList("0"), Cpus({0}));
+  EXPECT_EQ(utils::ParseCpuList("0-3"), Cpus({0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("8,0-2, 10-11\n"), Cpus({0, 1, 2, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("1-2,2-3"), Cpus({1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+
+  EXPECT_THROW(utils::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("a-b"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("1-"), std::runtime_error);
+}
+
+TEST(CpuAffinity, NumaNodeZero) {
+  // Non-NUMA Linux hosts still report a single node
+  if (!fs::blocking::FileExists("/sys/devices/system/node/node0/cpulist")) {
+    GTEST_SKIP() << "No NUMA information in sysfs";
+  }
+
+  const auto cpus = utils::GetNumaNodeCpus(0);
+  ASSERT_FALSE(cpus.empty());
+  EXPECT_EQ(utils::GetCpuNumaNode(cpus.front()), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// Just enough of the protobuf wire format to serialize a message by hand.
+// Nested messages are serialized with a separate writer and written as bytes.
+class ProtoWriter final {
+ public:
+  void WriteUint(int field, std::uint64_t value) {
+    WriteKey(field, kVarint);
+    WriteVarint(value);
+  }
+
+  void WriteInt(int field, std::int64_t value) {
+    WriteUint(field, static_cast<std::uint64_t>(value));
+  }
+
+  void WriteBool(int field, bool value) { WriteUint(field, value ? 1 : 0); }
+
+  void WriteFixed64(int field, std::uint64_t value) {
+    WriteKey(field, kFixed64);
+    WriteRawFixed64(value);
+  }
+
+  void WriteDouble(int field, double value) {
+    WriteFixed64(field, DoubleBits(value));
+  }
+
+  void WriteBytes(int field, std::string_view value) {
+    WriteKey(field, kLengthDelimited);
+    WriteVarint(value.size());
+    data_.append(value);
+  }
+
+  void WritePacked(int field, const std::vector<std::uint64_t>& values) {
+    ProtoWriter packed;
+    for (const auto value : values) packed.WriteVarint(value);
+    WriteBytes(field, packed.Extract());
+  }
+
+  void WritePackedFixed64(int field, const std::vector<std::uint64_t>& values) {
+    ProtoWriter packed;
+    for (const auto value : values) packed.WriteRawFixed64(value);
+    WriteBytes(field, packed.Extract());
+  }
+
+  void WritePackedDouble(int field, const std::vector<double>& values) {
+    ProtoWriter packed;
+    for (const auto value : values) packed.WriteRawFixed64(DoubleBits(value));
+    WriteBytes(field, packed.Extract());
+  }
+
+  std::string Extract() && { return std::move(data_); }
+  std::string Extract() & { return std::exchange(data_, {}); }
+
+ private:
+  static constexpr int kVarint = 0;
+  static constexpr int kFixed64 = 1;
+  static constexpr int kLengthDelimited = 2;
+
+  void WriteKey(int field, int wire_type) {
+    WriteVarint(static_cast<std::uint64_t>(field) << 3 | wire_type);
+  }
+
+  void WriteVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+
+  void WriteRawFixed64(std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      data_.push_back(static_cast<char>(value >> (i * 8)));
+    }
+  }
+
+  static std::uint64_t DoubleBits(double value) {
+    static_assert(sizeof(double) == sizeof(std::uint64_t));
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  std::string data_;
+};
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <cerrno>
 #endif
 
+#include <userver/compiler/thread_local.hpp>
 #include <userver/utils/thread_name.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -36,6 +37,27 @@ std::error_code MallCtl(const char* name) {
   return MakeErrorCode(rc);
 }
 
+template <typename T>
+T MallCtlRead(const char* name, T default_value) {
+  T value{};
+  std::size_t size = sizeof(value);
+  if (mallctl(name, &value, &size, nullptr, 0) != 0) return default_value;
+  return value;
+}
+
+// Pointers to the jemalloc per-thread counters, nullptr if unavailable
+struct ThreadCounters final {
+  const std::uint64_t* allocated{nullptr};
+  const std::uint64_t* deallocated{nullptr};
+};
+
+compiler::ThreadLocal thread_counters = [] {
+  return ThreadCounters{
+      MallCtlRead<std::uint64_t*>("thread.allocatedp", nullptr),
+      MallCtlRead<std::uint64_t*>("thread.deallocatedp", nullptr),
+  };
+};
+
 void MallocStatPrintCb(void* data, const char* msg) {
   auto* s = static_cast<std::string*>(data);
   *s += msg;
@@ -55,6 +77,10 @@ std::error_code ProfDeactivate() { return MallCtl<bool>("prof.active", false); }
 
 std::error_code ProfDump() { return MallCtl("prof.dump"); }
 
+std::error_code ProfDump(const std::string& filename) {
+  return MallCtl<const char*>("prof.dump", filename.c_str());
+}
+
 std::error_code SetMaxBgThreads(size_t max_bg_threads) {
   return MallCtl<size_t>("max_background_threads", max_bg_threads);
 }
@@ -68,6 +94,23 @@ std::error_code StopBgThreads() {
   return MallCtl<bool>("background_thread", false);
 }
 
+Allocations operator-(const Allocations& lhs, const Allocations& rhs) noexcept {
+  return {lhs.allocated_bytes - rhs.allocated_bytes,
+          lhs.deallocated_bytes - rhs.deallocated_bytes};
+}
+
+Allocations& operator+=(Allocations& lhs, const Allocations& rhs) noexcept {
+  lhs.allocated_bytes += rhs.allocated_bytes;
+  lhs.deallocated_bytes += rhs.deallocated_bytes;
+  return lhs;
+}
+
+Allocations GetThreadAllocations() noexcept {
+  auto counters = thread_counters.Use();
+  if (!counters->allocated || !counters->deallocated) return {};
+  return {*counters->allocated, *counters->deallocated};
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <system_error>
 
@@ -15,6 +16,9 @@ std::error_code ProfDeactivate();
 
 std::error_code ProfDump();
 
+// Dumps the heap profile into the specified file
+std::error_code ProfDump(const std::string& filename);
+
 std::error_code SetMaxBgThreads(size_t max_bg_threads);
 
 std::error_code EnableBgThreads();
@@ -22,6 +26,19 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+struct Allocations final {
+  std::uint64_t allocated_bytes{0};
+  std::uint64_t deallocated_bytes{0};
+};
+
+Allocations operator-(const Allocations& lhs, const Allocations& rhs) noexcept;
+
+Allocations& operator+=(Allocations& lhs, const Allocations& rhs) noexcept;
+
+// Total bytes allocated and freed by the current thread since its start.
+// Cheap, reads the jemalloc thread counters. Zeros if jemalloc is disabled.
+Allocations GetThreadAllocations() noexcept;
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
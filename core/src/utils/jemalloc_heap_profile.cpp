@@ -0,0 +1,204 @@
+#include <utils/jemalloc_heap_profile.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+#include <boost/stacktrace/frame.hpp>
+#include <fmt/format.h>
+
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::jemalloc {
+
+namespace {
+
+constexpr std::string_view kHeader = "heap_v2/";
+constexpr std::string_view kStackPrefix = "@ ";
+constexpr std::string_view kTotalPrefix = "t*: ";
+constexpr std::string_view kMappedLibraries = "MAPPED_LIBRARIES:";
+
+[[noreturn]] void ThrowInvalid(std::string_view what, std::string_view line) {
+  throw std::runtime_error(
+      fmt::format("Invalid jemalloc heap profile: {} in '{}'", what, line));
+}
+
+std::string_view Trim(std::string_view line) {
+  while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+  while (!line.empty() && (line.back() == ' ' || line.back() == '\r')) {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+class LineReader final {
+ public:
+  explicit LineReader(std::string_view data) : data_(data) {}
+
+  bool Next(std::string_view& line) {
+    if (data_.empty()) return false;
+    const auto pos = data_.find('\n');
+    line = data_.substr(0, pos);
+    data_.remove_prefix(pos == std::string_view::npos ? data_.size() : pos + 1);
+    return true;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+std::uint64_t ParseUnsigned(std::string_view token, std::string_view line) {
+  try {
+    return utils::FromString<std::uint64_t>(Trim(token));
+  } catch (const std::exception&) {
+    ThrowInvalid("bad number", line);
+  }
+}
+
+std::vector<std::uintptr_t> ParseFrames(std::string_view line) {
+  std::vector<std::uintptr_t> frames;
+  line.remove_prefix(kStackPrefix.size());
+  while (!line.empty()) {
+    const auto pos = line.find(' ');
+    const auto token = line.substr(0, pos);
+    line.remove_prefix(pos == std::string_view::npos ? line.size() : pos + 1);
+    if (token.empty()) continue;
+    if (!utils::text::StartsWith(token, "0x")) ThrowInvalid("bad frame", line);
+
+    std::uintptr_t address = 0;
+    for (const char c : token.substr(2)) {
+      const auto digit = std::string_view{"0123456789abcdef"}.find(
+          static_cast<char>(c | 0x20));
+      if (digit == std::string_view::npos) ThrowInvalid("bad frame", token);
+      address = address * 16 + digit;
+    }
+    frames.push_back(address);
+  }
+  return frames;
+}
+
+// "t*: <objects>: <bytes> [<accumulated objects>: <accumulated bytes>]"
+void ParseTotals(std::string_view line, std::uint64_t sample_period,
+                 HeapProfileStack& stack) {
+  line.remove_prefix(kTotalPrefix.size());
+  const auto colon = line.find(':');
+  const auto bracket = line.find('[');
+  if (colon == std::string_view::npos || bracket < colon) {
+    ThrowInvalid("bad totals", line);
+  }
+  const auto objects = ParseUnsigned(line.substr(0, colon), line);
+  const auto bytes =
+      ParseUnsigned(line.substr(colon + 1, bracket - colon - 1), line);
+
+  // Each allocation is sampled with the probability 1 - exp(-size / period),
+  // scale the samples back the same way jeprof does
+  double scale = 1.0;
+  if (sample_period != 0 && objects != 0 && bytes != 0) {
+    const auto average_size =
+        static_cast<double>(bytes) / static_cast<double>(objects);
+    scale = 1.0 / (1.0 - std::exp(-average_size /
+                                  static_cast<double>(sample_period)));
+  }
+  stack.objects = std::llround(static_cast<double>(objects) * scale);
+  stack.bytes = std::llround(static_cast<double>(bytes) * scale);
+}
+
+}  // namespace
+
+HeapProfile ParseHeapProfile(std::string_view data) {
+  LineReader reader{data};
+  std::string_view line;
+  if (!reader.Next(line) || !utils::text::StartsWith(line, kHeader)) {
+    ThrowInvalid("no heap_v2 header", line.substr(0, 64));
+  }
+
+  HeapProfile profile;
+  profile.sample_period =
+      ParseUnsigned(Trim(line).substr(kHeader.size()), line);
+
+  HeapProfileStack* stack = nullptr;
+  while (reader.Next(line)) {
+    line = Trim(line);
+    if (utils::text::StartsWith(line, kMappedLibraries)) break;
+
+    if (utils::text::StartsWith(line, kStackPrefix)) {
+      stack = &profile.stacks.emplace_back();
+      stack->frames = ParseFrames(line);
+    } else if (utils::text::StartsWith(line, kTotalPrefix)) {
+      // The first totals line is for the whole profile, per-stack ones follow
+      // the stacks; per-thread "t<N>:" lines are ignored
+      if (stack) {
+        ParseTotals(line, profile.sample_period, *stack);
+        stack = nullptr;
+      }
+    }
+  }
+  return profile;
+}
+
+std::vector<HeapProfileStack> DiffHeapProfiles(const HeapProfile& base,
+                                               const HeapProfile& current) {
+  struct Delta final {
+    std::int64_t objects{0};
+    std::int64_t bytes{0};
+  };
+  std::map<std::vector<std::uintptr_t>, Delta> deltas;
+  for (const auto& stack : current.stacks) {
+    auto& delta = deltas[stack.frames];
+    delta.objects += stack.objects;
+    delta.bytes += stack.bytes;
+  }
+  for (const auto& stack : base.stacks) {
+    auto& delta = deltas[stack.frames];
+    delta.objects -= stack.objects;
+    delta.bytes -= stack.bytes;
+  }
+
+  std::vector<HeapProfileStack> result;
+  for (auto& [frames, delta] : deltas) {
+    if (delta.objects == 0 && delta.bytes == 0) continue;
+    result.push_back({frames, delta.objects, delta.bytes});
+  }
+  std::stable_sort(result.begin(), result.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return lhs.bytes > rhs.bytes;
+                   });
+  return result;
+}
+
+std::string FormatHeapProfileDiff(const std::vector<HeapProfileStack>& diff,
+                                  std::size_t limit) {
+  std::int64_t total_bytes = 0;
+  std::int64_t total_objects = 0;
+  for (const auto& stack : diff) {
+    total_bytes += stack.bytes;
+    total_objects += stack.objects;
+  }
+
+  fmt::memory_buffer buffer;
+  fmt::format_to(std::back_inserter(buffer),
+                 "Live memory change: {:+} bytes, {:+} objects in {} stacks\n",
+                 total_bytes, total_objects, diff.size());
+  for (std::size_t i = 0; i < std::min(limit, diff.size()); ++i) {
+    const auto& stack = diff[i];
+    fmt::format_to(std::back_inserter(buffer), "\n{:+} bytes, {:+} objects\n",
+                   stack.bytes, stack.objects);
+    for (const auto address : stack.frames) {
+      // The frames are return addresses, step back into the call instruction
+      const boost::stacktrace::frame frame{
+          reinterpret_cast<const void*>(address - 1)};
+      auto name = frame.name();
+      if (name.empty()) name = fmt::format("{:#x}", address);
+      fmt::format_to(std::back_inserter(buffer), "    {}\n", name);
+    }
+  }
+  return fmt::to_string(buffer);
+}
+
+}  // namespace utils::jemalloc
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::jemalloc {
+
+struct HeapProfileStack final {
+  // Return addresses, the innermost frame first
+  std::vector<std::uintptr_t> frames;
+  // Live objects and bytes allocated from the stack, scaled from the samples
+  std::int64_t objects{0};
+  std::int64_t bytes{0};
+};
+
+// Heap profile as written by prof.dump
+struct HeapProfile final {
+  std::uint64_t sample_period{0};
+  std::vector<HeapProfileStack> stacks;
+};
+
+// Parses the "heap_v2" format, throws std::runtime_error on invalid data
+HeapProfile ParseHeapProfile(std::string_view data);
+
+// Returns the change of the live memory per stack from `base` to `current`,
+// the largest growth first. Stacks without changes are skipped.
+std::vector<HeapProfileStack> DiffHeapProfiles(const HeapProfile& base,
+                                               const HeapProfile& current);
+
+// Formats at most `limit` first stacks of the diff, symbolizing the frames
+// in the current process
+std::string FormatHeapProfileDiff(const std::vector<HeapProfileStack>& diff,
+                                  std::size_t limit);
+
+}  // namespace utils::jemalloc
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#include <utils/jemalloc_heap_profile.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kBase = R"(heap_v2/0
+  t*: 3: 96 [0: 0]
+  t0: 3: 96 [0: 0]
+@ 0x10 0x20 0x30
+  t*: 2: 64 [0: 0]
+  t0: 2: 64 [0: 0]
+@ 0x11 0x20
+  t*: 1: 32 [0: 0]
+
+MAPPED_LIBRARIES:
+55d7c0000000-55d7c0001000 r--p 00000000 08:01 1 /usr/bin/service
+)";
+
+constexpr std::string_view kCurrent = R"(heap_v2/0
+  t*: 12: 1088 [0: 0]
+@ 0x10 0x20 0x30
+  t*: 2: 64 [0: 0]
+@ 0x11 0x20
+  t*: 0: 0 [0: 0]
+@ 0x12 0x20
+  t*: 10: 1024 [0: 0]
+
+MAPPED_LIBRARIES:
+)";
+
+}  // namespace
+
+TEST(JemallocHeapProfile, Parse) {
+  const auto profile = utils::jemalloc::ParseHeapProfile(kBase);
+  EXPECT_EQ(profile.sample_period, 0);
+  ASSERT_EQ(profile.stacks.size(), 2);
+  EXPECT_EQ(profile.stacks[0].frames,
+            (std::vector<std::uintptr_t>{0x10, 0x20, 0x30}));
+  EXPECT_EQ(profile.stacks[0].objects, 2);
+  EXPECT_EQ(profile.stacks[0].bytes, 64);
+  EXPECT_EQ(profile.stacks[1].frames,
+            (std::vector<std::uintptr_t>{0x11, 0x20}));
+  EXPECT_EQ(profile.stacks[1].bytes, 32);
+}
+
+TEST(JemallocHeapProfile, SamplesAreScaled) {
+  const auto profile = utils::jemalloc::ParseHeapProfile(
+      "heap_v2/524288\n@ 0xa\n  t*: 1: 524288 [0: 0]\n");
+  ASSERT_EQ(profile.stacks.size(), 1);
+  // sampled with the probability of 1 - e^-1
+  EXPECT_EQ(profile.stacks[0].objects, 2);
+  EXPECT_EQ(profile.stacks[0].bytes, 829411);
+}
+
+TEST(JemallocHeapProfile, Invalid) {
+  EXPECT_THROW(utils::jemalloc::ParseHeapProfile("heap_v1/1\n"),
+               std::runtime_error);
+  EXPECT_THROW(utils::jemalloc::ParseHeapProfile("heap_v2/0\n@ 0xzz\n"),
+               std::runtime_error);
+  EXPECT_THROW(
+      utils::jemalloc::ParseHeapProfile("heap_v2/0\n@ 0x1\n  t*: x: 1 []\n"),
+      std::runtime_error);
+}
+
+TEST(JemallocHeapProfile, Diff) {
+  const auto diff = utils::jemalloc::DiffHeapProfiles(
+      utils::jemalloc::ParseHeapProfile(kBase),
+      utils::jemalloc::ParseHeapProfile(kCurrent));
+  ASSERT_EQ(diff.size(), 2);
+  EXPECT_EQ(diff[0].frames, (std::vector<std::uintptr_t>{0x12, 0x20}));
+  EXPECT_EQ(diff[0].objects, 10);
+  EXPECT_EQ(diff[0].bytes, 1024);
+  EXPECT_EQ(diff[1].frames, (std::vector<std::uintptr_t>{0x11, 0x20}));
+  EXPECT_EQ(diff[1].objects, -1);
+  EXPECT_EQ(diff[1].bytes, -32);
+
+  const auto report = utils::jemalloc::FormatHeapProfileDiff(diff, 1);
+  EXPECT_NE(report.find("+992 bytes"), std::string::npos) << report;
+  EXPECT_NE(report.find("+1024 bytes, +10 objects"), std::string::npos)
+      << report;
+  EXPECT_EQ(report.find("-32 bytes"), std::string::npos) << report;
+}
+
+USERVER_NAMESPACE_END
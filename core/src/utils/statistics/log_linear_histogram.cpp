@@ -0,0 +1,302 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <optional>
+#include <vector>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/histogram_view.hpp>
+#include <userver/utils/statistics/impl/histogram_bucket.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <utils/statistics/solomon_limits.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+constexpr int kPrecisionBits = LogLinearHistogram::kPrecisionBits;
+constexpr std::size_t kSubBuckets = std::size_t{1} << kPrecisionBits;
+constexpr std::size_t kStripes = 4;
+
+// The bucket grid splits each power of two into 2^precision buckets. Each of
+// the numbers below 2^precision has a bucket of its own. Row 0 contains those,
+// row N contains [2^(N + precision - 1), 2^(N + precision)).
+//
+// The grids with different precision are nested: each bucket of a coarser
+// grid consists of whole buckets of a finer grid.
+constexpr std::size_t GetBucketIndex(std::uint64_t x, int precision) noexcept {
+  if (x < (std::uint64_t{1} << precision)) return x;
+  const int exponent = 63 - __builtin_clzll(x);
+  const auto row = static_cast<std::size_t>(exponent - precision + 1);
+  const auto sub_bucket =
+      (x >> (exponent - precision)) - (std::uint64_t{1} << precision);
+  return (row << precision) + sub_bucket;
+}
+
+constexpr std::uint64_t GetBucketLowest(std::size_t index,
+                                        int precision) noexcept {
+  const auto row = index >> precision;
+  const auto sub_bucket = index & ((std::size_t{1} << precision) - 1);
+  if (row == 0) return sub_bucket;
+  return ((std::uint64_t{1} << precision) + sub_bucket) << (row - 1);
+}
+
+constexpr std::uint64_t GetBucketHighest(std::size_t index,
+                                         int precision) noexcept {
+  const auto row = index >> precision;
+  if (row == 0) return GetBucketLowest(index, precision);
+  return GetBucketLowest(index, precision) +
+         ((std::uint64_t{1} << (row - 1)) - 1);
+}
+
+static_assert(GetBucketIndex(31, kPrecisionBits) == 31);
+static_assert(GetBucketIndex(32, kPrecisionBits) == 32);
+static_assert(GetBucketIndex(64, kPrecisionBits) == 64);
+static_assert(GetBucketIndex(65, kPrecisionBits) == 64);
+static_assert(GetBucketIndex(66, kPrecisionBits) == 65);
+static_assert(GetBucketLowest(65, kPrecisionBits) == 66);
+static_assert(GetBucketHighest(65, kPrecisionBits) == 67);
+static_assert(GetBucketHighest(GetBucketIndex(~std::uint64_t{0}, 0), 0) ==
+              ~std::uint64_t{0});
+
+// Values 0 and 1 share a bucket, so that the bucket upper bounds are
+// the round numbers: a bucket of the grid contains values (lowest, highest + 1]
+constexpr std::uint64_t ToGridPoint(std::uint64_t value) noexcept {
+  return value - (value != 0);
+}
+
+constexpr std::uint64_t ToValueUpperBound(std::uint64_t highest) noexcept {
+  return highest == ~std::uint64_t{0} ? highest : highest + 1;
+}
+
+// The written grid: the values below `split_point` use `precision`, the values
+// from `split_point` on use `precision + 1`. The finer part spends the buckets
+// left over by the coarse grid on the largest values. `split_point` is a power
+// of two, so both parts consist of whole buckets of the accounted grid.
+struct ExportedGrid final {
+  int precision{0};
+  std::uint64_t split_point{~std::uint64_t{0}};
+  std::size_t split_index{0};
+  std::size_t fine_split_index{0};
+  std::size_t bucket_count{0};
+
+  std::size_t GetIndex(std::uint64_t x) const noexcept {
+    if (x < split_point) return GetBucketIndex(x, precision);
+    return split_index + GetBucketIndex(x, precision + 1) - fine_split_index;
+  }
+
+  std::uint64_t GetHighest(std::size_t index) const noexcept {
+    if (index < split_index) return GetBucketHighest(index, precision);
+    return GetBucketHighest(index - split_index + fine_split_index,
+                            precision + 1);
+  }
+};
+
+// The finest grid that represents [0, max_exported_value] with a limited
+// number of buckets.
+ExportedGrid GetExportedGrid(std::uint64_t max_exported_value) noexcept {
+  constexpr auto kMaxBuckets = impl::solomon::kMaxHistogramBuckets;
+  const auto max_point = ToGridPoint(max_exported_value);
+
+  ExportedGrid grid;
+  for (grid.precision = kPrecisionBits; grid.precision > 0; --grid.precision) {
+    if (GetBucketIndex(max_point, grid.precision) < kMaxBuckets) break;
+  }
+  grid.split_index = GetBucketIndex(max_point, grid.precision) + 1;
+  grid.bucket_count = std::min(grid.split_index, kMaxBuckets);
+  if (grid.precision == kPrecisionBits || grid.split_index > kMaxBuckets) {
+    return grid;
+  }
+
+  const auto fine_max_index = GetBucketIndex(max_point, grid.precision + 1);
+  for (int exponent = 0; (max_point >> exponent) != 0; ++exponent) {
+    const auto split_point = std::uint64_t{1} << exponent;
+    const auto split_index = GetBucketIndex(split_point, grid.precision);
+    const auto fine_split_index =
+        GetBucketIndex(split_point, grid.precision + 1);
+    const auto fine_count = fine_max_index - fine_split_index + 1;
+    if (split_index + fine_count <= kMaxBuckets) {
+      grid.split_point = split_point;
+      grid.split_index = split_index;
+      grid.fine_split_index = fine_split_index;
+      grid.bucket_count = split_index + fine_count;
+      break;
+    }
+  }
+  return grid;
+}
+
+std::atomic<std::size_t> next_stripe{0};
+
+compiler::ThreadLocal local_stripe = [] {
+  return next_stripe.fetch_add(1, std::memory_order_relaxed) % kStripes;
+};
+
+std::size_t GetCurrentStripe() noexcept {
+  auto stripe = local_stripe.Use();
+  return *stripe;
+}
+
+}  // namespace
+
+struct LogLinearHistogram::Row final {
+  struct alignas(concurrent::impl::kDestructiveInterferenceSize) Stripe final {
+    std::atomic<std::uint64_t> counters[kSubBuckets]{};
+  };
+
+  std::uint64_t Load(std::size_t sub_bucket) const noexcept {
+    std::uint64_t sum = 0;
+    for (const auto& stripe : stripes) {
+      sum += stripe.counters[sub_bucket].load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  Stripe stripes[kStripes];
+};
+
+LogLinearHistogram::LogLinearHistogram(std::uint64_t max_exported_value)
+    : max_exported_value_(max_exported_value) {
+  UINVARIANT(max_exported_value != 0,
+             "LogLinearHistogram max_exported_value must be positive");
+}
+
+LogLinearHistogram::LogLinearHistogram(const LogLinearHistogram& other)
+    : LogLinearHistogram(other.max_exported_value_) {
+  Add(other);
+}
+
+LogLinearHistogram& LogLinearHistogram::operator=(
+    const LogLinearHistogram& other) {
+  if (this == &other) return *this;
+  max_exported_value_ = other.max_exported_value_;
+  ResetMetric(*this);
+  Add(other);
+  return *this;
+}
+
+LogLinearHistogram::~LogLinearHistogram() {
+  for (auto& row : rows_) delete row.load(std::memory_order_relaxed);
+}
+
+LogLinearHistogram::Row* LogLinearHistogram::GetOrCreateRow(
+    std::size_t row_index) noexcept {
+  auto& row_ptr = rows_[row_index];
+  auto* row = row_ptr.load(std::memory_order_acquire);
+  if (row) return row;
+
+  auto* new_row = new (std::nothrow) Row{};
+  if (!new_row) return nullptr;
+  if (row_ptr.compare_exchange_strong(row, new_row, std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+    return new_row;
+  }
+  // Another thread has created the row first
+  delete new_row;
+  return row;
+}
+
+template <typename Func>
+void LogLinearHistogram::VisitBuckets(Func func) const {
+  for (std::size_t row_index = 0; row_index < kRowsCount; ++row_index) {
+    const auto* row = rows_[row_index].load(std::memory_order_acquire);
+    if (!row) continue;
+    for (std::size_t sub_bucket = 0; sub_bucket < kSubBuckets; ++sub_bucket) {
+      const auto count = row->Load(sub_bucket);
+      if (count != 0) func(row_index * kSubBuckets + sub_bucket, count);
+    }
+  }
+}
+
+void LogLinearHistogram::Account(std::uint64_t value,
+                                 std::uint64_t count) noexcept {
+  const auto index = GetBucketIndex(ToGridPoint(value), kPrecisionBits);
+  auto* row = GetOrCreateRow(index / kSubBuckets);
+  // Out of memory, the value is lost
+  if (!row) return;
+
+  row->stripes[GetCurrentStripe()]
+      .counters[index % kSubBuckets]
+      .fetch_add(count, std::memory_order_relaxed);
+}
+
+void LogLinearHistogram::Add(const LogLinearHistogram& other) {
+  other.VisitBuckets([this](std::size_t index, std::uint64_t count) {
+    auto* row = GetOrCreateRow(index / kSubBuckets);
+    if (!row) throw std::bad_alloc();
+    row->stripes[0].counters[index % kSubBuckets].fetch_add(
+        count, std::memory_order_relaxed);
+  });
+}
+
+std::uint64_t LogLinearHistogram::GetPercentile(
+    double percent) const noexcept {
+  const auto total = GetTotalCount();
+  if (total == 0) return 0;
+
+  const auto want_sum = static_cast<double>(total) * percent;
+  std::uint64_t sum = 0;
+  std::optional<std::size_t> result_index;
+  std::size_t last_index = 0;
+  VisitBuckets([&](std::size_t index, std::uint64_t count) {
+    if (result_index) return;
+    sum += count;
+    last_index = index;
+    if (static_cast<double>(sum) * 100 > want_sum) result_index = index;
+  });
+  return ToValueUpperBound(
+      GetBucketHighest(result_index.value_or(last_index), kPrecisionBits));
+}
+
+std::uint64_t LogLinearHistogram::GetTotalCount() const noexcept {
+  std::uint64_t total = 0;
+  VisitBuckets([&total](std::size_t, std::uint64_t count) { total += count; });
+  return total;
+}
+
+void ResetMetric(LogLinearHistogram& histogram) noexcept {
+  for (auto& row_ptr : histogram.rows_) {
+    auto* row = row_ptr.load(std::memory_order_acquire);
+    if (!row) continue;
+    for (auto& stripe : row->stripes) {
+      for (auto& counter : stripe.counters) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+void DumpMetric(Writer& writer, const LogLinearHistogram& histogram) {
+  const auto grid = GetExportedGrid(histogram.max_exported_value_);
+  const auto bucket_count = grid.bucket_count;
+
+  std::vector<double> bounds(bucket_count);
+  for (std::size_t index = 0; index < bucket_count; ++index) {
+    bounds[index] = static_cast<double>(grid.GetHighest(index)) + 1;
+  }
+
+  // The first bucket contains the size and the "infinity" bucket
+  const auto buckets =
+      std::make_unique<impl::histogram::Bucket[]>(bucket_count + 1);
+  impl::histogram::CopyBounds(buckets.get(), bounds);
+  histogram.VisitBuckets([&](std::size_t index, std::uint64_t count) {
+    const auto exported_index =
+        grid.GetIndex(GetBucketLowest(index, kPrecisionBits));
+    auto& bucket = exported_index < bucket_count ? buckets[exported_index + 1]
+                                                 : buckets[0];
+    bucket.counter.fetch_add(count, std::memory_order_relaxed);
+  });
+
+  writer = impl::histogram::MakeView(buckets.get());
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
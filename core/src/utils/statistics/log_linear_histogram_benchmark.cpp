@@ -0,0 +1,68 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <utils/gbench_auxilary.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Same as the handler and http client timings
+using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+
+Percentile gPercentile{};
+utils::statistics::LogLinearHistogram gLogLinearHistogram{60'000};
+
+// Timings in milliseconds with a long tail
+std::vector<std::uint64_t> MakeValues() {
+  std::vector<std::uint64_t> values(1024);
+  for (auto& value : values) {
+    value = utils::RandRange(std::uint64_t{1}, std::uint64_t{50});
+    if (utils::RandRange(100) == 0) value *= 1'000;
+  }
+  return Launder(std::move(values));
+}
+
+}  // namespace
+
+void PercentileAccount(benchmark::State& state) {
+  const auto values = MakeValues();
+  while (state.KeepRunningBatch(values.size())) {
+    for (const auto value : values) gPercentile.Account(value);
+  }
+}
+BENCHMARK(PercentileAccount)->ThreadRange(1, 16);
+
+void LogLinearHistogramAccount(benchmark::State& state) {
+  const auto values = MakeValues();
+  while (state.KeepRunningBatch(values.size())) {
+    for (const auto value : values) gLogLinearHistogram.Account(value);
+  }
+}
+BENCHMARK(LogLinearHistogramAccount)->ThreadRange(1, 16);
+
+void PercentileGetPercentile(benchmark::State& state) {
+  Percentile percentile;
+  for (const auto value : MakeValues()) percentile.Account(value);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(percentile.GetPercentile(99));
+  }
+}
+BENCHMARK(PercentileGetPercentile);
+
+void LogLinearHistogramGetPercentile(benchmark::State& state) {
+  utils::statistics::LogLinearHistogram histogram{60'000};
+  for (const auto value : MakeValues()) histogram.Account(value);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(histogram.GetPercentile(99));
+  }
+}
+BENCHMARK(LogLinearHistogramGetPercentile);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,226 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string ToString(const utils::statistics::LogLinearHistogram& histogram) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+  const utils::statistics::Snapshot snapshot{storage};
+  return fmt::to_string(snapshot.SingleMetric("test"));
+}
+
+utils::statistics::HistogramView GetView(
+    const utils::statistics::Snapshot& snapshot) {
+  return snapshot.SingleMetric("test").AsHistogram();
+}
+
+}  // namespace
+
+UTEST(StatisticsLogLinearHistogram, Sample) {
+  /// [sample]
+  utils::statistics::Storage storage;
+
+  // Values above 10 are written to the "infinity" bucket
+  utils::statistics::LogLinearHistogram histogram{10};
+
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  histogram.Account(0);
+  histogram.Account(1);
+  histogram.Account(2, 2);  // Account 2 times
+  histogram.Account(9);
+  histogram.Account(10);
+  histogram.Account(11);
+  histogram.Account(500);
+
+  const utils::statistics::Snapshot snapshot{storage};
+  EXPECT_EQ(fmt::to_string(snapshot.SingleMetric("test")),
+            "[1]=2,[2]=2,[3]=0,[4]=0,[5]=0,[6]=0,[7]=0,[8]=0,[9]=1,[10]=1,"
+            "[inf]=2");
+
+  // The values are still accounted precisely
+  EXPECT_EQ(histogram.GetPercentile(100), 500);
+  /// [sample]
+}
+
+UTEST(StatisticsLogLinearHistogram, ExportedBounds) {
+  utils::statistics::Storage storage;
+  utils::statistics::LogLinearHistogram histogram{60'000};
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  histogram.Account(60'000);
+  histogram.Account(65'536);
+  histogram.Account(65'537);
+
+  const utils::statistics::Snapshot snapshot{storage};
+  const auto view = GetView(snapshot);
+  ASSERT_EQ(view.GetBucketCount(), 50);
+  // Two buckets per power of two below 128, four buckets from 128 on
+  const double expected_bounds[] = {1,   2,   3,   4,   6,   8,   12,
+                                    16,  24,  32,  48,  64,  96,  128,
+                                    160, 192, 224, 256, 320, 384};
+  for (std::size_t i = 0; i < std::size(expected_bounds); ++i) {
+    EXPECT_EQ(view.GetUpperBoundAt(i), expected_bounds[i]);
+  }
+  EXPECT_EQ(view.GetUpperBoundAt(47), 49'152);
+  EXPECT_EQ(view.GetUpperBoundAt(48), 57'344);
+  EXPECT_EQ(view.GetUpperBoundAt(49), 65'536);
+  EXPECT_EQ(view.GetValueAt(48), 1);
+  EXPECT_EQ(view.GetValueAt(49), 1);
+  EXPECT_EQ(view.GetValueAtInf(), 1);
+}
+
+UTEST(StatisticsLogLinearHistogram, ExportedBucketsLimit) {
+  for (const std::uint64_t max_value :
+       {std::uint64_t{1}, std::uint64_t{49}, std::uint64_t{50},
+        std::uint64_t{1'000}, std::uint64_t{1'000'000'000},
+        std::uint64_t{100'000'000'000'000}}) {
+    utils::statistics::Storage storage;
+    utils::statistics::LogLinearHistogram histogram{max_value};
+    auto statistics_holder = storage.RegisterWriter(
+        "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+    histogram.Account(max_value);
+
+    const utils::statistics::Snapshot snapshot{storage};
+    const auto view = GetView(snapshot);
+    EXPECT_LE(view.GetBucketCount(), 50) << max_value;
+    EXPECT_GE(view.GetUpperBoundAt(view.GetBucketCount() - 1),
+              static_cast<double>(max_value))
+        << max_value;
+    EXPECT_EQ(view.GetValueAtInf(), 0) << max_value;
+  }
+
+  // Only the powers of two fit, the largest values are not distinguished
+  utils::statistics::Storage storage;
+  utils::statistics::LogLinearHistogram histogram{
+      std::numeric_limits<std::uint64_t>::max()};
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+  const utils::statistics::Snapshot snapshot{storage};
+  EXPECT_EQ(GetView(snapshot).GetBucketCount(), 50);
+}
+
+UTEST(StatisticsLogLinearHistogram, RelativeError) {
+  constexpr std::uint64_t kMaxValue = 1'000'000'000'000;
+  for (std::uint64_t value = 1; value < kMaxValue; value = value * 3 + 1) {
+    utils::statistics::LogLinearHistogram histogram{1'000};
+    histogram.Account(value);
+    const auto estimate = histogram.GetPercentile(50);
+    EXPECT_GE(estimate, value);
+    EXPECT_LE(estimate, value + value / 32) << value;
+  }
+
+  utils::statistics::LogLinearHistogram histogram{1'000};
+  histogram.Account(std::numeric_limits<std::uint64_t>::max());
+  EXPECT_EQ(histogram.GetPercentile(50),
+            std::numeric_limits<std::uint64_t>::max());
+}
+
+UTEST(StatisticsLogLinearHistogram, Percentiles) {
+  utils::statistics::LogLinearHistogram histogram{1'000};
+  EXPECT_EQ(histogram.GetPercentile(50), 0);
+
+  for (std::uint64_t value = 1; value <= 1'000; ++value) {
+    histogram.Account(value);
+  }
+  EXPECT_EQ(histogram.GetTotalCount(), 1'000);
+
+  for (const double percent : {0.0, 10.0, 50.0, 90.0, 99.0, 99.9}) {
+    const auto exact = static_cast<std::uint64_t>(percent * 10) + 1;
+    const auto estimate = histogram.GetPercentile(percent);
+    EXPECT_GE(estimate, exact) << percent;
+    EXPECT_LE(estimate, exact + exact / 32) << percent;
+  }
+  EXPECT_EQ(histogram.GetPercentile(100), 1'000);
+}
+
+UTEST(StatisticsLogLinearHistogram, Add) {
+  utils::statistics::LogLinearHistogram first{1'000};
+  utils::statistics::LogLinearHistogram second{1'000};
+  utils::statistics::LogLinearHistogram all{1'000};
+  for (std::uint64_t value = 0; value < 3'000; value += 7) {
+    (value % 2 ? first : second).Account(value);
+    all.Account(value);
+  }
+
+  first.Add(second);
+  EXPECT_EQ(first.GetTotalCount(), all.GetTotalCount());
+  for (const double percent : {1.0, 50.0, 95.0, 100.0}) {
+    EXPECT_EQ(first.GetPercentile(percent), all.GetPercentile(percent));
+  }
+  EXPECT_EQ(ToString(first), ToString(all));
+}
+
+UTEST(StatisticsLogLinearHistogram, CopyAndReset) {
+  utils::statistics::LogLinearHistogram histogram{100};
+  histogram.Account(5);
+  histogram.Account(5'000, 2);
+
+  utils::statistics::LogLinearHistogram copy{histogram};
+  EXPECT_EQ(copy.GetTotalCount(), 3);
+  EXPECT_EQ(ToString(copy), ToString(histogram));
+
+  ResetMetric(histogram);
+  EXPECT_EQ(histogram.GetTotalCount(), 0);
+  EXPECT_EQ(copy.GetTotalCount(), 3);
+
+  copy = histogram;
+  EXPECT_EQ(copy.GetTotalCount(), 0);
+}
+
+UTEST(StatisticsLogLinearHistogram, Prometheus) {
+  utils::statistics::Storage storage;
+  utils::statistics::LogLinearHistogram histogram{3};
+  auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+  histogram.Account(0);
+  histogram.Account(3);
+  histogram.Account(100);
+
+  constexpr std::string_view expected = R"(# TYPE test histogram
+test_bucket{le="1"} 1
+test_bucket{le="2"} 1
+test_bucket{le="3"} 2
+test_bucket{le="+Inf"} 3
+test_count{} 3
+)";
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage), expected);
+}
+
+UTEST_MT(StatisticsLogLinearHistogram, Concurrent, 4) {
+  constexpr std::size_t kTasks = 8;
+  constexpr std::uint64_t kValuesPerTask = 10'000;
+  utils::statistics::LogLinearHistogram histogram{1'000};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&histogram] {
+      for (std::uint64_t value = 0; value < kValuesPerTask; ++value) {
+        histogram.Account(value);
+      }
+    }));
+  }
+  engine::GetAll(tasks);
+
+  EXPECT_EQ(histogram.GetTotalCount(), kTasks * kValuesPerTask);
+}
+
+USERVER_NAMESPACE_END
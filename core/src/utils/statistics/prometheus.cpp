@@ -1,12 +1,16 @@
 #include <userver/utils/statistics/prometheus.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -22,10 +26,63 @@ namespace {
 
 enum class Typed { kYes, kNo };
 
+// Metric and label names converted to Prometheus format
+struct ConvertedNames final {
+  utils::impl::TransparentMap<std::string, std::string> metrics;
+  utils::impl::TransparentMap<std::string, std::string> labels;
+};
+
+// Don't let the cache grow indefinitely if the names are generated
+constexpr std::size_t kMaxCachedNames = 100'000;
+
+// Looks up the names converted by the previous calls first, then the names
+// converted during this call
+class NamesConverter final {
+ public:
+  explicit NamesConverter(const ConvertedNames* cached) : cached_(cached) {}
+
+  const std::string& GetMetricName(std::string_view name) {
+    return Get(name, &ConvertedNames::metrics, &impl::ToPrometheusName);
+  }
+
+  const std::string& GetLabelName(std::string_view name) {
+    return Get(name, &ConvertedNames::labels, &impl::ToPrometheusLabel);
+  }
+
+  ConvertedNames& GetNewNames() noexcept { return new_; }
+
+ private:
+  using Names = utils::impl::TransparentMap<std::string, std::string>;
+
+  const std::string& Get(std::string_view name, Names ConvertedNames::*names,
+                         std::string (*convert)(std::string_view)) {
+    if (cached_) {
+      if (const auto* const converted =
+              utils::impl::FindTransparentOrNullptr(cached_->*names, name)) {
+        return *converted;
+      }
+    }
+
+    auto& new_names = new_.*names;
+    if (const auto* const converted =
+            utils::impl::FindTransparentOrNullptr(new_names, name)) {
+      return *converted;
+    }
+    return new_names.emplace(std::string{name}, convert(name)).first->second;
+  }
+
+  const ConvertedNames* const cached_;
+  ConvertedNames new_;
+};
+
+// Original paths of the metrics with a `# TYPE` line already written
+using TypedMetrics = utils::impl::TransparentSet<std::string>;
+
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
  public:
-  explicit FormatBuilder() = default;
+  explicit FormatBuilder(const ConvertedNames* cached_names = nullptr)
+      : names_(cached_names) {}
 
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
@@ -41,6 +98,20 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
 
   std::string Release() { return fmt::to_string(buf_); }
 
+  // Appends the output to `out`, skipping the `# TYPE` lines of the metrics
+  // that were typed by the builders of the preceding parts
+  void AppendTo(std::string& out, TypedMetrics& typed_metrics) const {
+    std::size_t position = 0;
+    for (const auto& line : type_lines_) {
+      if (typed_metrics.insert(line.metric).second) continue;
+      out.append(buf_.data() + position, line.begin - position);
+      position = line.end;
+    }
+    out.append(buf_.data() + position, buf_.size() - position);
+  }
+
+  ConvertedNames& GetNewNames() noexcept { return names_.GetNewNames(); }
+
  private:
   void AppendHistogramMetric(std::string_view metric_suffix,
                              std::string_view path,
@@ -67,7 +138,7 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
                        const MetricValue& value) {
     static constexpr std::string_view kBucket = "bucket";
 
-    const auto prometheus_name = impl::ToPrometheusName(path);
+    const auto& prometheus_name = names_.GetMetricName(path);
     DumpMetricType(prometheus_name, value);
 
     auto histogram = value.AsHistogram();
@@ -90,14 +161,19 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
   void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
     if (const auto* const converted =
             utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
+      buf_.append(**converted);
       return;
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
+    const auto& prometheus_name = names_.GetMetricName(name);
+    const auto type_begin = buf_.size();
     DumpMetricType(prometheus_name, value);
+    if (buf_.size() != type_begin) {
+      type_lines_.push_back(
+          TypeLine{type_begin, buf_.size(), std::string{name}});
+    }
     buf_.append(prometheus_name);
-    metrics_.emplace(name, std::move(prometheus_name));
+    metrics_.emplace(name, &prometheus_name);
   }
 
   void DumpMetricType([[maybe_unused]] std::string_view prometheus_name,
@@ -129,7 +205,7 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
         buf_.push_back(',');
       }
       fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""),
-                     impl::ToPrometheusLabel(label.Name()));
+                     names_.GetLabelName(label.Name()));
       const auto& value = label.Value();
       std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_),
                         '"', '\'');
@@ -144,10 +220,28 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
     buf_.push_back('}');
   }
 
+  struct TypeLine final {
+    std::size_t begin;
+    std::size_t end;
+    std::string metric;
+  };
+
   fmt::memory_buffer buf_;
-  utils::impl::TransparentMap<std::string, std::string> metrics_;
+  NamesConverter names_;
+  // Metrics typed by this builder
+  utils::impl::TransparentMap<std::string, const std::string*> metrics_;
+  std::vector<TypeLine> type_lines_;
 };
 
+void MergeNames(ConvertedNames& to, ConvertedNames&& from) {
+  for (auto& [name, converted] : from.metrics) {
+    to.metrics.emplace(name, std::move(converted));
+  }
+  for (auto& [name, converted] : from.labels) {
+    to.labels.emplace(name, std::move(converted));
+  }
+}
+
 }  // namespace
 
 std::string ToPrometheusName(std::string_view data) {
@@ -182,6 +276,94 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 }  // namespace impl
 
+struct PrometheusFormatter::Impl final {
+  Impl(const Storage& storage, Format format, std::size_t parallel_tasks)
+      : storage(storage), format(format), parallel_tasks(parallel_tasks) {}
+
+  template <impl::Typed IsTyped>
+  void ToStream(const Request& request,
+                const std::function<void(std::string&&)>& consumer) {
+    using Builder = impl::FormatBuilder<IsTyped>;
+
+    const auto cached_names = names.Read();
+    std::vector<std::unique_ptr<Builder>> builders;
+    std::vector<BaseFormatBuilder*> builder_ptrs;
+    for (std::size_t i = 0; i < parallel_tasks; ++i) {
+      builders.push_back(std::make_unique<Builder>(&*cached_names));
+      builder_ptrs.push_back(builders.back().get());
+    }
+
+    impl::TypedMetrics typed_metrics;
+    impl::ConvertedNames new_names;
+    storage.VisitMetricsInParallel(
+        builder_ptrs,
+        [&](std::size_t part) {
+          std::string chunk;
+          builders[part]->AppendTo(chunk, typed_metrics);
+          if (!names_cache_full) {
+            impl::MergeNames(new_names,
+                             std::move(builders[part]->GetNewNames()));
+          }
+          // The output of the part is not needed anymore
+          builders[part].reset();
+          consumer(std::move(chunk));
+        },
+        request);
+
+    if (new_names.metrics.empty() && new_names.labels.empty()) return;
+    auto writer = names.StartWrite();
+    impl::MergeNames(*writer, std::move(new_names));
+    if (writer->metrics.size() + writer->labels.size() >
+        impl::kMaxCachedNames) {
+      // Copying the cache on every scrape costs more than the conversions it
+      // saves, the names that did not fit are converted on every scrape
+      names_cache_full = true;
+      return;
+    }
+    writer.Commit();
+  }
+
+  const Storage& storage;
+  const Format format;
+  const std::size_t parallel_tasks;
+  rcu::Variable<impl::ConvertedNames> names;
+  std::atomic<bool> names_cache_full{false};
+};
+
+PrometheusFormatter::PrometheusFormatter(const Storage& storage, Format format,
+                                         std::size_t parallel_tasks)
+    : impl_(std::make_unique<Impl>(storage, format, parallel_tasks)) {
+  UINVARIANT(parallel_tasks != 0, "At least one task is required");
+}
+
+PrometheusFormatter::~PrometheusFormatter() = default;
+
+std::string PrometheusFormatter::ToString(const Request& request) const {
+  std::string result;
+  ToStream(request, [&result](std::string&& chunk) {
+    if (result.empty()) {
+      result = std::move(chunk);
+    } else {
+      result += chunk;
+    }
+  });
+  return result;
+}
+
+void PrometheusFormatter::ToStream(
+    const Request& request,
+    const std::function<void(std::string&& chunk)>& consumer) const {
+  switch (impl_->format) {
+    case Format::kTyped:
+      impl_->ToStream<impl::Typed::kYes>(request, consumer);
+      return;
+    case Format::kUntyped:
+      impl_->ToStream<impl::Typed::kNo>(request, consumer);
+      return;
+  }
+  UINVARIANT(false, "Unexpected PrometheusFormatter::Format");
+}
+
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request) {
   impl::FormatBuilder<impl::Typed::kYes> builder{};
@@ -0,0 +1,70 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWriters = 100;
+constexpr std::size_t kSeriesPerWriter = 1'000;
+
+// 100k metric series, as in a service with many handlers and clients
+std::vector<utils::statistics::Entry> RegisterWriters(
+    utils::statistics::Storage& storage) {
+  std::vector<utils::statistics::Entry> entries;
+  for (std::size_t i = 0; i < kWriters; ++i) {
+    entries.push_back(storage.RegisterWriter(
+        "bench.component." + std::to_string(i),
+        [](utils::statistics::Writer& writer) {
+          for (std::size_t j = 0; j < kSeriesPerWriter; ++j) {
+            writer["timings"]["series"].ValueWithLabels(
+                j, {{"http_path", "/v1/handler/" + std::to_string(j % 100)},
+                    {"http_code", std::to_string(200 + j / 100)}});
+          }
+        }));
+  }
+  return entries;
+}
+
+}  // namespace
+
+void PrometheusFormat(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto entries = RegisterWriters(storage);
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+  });
+}
+BENCHMARK(PrometheusFormat)->Unit(benchmark::kMillisecond);
+
+void PrometheusFormatter(benchmark::State& state) {
+  const auto tasks = static_cast<std::size_t>(state.range(0));
+  engine::RunStandalone(tasks, [&] {
+    utils::statistics::Storage storage;
+    const auto entries = RegisterWriters(storage);
+    const utils::statistics::PrometheusFormatter formatter{
+        storage, utils::statistics::PrometheusFormatter::Format::kTyped,
+        tasks};
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(formatter.ToString());
+    }
+  });
+}
+BENCHMARK(PrometheusFormatter)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
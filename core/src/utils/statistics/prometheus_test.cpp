@@ -409,6 +409,76 @@ child{application="processing"} 8
   }
 }
 
+namespace {
+
+class PrometheusFormatterTest : public ::testing::Test {
+ protected:
+  PrometheusFormatterTest() {
+    for (int i = 0; i < 5; ++i) {
+      entries_.push_back(storage_.RegisterWriter(
+          "test", [i](utils::statistics::Writer& writer) {
+            // Same metric in all the writers
+            writer["shared"].ValueWithLabels(
+                i, {{"writer", std::to_string(i)}, {"label.name", "value"}});
+            writer["own"][std::to_string(i)] = utils::statistics::Rate{42};
+          }));
+    }
+    entries_.push_back(storage_.RegisterExtender(
+        "legacy", [](const utils::statistics::StatisticsRequest&) {
+          formats::json::ValueBuilder result;
+          result["value"] = 1;
+          return result;
+        }));
+  }
+
+  const utils::statistics::Storage& GetStorage() const { return storage_; }
+
+ private:
+  utils::statistics::Storage storage_;
+  std::vector<utils::statistics::Entry> entries_;
+};
+
+using Formatter = utils::statistics::PrometheusFormatter;
+
+}  // namespace
+
+UTEST_F_MT(PrometheusFormatterTest, SameAsToPrometheusFormat, 4) {
+  const auto typed = ToPrometheusFormat(GetStorage());
+  const auto untyped = ToPrometheusFormatUntyped(GetStorage());
+
+  for (const std::size_t tasks : {1, 2, 3, 8}) {
+    const Formatter typed_formatter{GetStorage(), Formatter::Format::kTyped,
+                                    tasks};
+    const Formatter untyped_formatter{GetStorage(),
+                                      Formatter::Format::kUntyped, tasks};
+    // The second call uses the cached names
+    for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(typed_formatter.ToString(), typed) << tasks;
+      EXPECT_EQ(untyped_formatter.ToString(), untyped) << tasks;
+    }
+  }
+}
+
+UTEST_F_MT(PrometheusFormatterTest, Stream, 4) {
+  const Formatter formatter{GetStorage(), Formatter::Format::kTyped, 3};
+  const auto request = utils::statistics::Request::MakeWithPrefix(
+      "test", {{"application", "processing"}});
+
+  std::vector<std::string> chunks;
+  formatter.ToStream(request, [&chunks](std::string&& chunk) {
+    chunks.push_back(std::move(chunk));
+  });
+
+  ASSERT_EQ(chunks.size(), 3);
+  const auto result = utils::text::Join(chunks, "");
+  EXPECT_EQ(result, ToPrometheusFormat(GetStorage(), request));
+
+  // The type is written once, by the first part
+  const std::string_view type_line = "# TYPE test_shared gauge";
+  EXPECT_NE(chunks[0].find(type_line), std::string::npos);
+  EXPECT_EQ(result.find(type_line), result.rfind(type_line));
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
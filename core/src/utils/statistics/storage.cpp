@@ -8,6 +8,7 @@
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/text_light.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
@@ -35,6 +36,44 @@ void RemoveAddedLabels(std::vector<Label>& labels,
                labels.end());
 }
 
+using LabelsVector = boost::container::small_vector<LabelView, 16>;
+
+void VisitWriter(impl::WriterState& state, LabelsVector& labels_vector,
+                 const impl::MetricsSource& entry) {
+  UASSERT(entry.writer);
+  labels_vector.clear();
+  labels_vector.reserve(entry.writer_labels.size());
+  for (const auto& l : entry.writer_labels) {
+    labels_vector.emplace_back(l);
+  }
+
+  try {
+    auto writer =
+        (entry.prefix_path.empty()
+             ? Writer{state, LabelsSpan{labels_vector}}
+             : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
+    if (writer) {
+      LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
+      entry.writer(writer);
+    }
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false,
+                fmt::format("Failed to write metrics for prefix '{}': {}",
+                            entry.prefix_path, e.what()));
+    LOG_ERROR() << "Failed to write metrics for prefix '" << entry.prefix_path
+                << "': " << e;
+  }
+}
+
+impl::WriterState MakeWriterState(BaseFormatBuilder& out,
+                                  const Request& request) {
+  impl::WriterState state{out, request, {}, {}};
+  for (const auto& [name, value] : request.add_labels) {
+    state.add_labels.emplace_back(name, value);
+  }
+  return state;
+}
+
 class FakeFormatBuilder final : public BaseFormatBuilder {
  public:
   void HandleMetric(std::string_view, LabelsSpan, const MetricValue&) override {
@@ -119,45 +158,68 @@ formats::json::Value Storage::GetAsJson() const {
 void Storage::VisitMetrics(BaseFormatBuilder& out,
                            const Request& request) const {
   {
-    impl::WriterState state{out, request, {}, {}};
-    for (const auto& [name, value] : request.add_labels) {
-      state.add_labels.emplace_back(name, value);
-    }
-
-    boost::container::small_vector<LabelView, 16> labels_vector;
+    auto state = MakeWriterState(out, request);
+    LabelsVector labels_vector;
 
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
       if (!entry.writer) {
         continue;
       }
+      VisitWriter(state, labels_vector, entry);
+    }
+  }
 
-      labels_vector.clear();
-      labels_vector.reserve(entry.writer_labels.size());
-      for (const auto& l : entry.writer_labels) {
-        labels_vector.emplace_back(l);
-      }
+  statistics::VisitMetrics(out, GetAsJson(), request);
+}
 
-      try {
-        auto writer =
-            (entry.prefix_path.empty()
-                 ? Writer{state, LabelsSpan{labels_vector}}
-                 : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
-        if (writer) {
-          LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-          entry.writer(writer);
-        }
-      } catch (const std::exception& e) {
-        UASSERT_MSG(false,
-                    fmt::format("Failed to write metrics for prefix '{}': {}",
-                                entry.prefix_path, e.what()));
-        LOG_ERROR() << "Failed to write metrics for prefix '"
-                    << entry.prefix_path << "': " << e;
-      }
+void Storage::VisitMetricsInParallel(
+    utils::span<BaseFormatBuilder* const> builders,
+    const std::function<void(std::size_t part)>& on_part_visited,
+    const Request& request) const {
+  UINVARIANT(!builders.empty(), "At least one builder is required");
+  const auto parts = builders.size();
+
+  if (parts == 1) {
+    VisitMetrics(*builders[0], request);
+    on_part_visited(0);
+    return;
+  }
+
+  {
+    std::shared_lock lock(mutex_);
+    std::vector<const impl::MetricsSource*> writers;
+    for (const auto& entry : metrics_sources_) {
+      if (entry.writer) writers.push_back(&entry);
+    }
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(parts);
+    for (std::size_t part = 0; part < parts; ++part) {
+      const auto begin = writers.size() * part / parts;
+      const auto end = writers.size() * (part + 1) / parts;
+      // The scrape waits for all the parts, none of them may be cancelled
+      // on its own
+      tasks.push_back(utils::CriticalAsync(
+          "statistics-visit-metrics",
+          [&writers, &request, begin, end, &builder = *builders[part]] {
+            auto state = MakeWriterState(builder, request);
+            LabelsVector labels_vector;
+            for (auto i = begin; i < end; ++i) {
+              VisitWriter(state, labels_vector, *writers[i]);
+            }
+          }));
     }
+
+    for (std::size_t part = 0; part + 1 < parts; ++part) {
+      tasks[part].Get();
+      on_part_visited(part);
+    }
+    tasks.back().Get();
   }
 
-  statistics::VisitMetrics(out, GetAsJson(), request);
+  statistics::VisitMetrics(*builders[parts - 1], GetAsJson(), request);
+  on_part_visited(parts - 1);
 }
 
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
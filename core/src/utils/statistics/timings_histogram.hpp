@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+// Timings up to a minute are distinguished in the summable
+// utils::statistics::LogLinearHistogram of the HTTP handlers and clients
+inline constexpr std::uint64_t kTimingsHistogramMaxMs = 60'000;
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
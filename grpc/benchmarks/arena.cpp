@@ -0,0 +1,95 @@
+#include <string>
+
+#include <google/protobuf/arena.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/ugrpc/arena.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kArenaInitialBlockSize = 4096;
+constexpr std::size_t kNameSize = 64;
+
+class ArenaUnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    auto* response =
+        google::protobuf::Arena::CreateMessage<sample::ugrpc::GreetingResponse>(
+            call.GetArena());
+    response->set_name("Hello " + request.name());
+    call.Finish(*response);
+    if (!call.GetArena()) delete response;
+  }
+};
+
+ugrpc::server::ServerConfig MakeServerConfig(std::size_t arena_block_size) {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.arena_initial_block_size = arena_block_size;
+  return config;
+}
+
+template <typename Message>
+void FillMessage(Message& message) {
+  message.set_name(std::string(kNameSize, 'x'));
+}
+
+}  // namespace
+
+// Arg: arena initial block size, 0 disables arenas
+void UnaryRPCArena(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    ugrpc::tests::Service<ArenaUnitTestService> service(
+        dynamic_config::MakeDefaultStorage({}),
+        MakeServerConfig(state.range(0)));
+    auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+    sample::ugrpc::GreetingRequest request;
+    FillMessage(request);
+    for (auto _ : state) {
+      auto response = client.SayHello(request).Finish();
+      benchmark::DoNotOptimize(response);
+    }
+  });
+}
+BENCHMARK(UnaryRPCArena)
+    ->Arg(0)
+    ->Arg(kArenaInitialBlockSize)
+    ->Unit(benchmark::kMicrosecond);
+
+void MessageHeap(benchmark::State& state) {
+  for (auto _ : state) {
+    sample::ugrpc::StreamGreetingRequest message;
+    FillMessage(message);
+    benchmark::DoNotOptimize(message);
+  }
+}
+BENCHMARK(MessageHeap);
+
+void MessageArena(benchmark::State& state) {
+  const auto options = ugrpc::MakeArenaOptions(kArenaInitialBlockSize);
+  std::uint64_t space_allocated = 0;
+  for (auto _ : state) {
+    google::protobuf::Arena arena(options);
+    auto* message = google::protobuf::Arena::CreateMessage<
+        sample::ugrpc::StreamGreetingRequest>(&arena);
+    FillMessage(*message);
+    benchmark::DoNotOptimize(message);
+    space_allocated += arena.SpaceAllocated();
+  }
+  state.counters["arena_bytes"] = benchmark::Counter(
+      space_allocated, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(MessageArena);
+
+USERVER_NAMESPACE_END
@@ -120,6 +120,50 @@ void UnaryRPC(benchmark::State& state) {
 
 BENCHMARK(UnaryRPC)->DenseRange(1, 4)->Unit(benchmark::kMicrosecond);
 
+namespace {
+
+enum class QueuePolling {
+  kThreads = 0,
+  kPinnedThreads = 1,
+  kTaskProcessor = 2,
+};
+
+server::ServerConfig MakeServerConfig(int completion_queue_num,
+                                      QueuePolling polling) {
+  server::ServerConfig config;
+  config.port = 0;
+  config.completion_queue_num = completion_queue_num;
+  config.pin_completion_queues = polling == QueuePolling::kPinnedThreads;
+  if (polling == QueuePolling::kTaskProcessor) {
+    config.completion_queue_task_processor =
+        &engine::current_task::GetTaskProcessor();
+  }
+  return config;
+}
+
+}  // namespace
+
+// Args: completion queue count, how the queues are polled (see QueuePolling)
+void UnaryRPCCompletionQueues(benchmark::State& state) {
+  static constexpr std::size_t kWorkerThreads = 4;
+  engine::RunStandalone(kWorkerThreads, [&] {
+    GrpcClientTest client_factory(
+        dynamic_config::MakeDefaultStorage({}),
+        MakeServerConfig(state.range(0),
+                         static_cast<QueuePolling>(state.range(1))));
+    auto client =
+        client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+    for (auto _ : state) {
+      UnaryRPCPayload(client);
+    }
+  });
+}
+
+BENCHMARK(UnaryRPCCompletionQueues)
+    ->ArgsProduct({{1, 2, 4}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
 void UnaryRPCNewClient(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     GrpcClientTest client_factory;
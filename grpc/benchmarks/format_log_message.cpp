@@ -1,9 +1,13 @@
 #include <userver/ugrpc/server/rpc.hpp>
 
+#include <userver/utils/log.hpp>
 #include <userver/utils/text.hpp>
 
 #include <benchmark/benchmark.h>
 
+#include <tests/messages.pb.h>
+#include <ugrpc/impl/protobuf_utils.hpp>
+
 using namespace std::chrono_literals;
 
 USERVER_NAMESPACE_BEGIN
@@ -44,4 +48,42 @@ void FormatLogMessage(benchmark::State& state) {
 
 BENCHMARK(FormatLogMessage);
 
+namespace {
+
+constexpr std::size_t kMessageLogLimit = 512;
+
+sample::ugrpc::JsonMessage MakeLoggedMessage(std::size_t size) {
+  sample::ugrpc::JsonMessage message;
+  message.set_string_field("some string value");
+  for (std::size_t i = 0; i < size; ++i) {
+    auto& nested = *message.add_repeated_nested();
+    nested.set_number(static_cast<std::int32_t>(i));
+    nested.set_name("name " + std::to_string(i));
+  }
+  return message;
+}
+
+}  // namespace
+
+void FormatMessageDebugString(benchmark::State& state) {
+  const auto message = MakeLoggedMessage(state.range(0));
+  for (auto _ : state) {
+    auto result = utils::log::ToLimitedUtf8(message.Utf8DebugString(),
+                                            kMessageLogLimit);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+void FormatMessageLimited(benchmark::State& state) {
+  const auto message = MakeLoggedMessage(state.range(0));
+  for (auto _ : state) {
+    auto result =
+        ugrpc::impl::ToLimitedDebugString(message, kMessageLogLimit);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(FormatMessageDebugString)->RangeMultiplier(8)->Range(1, 4096);
+BENCHMARK(FormatMessageLimited)->RangeMultiplier(8)->Range(1, 4096);
+
 USERVER_NAMESPACE_END
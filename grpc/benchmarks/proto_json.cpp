@@ -0,0 +1,83 @@
+#include <userver/ugrpc/proto_json.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/formats/json/string_builder.hpp>
+
+#include <tests/messages.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+sample::ugrpc::JsonMessage MakeMessage(std::size_t size) {
+  sample::ugrpc::JsonMessage message;
+  message.set_int32_field(42);
+  message.set_int64_field(1234567890123);
+  message.set_double_field(3.25);
+  message.set_string_field("some string value");
+  message.set_enum_field(sample::ugrpc::JSON_ENUM_FIRST);
+  message.mutable_nested()->set_name("nested");
+  for (std::size_t i = 0; i < size; ++i) {
+    message.add_repeated_int32(static_cast<std::int32_t>(i));
+    auto& nested = *message.add_repeated_nested();
+    nested.set_number(static_cast<std::int32_t>(i));
+    nested.set_name("name " + std::to_string(i));
+    (*message.mutable_string_map())["key " + std::to_string(i)] =
+        static_cast<std::int32_t>(i);
+  }
+  return message;
+}
+
+}  // namespace
+
+void ProtoToJsonValue(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ugrpc::MessageToJson(message));
+  }
+}
+
+void ProtoToJsonString(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ugrpc::ToJsonString(message));
+  }
+}
+
+void ProtoToJsonStringBuilder(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for (auto _ : state) {
+    formats::json::StringBuilder sw;
+    ugrpc::WriteMessageToJson(message, sw);
+    benchmark::DoNotOptimize(sw.GetStringView());
+  }
+}
+
+void JsonToProtoProtobuf(benchmark::State& state) {
+  const auto json = ugrpc::ToJsonString(MakeMessage(state.range(0)));
+  for (auto _ : state) {
+    sample::ugrpc::JsonMessage message;
+    const auto status =
+        google::protobuf::util::JsonStringToMessage(json, &message);
+    benchmark::DoNotOptimize(status);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+void JsonToProtoSax(benchmark::State& state) {
+  const auto json = ugrpc::ToJsonString(MakeMessage(state.range(0)));
+  for (auto _ : state) {
+    sample::ugrpc::JsonMessage message;
+    ugrpc::ParseMessageFromJson(json, message);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(ProtoToJsonValue)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(ProtoToJsonString)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(ProtoToJsonStringBuilder)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(JsonToProtoProtobuf)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(JsonToProtoSax)->RangeMultiplier(8)->Range(1, 512);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/ugrpc/arena.hpp
+/// @brief Utilities for allocating protobuf messages on arenas
+
+#include <cstddef>
+
+#include <google/protobuf/arena.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+/// @brief Creates options for a google::protobuf::Arena, whose memory blocks
+/// are taken from and returned to a small thread-local pool
+///
+/// Arenas are useful for large nested messages: the whole message is freed
+/// at once together with the arena instead of per-field deallocations.
+/// Messages created on arenas must not outlive the arena. Moving a message
+/// out of an arena performs a deep copy.
+///
+/// @param initial_block_size the size of the first memory block of an arena
+google::protobuf::ArenaOptions MakeArenaOptions(std::size_t initial_block_size);
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
@@ -47,6 +47,8 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// max-channel-count | Number of grpc::Channel objects the pool may grow to under load | channel-count
+/// max-streams-per-channel | In-flight RPCs per channel that trigger pool growth | 100
 /// middlewares | middlewares names to use | []
 ///
 ///
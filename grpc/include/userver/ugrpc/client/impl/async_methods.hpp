@@ -154,6 +154,9 @@ class RpcData final {
   };
 
  private:
+  // Keeps the RPC accounted on its channel until all the other members are
+  // destroyed
+  ChannelCache::Lease channel_lease_;
   std::unique_ptr<grpc::ClientContext> context_;
   std::string client_name_;
   std::string_view call_name_;
@@ -24,6 +24,7 @@ struct CallParams {
   std::unique_ptr<grpc::ClientContext> context;
   ugrpc::impl::MethodStatistics& statistics;
   const Middlewares& mws;
+  ChannelCache::Lease channel_lease;
 };
 
 CallParams DoCreateCallParams(const ClientData&, std::size_t method_id,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -12,33 +13,87 @@
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+struct ChannelPoolSettings final {
+  /// Number of channels that are in use from the start
+  std::size_t channel_count{1};
+
+  /// Number of channels the pool may grow to under load
+  std::size_t max_channel_count{1};
+
+  /// In-flight RPCs per channel after which a new channel is activated
+  std::size_t max_streams_per_channel{100};
+};
+
+/// A set of grpc::Channel to the same endpoint. Calls are spread over the
+/// active channels by the number of in-flight RPCs; once every active channel
+/// carries `max_streams_per_channel` RPCs, one more channel is activated.
+/// Activated channels stay active for the lifetime of the pool.
+class ChannelPool final {
+ public:
+  ChannelPool(const std::string& endpoint,
+              const std::shared_ptr<grpc::ChannelCredentials>& credentials,
+              const grpc::ChannelArguments& channel_args,
+              const ChannelPoolSettings& settings);
+
+  std::size_t GetChannelCount() const noexcept;
+
+  std::size_t GetActiveChannelCount() const noexcept;
+
+  const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
+      noexcept;
+
+  std::uint64_t GetStreamCount(std::size_t index) const noexcept;
+
+  // Picks the least loaded channel and accounts a new RPC on it
+  std::size_t Acquire() noexcept;
+
+  void Release(std::size_t index) noexcept;
+
+ private:
+  struct Channel final {
+    std::shared_ptr<grpc::Channel> channel;
+    std::atomic<std::uint64_t> streams{0};
+  };
+
+  utils::FixedArray<Channel> channels_;
+  std::atomic<std::size_t> active_count_;
+  const std::uint64_t max_streams_per_channel_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const ChannelPool& pool);
+
 class ChannelCache final {
  public:
   ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
                const grpc::ChannelArguments& channel_args,
-               std::size_t channel_count);
+               const ChannelPoolSettings& settings);
 
   ~ChannelCache();
 
   class Token;
+  class Lease;
 
   // The grpc::Channel is kept in cache as long as some Token pointing to it is
   // alive.
   Token Get(const std::string& endpoint);
 
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const ChannelCache& cache);
+
  private:
   struct CountedChannel final {
     CountedChannel(const std::string& endpoint,
                    const std::shared_ptr<grpc::ChannelCredentials>& credentials,
                    const grpc::ChannelArguments& channel_args,
-                   std::size_t count);
+                   const ChannelPoolSettings& settings);
 
-    utils::FixedArray<std::shared_ptr<grpc::Channel>> channels;
+    std::shared_ptr<ChannelPool> pool;
     std::uint64_t counter{0};
   };
 
@@ -46,10 +101,28 @@ class ChannelCache final {
 
   const std::shared_ptr<grpc::ChannelCredentials> credentials_;
   const grpc::ChannelArguments channel_args_;
-  const std::size_t channel_count_;
+  const ChannelPoolSettings settings_;
   concurrent::Variable<Map> channels_;
 };
 
+/// Marks an RPC as in-flight on one of the channels of a pool for as long
+/// as the lease is alive
+class ChannelCache::Lease final {
+ public:
+  Lease() noexcept = default;
+  Lease(std::shared_ptr<ChannelPool> pool, std::size_t index) noexcept;
+
+  Lease(Lease&&) noexcept;
+  Lease& operator=(Lease&&) noexcept;
+  ~Lease();
+
+  std::size_t GetIndex() const noexcept;
+
+ private:
+  std::shared_ptr<ChannelPool> pool_;
+  std::size_t index_{0};
+};
+
 class ChannelCache::Token final {
  public:
   Token() noexcept = default;
@@ -64,9 +137,13 @@ class ChannelCache::Token final {
 
   std::size_t GetChannelCount() const noexcept;
 
+  std::size_t GetActiveChannelCount() const noexcept;
+
   const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
       noexcept;
 
+  Lease AcquireChannel() const noexcept;
+
  private:
   ChannelCache* cache_{nullptr};
   const std::string* endpoint_{nullptr};
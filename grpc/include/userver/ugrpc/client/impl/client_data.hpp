@@ -13,8 +13,8 @@
 #include <userver/ugrpc/client/middlewares/fwd.hpp>
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/fixed_array.hpp>
-#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -57,9 +57,9 @@ class ClientData final {
   ClientData& operator=(const ClientData&) = delete;
 
   template <typename Service>
-  Stub<Service>& NextStub() const {
-    return *static_cast<Stub<Service>*>(
-        stubs_[utils::RandRange(stubs_.size())].get());
+  Stub<Service>& GetStub(const ChannelCache::Lease& lease) const {
+    UASSERT(lease.GetIndex() < stubs_.size());
+    return *static_cast<Stub<Service>*>(stubs_[lease.GetIndex()].get());
   }
 
   grpc::CompletionQueue& GetQueue() const { return params_.queue; }
@@ -74,6 +74,10 @@ class ClientData final {
 
   ChannelCache::Token& GetChannelToken() { return params_.channel_token; }
 
+  const ChannelCache::Token& GetChannelToken() const {
+    return params_.channel_token;
+  }
+
   std::string_view GetClientName() const { return params_.client_name; }
 
   const Middlewares& GetMiddlewares() const { return params_.mws; }
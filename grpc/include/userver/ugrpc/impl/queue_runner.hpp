@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/engine/single_use_event.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -10,12 +15,22 @@ namespace ugrpc::impl {
 
 class QueueRunner final {
  public:
-  explicit QueueRunner(grpc::CompletionQueue& queue);
+  /// @param cpu if set, the polling thread is pinned to this CPU core
+  explicit QueueRunner(grpc::CompletionQueue& queue,
+                       std::optional<std::size_t> cpu = std::nullopt);
+
+  /// Polls the queue from a task of `task_processor` instead of a dedicated
+  /// thread, so that the completions are handled by the task processor
+  /// workers without waking up another thread
+  QueueRunner(grpc::CompletionQueue& queue,
+              engine::TaskProcessor& task_processor);
+
   ~QueueRunner();
 
  private:
   grpc::CompletionQueue& queue_;
   engine::SingleUseEvent completion_;
+  engine::Task poller_;
 };
 
 }  // namespace ugrpc::impl
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <functional>
 #include <string_view>
 #include <unordered_map>
 
 #include <userver/engine/shared_mutex.hpp>
 #include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 #include <userver/ugrpc/impl/statistics.hpp>
 
@@ -16,8 +18,13 @@ namespace ugrpc::impl {
 /// for storing their statistics.
 class StatisticsStorage final {
  public:
+  using ExtraWriterFunc = std::function<void(utils::statistics::Writer&)>;
+
+  /// `extra_writer` writes the domain metrics that are not per-service, it is
+  /// called by the same writer as the service metrics
   explicit StatisticsStorage(utils::statistics::Storage& statistics_storage,
-                             StatisticsDomain domain);
+                             StatisticsDomain domain,
+                             ExtraWriterFunc extra_writer = {});
 
   StatisticsStorage(const StatisticsStorage&) = delete;
   StatisticsStorage& operator=(const StatisticsStorage&) = delete;
@@ -46,6 +53,7 @@ class StatisticsStorage final {
   };
 
   const StatisticsDomain domain_;
+  const ExtraWriterFunc extra_writer_;
 
   std::unordered_map<ServiceId, ugrpc::impl::ServiceStatistics,
                      std::hash<ServiceId>, ServiceIdComparer>
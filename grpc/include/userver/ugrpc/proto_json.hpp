@@ -1,14 +1,18 @@
 #pragma once
 
 /// @file userver/ugrpc/proto_json.hpp
-/// @brief Utilities for conversion Protobuf -> Json
+/// @brief Utilities for conversion Protobuf <-> Json
 /// @ingroup userver_formats_serialize userver_formats_parse
 
+#include <string>
+#include <string_view>
+
 #include <google/protobuf/struct.pb.h>
 #include <google/protobuf/util/json_util.h>
 
 #include <userver/formats/json.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -25,6 +29,27 @@ std::string ToString(const google::protobuf::Message& message);
 /// @throws formats::json::Exception
 std::string ToJsonString(const google::protobuf::Message& message);
 
+/// @brief Writes Json representation of protobuf message into the builder
+///
+/// The message is walked with reflection and written directly into @a sw,
+/// without intermediate strings or formats::json::Value. The output follows
+/// the proto3 Json mapping with the options of ToJsonString, except that
+/// members are written in the declaration order of fields. Well-known types
+/// (google.protobuf.*) are delegated to the protobuf library.
+/// @throws formats::json::Exception
+void WriteMessageToJson(const google::protobuf::Message& message,
+                        formats::json::StringBuilder& sw);
+
+/// @brief Clears the message and fills it from its Json representation
+///
+/// The input is consumed by the SAX parser without building
+/// formats::json::Value for the document. Fields may be named both in
+/// lowerCamelCase and as in the .proto file, unknown fields are an error.
+/// Well-known types (google.protobuf.*) are delegated to the protobuf library.
+/// @throws formats::json::Exception
+void ParseMessageFromJson(std::string_view json,
+                          google::protobuf::Message& message);
+
 }  // namespace ugrpc
 
 namespace formats::serialize {
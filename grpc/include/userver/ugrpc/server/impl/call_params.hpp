@@ -2,6 +2,7 @@
 
 #include <string_view>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_context.h>
 
@@ -28,6 +29,7 @@ struct CallParams {
   tracing::Span& call_span;
   utils::AnyStorage<StorageContext>& storage_context;
   const Middlewares& middlewares;
+  google::protobuf::Arena* arena;
 };
 
 }  // namespace ugrpc::server::impl
@@ -4,6 +4,7 @@
 
 #include <grpcpp/server_builder.h>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -17,7 +18,14 @@ namespace ugrpc::server::impl {
 /// instances are destroyed.
 class QueueHolder final {
  public:
-  explicit QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder);
+  /// @param pin_to_cpus pin the thread polling queue `i` to the `i`-th CPU
+  /// (modulo the number of CPUs) the calling thread is allowed to run on
+  /// @param polling_task_processor if set, the queues are polled by the tasks
+  /// of this task processor instead of dedicated threads, `pin_to_cpus` is
+  /// ignored
+  QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder,
+              bool pin_to_cpus = false,
+              engine::TaskProcessor* polling_task_processor = nullptr);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <exception>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -26,6 +27,7 @@
 
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/ugrpc/arena.hpp>
 #include <userver/ugrpc/impl/statistics_scope.hpp>
 #include <userver/ugrpc/server/impl/async_method_invocation.hpp>
 #include <userver/ugrpc/server/impl/async_service.hpp>
@@ -102,6 +104,20 @@ class CallData final {
         method_data_(method_data) {
     UASSERT(method_data.method_id <
             method_data.service_data.metadata.method_full_names.size());
+
+    const auto arena_initial_block_size =
+        method_data.service_data.settings.arena_initial_block_size;
+    if (arena_initial_block_size != 0) {
+      arena_.emplace(ugrpc::MakeArenaOptions(arena_initial_block_size));
+    }
+    if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+      if (arena_) {
+        initial_request_ =
+            google::protobuf::Arena::CreateMessage<InitialRequest>(&*arena_);
+        return;
+      }
+    }
+    initial_request_ = &inline_initial_request_.emplace();
   }
 
   void operator()() && {
@@ -120,7 +136,7 @@ class CallData final {
         method_data_.queue_num);
 
     method_data_.service_data.async_service.template Prepare<CallTraits>(
-        method_data_.method_id, context_, initial_request_, raw_responder_,
+        method_data_.method_id, context_, *initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
 
     // Note: we ignore task cancellations here. Even if notify_when_done has
@@ -181,20 +197,21 @@ class CallData final {
     utils::AnyStorage<StorageContext> storage_context;
     Call responder(CallParams{context_, call_name, service_name, method_name,
                               statistics_scope, *access_tskv_logger,
-                              span_->Get(), storage_context, middlewares},
+                              span_->Get(), storage_context, middlewares,
+                              arena_ ? &*arena_ : nullptr},
                    raw_responder_);
     auto do_call = [&] {
       if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
         (service.*service_method)(responder);
       } else {
-        (service.*service_method)(responder, std::move(initial_request_));
+        (service.*service_method)(responder, std::move(*initial_request_));
       }
     };
 
     try {
       ::google::protobuf::Message* initial_request = nullptr;
       if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
-        initial_request = &initial_request_;
+        initial_request = initial_request_;
       }
 
       MiddlewareCallContext middleware_context(
@@ -219,7 +236,11 @@ class CallData final {
   MethodData<GrpcppService, CallTraits> method_data_;
 
   grpc::ServerContext context_{};
-  InitialRequest initial_request_{};
+  // 'arena_' must outlive the initial request allocated on it
+  std::optional<google::protobuf::Arena> arena_;
+  // Only constructed if the initial request is not allocated on 'arena_'
+  std::optional<InitialRequest> inline_initial_request_;
+  InitialRequest* initial_request_{nullptr};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_;
   std::optional<tracing::InPlaceSpan> span_{};
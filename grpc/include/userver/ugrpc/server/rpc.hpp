@@ -86,6 +86,21 @@ class CallAnyBase {
     return params_.storage_context;
   }
 
+  /// @brief Returns the per-call protobuf arena, or `nullptr` if arenas are
+  /// disabled in ugrpc::server::ServerConfig
+  ///
+  /// Messages created on the arena are freed together with the call, after
+  /// the handler returns. The initial request is already allocated on it.
+  ///
+  /// @code
+  /// auto* response =
+  ///     google::protobuf::Arena::CreateMessage<Response>(call.GetArena());
+  /// @endcode
+  ///
+  /// @warning If the arena is `nullptr`, `CreateMessage` allocates
+  /// on the heap and the caller has to delete the message.
+  google::protobuf::Arena* GetArena() { return params_.arena; }
+
   virtual bool IsFinished() const = 0;
 
   /// @cond
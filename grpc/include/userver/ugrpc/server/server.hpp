@@ -42,6 +42,26 @@ struct ServerConfig final {
   /// of worker threads for best RPS.
   int completion_queue_num{2};
 
+  /// Pin the thread polling completion queue `i` to the `i`-th CPU allowed
+  /// for the thread that creates the server, i.e. the CPUs of its task
+  /// processor (see `cpu-affinity`) or of the container cpuset. Together
+  /// with `completion_queue_num` equal to the number of task processor
+  /// workers, this gives a completion queue per core and keeps the polling
+  /// threads from migrating between cores.
+  ///
+  /// Only applies to the dedicated polling threads, see
+  /// `completion_queue_task_processor`.
+  bool pin_completion_queues{false};
+
+  /// If set, the completion queues are polled cooperatively by the tasks of
+  /// this task processor instead of dedicated threads. A completion then
+  /// wakes up the RPC task right from a worker of the task processor, without
+  /// a hop through another thread. With `completion_queue_num` equal to the
+  /// number of the task processor workers the completions are sharded between
+  /// the workers. An idle poller waits for its queue for up to 200us at a
+  /// time, keeping its worker.
+  engine::TaskProcessor* completion_queue_task_processor{nullptr};
+
   /// Optional grpc-core channel args
   /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
   std::unordered_map<std::string, std::string> channel_args{};
@@ -55,6 +75,11 @@ struct ServerConfig final {
 
   /// 'access-tskv.log' logger
   logging::LoggerPtr access_tskv_logger{logging::MakeNullLogger()};
+
+  /// If non-zero, initial requests of RPCs are allocated on per-call
+  /// google::protobuf::Arena with such initial block size
+  /// @see ugrpc::server::CallAnyBase::GetArena
+  std::size_t arena_initial_block_size{0};
 };
 
 /// @brief Manages the gRPC server
@@ -30,9 +30,12 @@ struct ServiceDefaults;
 /// port | the port to use for all gRPC services, or 0 to pick any available | -
 /// unix-socket-path | unix socket absolute path to listen to, instead of listening on `port` | -
 /// completion-queue-count | count of completion queues to create | 2
+/// pin-completion-queues | pin the thread polling completion queue `i` to the `i`-th CPU of the task processor affinity or cpuset | false
+/// completion-queue-task-processor | poll the completion queues by the tasks of this task processor instead of dedicated threads | -
 /// channel-args | a map of channel arguments, see gRPC Core docs | {}
 /// native-log-level | min log level for the native gRPC library | 'error'
 /// enable-channelz | initialize service with runtime info about gRPC connections | false
+/// arena-initial-block-size | if non-zero, requests are allocated on per-call protobuf arenas with such initial block size | 0
 /// service-defaults | default config values for gRPC services, see config schema | {}
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
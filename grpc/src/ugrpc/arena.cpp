@@ -0,0 +1,89 @@
+#include <userver/ugrpc/arena.hpp>
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+namespace {
+
+// Blocks are usually freed on the same thread they were allocated on, so
+// a few recycled blocks per thread remove most of the malloc calls for arenas
+constexpr std::size_t kMaxPooledBlocks = 16;
+constexpr std::size_t kMaxPooledBlockSize = 64 * 1024;
+
+struct Block final {
+  void* data;
+  std::size_t size;
+};
+
+class BlockPool final {
+ public:
+  BlockPool() { blocks_.reserve(kMaxPooledBlocks); }
+
+  ~BlockPool() {
+    for (const auto& block : blocks_) ::operator delete(block.data);
+  }
+
+  void* TryTake(std::size_t size) noexcept {
+    const auto it =
+        std::find_if(blocks_.begin(), blocks_.end(),
+                     [size](const Block& block) { return block.size == size; });
+    if (it == blocks_.end()) return nullptr;
+
+    auto* data = it->data;
+    *it = blocks_.back();
+    blocks_.pop_back();
+    return data;
+  }
+
+  bool TryPut(void* data, std::size_t size) noexcept {
+    if (size > kMaxPooledBlockSize || blocks_.size() >= kMaxPooledBlocks) {
+      return false;
+    }
+    blocks_.push_back({data, size});
+    return true;
+  }
+
+ private:
+  std::vector<Block> blocks_;
+};
+
+compiler::ThreadLocal local_block_pool = [] { return BlockPool{}; };
+
+void* AllocateBlock(std::size_t size) {
+  {
+    auto pool = local_block_pool.Use();
+    if (auto* data = pool->TryTake(size)) return data;
+  }
+  return ::operator new(size);
+}
+
+void DeallocateBlock(void* data, std::size_t size) {
+  {
+    auto pool = local_block_pool.Use();
+    if (pool->TryPut(data, size)) return;
+  }
+  ::operator delete(data);
+}
+
+}  // namespace
+
+google::protobuf::ArenaOptions MakeArenaOptions(
+    std::size_t initial_block_size) {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = initial_block_size;
+  options.max_block_size = std::max(initial_block_size, kMaxPooledBlockSize);
+  options.block_alloc = &AllocateBlock;
+  options.block_dealloc = &DeallocateBlock;
+  return options;
+}
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
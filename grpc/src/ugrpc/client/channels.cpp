@@ -49,7 +49,7 @@ namespace {
 [[nodiscard]] bool TryWaitForConnected(
     impl::ChannelCache::Token& token, grpc::CompletionQueue& queue,
     engine::Deadline deadline, engine::TaskProcessor& blocking_task_processor) {
-  auto range = boost::irange(std::size_t{0}, token.GetChannelCount());
+  auto range = boost::irange(std::size_t{0}, token.GetActiveChannelCount());
   return std::all_of(range.begin(), range.end(), [&](std::size_t index) {
     return TryWaitForConnected(*token.GetChannel(index), queue, deadline,
                                blocking_task_processor);
@@ -1,5 +1,6 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <memory>
 #include <optional>
 #include <stdexcept>
 
@@ -8,6 +9,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/client/impl/client_factory_config.hpp>
@@ -19,6 +21,31 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
+namespace {
+
+impl::ChannelPoolSettings MakeChannelPoolSettings(
+    const ClientFactorySettings& settings) {
+  return {settings.channel_count, settings.max_channel_count,
+          settings.max_streams_per_channel};
+}
+
+std::unordered_map<std::string, std::unique_ptr<impl::ChannelCache>>
+MakeClientChannelCaches(ClientFactorySettings& settings,
+                        const testsuite::GrpcControl& testsuite_grpc) {
+  std::unordered_map<std::string, std::unique_ptr<impl::ChannelCache>> result;
+  for (auto& [client_name, creds] : settings.client_credentials) {
+    result.emplace(
+        std::string{client_name},
+        std::make_unique<impl::ChannelCache>(
+            testsuite_grpc.IsTlsEnabled() ? creds
+                                          : grpc::InsecureChannelCredentials(),
+            settings.channel_args, MakeChannelPoolSettings(settings)));
+  }
+  return result;
+}
+
+}  // namespace
+
 ClientFactory::ClientFactory(ClientFactorySettings&& settings,
                              engine::TaskProcessor& channel_task_processor,
                              MiddlewareFactories mws,
@@ -32,22 +59,20 @@ ClientFactory::ClientFactory(ClientFactorySettings&& settings,
       channel_cache_(testsuite_grpc.IsTlsEnabled()
                          ? settings.credentials
                          : grpc::InsecureChannelCredentials(),
-                     settings.channel_args, settings.channel_count),
-      client_statistics_storage_(statistics_storage,
-                                 ugrpc::impl::StatisticsDomain::kClient),
+                     settings.channel_args, MakeChannelPoolSettings(settings)),
+      client_channel_cache_(MakeClientChannelCaches(settings, testsuite_grpc)),
+      // The channel caches are filled above, the writer may be called as soon
+      // as it is registered
+      client_statistics_storage_(
+          statistics_storage, ugrpc::impl::StatisticsDomain::kClient,
+          [this](utils::statistics::Writer& writer) {
+            auto channels = writer["channels"];
+            ExtendStatistics(channels);
+          }),
       config_source_(source),
       testsuite_grpc_(testsuite_grpc) {
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(settings.native_log_level);
-
-  for (auto& [client_name, creds] : settings.client_credentials) {
-    client_channel_cache_.emplace(
-        std::string{client_name},
-        std::make_unique<impl::ChannelCache>(
-            testsuite_grpc.IsTlsEnabled() ? creds
-                                          : grpc::InsecureChannelCredentials(),
-            settings.channel_args, settings.channel_count));
-  }
 }
 
 impl::ChannelCache::Token ClientFactory::GetChannel(
@@ -69,6 +94,13 @@ impl::ChannelCache::Token ClientFactory::GetChannel(
       .Get();
 }
 
+void ClientFactory::ExtendStatistics(utils::statistics::Writer& writer) const {
+  writer = channel_cache_;
+  for (const auto& [client_name, channel_cache] : client_channel_cache_) {
+    writer.ValueWithLabels(*channel_cache, {"client_name", client_name});
+  }
+}
+
 }  // namespace ugrpc::client
 
 USERVER_NAMESPACE_END
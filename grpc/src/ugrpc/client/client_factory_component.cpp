@@ -119,6 +119,18 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    max-channel-count:
+        type: integer
+        description: |
+            Number of channels the pool of each endpoint may grow to when
+            all of its channels are loaded
+        defaultDescription: channel-count
+    max-streams-per-channel:
+        type: integer
+        description: |
+            Number of in-flight RPCs per channel after which a new channel
+            is added to the pool, up to max-channel-count
+        defaultDescription: 100
     middlewares:
         type: array
         items:
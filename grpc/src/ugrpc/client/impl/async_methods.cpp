@@ -87,7 +87,8 @@ RpcData* FutureImpl::GetData() noexcept { return data_; }
 void FutureImpl::ClearData() noexcept { data_ = nullptr; }
 
 RpcData::RpcData(impl::CallParams&& params)
-    : context_(std::move(params.context)),
+    : channel_lease_(std::move(params.channel_lease)),
+      context_(std::move(params.context)),
       client_name_(params.call_name),
       call_name_(params.call_name),
       stats_scope_(params.statistics),
@@ -13,7 +13,8 @@ CallParams DoCreateCallParams(const ClientData& client_data,
                     client_data.GetMetadata().method_full_names[method_id],
                     std::move(context),
                     client_data.GetStatistics(method_id),
-                    client_data.GetMiddlewares()};
+                    client_data.GetMiddlewares(),
+                    client_data.GetChannelToken().AcquireChannel()};
 }
 
 }  // namespace ugrpc::client::impl
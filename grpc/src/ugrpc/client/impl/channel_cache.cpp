@@ -1,12 +1,16 @@
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <utility>
 
+#include <grpc/grpc.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
 
@@ -14,6 +18,129 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+namespace {
+
+grpc::ChannelArguments MakePoolChannelArgs(
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& settings) {
+  auto result = channel_args;
+  if (settings.max_channel_count > 1) {
+    // By default grpc shares subchannels (connections) between channels with
+    // equal arguments, which would defeat the purpose of the pool
+    result.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  }
+  return result;
+}
+
+}  // namespace
+
+ChannelPool::ChannelPool(
+    const std::string& endpoint,
+    const std::shared_ptr<grpc::ChannelCredentials>& credentials,
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& settings)
+    : active_count_(settings.channel_count),
+      max_streams_per_channel_(settings.max_streams_per_channel) {
+  UASSERT(settings.channel_count > 0);
+  UASSERT(settings.channel_count <= settings.max_channel_count);
+
+  const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
+  const auto pool_args = MakePoolChannelArgs(channel_args, settings);
+  channels_ =
+      utils::GenerateFixedArray(settings.max_channel_count, [&](std::size_t) {
+        return Channel{
+            grpc::CreateCustomChannel(endpoint_string, credentials, pool_args)};
+      });
+}
+
+std::size_t ChannelPool::GetChannelCount() const noexcept {
+  return channels_.size();
+}
+
+std::size_t ChannelPool::GetActiveChannelCount() const noexcept {
+  return active_count_.load(std::memory_order_relaxed);
+}
+
+const std::shared_ptr<grpc::Channel>& ChannelPool::GetChannel(
+    std::size_t index) const noexcept {
+  UASSERT(index < channels_.size());
+  return channels_[index].channel;
+}
+
+std::uint64_t ChannelPool::GetStreamCount(std::size_t index) const noexcept {
+  UASSERT(index < channels_.size());
+  return channels_[index].streams.load(std::memory_order_relaxed);
+}
+
+std::size_t ChannelPool::Acquire() noexcept {
+  const auto active = active_count_.load(std::memory_order_relaxed);
+  UASSERT(active > 0 && active <= channels_.size());
+
+  // Start from a random channel, so that equally loaded channels get an equal
+  // share of RPCs
+  const auto start = active == 1 ? 0 : utils::RandRange(active);
+  std::size_t best = start;
+  auto best_streams = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t i = 0; i < active; ++i) {
+    const auto index = (start + i) % active;
+    const auto streams =
+        channels_[index].streams.load(std::memory_order_relaxed);
+    if (streams < best_streams) {
+      best = index;
+      best_streams = streams;
+      if (streams == 0) break;
+    }
+  }
+
+  if (best_streams >= max_streams_per_channel_ && active < channels_.size()) {
+    auto expected = active;
+    if (active_count_.compare_exchange_strong(expected, active + 1,
+                                              std::memory_order_relaxed)) {
+      best = active;
+    }
+  }
+
+  channels_[best].streams.fetch_add(1, std::memory_order_relaxed);
+  return best;
+}
+
+void ChannelPool::Release(std::size_t index) noexcept {
+  UASSERT(index < channels_.size());
+  const auto old = channels_[index].streams.fetch_sub(
+      1, std::memory_order_relaxed);
+  UASSERT(old > 0);
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const ChannelPool& pool) {
+  writer["active"] = pool.GetActiveChannelCount();
+  writer["max"] = pool.GetChannelCount();
+  for (std::size_t i = 0; i < pool.GetActiveChannelCount(); ++i) {
+    writer["streams"].ValueWithLabels(pool.GetStreamCount(i),
+                                      {"grpc_channel", std::to_string(i)});
+  }
+}
+
+ChannelCache::Lease::Lease(std::shared_ptr<ChannelPool> pool,
+                           std::size_t index) noexcept
+    : pool_(std::move(pool)), index_(index) {
+  UASSERT(pool_);
+}
+
+ChannelCache::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::move(other.pool_)), index_(other.index_) {}
+
+ChannelCache::Lease& ChannelCache::Lease::operator=(Lease&& other) noexcept {
+  std::swap(pool_, other.pool_);
+  std::swap(index_, other.index_);
+  return *this;
+}
+
+ChannelCache::Lease::~Lease() {
+  if (pool_) pool_->Release(index_);
+}
+
+std::size_t ChannelCache::Lease::GetIndex() const noexcept { return index_; }
+
 ChannelCache::Token::Token(ChannelCache& cache, const std::string& endpoint,
                            CountedChannel& counted_channel) noexcept
     : cache_(&cache), endpoint_(&endpoint), counted_channel_(&counted_channel) {
@@ -46,34 +173,47 @@ ChannelCache::Token::~Token() {
 const std::shared_ptr<grpc::Channel>& ChannelCache::Token::GetChannel(
     std::size_t index) const noexcept {
   UASSERT(counted_channel_);
-  UASSERT(index < counted_channel_->channels.size());
-  return counted_channel_->channels[index];
+  return counted_channel_->pool->GetChannel(index);
 }
 
 std::size_t ChannelCache::Token::GetChannelCount() const noexcept {
   UASSERT(counted_channel_);
-  return counted_channel_->channels.size();
+  return counted_channel_->pool->GetChannelCount();
+}
+
+std::size_t ChannelCache::Token::GetActiveChannelCount() const noexcept {
+  UASSERT(counted_channel_);
+  return counted_channel_->pool->GetActiveChannelCount();
+}
+
+ChannelCache::Lease ChannelCache::Token::AcquireChannel() const noexcept {
+  UASSERT(counted_channel_);
+  auto& pool = counted_channel_->pool;
+  const auto index = pool->Acquire();
+  return Lease{pool, index};
 }
 
 ChannelCache::CountedChannel::CountedChannel(
     const std::string& endpoint,
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t count) {
-  const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
-  channels = utils::GenerateFixedArray(count, [&](std::size_t) {
-    return grpc::CreateCustomChannel(endpoint_string, credentials,
-                                     channel_args);
-  });
-  UASSERT(count > 0);
-}
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& settings)
+    : pool(std::make_shared<ChannelPool>(endpoint, credentials, channel_args,
+                                         settings)) {}
 
 ChannelCache::ChannelCache(
     std::shared_ptr<grpc::ChannelCredentials>&& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& settings)
     : credentials_(std::move(credentials)),
       channel_args_(channel_args),
-      channel_count_(channel_count) {
-  UINVARIANT(channel_count > 0, "Channels count must be greater than zero");
+      settings_{settings.channel_count,
+                std::max(settings.channel_count, settings.max_channel_count),
+                settings.max_streams_per_channel} {
+  UINVARIANT(settings.channel_count > 0,
+             "Channels count must be greater than zero");
+  UINVARIANT(settings.max_streams_per_channel > 0,
+             "Max streams per channel must be greater than zero");
 }
 
 ChannelCache::~ChannelCache() = default;
@@ -81,10 +221,17 @@ ChannelCache::~ChannelCache() = default;
 ChannelCache::Token ChannelCache::Get(const std::string& endpoint) {
   auto channels = channels_.Lock();
   const auto [it, _] = channels->try_emplace(endpoint, endpoint, credentials_,
-                                             channel_args_, channel_count_);
+                                             channel_args_, settings_);
   return {*this, it->first, it->second};
 }
 
+void DumpMetric(utils::statistics::Writer& writer, const ChannelCache& cache) {
+  const auto channels = cache.channels_.Lock();
+  for (const auto& [endpoint, counted_channel] : *channels) {
+    writer.ValueWithLabels(*counted_channel.pool, {"grpc_endpoint", endpoint});
+  }
+}
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
@@ -68,6 +68,11 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.max_channel_count =
+      value["max-channel-count"].As<std::size_t>(config.channel_count);
+  config.max_streams_per_channel =
+      value["max-streams-per-channel"].As<std::size_t>(
+          config.max_streams_per_channel);
 
   return config;
 }
@@ -95,6 +100,8 @@ ClientFactorySettings MakeFactorySettings(
       config.channel_args,
       config.native_log_level,
       config.channel_count,
+      config.max_channel_count,
+      config.max_streams_per_channel,
   };
 }
 
@@ -26,6 +26,14 @@ struct ClientFactoryConfig final {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Number of channels the pool of every endpoint may grow to when all
+  /// of its channels are loaded. Values below `channel_count` mean no growth.
+  std::size_t max_channel_count{1};
+
+  /// Number of in-flight RPCs on every channel of a pool after which
+  /// a new channel is activated, if `max_channel_count` permits.
+  std::size_t max_streams_per_channel{100};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
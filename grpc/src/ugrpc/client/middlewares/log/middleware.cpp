@@ -1,6 +1,8 @@
 #include "middleware.hpp"
 
-#include <userver/utils/log.hpp>
+#include <userver/logging/log.hpp>
+
+#include <ugrpc/impl/protobuf_utils.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -11,11 +13,10 @@ Middleware::Middleware(const Settings& settings) : settings_(settings) {}
 void Middleware::Handle(MiddlewareCallContext& context) const {
   const auto* request = context.GetInitialRequest();
   if (request) {
+    // Evaluated only if the level is enabled
     LOG(settings_.log_level)
-        << "gRPC message: " << [request, this]() -> std::string {
-      const auto& str = request->Utf8DebugString();
-      return utils::log::ToLimitedUtf8(str, settings_.max_msg_size);
-    }();
+        << "gRPC message: "
+        << ugrpc::impl::ToLimitedDebugString(*request, settings_.max_msg_size);
   }
   context.Next();
 }
@@ -0,0 +1,103 @@
+#include <ugrpc/impl/protobuf_utils.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include <google/protobuf/io/zero_copy_stream.h>
+#include <google/protobuf/text_format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+namespace {
+
+constexpr std::string_view kTruncatedSuffix = "...(truncated)";
+constexpr std::size_t kMinChunkSize = 64;
+
+// Hands out the memory of `output` in growing chunks, up to `limit` bytes.
+// Asking for more fails the stream, the printer does not write anything after
+// that. The printer must not be unwound by an exception: it backs up the
+// stream in its destructor with a stale count.
+class LimitingOutputStream final
+    : public google::protobuf::io::ZeroCopyOutputStream {
+ public:
+  LimitingOutputStream(std::string& output, std::size_t limit)
+      : output_(output), limit_(limit) {}
+
+  bool Next(void** data, int* size) override {
+    if (size_ >= limit_) {
+      limit_reached_ = true;
+      return false;
+    }
+
+    const auto chunk_size =
+        std::min(limit_ - size_, std::max(size_, kMinChunkSize));
+    output_.resize(size_ + chunk_size);
+    *data = output_.data() + size_;
+    *size = static_cast<int>(chunk_size);
+    size_ += chunk_size;
+    return true;
+  }
+
+  void BackUp(int count) override {
+    // All the handed out memory is filled by the moment the limit is reached
+    if (limit_reached_) return;
+    UASSERT(count >= 0 && static_cast<std::size_t>(count) <= size_);
+    size_ -= count;
+  }
+
+  std::int64_t ByteCount() const override { return size_; }
+
+  bool IsLimitReached() const { return limit_reached_; }
+
+ private:
+  std::string& output_;
+  const std::size_t limit_;
+  std::size_t size_{0};
+  bool limit_reached_{false};
+};
+
+struct DebugStringPrinter final {
+  DebugStringPrinter() {
+    printer.SetSingleLineMode(true);
+    printer.SetUseUtf8StringEscaping(true);
+#if GOOGLE_PROTOBUF_VERSION >= 4022000
+    printer.SetRedactDebugString(true);
+#endif
+  }
+
+  google::protobuf::TextFormat::Printer printer;
+};
+
+}  // namespace
+
+std::string ToLimitedDebugString(const google::protobuf::Message& message,
+                                 std::size_t limit) {
+  static const DebugStringPrinter kPrinter;
+
+  std::string output;
+  LimitingOutputStream stream{output, limit};
+  kPrinter.printer.Print(message, &stream);
+  const bool truncated = stream.IsLimitReached();
+  output.resize(truncated ? limit : stream.ByteCount());
+
+  if (truncated) {
+    std::string_view view{output};
+    utils::text::utf8::TrimViewTruncatedEnding(view);
+    output.resize(view.size());
+    output += kTruncatedSuffix;
+  } else if (!output.empty() && output.back() == ' ') {
+    // Single line mode leaves a separator after the last field
+    output.pop_back();
+  }
+  return output;
+}
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <google/protobuf/message.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::impl {
+
+// Formats the message in a single line, like ShortDebugString, but stops
+// formatting once `limit` bytes are produced. Fields marked with
+// `debug_redact` option are replaced with a placeholder. The result is valid
+// UTF-8, truncation is marked with a suffix.
+std::string ToLimitedDebugString(const google::protobuf::Message& message,
+                                 std::size_t limit);
+
+}  // namespace ugrpc::impl
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,18 @@
 #include <userver/ugrpc/impl/queue_runner.hpp>
 
+#include <cstdint>
 #include <thread>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <grpc/support/time.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/thread_name.hpp>
 
@@ -13,9 +24,28 @@ namespace ugrpc::impl {
 
 namespace {
 
+void PinCurrentThread(std::size_t cpu) noexcept {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  const int ret =
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    LOG_WARNING() << "Failed to pin gRPC completion queue thread to CPU "
+                  << cpu << ", error code " << ret;
+  }
+#else
+  LOG_WARNING() << "Pinning gRPC completion queue thread to CPU " << cpu
+                << " is not supported on this platform";
+#endif
+}
+
 void ProcessQueue(grpc::CompletionQueue& queue,
-                  engine::SingleUseEvent& completion) noexcept {
+                  engine::SingleUseEvent& completion,
+                  std::optional<std::size_t> cpu) noexcept {
   utils::SetCurrentThreadName("grpc-queue");
+  if (cpu) PinCurrentThread(*cpu);
 
   void* tag = nullptr;
   bool ok = false;
@@ -29,12 +59,66 @@ void ProcessQueue(grpc::CompletionQueue& queue,
   completion.Send();
 }
 
+// Empty polls in a row after which the poller waits for the queue instead of
+// just yielding to the other tasks
+constexpr std::size_t kSpinPolls = 64;
+
+// Completions handled in a row before the poller lets the woken up RPC tasks
+// and the other tasks of the task processor run
+constexpr std::size_t kEventsPerYield = 16;
+
+// The longest time a task processor worker is kept by an idle poller. The
+// queue wakes the poller up as soon as a completion arrives.
+constexpr std::int64_t kIdleWaitMicroseconds = 200;
+
+void PollQueue(grpc::CompletionQueue& queue,
+               engine::SingleUseEvent& completion) noexcept {
+  void* tag = nullptr;
+  bool ok = false;
+  std::size_t empty_polls = 0;
+  std::size_t events = 0;
+
+  while (true) {
+    const auto deadline =
+        empty_polls < kSpinPolls
+            ? gpr_time_0(GPR_CLOCK_MONOTONIC)
+            : gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                           gpr_time_from_micros(kIdleWaitMicroseconds,
+                                                GPR_TIMESPAN));
+    const auto status = queue.AsyncNext(&tag, &ok, deadline);
+    if (status == grpc::CompletionQueue::SHUTDOWN) break;
+
+    if (status == grpc::CompletionQueue::GOT_EVENT) {
+      empty_polls = 0;
+      auto* call = static_cast<EventBase*>(tag);
+      UASSERT(call != nullptr);
+      call->Notify(ok);
+      if (++events % kEventsPerYield != 0) continue;
+    } else {
+      ++empty_polls;
+    }
+    engine::Yield();
+  }
+
+  completion.Send();
+}
+
 }  // namespace
 
-QueueRunner::QueueRunner(grpc::CompletionQueue& queue) : queue_(queue) {
-  std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+QueueRunner::QueueRunner(grpc::CompletionQueue& queue,
+                         std::optional<std::size_t> cpu)
+    : queue_(queue) {
+  std::thread([this, cpu] { ProcessQueue(queue_, completion_, cpu); })
+      .detach();
 }
 
+QueueRunner::QueueRunner(grpc::CompletionQueue& queue,
+                         engine::TaskProcessor& task_processor)
+    : queue_(queue),
+      // The poller ignores cancellations, it stops on the queue shutdown
+      poller_(engine::CriticalAsyncNoSpan(
+          task_processor, [this] { PollQueue(queue_, completion_); })) {}
+
 QueueRunner::~QueueRunner() {
   queue_.Shutdown();
   completion_.WaitNonCancellable();
@@ -1,5 +1,7 @@
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/utils/algo.hpp>
@@ -21,8 +23,9 @@ std::string_view ToString(StatisticsDomain domain) {
 }
 
 StatisticsStorage::StatisticsStorage(
-    utils::statistics::Storage& statistics_storage, StatisticsDomain domain)
-    : domain_(domain) {
+    utils::statistics::Storage& statistics_storage, StatisticsDomain domain,
+    ExtraWriterFunc extra_writer)
+    : domain_(domain), extra_writer_(std::move(extra_writer)) {
   statistics_holder_ = statistics_storage.RegisterWriter(
       fmt::format("grpc.{}", ToString(domain)),
       [this](utils::statistics::Writer& writer) { ExtendStatistics(writer); });
@@ -54,13 +57,14 @@ ugrpc::impl::ServiceStatistics& StatisticsStorage::GetServiceStatistics(
 }
 
 void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
-  const std::shared_lock lock(mutex_);
   {
+    const std::shared_lock lock(mutex_);
     auto by_destination = writer["by-destination"];
     for (const auto& [_, service_stats] : service_statistics_) {
       by_destination = service_stats;
     }
   }
+  if (extra_writer_) extra_writer_(writer);
 }
 
 std::uint64_t StatisticsStorage::GetStartedRequests() const {
@@ -1,9 +1,26 @@
 #include <userver/ugrpc/proto_json.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
 #include <grpcpp/support/config.h>
 #include <boost/container/small_vector.hpp>
 
+#include <userver/crypto/base64.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/parser_state.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/numeric_cast.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -43,6 +60,796 @@ std::string ToJsonString(const google::protobuf::Message& message) {
   return result;
 }
 
+namespace {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+bool IsWellKnownType(const Descriptor& descriptor) {
+  return descriptor.file()->package() == "google.protobuf";
+}
+
+bool IsNullValue(const FieldDescriptor& field) {
+  return field.cpp_type() == FieldDescriptor::CPPTYPE_ENUM &&
+         field.enum_type()->full_name() == "google.protobuf.NullValue";
+}
+
+const FieldDescriptor* FindField(const Descriptor& descriptor,
+                                 std::string_view name) {
+  const std::string name_str{name};
+  if (const auto* field = descriptor.FindFieldByCamelcaseName(name_str)) {
+    return field;
+  }
+  if (const auto* field = descriptor.FindFieldByName(name_str)) return field;
+
+  // A custom json_name differs from the camelCase name, such fields are rare
+  for (int i = 0; i < descriptor.field_count(); ++i) {
+    const auto* field = descriptor.field(i);
+    if (field->has_json_name() && field->json_name() == name) return field;
+  }
+  return nullptr;
+}
+
+// Accesses either a singular field or an element of a repeated field
+class FieldRef final {
+ public:
+  FieldRef(const Message& message, const FieldDescriptor& field,
+           int index = -1)
+      : message_(message),
+        reflection_(*message.GetReflection()),
+        field_(field),
+        index_(index) {}
+
+  const FieldDescriptor& Field() const { return field_; }
+
+  std::int32_t Int32() const {
+    return IsElement() ? reflection_.GetRepeatedInt32(message_, &field_, index_)
+                       : reflection_.GetInt32(message_, &field_);
+  }
+
+  std::int64_t Int64() const {
+    return IsElement() ? reflection_.GetRepeatedInt64(message_, &field_, index_)
+                       : reflection_.GetInt64(message_, &field_);
+  }
+
+  std::uint32_t UInt32() const {
+    return IsElement()
+               ? reflection_.GetRepeatedUInt32(message_, &field_, index_)
+               : reflection_.GetUInt32(message_, &field_);
+  }
+
+  std::uint64_t UInt64() const {
+    return IsElement()
+               ? reflection_.GetRepeatedUInt64(message_, &field_, index_)
+               : reflection_.GetUInt64(message_, &field_);
+  }
+
+  float Float() const {
+    return IsElement() ? reflection_.GetRepeatedFloat(message_, &field_, index_)
+                       : reflection_.GetFloat(message_, &field_);
+  }
+
+  double Double() const {
+    return IsElement()
+               ? reflection_.GetRepeatedDouble(message_, &field_, index_)
+               : reflection_.GetDouble(message_, &field_);
+  }
+
+  bool Bool() const {
+    return IsElement() ? reflection_.GetRepeatedBool(message_, &field_, index_)
+                       : reflection_.GetBool(message_, &field_);
+  }
+
+  int EnumValue() const {
+    return IsElement()
+               ? reflection_.GetRepeatedEnumValue(message_, &field_, index_)
+               : reflection_.GetEnumValue(message_, &field_);
+  }
+
+  const grpc::string& String(grpc::string& scratch) const {
+    return IsElement() ? reflection_.GetRepeatedStringReference(
+                             message_, &field_, index_, &scratch)
+                       : reflection_.GetStringReference(message_, &field_,
+                                                        &scratch);
+  }
+
+  const Message& SubMessage() const {
+    return IsElement()
+               ? reflection_.GetRepeatedMessage(message_, &field_, index_)
+               : reflection_.GetMessage(message_, &field_);
+  }
+
+ private:
+  bool IsElement() const { return index_ >= 0; }
+
+  const Message& message_;
+  const Reflection& reflection_;
+  const FieldDescriptor& field_;
+  const int index_;
+};
+
+void WriteMessage(const Message& message, formats::json::StringBuilder& sw);
+
+void WriteWellKnownType(const Message& message,
+                        formats::json::StringBuilder& sw) {
+  grpc::string result{};
+  const auto status =
+      google::protobuf::util::MessageToJsonString(message, &result, kOptions);
+  if (!status.ok()) {
+    throw formats::json::Exception("Cannot convert protobuf to string");
+  }
+  sw.WriteRawString(result);
+}
+
+template <typename Float>
+void WriteFloatingPoint(Float value, formats::json::StringBuilder& sw) {
+  if (std::isnan(value)) {
+    sw.WriteString("NaN");
+  } else if (std::isinf(value)) {
+    sw.WriteString(value > 0 ? "Infinity" : "-Infinity");
+  } else if constexpr (std::is_same_v<Float, float>) {
+    // Shortest representation that round-trips through float, as protobuf
+    // does, rather than the one of the widened double
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), "{}", value);
+    sw.WriteRawString(std::string_view{buffer.data(), buffer.size()});
+  } else {
+    sw.WriteDouble(value);
+  }
+}
+
+void WriteValue(const FieldRef& ref, formats::json::StringBuilder& sw) {
+  const auto& field = ref.Field();
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      sw.WriteInt64(ref.Int32());
+      return;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      sw.WriteUInt64(ref.UInt32());
+      return;
+    case FieldDescriptor::CPPTYPE_INT64: {
+      // 64-bit integers are strings in proto3 Json mapping
+      const fmt::format_int value{ref.Int64()};
+      sw.WriteString(std::string_view{value.data(), value.size()});
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_UINT64: {
+      const fmt::format_int value{ref.UInt64()};
+      sw.WriteString(std::string_view{value.data(), value.size()});
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      WriteFloatingPoint(ref.Float(), sw);
+      return;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      WriteFloatingPoint(ref.Double(), sw);
+      return;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      sw.WriteBool(ref.Bool());
+      return;
+    case FieldDescriptor::CPPTYPE_ENUM: {
+      if (IsNullValue(field)) {
+        sw.WriteNull();
+        return;
+      }
+      const auto value = ref.EnumValue();
+      const auto* value_descriptor =
+          field.enum_type()->FindValueByNumber(value);
+      if (value_descriptor) {
+        sw.WriteString(value_descriptor->name());
+      } else {
+        sw.WriteInt64(value);
+      }
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_STRING: {
+      grpc::string scratch;
+      const auto& value = ref.String(scratch);
+      if (field.type() == FieldDescriptor::TYPE_BYTES) {
+        sw.WriteString(crypto::base64::Base64Encode(value));
+      } else {
+        sw.WriteString(value);
+      }
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      WriteMessage(ref.SubMessage(), sw);
+      return;
+  }
+  UINVARIANT(false, "Unknown protobuf field type");
+}
+
+void WriteMapKey(const FieldRef& ref, formats::json::StringBuilder& sw) {
+  switch (ref.Field().cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      sw.Key(fmt::format_int{ref.Int32()}.str());
+      return;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      sw.Key(fmt::format_int{ref.UInt32()}.str());
+      return;
+    case FieldDescriptor::CPPTYPE_INT64:
+      sw.Key(fmt::format_int{ref.Int64()}.str());
+      return;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      sw.Key(fmt::format_int{ref.UInt64()}.str());
+      return;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      sw.Key(ref.Bool() ? "true" : "false");
+      return;
+    case FieldDescriptor::CPPTYPE_STRING: {
+      grpc::string scratch;
+      sw.Key(ref.String(scratch));
+      return;
+    }
+    default:
+      UINVARIANT(false, "Invalid protobuf map key type");
+  }
+}
+
+void WriteRepeated(const Message& message, const FieldDescriptor& field,
+                   formats::json::StringBuilder& sw) {
+  const auto& reflection = *message.GetReflection();
+  const auto size = reflection.FieldSize(message, &field);
+
+  if (field.is_map()) {
+    const auto& key_field = *field.message_type()->map_key();
+    const auto& value_field = *field.message_type()->map_value();
+    formats::json::StringBuilder::ObjectGuard guard{sw};
+    for (int i = 0; i < size; ++i) {
+      const auto& entry = reflection.GetRepeatedMessage(message, &field, i);
+      WriteMapKey(FieldRef{entry, key_field}, sw);
+      WriteValue(FieldRef{entry, value_field}, sw);
+    }
+  } else {
+    formats::json::StringBuilder::ArrayGuard guard{sw};
+    for (int i = 0; i < size; ++i) {
+      WriteValue(FieldRef{message, field, i}, sw);
+    }
+  }
+}
+
+void WriteMessage(const Message& message, formats::json::StringBuilder& sw) {
+  const auto& descriptor = *message.GetDescriptor();
+  if (IsWellKnownType(descriptor)) {
+    WriteWellKnownType(message, sw);
+    return;
+  }
+
+  const auto& reflection = *message.GetReflection();
+  formats::json::StringBuilder::ObjectGuard guard{sw};
+  for (int i = 0; i < descriptor.field_count(); ++i) {
+    const auto& field = *descriptor.field(i);
+    if (field.is_repeated()) {
+      // Empty repeated fields and maps are written, as in ToJsonString
+      sw.Key(field.json_name());
+      WriteRepeated(message, field, sw);
+    } else if (!field.has_presence() || reflection.HasField(message, &field)) {
+      sw.Key(field.json_name());
+      WriteValue(FieldRef{message, field}, sw);
+    }
+  }
+}
+
+void ParseWellKnownType(std::string_view json, Message& message) {
+  const auto status = google::protobuf::util::JsonStringToMessage(
+      grpc::string{json}, &message);
+  if (!status.ok()) {
+    throw formats::json::parser::InternalParseError(status.ToString());
+  }
+}
+
+// A value of a JSON scalar token
+struct Scalar final {
+  enum class Kind { kNull, kBool, kInt64, kUint64, kDouble, kString };
+
+  Kind kind{Kind::kNull};
+  bool bool_value{false};
+  std::int64_t int64_value{0};
+  std::uint64_t uint64_value{0};
+  double double_value{0};
+  std::string_view string_value{};
+
+  std::string_view KindName() const {
+    switch (kind) {
+      case Kind::kNull:
+        return "null";
+      case Kind::kBool:
+        return "bool";
+      case Kind::kInt64:
+      case Kind::kUint64:
+        return "integer";
+      case Kind::kDouble:
+        return "double";
+      case Kind::kString:
+        return "string";
+    }
+    return "value";
+  }
+};
+
+template <typename T>
+T ToInteger(const Scalar& scalar) {
+  switch (scalar.kind) {
+    case Scalar::Kind::kInt64:
+      return utils::numeric_cast<T>(scalar.int64_value);
+    case Scalar::Kind::kUint64:
+      return utils::numeric_cast<T>(scalar.uint64_value);
+    case Scalar::Kind::kDouble: {
+      const auto value = scalar.double_value;
+      if (std::trunc(value) != value ||
+          value < static_cast<double>(std::numeric_limits<T>::min()) ||
+          value > static_cast<double>(std::numeric_limits<T>::max())) {
+        throw formats::json::parser::InternalParseError(
+            fmt::format("{} is not a valid integer", value));
+      }
+      return static_cast<T>(value);
+    }
+    case Scalar::Kind::kString:
+      return utils::FromString<T>(scalar.string_value);
+    default:
+      throw formats::json::parser::InternalParseError(
+          fmt::format("integer was expected, but {} found", scalar.KindName()));
+  }
+}
+
+template <typename T>
+T ToFloatingPoint(const Scalar& scalar) {
+  switch (scalar.kind) {
+    case Scalar::Kind::kInt64:
+      return static_cast<T>(scalar.int64_value);
+    case Scalar::Kind::kUint64:
+      return static_cast<T>(scalar.uint64_value);
+    case Scalar::Kind::kDouble:
+      return static_cast<T>(scalar.double_value);
+    case Scalar::Kind::kString:
+      if (scalar.string_value == "NaN") {
+        return std::numeric_limits<T>::quiet_NaN();
+      } else if (scalar.string_value == "Infinity") {
+        return std::numeric_limits<T>::infinity();
+      } else if (scalar.string_value == "-Infinity") {
+        return -std::numeric_limits<T>::infinity();
+      }
+      return utils::FromString<T>(scalar.string_value);
+    default:
+      throw formats::json::parser::InternalParseError(
+          fmt::format("number was expected, but {} found", scalar.KindName()));
+  }
+}
+
+bool ToBool(const Scalar& scalar) {
+  if (scalar.kind != Scalar::Kind::kBool) {
+    throw formats::json::parser::InternalParseError(
+        fmt::format("bool was expected, but {} found", scalar.KindName()));
+  }
+  return scalar.bool_value;
+}
+
+std::string_view ToStringView(const Scalar& scalar) {
+  if (scalar.kind != Scalar::Kind::kString) {
+    throw formats::json::parser::InternalParseError(
+        fmt::format("string was expected, but {} found", scalar.KindName()));
+  }
+  return scalar.string_value;
+}
+
+int ToEnumValue(const FieldDescriptor& field, const Scalar& scalar) {
+  if (scalar.kind != Scalar::Kind::kString) {
+    return ToInteger<std::int32_t>(scalar);
+  }
+  const auto* value = field.enum_type()->FindValueByName(
+      grpc::string{scalar.string_value});
+  if (!value) {
+    throw formats::json::parser::InternalParseError(
+        fmt::format("'{}' is not a value of enum {}", scalar.string_value,
+                    field.enum_type()->full_name()));
+  }
+  return value->number();
+}
+
+grpc::string DecodeBytes(std::string_view value) {
+#ifndef USERVER_NO_CRYPTOPP_BASE64_URL
+  // Both standard and URL-safe alphabets are accepted by proto3 Json mapping
+  if (value.find_first_of("-_") != std::string_view::npos) {
+    return crypto::base64::Base64UrlDecode(value);
+  }
+#endif
+  return crypto::base64::Base64Decode(value);
+}
+
+// A place in the message where the next JSON value goes to
+struct Target final {
+  Message* message{nullptr};
+  const FieldDescriptor* field{nullptr};
+  // Whether the value is an element of the repeated field
+  bool is_element{false};
+
+  bool IsSingular() const { return is_element || !field->is_repeated(); }
+
+  bool IsMessage() const {
+    return IsSingular() &&
+           field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE;
+  }
+
+  Message& MutableMessage() const {
+    auto& reflection = *message->GetReflection();
+    return is_element ? *reflection.AddMessage(message, field)
+                      : *reflection.MutableMessage(message, field);
+  }
+};
+
+void SetScalar(const Target& target, const Scalar& scalar) {
+  auto& message = *target.message;
+  const auto& field = *target.field;
+  auto& reflection = *message.GetReflection();
+  const bool add = target.is_element;
+
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32: {
+      const auto value = ToInteger<std::int32_t>(scalar);
+      add ? reflection.AddInt32(&message, &field, value)
+          : reflection.SetInt32(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_INT64: {
+      const auto value = ToInteger<std::int64_t>(scalar);
+      add ? reflection.AddInt64(&message, &field, value)
+          : reflection.SetInt64(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_UINT32: {
+      const auto value = ToInteger<std::uint32_t>(scalar);
+      add ? reflection.AddUInt32(&message, &field, value)
+          : reflection.SetUInt32(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_UINT64: {
+      const auto value = ToInteger<std::uint64_t>(scalar);
+      add ? reflection.AddUInt64(&message, &field, value)
+          : reflection.SetUInt64(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_FLOAT: {
+      const auto value = ToFloatingPoint<float>(scalar);
+      add ? reflection.AddFloat(&message, &field, value)
+          : reflection.SetFloat(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_DOUBLE: {
+      const auto value = ToFloatingPoint<double>(scalar);
+      add ? reflection.AddDouble(&message, &field, value)
+          : reflection.SetDouble(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_BOOL: {
+      const auto value = ToBool(scalar);
+      add ? reflection.AddBool(&message, &field, value)
+          : reflection.SetBool(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_ENUM: {
+      const auto value = ToEnumValue(field, scalar);
+      add ? reflection.AddEnumValue(&message, &field, value)
+          : reflection.SetEnumValue(&message, &field, value);
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_STRING: {
+      auto value = field.type() == FieldDescriptor::TYPE_BYTES
+                       ? DecodeBytes(ToStringView(scalar))
+                       : grpc::string{ToStringView(scalar)};
+      add ? reflection.AddString(&message, &field, std::move(value))
+          : reflection.SetString(&message, &field, std::move(value));
+      return;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      break;
+  }
+  throw formats::json::parser::InternalParseError(fmt::format(
+      "object was expected, but {} found", scalar.KindName()));
+}
+
+void SetMapKey(Message& entry, std::string_view key) {
+  const auto& key_field = *entry.GetDescriptor()->map_key();
+  if (key_field.cpp_type() == FieldDescriptor::CPPTYPE_BOOL) {
+    if (key != "true" && key != "false") {
+      throw formats::json::parser::InternalParseError(
+          fmt::format("'{}' is not a valid bool map key", key));
+    }
+    entry.GetReflection()->SetBool(&entry, &key_field, key == "true");
+    return;
+  }
+
+  Scalar scalar;
+  scalar.kind = Scalar::Kind::kString;
+  scalar.string_value = key;
+  SetScalar(Target{&entry, &key_field}, scalar);
+}
+
+// Fills a message from SAX events. Keeps its own stack of nested messages,
+// repeated fields and maps instead of pushing a parser per level. Values of
+// well-known types are collected with JsonValueParser and handed over to
+// the protobuf library.
+class MessageParser final
+    : public formats::json::parser::BaseParser,
+      public formats::json::parser::Subscriber<formats::json::Value> {
+ public:
+  explicit MessageParser(Message& message) : root_(message) {}
+
+  void Null() override {
+    Scalar scalar;
+    OnScalar(scalar);
+  }
+
+  void Bool(bool value) override {
+    Scalar scalar;
+    scalar.kind = Scalar::Kind::kBool;
+    scalar.bool_value = value;
+    OnScalar(scalar);
+  }
+
+  void Int64(std::int64_t value) override {
+    Scalar scalar;
+    scalar.kind = Scalar::Kind::kInt64;
+    scalar.int64_value = value;
+    OnScalar(scalar);
+  }
+
+  void Uint64(std::uint64_t value) override {
+    Scalar scalar;
+    scalar.kind = Scalar::Kind::kUint64;
+    scalar.uint64_value = value;
+    OnScalar(scalar);
+  }
+
+  void Double(double value) override {
+    Scalar scalar;
+    scalar.kind = Scalar::Kind::kDouble;
+    scalar.double_value = value;
+    OnScalar(scalar);
+  }
+
+  void String(std::string_view value) override {
+    Scalar scalar;
+    scalar.kind = Scalar::Kind::kString;
+    scalar.string_value = value;
+    OnScalar(scalar);
+  }
+
+  void StartObject() override {
+    if (stack_.empty()) {
+      Push(Frame::Kind::kMessage, root_);
+      return;
+    }
+
+    const auto target = GetTarget();
+    if (!target.is_element && target.field->is_map()) {
+      Push(Frame::Kind::kMap, *target.message, target.field);
+      return;
+    }
+    if (!target.IsMessage()) Throw("object");
+
+    auto& message = target.MutableMessage();
+    if (IsWellKnownType(*message.GetDescriptor())) {
+      StartWellKnownType(message).StartObject();
+      return;
+    }
+    Push(Frame::Kind::kMessage, message);
+  }
+
+  void Key(std::string_view key) override {
+    UASSERT(!stack_.empty());
+    auto& frame = stack_.back();
+
+    if (frame.kind == Frame::Kind::kMap) {
+      auto& entry =
+          *frame.message->GetReflection()->AddMessage(frame.message,
+                                                       frame.field);
+      SetMapKey(entry, key);
+      frame.map_entry = &entry;
+      return;
+    }
+
+    UASSERT(frame.kind == Frame::Kind::kMessage);
+    frame.field = FindField(*frame.message->GetDescriptor(), key);
+    if (!frame.field) {
+      throw formats::json::parser::InternalParseError(
+          fmt::format("unknown field '{}' of {}", key,
+                      frame.message->GetDescriptor()->full_name()));
+    }
+  }
+
+  void EndObject() override { Pop(); }
+
+  void StartArray() override {
+    if (stack_.empty()) Throw("array");
+
+    const auto target = GetTarget();
+    if (!target.IsSingular() && !target.field->is_map()) {
+      Push(Frame::Kind::kRepeated, *target.message, target.field);
+      return;
+    }
+    if (target.IsMessage() &&
+        IsWellKnownType(*target.field->message_type())) {
+      StartWellKnownType(target.MutableMessage()).StartArray();
+      return;
+    }
+    Throw("array");
+  }
+
+  void EndArray() override { Pop(); }
+
+  void OnSend(formats::json::Value&& value) override {
+    UASSERT(well_known_target_);
+    ParseWellKnownType(formats::json::ToString(value), *well_known_target_);
+    well_known_target_ = nullptr;
+    OnValueDone();
+  }
+
+  std::string Expected() const override {
+    return stack_.empty() ? "object" : "value";
+  }
+
+  std::string GetPathItem() const override {
+    std::string path;
+    for (const auto& frame : stack_) {
+      if (frame.kind != Frame::Kind::kMessage || !frame.field) continue;
+      if (!path.empty()) path += '.';
+      path += frame.field->name();
+    }
+    return path;
+  }
+
+ private:
+  struct Frame final {
+    enum class Kind { kMessage, kRepeated, kMap };
+
+    Kind kind;
+    Message* message;
+    // kMessage: the field of the last key, kRepeated and kMap: the field
+    const FieldDescriptor* field{nullptr};
+    // kMap: the entry of the last key
+    Message* map_entry{nullptr};
+  };
+
+  void Push(Frame::Kind kind, Message& message,
+            const FieldDescriptor* field = nullptr) {
+    if (stack_.size() >= formats::json::kDepthParseLimit) {
+      throw formats::json::parser::InternalParseError(
+          "Exceeded maximum allowed JSON depth of: " +
+          std::to_string(formats::json::kDepthParseLimit));
+    }
+    stack_.push_back(Frame{kind, &message, field});
+  }
+
+  void Pop() {
+    UASSERT(!stack_.empty());
+    stack_.pop_back();
+    if (stack_.empty()) {
+      parser_state_->PopMe(*this);
+    } else {
+      OnValueDone();
+    }
+  }
+
+  Target GetTarget() const {
+    UASSERT(!stack_.empty());
+    const auto& frame = stack_.back();
+    switch (frame.kind) {
+      case Frame::Kind::kMessage:
+        UASSERT(frame.field);
+        return {frame.message, frame.field, false};
+      case Frame::Kind::kRepeated:
+        return {frame.message, frame.field, true};
+      case Frame::Kind::kMap:
+        UASSERT(frame.map_entry);
+        return {frame.map_entry, frame.map_entry->GetDescriptor()->map_value(),
+                false};
+    }
+    UINVARIANT(false, "Invalid frame kind");
+  }
+
+  void OnValueDone() {
+    auto& frame = stack_.back();
+    frame.field = frame.kind == Frame::Kind::kMessage ? nullptr : frame.field;
+    frame.map_entry = nullptr;
+  }
+
+  void OnScalar(const Scalar& scalar) {
+    if (stack_.empty()) Throw(std::string{scalar.KindName()});
+
+    const auto target = GetTarget();
+    if (target.IsMessage()) {
+      const auto& type = *target.field->message_type();
+      const bool is_value = type.full_name() == "google.protobuf.Value";
+      if (IsWellKnownType(type) &&
+          (scalar.kind != Scalar::Kind::kNull || is_value)) {
+        ForwardScalar(StartWellKnownType(target.MutableMessage()), scalar);
+        return;
+      }
+    }
+
+    if (scalar.kind == Scalar::Kind::kNull) {
+      // null stands for the default value of a field
+      if (IsNullValue(*target.field) && target.IsSingular()) {
+        SetScalar(target, Scalar{Scalar::Kind::kInt64});
+      } else if (target.is_element) {
+        Throw("null");
+      }
+      OnValueDone();
+      return;
+    }
+
+    if (!target.IsSingular()) Throw(std::string{scalar.KindName()});
+    SetScalar(target, scalar);
+    OnValueDone();
+  }
+
+  formats::json::parser::JsonValueParser& StartWellKnownType(
+      Message& message) {
+    well_known_target_ = &message;
+    auto& parser = well_known_parser_.emplace();
+    parser.Subscribe(*this);
+    parser_state_->PushParser(parser);
+    return parser;
+  }
+
+  static void ForwardScalar(formats::json::parser::JsonValueParser& parser,
+                            const Scalar& scalar) {
+    switch (scalar.kind) {
+      case Scalar::Kind::kNull:
+        parser.Null();
+        return;
+      case Scalar::Kind::kBool:
+        parser.Bool(scalar.bool_value);
+        return;
+      case Scalar::Kind::kInt64:
+        parser.Int64(scalar.int64_value);
+        return;
+      case Scalar::Kind::kUint64:
+        parser.Uint64(scalar.uint64_value);
+        return;
+      case Scalar::Kind::kDouble:
+        parser.Double(scalar.double_value);
+        return;
+      case Scalar::Kind::kString:
+        parser.String(scalar.string_value);
+        return;
+    }
+  }
+
+  Message& root_;
+  boost::container::small_vector<Frame, 16> stack_;
+  std::optional<formats::json::parser::JsonValueParser> well_known_parser_;
+  Message* well_known_target_{nullptr};
+};
+
+}  // namespace
+
+void WriteMessageToJson(const google::protobuf::Message& message,
+                        formats::json::StringBuilder& sw) {
+  WriteMessage(message, sw);
+}
+
+void ParseMessageFromJson(std::string_view json,
+                          google::protobuf::Message& message) {
+  message.Clear();
+
+  if (IsWellKnownType(*message.GetDescriptor())) {
+    try {
+      ParseWellKnownType(json, message);
+    } catch (const formats::json::parser::InternalParseError& e) {
+      throw formats::json::parser::ParseError(0, "", e.what());
+    }
+    return;
+  }
+
+  MessageParser parser{message};
+  formats::json::parser::ParserState state;
+  state.PushParser(parser);
+  state.ProcessInput(json);
+}
+
 }  // namespace ugrpc
 
 namespace formats::serialize {
@@ -98,11 +98,20 @@ ServerConfig ParseServerConfig(const yaml_config::YamlConfig& value,
       value["unix-socket-path"].As<std::optional<std::string>>();
   config.port = value["port"].As<std::optional<int>>();
   config.completion_queue_num = value["completion-queue-count"].As<int>(2);
+  config.pin_completion_queues =
+      value["pin-completion-queues"].As<bool>(false);
+  const auto queue_task_processor = value["completion-queue-task-processor"];
+  if (!queue_task_processor.IsMissing()) {
+    config.completion_queue_task_processor =
+        &ParseTaskProcessor(queue_task_processor, context);
+  }
   config.channel_args =
       value["channel-args"].As<decltype(config.channel_args)>({});
   config.native_log_level =
       value["native-log-level"].As<logging::Level>(logging::Level::kError);
   config.enable_channelz = value["enable-channelz"].As<bool>(false);
+  config.arena_initial_block_size =
+      value["arena-initial-block-size"].As<std::size_t>(0);
 
   const auto logger_name = value["access-tskv-logger"];
   if (!logger_name.IsMissing()) {
@@ -1,9 +1,18 @@
 #include <userver/ugrpc/server/impl/queue_holder.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include <grpcpp/server_builder.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fixed_array.hpp>
@@ -15,20 +24,67 @@ namespace ugrpc::server::impl {
 namespace {
 
 struct QueueSubHolder final {
-  explicit QueueSubHolder(std::unique_ptr<grpc::ServerCompletionQueue> queue)
-      : queue(std::move(queue)) {}
+  QueueSubHolder(std::unique_ptr<grpc::ServerCompletionQueue> queue,
+                 std::optional<std::size_t> cpu)
+      : queue(std::move(queue)), queue_runner(*this->queue, cpu) {}
+
+  QueueSubHolder(std::unique_ptr<grpc::ServerCompletionQueue> queue,
+                 engine::TaskProcessor& polling_task_processor)
+      : queue(std::move(queue)),
+        queue_runner(*this->queue, polling_task_processor) {}
 
   std::unique_ptr<grpc::ServerCompletionQueue> queue;
-  ugrpc::impl::QueueRunner queue_runner{*queue};
+  ugrpc::impl::QueueRunner queue_runner;
 };
 
+// CPUs the current thread may run on. The server is created from a task
+// processor worker, so with `cpu-affinity` or `numa-node` set for the task
+// processor the pollers share its CPUs. A cpuset of the container is honored
+// the same way.
+std::vector<std::size_t> GetAllowedCpus() {
+  std::vector<std::size_t> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (::sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+    }
+  } else {
+    LOG_WARNING() << "Failed to get the CPU affinity of the current thread, "
+                     "assuming all the CPUs are allowed";
+  }
+#endif
+  if (cpus.empty()) {
+    const std::size_t cpu_count =
+        std::max(std::thread::hardware_concurrency(), 1U);
+    for (std::size_t cpu = 0; cpu < cpu_count; ++cpu) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+std::optional<std::size_t> GetQueueCpu(std::size_t queue_index,
+                                       const std::vector<std::size_t>& cpus) {
+  if (cpus.empty()) return std::nullopt;
+  return cpus[queue_index % cpus.size()];
+}
+
 }  // namespace
 
 struct QueueHolder::Impl final {
-  explicit Impl(std::size_t num, grpc::ServerBuilder& server_builder)
-      : queue(utils::GenerateFixedArray(num, [&server_builder](size_t) {
-          return QueueSubHolder(server_builder.AddCompletionQueue());
-        })) {
+  Impl(std::size_t num, grpc::ServerBuilder& server_builder, bool pin_to_cpus,
+       engine::TaskProcessor* polling_task_processor)
+      : queue(utils::GenerateFixedArray(
+            num, [&, cpus = pin_to_cpus && !polling_task_processor
+                                ? GetAllowedCpus()
+                                : std::vector<std::size_t>{}](std::size_t i) {
+              if (polling_task_processor) {
+                return QueueSubHolder(server_builder.AddCompletionQueue(),
+                                      *polling_task_processor);
+              }
+              return QueueSubHolder(server_builder.AddCompletionQueue(),
+                                    GetQueueCpu(i, cpus));
+            })) {
     for (auto& subholder : queue)
       queues.queues.push_back(subholder.queue.get());
   }
@@ -37,8 +93,10 @@ struct QueueHolder::Impl final {
   ugrpc::impl::CompletionQueues queues;
 };
 
-QueueHolder::QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder)
-    : impl_(num, server_builder) {}
+QueueHolder::QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder,
+                         bool pin_to_cpus,
+                         engine::TaskProcessor* polling_task_processor)
+    : impl_(num, server_builder, pin_to_cpus, polling_task_processor) {}
 
 QueueHolder::~QueueHolder() = default;
 
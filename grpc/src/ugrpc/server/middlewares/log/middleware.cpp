@@ -1,8 +1,10 @@
 #include "middleware.hpp"
 
+#include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
 #include <userver/tracing/span.hpp>
-#include <userver/utils/log.hpp>
+
+#include <ugrpc/impl/protobuf_utils.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -16,33 +18,34 @@ void Middleware::CallRequestHook(const MiddlewareCallContext& context,
     auto& span = tracing::Span::CurrentSpan();
     span.SetLocalLogLevel(*settings_.local_log_level);
   }
-
-  const logging::LogExtra log_extra{
-      {"grpc_service", std::string(context.GetServiceName())},
-      {"grpc_method", std::string(context.GetMethodName())}};
-  auto log_func = [&]() -> std::string {
-    const auto& str = request.Utf8DebugString();
-    return utils::log::ToLimitedUtf8(str, settings_.max_msg_size);
-  };
+  if (!ShouldLogMessages()) return;
 
   LOG(settings_.msg_log_level)
-      << "gRPC request message: " << log_func() << log_extra;
+      << "gRPC request message: "
+      << ugrpc::impl::ToLimitedDebugString(request, settings_.max_msg_size)
+      << logging::LogExtra{
+             {"grpc_service", std::string(context.GetServiceName())},
+             {"grpc_method", std::string(context.GetMethodName())}};
 }
 
-void Middleware::CallResponseHook(const MiddlewareCallContext& context,
+void Middleware::CallResponseHook(const MiddlewareCallContext& /*context*/,
                                   google::protobuf::Message& response) {
   if (settings_.local_log_level) {
     auto& span = tracing::Span::CurrentSpan();
     span.SetLocalLogLevel(*settings_.local_log_level);
   }
-  const logging::LogExtra log_extra{
-      {"grpc_service", std::string(context.GetServiceName())},
-      {"grpc_method", std::string(context.GetMethodName())}};
-  auto log_func = [&]() -> std::string {
-    const auto& str = response.Utf8DebugString();
-    return utils::log::ToLimitedUtf8(str, settings_.max_msg_size);
-  };
-  LOG(settings_.msg_log_level) << "gRPC response message: " << log_func();
+  if (!ShouldLogMessages()) return;
+
+  LOG(settings_.msg_log_level)
+      << "gRPC response message: "
+      << ugrpc::impl::ToLimitedDebugString(response, settings_.max_msg_size);
+}
+
+bool Middleware::ShouldLogMessages() const {
+  // The span level set above would drop the record only after the message
+  // is formatted, check it beforehand
+  return !settings_.local_log_level ||
+         settings_.msg_log_level >= *settings_.local_log_level;
 }
 
 void Middleware::Handle(MiddlewareCallContext& context) const {
@@ -25,6 +25,8 @@ class Middleware final : public MiddlewareBase {
                         google::protobuf::Message& response) override;
 
  private:
+  bool ShouldLogMessages() const;
+
   Settings settings_;
 };
 
@@ -121,6 +121,7 @@ class Server::Impl final {
   ugrpc::impl::StatisticsStorage statistics_storage_;
   const dynamic_config::Source config_source_;
   logging::LoggerPtr access_tskv_logger_;
+  const std::size_t arena_initial_block_size_;
 };
 
 Server::Impl::Impl(ServerConfig&& config,
@@ -129,7 +130,8 @@ Server::Impl::Impl(ServerConfig&& config,
     : statistics_storage_(statistics_storage,
                           ugrpc::impl::StatisticsDomain::kServer),
       config_source_(config_source),
-      access_tskv_logger_(std::move(config.access_tskv_logger)) {
+      access_tskv_logger_(std::move(config.access_tskv_logger)),
+      arena_initial_block_size_(config.arena_initial_block_size) {
   LOG_INFO() << "Configuring the gRPC server";
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
@@ -143,7 +145,8 @@ Server::Impl::Impl(ServerConfig&& config,
   server_builder_.emplace();
   ApplyChannelArgs(*server_builder_, config);
   queue_.emplace(static_cast<std::size_t>(config.completion_queue_num),
-                 std::ref(*server_builder_));
+                 std::ref(*server_builder_), config.pin_completion_queues,
+                 config.completion_queue_task_processor);
 
   if (config.unix_socket_path) AddListeningUnixSocket(*config.unix_socket_path);
 
@@ -200,6 +203,7 @@ void Server::Impl::AddService(ServiceBase& service, ServiceConfig&& config) {
       std::move(config.middlewares),
       access_tskv_logger_,
       config_source_,
+      arena_initial_block_size_,
   }));
 }
 
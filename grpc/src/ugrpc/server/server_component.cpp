@@ -54,6 +54,18 @@ properties:
             completion queue count to create. Should be ~2 times less than worker
             threads for best RPS.
         minimum: 1
+    pin-completion-queues:
+        type: boolean
+        description: |
+            pin the thread polling completion queue `i` to the `i`-th CPU of
+            the task processor affinity or cpuset
+        defaultDescription: false
+    completion-queue-task-processor:
+        type: string
+        description: |
+            poll the completion queues by the tasks of this task processor
+            instead of dedicated threads, so that the completions wake up
+            the RPC tasks without a hop through another thread
     channel-args:
         type: object
         description: a map of channel arguments, see gRPC Core docs
@@ -80,6 +92,13 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    arena-initial-block-size:
+        type: integer
+        description: |
+            if non-zero, requests are allocated on per-call protobuf arenas
+            with such initial block size
+        defaultDescription: 0
+        minimum: 0
     service-defaults:
         type: object
         description: omitted options for service components will default to the corresponding option from here
@@ -0,0 +1,65 @@
+#include <userver/utest/utest.hpp>
+
+#include <google/protobuf/arena.h>
+
+#include <userver/ugrpc/arena.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.arena_initial_block_size = 1024;
+  return config;
+}
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    EXPECT_NE(call.GetArena(), nullptr);
+    EXPECT_EQ(request.GetArena(), call.GetArena());
+
+    auto* response =
+        google::protobuf::Arena::CreateMessage<sample::ugrpc::GreetingResponse>(
+            call.GetArena());
+    response->set_name("Hello " + request.name());
+    call.Finish(*response);
+  }
+};
+
+class GrpcArena : public ugrpc::tests::ServiceFixture<UnitTestService> {
+ public:
+  GrpcArena()
+      : ugrpc::tests::ServiceFixture<UnitTestService>(
+            dynamic_config::MakeDefaultStorage({}), MakeServerConfig()) {}
+};
+
+}  // namespace
+
+UTEST_F(GrpcArena, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+  EXPECT_EQ(client.SayHello(out).Finish().name(), "Hello userver");
+}
+
+TEST(GrpcArenaOptions, Basic) {
+  const auto options = ugrpc::MakeArenaOptions(256);
+  for (int i = 0; i < 10; ++i) {
+    google::protobuf::Arena arena(options);
+    auto* message =
+        google::protobuf::Arena::CreateMessage<sample::ugrpc::GreetingRequest>(
+            &arena);
+    message->set_name(std::string(1000, 'x'));
+    EXPECT_GE(arena.SpaceAllocated(), 1000);
+  }
+}
+
+USERVER_NAMESPACE_END
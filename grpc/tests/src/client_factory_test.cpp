@@ -1,5 +1,7 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <vector>
+
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/value.hpp>
@@ -42,4 +44,60 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, ChannelPoolGrowth) {
+  ugrpc::client::ClientFactorySettings settings;
+  settings.channel_count = 1;
+  settings.max_channel_count = 3;
+  settings.max_streams_per_channel = 2;
+  ugrpc::client::QueueHolder client_queue;
+
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage;
+
+  testsuite::GrpcControl ts({}, false);
+  ugrpc::client::MiddlewareFactories mws;
+  ugrpc::client::ClientFactory client_factory(
+      std::move(settings), engine::current_task::GetTaskProcessor(), mws,
+      client_queue.GetQueue(), statistics_storage, ts,
+      config_storage.GetSource());
+
+  const std::string endpoint{"[::]:50051"};
+  auto client = client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+      "test", endpoint);
+
+  const auto& token =
+      ugrpc::client::impl::GetClientData(client).GetChannelToken();
+  ASSERT_EQ(3, token.GetChannelCount());
+  ASSERT_EQ(1, token.GetActiveChannelCount());
+
+  std::vector<ugrpc::client::impl::ChannelCache::Lease> leases;
+  leases.push_back(token.AcquireChannel());
+  leases.push_back(token.AcquireChannel());
+  EXPECT_EQ(0, leases[0].GetIndex());
+  EXPECT_EQ(0, leases[1].GetIndex());
+  EXPECT_EQ(1, token.GetActiveChannelCount());
+
+  // The only active channel is full, a new one is activated
+  leases.push_back(token.AcquireChannel());
+  EXPECT_EQ(1, leases[2].GetIndex());
+  EXPECT_EQ(2, token.GetActiveChannelCount());
+
+  // The least loaded channel is picked
+  leases.push_back(token.AcquireChannel());
+  EXPECT_EQ(1, leases[3].GetIndex());
+
+  leases.push_back(token.AcquireChannel());
+  EXPECT_EQ(2, leases[4].GetIndex());
+  EXPECT_EQ(3, token.GetActiveChannelCount());
+
+  // The pool does not grow beyond max-channel-count
+  leases.push_back(token.AcquireChannel());
+  EXPECT_EQ(3, token.GetActiveChannelCount());
+
+  // Released channels are picked first
+  leases[0] = {};
+  leases[1] = {};
+  EXPECT_EQ(0, token.AcquireChannel().GetIndex());
+}
+
 USERVER_NAMESPACE_END
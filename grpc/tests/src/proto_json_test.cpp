@@ -0,0 +1,150 @@
+#include <userver/ugrpc/proto_json.hpp>
+
+#include <cmath>
+
+#include <google/protobuf/util/message_differencer.h>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <tests/messages.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+sample::ugrpc::JsonMessage MakeMessage() {
+  sample::ugrpc::JsonMessage message;
+  message.set_int32_field(-42);
+  message.set_int64_field(-1234567890123456789);
+  message.set_uint32_field(42);
+  message.set_uint64_field(12345678901234567890ULL);
+  message.set_float_field(1.5F);
+  message.set_double_field(-0.25);
+  message.set_bool_field(true);
+  message.set_string_field("string \"with\" quotes");
+  message.set_bytes_field(std::string{"\0\1\2bytes", 8});
+  message.set_enum_field(sample::ugrpc::JSON_ENUM_FIRST);
+  message.mutable_nested()->set_number(1);
+  message.mutable_nested()->set_name("nested");
+  message.add_repeated_int32(1);
+  message.add_repeated_int32(2);
+  message.add_repeated_nested()->set_name("first");
+  message.add_repeated_nested()->set_number(2);
+  (*message.mutable_string_map())["key"] = 3;
+  (*message.mutable_int64_map())[-7].set_name("seven");
+  message.mutable_choice_nested()->set_number(17);
+  message.mutable_timestamp()->set_seconds(1700000000);
+  message.mutable_timestamp()->set_nanos(500000000);
+  auto& fields =
+      *message.mutable_value()->mutable_struct_value()->mutable_fields();
+  fields["list"].mutable_list_value()->add_values()->set_bool_value(true);
+  fields["null"].set_null_value(google::protobuf::NULL_VALUE);
+  return message;
+}
+
+std::string WriteToString(const google::protobuf::Message& message) {
+  formats::json::StringBuilder sw;
+  ugrpc::WriteMessageToJson(message, sw);
+  return sw.GetString();
+}
+
+}  // namespace
+
+TEST(ProtoJson, WriteMatchesProtobuf) {
+  const auto message = MakeMessage();
+  EXPECT_EQ(formats::json::FromString(WriteToString(message)),
+            ugrpc::MessageToJson(message));
+}
+
+TEST(ProtoJson, WriteDefaultsMatchProtobuf) {
+  const sample::ugrpc::JsonMessage message;
+  EXPECT_EQ(formats::json::FromString(WriteToString(message)),
+            ugrpc::MessageToJson(message));
+}
+
+TEST(ProtoJson, WriteNested) {
+  const auto message = MakeMessage();
+  formats::json::StringBuilder sw;
+  {
+    const formats::json::StringBuilder::ObjectGuard guard{sw};
+    sw.Key("message");
+    ugrpc::WriteMessageToJson(message, sw);
+    sw.Key("other");
+    sw.WriteBool(true);
+  }
+
+  const auto json = formats::json::FromString(sw.GetString());
+  EXPECT_EQ(json["message"], ugrpc::MessageToJson(message));
+  EXPECT_TRUE(json["other"].As<bool>());
+}
+
+TEST(ProtoJson, ParseRoundTrip) {
+  const auto message = MakeMessage();
+
+  sample::ugrpc::JsonMessage parsed;
+  ugrpc::ParseMessageFromJson(ugrpc::ToJsonString(message), parsed);
+  EXPECT_TRUE(
+      google::protobuf::util::MessageDifferencer::Equals(message, parsed))
+      << parsed.DebugString();
+
+  sample::ugrpc::JsonMessage reparsed;
+  ugrpc::ParseMessageFromJson(WriteToString(parsed), reparsed);
+  EXPECT_TRUE(
+      google::protobuf::util::MessageDifferencer::Equals(message, reparsed))
+      << reparsed.DebugString();
+}
+
+TEST(ProtoJson, ParseFieldNamesAndNulls) {
+  sample::ugrpc::JsonMessage message;
+  message.set_bool_field(true);
+
+  ugrpc::ParseMessageFromJson(R"({
+    "int32_field": "5",
+    "stringField": "value",
+    "doubleField": "NaN",
+    "enumField": 1,
+    "nested": null,
+    "repeatedInt32": null,
+    "bytesField": "AQL-_w"
+  })",
+                              message);
+
+  EXPECT_FALSE(message.bool_field());
+  EXPECT_EQ(message.int32_field(), 5);
+  EXPECT_EQ(message.string_field(), "value");
+  EXPECT_TRUE(std::isnan(message.double_field()));
+  EXPECT_EQ(message.enum_field(), sample::ugrpc::JSON_ENUM_FIRST);
+  EXPECT_FALSE(message.has_nested());
+  EXPECT_EQ(message.repeated_int32_size(), 0);
+  EXPECT_EQ(message.bytes_field(), std::string("\1\2\xfe\xff", 4));
+}
+
+TEST(ProtoJson, ParseErrors) {
+  sample::ugrpc::JsonMessage message;
+
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"unknown": 1})", message),
+               formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"int32Field": 1.5})", message),
+               formats::json::Exception);
+  EXPECT_THROW(
+      ugrpc::ParseMessageFromJson(R"({"int32Field": 4294967296})", message),
+      formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"boolField": 1})", message),
+               formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"enumField": "NONE"})", message),
+               formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"repeatedInt32": 1})", message),
+               formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"nested": [1]})", message),
+               formats::json::Exception);
+  EXPECT_THROW(
+      ugrpc::ParseMessageFromJson(R"({"timestamp": "yesterday"})", message),
+      formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"([])", message),
+               formats::json::Exception);
+  EXPECT_THROW(ugrpc::ParseMessageFromJson(R"({"nested": {})", message),
+               formats::json::Exception);
+}
+
+USERVER_NAMESPACE_END
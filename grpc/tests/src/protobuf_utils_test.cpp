@@ -0,0 +1,48 @@
+#include <ugrpc/impl/protobuf_utils.hpp>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/text_light.hpp>
+
+#include <tests/messages.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ToLimitedDebugString, Short) {
+  sample::ugrpc::GreetingRequest message;
+  message.set_name("userver");
+
+  EXPECT_EQ(ugrpc::impl::ToLimitedDebugString(message, 512),
+            R"(name: "userver")");
+}
+
+TEST(ToLimitedDebugString, Nested) {
+  sample::ugrpc::JsonMessage message;
+  message.set_int32_field(5);
+  message.mutable_nested()->set_name("nested");
+
+  EXPECT_EQ(ugrpc::impl::ToLimitedDebugString(message, 512),
+            R"(int32_field: 5 nested { name: "nested" })");
+}
+
+TEST(ToLimitedDebugString, Truncated) {
+  sample::ugrpc::JsonMessage message;
+  for (int i = 0; i < 1000; ++i) {
+    message.add_repeated_nested()->set_name("name");
+  }
+
+  const auto result = ugrpc::impl::ToLimitedDebugString(message, 100);
+  EXPECT_EQ(result.size(), 100 + std::string_view{"...(truncated)"}.size());
+  EXPECT_TRUE(utils::text::EndsWith(result, "...(truncated)"));
+  EXPECT_TRUE(utils::text::StartsWith(result, "repeated_nested { name:"));
+}
+
+TEST(ToLimitedDebugString, TruncatedUtf8) {
+  sample::ugrpc::GreetingRequest message;
+  // Each character takes two bytes
+  message.set_name("привет привет привет");
+
+  const auto result = ugrpc::impl::ToLimitedDebugString(message, 10);
+  EXPECT_EQ(result, "name: \"п...(truncated)");
+}
+
+USERVER_NAMESPACE_END
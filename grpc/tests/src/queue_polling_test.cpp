@@ -0,0 +1,99 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kCompletionQueues = 2;
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.completion_queue_num = kCompletionQueues;
+  config.completion_queue_task_processor =
+      &engine::current_task::GetTaskProcessor();
+  return config;
+}
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_name("Hello " + request.name());
+      response.set_number(request.number());
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+class GrpcQueuePolling : public ugrpc::tests::ServiceFixture<UnitTestService> {
+ public:
+  GrpcQueuePolling()
+      : ugrpc::tests::ServiceFixture<UnitTestService>(
+            dynamic_config::MakeDefaultStorage({}), MakeServerConfig()) {}
+};
+
+}  // namespace
+
+UTEST_F(GrpcQueuePolling, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+  EXPECT_EQ(client.SayHello(out).Finish().name(), "Hello userver");
+}
+
+UTEST_F(GrpcQueuePolling, BidirectionalStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto call = client.Chat();
+
+  sample::ugrpc::StreamGreetingRequest out;
+  sample::ugrpc::StreamGreetingResponse in;
+  out.set_name("userver");
+  for (int i = 0; i < 10; ++i) {
+    out.set_number(i);
+    ASSERT_TRUE(call.Write(out));
+    ASSERT_TRUE(call.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  ASSERT_TRUE(call.WritesDone());
+  EXPECT_FALSE(call.Read(in));
+}
+
+UTEST_F_MT(GrpcQueuePolling, ConcurrentUnaryRPC, 4) {
+  constexpr int kTasks = 16;
+  constexpr int kCallsPerTask = 20;
+
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&client] {
+      sample::ugrpc::GreetingRequest out;
+      out.set_name("userver");
+      for (int j = 0; j < kCallsPerTask; ++j) {
+        EXPECT_EQ(client.SayHello(out).Finish().name(), "Hello userver");
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+}
+
+USERVER_NAMESPACE_END
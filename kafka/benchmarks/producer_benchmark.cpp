@@ -0,0 +1,87 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/kafka/producer.hpp>
+
+#include <kafka/impl/configuration.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kPayloadSize = 256;
+constexpr std::size_t kWorkerThreads = 4;
+
+const std::string kTopic{"benchmark-topic"};
+
+std::unique_ptr<kafka::impl::Configuration> MakeMockClusterConfiguration() {
+  /// @note `test.mock.num.brokers` makes `librdkafka` start the local mock
+  /// cluster, that automatically creates the topics on first produce
+  return std::make_unique<kafka::impl::Configuration>(
+      "kafka-producer-benchmark",
+      std::vector<std::pair<std::string, std::string>>{
+          {"test.mock.num.brokers", "3"},
+          {"linger.ms", "1"},
+      });
+}
+
+}  // namespace
+
+void ProducerSendAsync(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&state] {
+    const kafka::Producer producer{
+        MakeMockClusterConfiguration(),
+        engine::current_task::GetTaskProcessor(),
+        kafka::Producer::kDefaultPollTimeout,
+        kafka::Producer::kDefaultSendRetries};
+    const std::string payload(kPayloadSize, 'x');
+    const auto messages_count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<engine::TaskWithResult<void>> sends;
+    sends.reserve(messages_count);
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < messages_count; ++i) {
+        sends.push_back(producer.SendAsync(kTopic, std::to_string(i), payload));
+      }
+      engine::WaitAllChecked(sends);
+      sends.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(ProducerSendAsync)->RangeMultiplier(8)->Range(1, 4096);
+
+void ProducerSendBatch(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&state] {
+    const kafka::Producer producer{
+        MakeMockClusterConfiguration(),
+        engine::current_task::GetTaskProcessor(),
+        kafka::Producer::kDefaultPollTimeout,
+        kafka::Producer::kDefaultSendRetries};
+    const std::string payload(kPayloadSize, 'x');
+    const auto messages_count = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+      std::vector<kafka::ProducerMessage> messages;
+      messages.reserve(messages_count);
+      for (std::size_t i = 0; i < messages_count; ++i) {
+        messages.push_back({std::to_string(i), payload, std::nullopt});
+      }
+      producer.SendBatch(kTopic, std::move(messages));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(ProducerSendBatch)->RangeMultiplier(8)->Range(1, 4096);
+
+USERVER_NAMESPACE_END
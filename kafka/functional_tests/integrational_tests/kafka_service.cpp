@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 
 #include <userver/utest/using_namespace_userver.hpp>
@@ -16,6 +20,7 @@
 #include <userver/formats/json/serialize_container.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 
 #include <userver/server/handlers/http_handler_json_base.hpp>
 #include <userver/server/handlers/tests_control.hpp>
@@ -41,9 +46,15 @@ constexpr std::string_view kReqProducerFieldName = "producer";
 constexpr std::string_view kReqTopicFieldName = "topic";
 constexpr std::string_view kReqKeyFieldName = "key";
 constexpr std::string_view kReqPayloadFieldName = "payload";
+constexpr std::string_view kReqPartitionFieldName = "partition";
+constexpr std::string_view kReqMessagesFieldName = "messages";
 
 constexpr std::string_view kReqTopicArgName = "topic_name";
 
+/// Processing of a batch with this payload fails once, for the tests of the
+/// failed partitions reprocessing
+constexpr std::string_view kFailOncePayload = "fail-once";
+
 constexpr std::string_view kMessageSend = R"(
   {
     "message": "Message send successfully"
@@ -64,6 +75,11 @@ constexpr std::string_view kErrorMembersNotSet = R"(
     "error": "Expected body has 'producer', `topic`, `key` and `payload` fields"
   }
 )";
+constexpr std::string_view kErrorBatchMembersNotSet = R"(
+  {
+    "error": "Expected body has 'producer', `topic` and `messages` fields"
+  }
+)";
 constexpr std::string_view kErrorProducerNotFound = R"(
   {
     "error": "Given producer not found"
@@ -83,6 +99,8 @@ class HandlerKafkaConsumer final
       const formats::json::Value& request_json,
       server::request::RequestContext& context) const override;
 
+  static yaml_config::Schema GetStaticConfigSchema();
+
  private:
   using MessagesByTopic =
       std::unordered_map<std::string, std::vector<formats::json::Value>>;
@@ -98,6 +116,7 @@ class HandlerKafkaConsumer final
 
  private:
   mutable concurrent::Variable<MessagesByTopic> messages_by_topic_;
+  std::atomic<bool> failed_once_{false};
 
   // Subscriptions must be the last fields! Add new fields above this comment.
   kafka::ConsumerScope consumer_;
@@ -134,6 +153,25 @@ class HandlerKafkaProducers final
   std::unordered_map<std::string, kafka::Producer&> producer_by_topic_;
 };
 
+class HandlerKafkaProducerBatch final
+    : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-kafka-producer-batch";
+
+  HandlerKafkaProducerBatch(const components::ComponentConfig& config,
+                            const components::ComponentContext& context);
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      server::request::RequestContext& context) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unordered_map<std::string, kafka::Producer&> producer_by_name_;
+};
+
 }  // namespace functional_tests
 
 namespace functional_tests {
@@ -166,6 +204,16 @@ RequestMessage Parse(const formats::json::Value& doc,
   return request_message;
 }
 
+kafka::ProducerMessage ParseProducerMessage(const formats::json::Value& doc) {
+  kafka::ProducerMessage message;
+  message.key = doc[kReqKeyFieldName].As<std::string>();
+  message.payload = doc[kReqPayloadFieldName].As<std::string>();
+  message.partition =
+      doc[kReqPartitionFieldName].As<std::optional<std::uint32_t>>();
+
+  return message;
+}
+
 bool IsCorrectRequest(const formats::json::Value& request_json) {
   const auto check_message = [](const formats::json::Value& value) {
     return value.HasMember(kReqPayloadFieldName) &&
@@ -188,9 +236,17 @@ HandlerKafkaConsumer::HandlerKafkaConsumer(
     const components::ComponentConfig& config,
     const components::ComponentContext& context)
     : server::handlers::HttpHandlerJsonBase(config, context),
-      consumer_(
-          context.FindComponent<kafka::ConsumerComponent>("kafka-consumer")
-              .GetConsumer()) {
+      consumer_(context
+                    .FindComponent<kafka::ConsumerComponent>(
+                        config["consumer"].As<std::string>("kafka-consumer"))
+                    .GetConsumer()) {
+  if (config["partition_parallel"].As<bool>(false)) {
+    // Offsets of the processed partitions are committed by the consumer
+    consumer_.Start(
+        [this](kafka::MessageBatchView messages) { Consume(messages); });
+    return;
+  }
+
   consumer_.Start([this](kafka::MessageBatchView messages) {
     Consume(messages);
     consumer_.AsyncCommit();
@@ -198,6 +254,23 @@ HandlerKafkaConsumer::HandlerKafkaConsumer(
 }
 /// [Kafka service sample - consumer usage]
 
+yaml_config::Schema HandlerKafkaConsumer::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<server::handlers::HttpHandlerJsonBase>(R"(
+type: object
+description: Handler of Kafka consumer
+additionalProperties: false
+properties:
+    consumer:
+        type: string
+        description: consumer component name
+        defaultDescription: kafka-consumer
+    partition_parallel:
+        type: boolean
+        description: whether the consumer has partition_parallelism greater than 1
+        defaultDescription: false
+)");
+}
+
 formats::json::Value HandlerKafkaConsumer::HandleRequestJsonThrow(
     const server::http::HttpRequest& request,
     [[maybe_unused]] const formats::json::Value& request_json,
@@ -247,6 +320,14 @@ std::vector<formats::json::Value> HandlerKafkaConsumer::ReleaseMessages(
 }
 
 void HandlerKafkaConsumer::Consume(kafka::MessageBatchView messages) {
+  const auto should_fail = [this](const kafka::Message& message) {
+    return message.GetPayload() == kFailOncePayload &&
+           !failed_once_.exchange(true);
+  };
+  if (std::any_of(messages.begin(), messages.end(), should_fail)) {
+    throw std::runtime_error("Failing the batch once on test request");
+  }
+
   auto thisMessages = messages_by_topic_.Lock();
 
   for (const auto& message : messages) {
@@ -419,12 +500,95 @@ formats::json::Value HandlerKafkaProducers::HandleMultiProducersRequest(
 
   return formats::json::FromString(kMessagesSend);
 }
+
+HandlerKafkaProducerBatch::HandlerKafkaProducerBatch(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : server::handlers::HttpHandlerJsonBase(config, context) {
+  for (const auto& producer_component_name : config[kProducersListFieldName]) {
+    const auto parsed_producer_component_name =
+        producer_component_name.As<std::string>();
+    producer_by_name_.emplace(parsed_producer_component_name,
+                              context
+                                  .FindComponent<kafka::ProducerComponent>(
+                                      parsed_producer_component_name)
+                                  .GetProducer());
+  }
+}
+
+formats::json::Value HandlerKafkaProducerBatch::HandleRequestJsonThrow(
+    const server::http::HttpRequest& request,
+    const formats::json::Value& request_json,
+    [[maybe_unused]] server::request::RequestContext& context) const {
+  if (!request_json.HasMember(kReqProducerFieldName) ||
+      !request_json.HasMember(kReqTopicFieldName) ||
+      !request_json[kReqMessagesFieldName].IsArray()) {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+
+    return formats::json::FromString(kErrorBatchMembersNotSet);
+  }
+
+  const auto producer_it = producer_by_name_.find(
+      request_json[kReqProducerFieldName].As<std::string>());
+  if (producer_it == producer_by_name_.end()) {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+
+    return formats::json::FromString(kErrorProducerNotFound);
+  }
+
+  std::vector<kafka::ProducerMessage> messages;
+  messages.reserve(request_json[kReqMessagesFieldName].GetSize());
+  for (const auto& message : request_json[kReqMessagesFieldName]) {
+    messages.push_back(ParseProducerMessage(message));
+  }
+
+  try {
+    producer_it->second.SendBatch(
+        request_json[kReqTopicFieldName].As<std::string>(),
+        std::move(messages));
+  } catch (const kafka::SendBatchError& ex) {
+    // Other messages of the batch are delivered, only the failed ones
+    // may be sent again
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+
+    formats::json::ValueBuilder builder{formats::common::Type::kObject};
+    builder["error"] = fmt::format("Kafka error: {}", ex.what());
+    builder["failed_messages"] = formats::common::Type::kArray;
+    for (const auto& failed : ex.GetFailedMessages()) {
+      formats::json::ValueBuilder failed_builder;
+      failed_builder["key"] = failed.message.key;
+      failed_builder["payload"] = failed.message.payload;
+      failed_builder["error"] = failed.error;
+      builder["failed_messages"].PushBack(failed_builder.ExtractValue());
+    }
+
+    return builder.ExtractValue();
+  }
+
+  return formats::json::FromString(kMessagesSend);
+}
+
+yaml_config::Schema HandlerKafkaProducerBatch::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<server::handlers::HttpHandlerJsonBase>(R"(
+type: object
+description: Handler of Kafka producers sending messages in batches
+additionalProperties: false
+properties:
+    producers_list:
+        type: array
+        description: list of producer names
+        items:
+          type: string
+          description: producer name
+)");
+}
 }  // namespace functional_tests
 
 int main(int argc, char* argv[]) {
   const auto components_list =
       components::MinimalServerComponentList()
           .Append<kafka::ConsumerComponent>("kafka-consumer")
+          .Append<kafka::ConsumerComponent>("kafka-consumer-parallel")
           .Append<kafka::ProducerComponent>("kafka-producer-first")
           .Append<kafka::ProducerComponent>("kafka-producer-second")
           .Append<components::TestsuiteSupport>()
@@ -434,7 +598,10 @@ int main(int argc, char* argv[]) {
           .Append<clients::dns::Component>()
           .Append<server::handlers::TestsControl>()
           .Append<functional_tests::HandlerKafkaConsumer>()
-          .Append<functional_tests::HandlerKafkaProducers>();
+          .Append<functional_tests::HandlerKafkaConsumer>(
+              "handler-kafka-consumer-parallel")
+          .Append<functional_tests::HandlerKafkaProducers>()
+          .Append<functional_tests::HandlerKafkaProducerBatch>();
 
   return utils::DaemonMain(argc, argv, components_list);
 }
@@ -23,6 +23,7 @@ def service_env():
     secdist_config = {
         'kafka_settings': {
             'kafka-consumer': single_setting,
+            'kafka-consumer-parallel': single_setting,
             'kafka-producer-first': single_setting,
             'kafka-producer-second': single_setting,
         },
@@ -0,0 +1,88 @@
+from common import generate_messages_to_consume
+from utils import consume
+
+
+CONSUME_PARALLEL_ROUTE = '/consume-parallel'
+TOPICS = [
+    'test-topic-parallel-1',
+    'test-topic-parallel-2',
+    'test-topic-parallel-3',
+]
+
+
+async def _consume_all(
+        service_client, received_messages_func, expected_cnt: int,
+) -> dict[str, list[dict[str, str]]]:
+    consumed: dict[str, list[dict[str, str]]] = {topic: [] for topic in TOPICS}
+    consumed_cnt = 0
+    while consumed_cnt < expected_cnt:
+        await received_messages_func.wait_call()
+
+        for topic in TOPICS:
+            response = await consume(
+                service_client, topic, route=CONSUME_PARALLEL_ROUTE,
+            )
+            consumed[topic].extend(response['messages'])
+            consumed_cnt += len(response['messages'])
+
+    return consumed
+
+
+async def test_consume_partitions_in_parallel(
+        service_client, testpoint, kafka_producer,
+):
+    @testpoint('tp_kafka-consumer-parallel')
+    def received_messages_func(_data):
+        pass
+
+    await service_client.enable_testpoints()
+
+    messages = generate_messages_to_consume(topics=TOPICS, cnt=10)
+    for topic in TOPICS:
+        for message in messages[topic]:
+            await kafka_producer.produce(
+                message['topic'], message['key'], message['payload'],
+            )
+
+    consumed = await _consume_all(
+        service_client, received_messages_func, expected_cnt=30,
+    )
+
+    # Each topic has a single partition, its messages come in produced order
+    assert consumed == messages
+
+
+async def test_failed_partition_reprocessed_alone(
+        service_client, testpoint, kafka_producer,
+):
+    @testpoint('tp_kafka-consumer-parallel')
+    def received_messages_func(_data):
+        pass
+
+    @testpoint('tp_error_kafka-consumer-parallel')
+    def error_func(_data):
+        pass
+
+    await service_client.enable_testpoints()
+
+    failed_topic = TOPICS[0]
+    await kafka_producer.produce(failed_topic, 'key-fail', 'fail-once')
+    messages = generate_messages_to_consume(topics=TOPICS[1:], cnt=5)
+    for topic in TOPICS[1:]:
+        for message in messages[topic]:
+            await kafka_producer.produce(
+                message['topic'], message['key'], message['payload'],
+            )
+
+    await error_func.wait_call()
+    consumed = await _consume_all(
+        service_client, received_messages_func, expected_cnt=11,
+    )
+
+    # Offsets of the succeeded partitions are committed before resubscription,
+    # so only the failed partition messages come again
+    assert consumed[failed_topic] == [
+        {'topic': failed_topic, 'key': 'key-fail', 'payload': 'fail-once'},
+    ]
+    for topic in TOPICS[1:]:
+        assert consumed[topic] == messages[topic]
@@ -0,0 +1,118 @@
+from utils import consume
+
+
+PRODUCE_BATCH_ROUTE = '/produce-batch'
+PRODUCER = 'kafka-producer-first'
+TOPIC = 'test-topic-send'
+NONEXISTENT_PARTITION = 100
+
+
+def _make_messages(cnt: int, partition: int, prefix: str) -> list[dict]:
+    return [
+        {
+            'key': f'{prefix}-key-{i}',
+            'payload': f'{prefix}-payload-{i}',
+            'partition': partition,
+        }
+        for i in range(cnt)
+    ]
+
+
+async def _produce_batch(service_client, messages: list[dict]):
+    return await service_client.post(
+        PRODUCE_BATCH_ROUTE,
+        json={'producer': PRODUCER, 'topic': TOPIC, 'messages': messages},
+    )
+
+
+async def _consume_all(
+        service_client, received_messages_func, expected_cnt: int,
+) -> list[dict[str, str]]:
+    consumed: list[dict[str, str]] = []
+    while len(consumed) < expected_cnt:
+        await received_messages_func.wait_call()
+
+        response = await consume(service_client, TOPIC)
+        consumed.extend(response['messages'])
+
+    return consumed
+
+
+def _without_partition(messages: list[dict]) -> list[dict[str, str]]:
+    return [
+        {'topic': TOPIC, 'key': message['key'], 'payload': message['payload']}
+        for message in messages
+    ]
+
+
+async def test_send_batch(service_client, testpoint):
+    @testpoint('tp_kafka-consumer')
+    def received_messages_func(_data):
+        pass
+
+    @testpoint(f'tp_{PRODUCER}')
+    def delivered_func(_data):
+        pass
+
+    await service_client.enable_testpoints()
+
+    messages = _make_messages(cnt=10, partition=0, prefix='batch')
+    response = await _produce_batch(service_client, messages)
+    assert response.status_code == 200
+
+    delivered_keys = set()
+    for _ in messages:
+        delivered_keys.add((await delivered_func.wait_call())['_data']['key'])
+    assert delivered_keys == {message['key'] for message in messages}
+
+    consumed = await _consume_all(
+        service_client, received_messages_func, expected_cnt=len(messages),
+    )
+    # Messages of the batch are sent to the same partition, so the order is
+    # preserved
+    assert consumed == _without_partition(messages)
+
+
+async def test_send_batch_partially_failed(service_client, testpoint):
+    @testpoint('tp_kafka-consumer')
+    def received_messages_func(_data):
+        pass
+
+    @testpoint(f'tp_{PRODUCER}')
+    def delivered_func(_data):
+        pass
+
+    await service_client.enable_testpoints()
+
+    delivered = _make_messages(cnt=5, partition=0, prefix='delivered')
+    failed = _make_messages(
+        cnt=3, partition=NONEXISTENT_PARTITION, prefix='failed',
+    )
+    messages = [
+        message for pair in zip(delivered, failed) for message in pair
+    ] + delivered[len(failed):]
+
+    response = await _produce_batch(service_client, messages)
+    assert response.status_code == 400
+
+    failed_messages = response.json()['failed_messages']
+    assert [
+        {'key': message['key'], 'payload': message['payload']}
+        for message in failed_messages
+    ] == [
+        {'key': message['key'], 'payload': message['payload']}
+        for message in failed
+    ]
+    assert all(message['error'] for message in failed_messages)
+
+    # Testpoints are sent only for the delivered messages
+    delivered_keys = set()
+    for _ in delivered:
+        delivered_keys.add((await delivered_func.wait_call())['_data']['key'])
+    assert delivered_keys == {message['key'] for message in delivered}
+    assert not delivered_func.has_calls
+
+    consumed = await _consume_all(
+        service_client, received_messages_func, expected_cnt=len(delivered),
+    )
+    assert consumed == _without_partition(delivered)
@@ -55,9 +55,9 @@ async def produce_batch(
 
 
 async def consume(
-        service_client, topic: str,
+        service_client, topic: str, route: str = CONSUME_BASE_ROUTE,
 ) -> dict[str, list[dict[str, str]]]:
-    response = await service_client.post(f'{CONSUME_BASE_ROUTE}/{topic}')
+    response = await service_client.post(f'{route}/{topic}')
 
     assert response.status_code == 200
 
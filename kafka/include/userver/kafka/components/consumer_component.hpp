@@ -41,6 +41,7 @@ class Consumer;
 /// enable_auto_commit                 | whether to automatically and periodically commit offsets | false
 /// auto_offset_reset                  | action to take when there is no initial offset in offset store | --
 /// max_batch_size                     | maximum batch size for one callback call | --
+/// partition_parallelism              | maximum number of tasks that concurrently process the polled batch grouped by partitions | 1
 /// env_pod_name                       | environment variable to substitute `{pod_name}` substring in `group_id` | none
 /// security_protocol                  | protocol used to communicate with brokers | --
 /// sasl_mechanisms                    | SASL mechanism to use for authentication | none
@@ -46,6 +46,16 @@ class Consumer;
 /// @note Each `ConsumerScope` instance is not thread-safe. To speed up the topic
 /// messages processing, create more consumers with the same `group_id`.
 ///
+/// Alternatively, set `partition_parallelism` static option greater than 1.
+/// Then each polled batch is split by topic partitions and callback is
+/// invoked on each partition messages concurrently in no more than
+/// `partition_parallelism` tasks. Messages order within each partition is
+/// preserved. Offsets of each successfully processed partition are committed
+/// automatically as soon as it is processed (unless `enable_auto_commit` is
+/// set), only failed partitions messages come again. The next batch is polled
+/// once all the partitions of the current one are processed, so a slow
+/// partition delays the others by at most one batch.
+///
 /// @see https://docs.confluent.io/platform/current/clients/consumer.html for
 /// basic consumer concepts
 /// @see
@@ -69,6 +79,8 @@ class ConsumerScope final {
   /// @warning If callback throws, it called over and over again with the batch
   /// with the same messages, until successfull invokation.
   /// Though, user should consider idempotent message processing mechanism
+  /// @warning With `partition_parallelism` greater than 1 callback is called
+  /// concurrently, so it must be thread-safe
   using Callback = std::function<void(MessageBatchView)>;
 
   /// @brief Stops the consumer (if not yet stopped).
@@ -111,6 +123,9 @@ class ConsumerScope final {
   /// `enable_auto_commit: true` in the static config. But read Kafka
   /// documentation carefully before to understand what auto committment
   /// mechanism actually mean
+  ///
+  /// @warning Must not be called with `partition_parallelism` greater than 1,
+  /// because it commits the offsets of not yet processed partitions
   void AsyncCommit();
 
  private:
@@ -2,6 +2,10 @@
 
 #include <chrono>
 #include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -19,6 +23,35 @@ class ProducerImpl;
 
 }  // namespace impl
 
+/// @brief Message to be sent with `Producer::SendBatch`.
+struct ProducerMessage final {
+  std::string key;
+  std::string payload;
+  /// @brief If not set, partition is chosen by internal Kafka partitioner
+  std::optional<std::uint32_t> partition;
+};
+
+/// @brief Thrown by `Producer::SendBatch` if some of the batch messages are
+/// not delivered. All the other messages of the batch are delivered.
+class SendBatchError final : public std::runtime_error {
+ public:
+  /// @brief Undelivered message and the description of its delivery error
+  struct FailedMessage final {
+    ProducerMessage message;
+    std::string error;
+  };
+
+  SendBatchError(const std::string& what,
+                 std::vector<FailedMessage> failed_messages);
+
+  /// @brief Returns the undelivered messages in the order they were passed
+  /// to `Producer::SendBatch`
+  const std::vector<FailedMessage>& GetFailedMessages() const noexcept;
+
+ private:
+  std::vector<FailedMessage> failed_messages_;
+};
+
 /// @ingroup userver_clients
 ///
 /// @brief Apache Kafka Producer Client.
@@ -31,8 +64,9 @@ class ProducerImpl;
 /// Implementation does not block on any send to Kafka and asynchronously
 /// waits for each message to be delivered.
 ///
-/// `Producer` periodically polls the metadata about delivered messages
-/// from Kafka Broker, blocking for some time, in separate task processor.
+/// `Producer` polls the metadata about delivered messages from Kafka Broker
+/// in separate task processor. Polling task sleeps without blocking the
+/// thread until `librdkafka` signals about new delivery events.
 ///
 /// `Producer` maintains the per topic statistics including the broker
 /// connection errors.
@@ -43,7 +77,8 @@ class ProducerImpl;
 /// @see https://docs.confluent.io/platform/current/clients/producer.html
 class Producer final {
  public:
-  /// @brief Time producer waits for new delivery events.
+  /// @brief Max time producer waits for new delivery events before polling
+  /// `librdkafka` anyway. Delivery events wake up the producer immediately.
   static constexpr std::chrono::milliseconds kDefaultPollTimeout{10};
 
   /// @brief How many times `Produce::Send*` retries when delivery
@@ -110,6 +145,29 @@ class Producer final {
       std::string topic_name, std::string key, std::string message,
       std::optional<std::uint32_t> partition = std::nullopt) const;
 
+  /// @brief Sends all `messages` to topic `topic_name` and asynchronously
+  /// waits until all of them are delivered or the delivery error occured.
+  ///
+  /// All messages are enqueued at once and the calling task is woken up once,
+  /// when the whole batch is delivered, that is much cheaper than
+  /// `Producer::Send` call per message.
+  ///
+  /// Ownership on `messages` is transferred to the producer, no payload data
+  /// is copied. Messages are released after their delivery reports come,
+  /// even if the calling task is cancelled.
+  ///
+  /// Only undelivered messages are retried, no more than `send_retries`
+  /// times. Same as for `Producer::SendAsync`, retries may change the order
+  /// messages are written to partition.
+  ///
+  /// thread-safe and can be called from any number of threads
+  /// simultaneously.
+  ///
+  /// @throws SendBatchError with the undelivered messages and their errors if
+  /// some of messages are not delivered and acked by Kafka Broker
+  void SendBatch(const std::string& topic_name,
+                 std::vector<ProducerMessage> messages) const;
+
   /// @brief Dumps per topic messages produce statistics.
   /// @see impl/stats.hpp
   void DumpMetric(utils::statistics::Writer& writer) const;
@@ -23,6 +23,7 @@ ConsumerComponent::ConsumerComponent(
                 config["poll_timeout"].As<std::chrono::milliseconds>(
                     impl::Consumer::kDefaultPollTimeout),
                 config["enable_auto_commit"].As<bool>(false),
+                config["partition_parallelism"].As<std::size_t>(1),
                 context.GetTaskProcessor("consumer-task-processor"),
                 context.GetTaskProcessor("main-task-processor")) {
   auto& storage =
@@ -96,6 +97,15 @@ properties:
     max_batch_size:
         type: integer
         description: maximum batch size for one callback call
+    partition_parallelism:
+        type: integer
+        description: |
+            maximum number of tasks that concurrently process
+            the polled batch grouped by partitions.
+            If greater than 1, callback is called on each partition
+            messages separately and offsets are committed per partition
+        defaultDescription: 1
+        minimum: 1
     security_protocol:
         type: string
         description: protocol used to communicate with brokers
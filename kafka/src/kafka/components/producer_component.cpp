@@ -54,7 +54,9 @@ properties:
         defaultDescription: false
     poll_timeout_ms:
         type: integer
-        description: time in milliseconds producer waits for new delivery events
+        description: |
+            max time in milliseconds producer waits for new delivery events.
+            Delivery events wake up the producer immediately
         defaultDescription: 10
     send_retries_count:
         type: integer
@@ -158,6 +158,17 @@ Configuration::Configuration(const components::ComponentConfig& config,
   }
 }
 
+Configuration::Configuration(
+    std::string component_name,
+    const std::vector<std::pair<std::string, std::string>>& options)
+    : component_name_(std::move(component_name)), conf_(rd_kafka_conf_new()) {
+  for (const auto& [option, value] : options) {
+    ConfSetOption(conf_, option.c_str(), value);
+  }
+
+  rd_kafka_conf_set_log_cb(conf_, &LogCallback);
+}
+
 Configuration::~Configuration() {
   if (conf_ != nullptr) {
     rd_kafka_conf_destroy(conf_);
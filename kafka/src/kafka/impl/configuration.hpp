@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <userver/components/component_fwd.hpp>
 
 #include <kafka/impl/entity_type.hpp>
@@ -24,6 +28,12 @@ class Configuration final {
                 const components::ComponentContext& context,
                 EntityType entity_type);
 
+  /// @brief Sets only the given raw `librdkafka` options.
+  /// @note Intended for benchmarks, where no components are available
+  Configuration(
+      std::string component_name,
+      const std::vector<std::pair<std::string, std::string>>& options);
+
   ~Configuration();
 
   Configuration(const Configuration&) = delete;
@@ -1,7 +1,11 @@
 #include <kafka/impl/consumer.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
 #include <string_view>
 
+#include <userver/engine/wait_all_checked.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/testsuite/testpoint.hpp>
 #include <userver/tracing/span.hpp>
@@ -9,6 +13,7 @@
 
 #include <kafka/impl/configuration.hpp>
 #include <kafka/impl/consumer_impl.hpp>
+#include <kafka/impl/partitions.hpp>
 #include <kafka/impl/stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,6 +25,7 @@ Consumer::Consumer(std::unique_ptr<Configuration> configuration,
                    std::size_t max_batch_size,
                    std::chrono::milliseconds poll_timeout,
                    bool enable_auto_commit,
+                   std::size_t partition_parallelism,
                    engine::TaskProcessor& consumer_task_processor,
                    engine::TaskProcessor& main_task_processor)
     : component_name_(configuration->GetComponentName()),
@@ -27,6 +33,7 @@ Consumer::Consumer(std::unique_ptr<Configuration> configuration,
       max_batch_size_(max_batch_size),
       poll_timeout(poll_timeout),
       enable_auto_commit_(enable_auto_commit),
+      partition_parallelism_(partition_parallelism),
       consumer_task_processor_(consumer_task_processor),
       main_task_processor_(main_task_processor),
       consumer_(std::make_unique<ConsumerImpl>(std::move(configuration))) {}
@@ -73,28 +80,15 @@ void Consumer::StartMessageProcessing(ConsumerScope::Callback callback) {
             continue;
           }
           TESTPOINT(fmt::format("tp_{}_polled", component_name_), {});
+          consumer_->AccountConsumerLag(polled_messages);
 
-          auto batch_processing_task =
-              utils::Async(main_task_processor_, "messages_processing",
-                           callback, utils::span{polled_messages});
-          try {
-            batch_processing_task.Get();
-
-            consumer_->AccountMessageBatchProccessingSucceeded(polled_messages);
+          const bool processing_succeeded =
+              partition_parallelism_ > 1
+                  ? ProcessPartitionsInParallel(callback, polled_messages)
+                  : ProcessBatch(callback, polled_messages);
+          if (processing_succeeded) {
             TESTPOINT(fmt::format("tp_{}", component_name_), {});
-          } catch (const std::exception& e) {
-            consumer_->AccountMessageBatchProcessingFailed(polled_messages);
-
-            const std::string error_text = e.what();
-            LOG_ERROR() << fmt::format(
-                "Messages processing failed in consumer: {}", error_text);
-            TESTPOINT(fmt::format("tp_error_{}", component_name_),
-                      [&error_text] {
-                        formats::json::ValueBuilder error_json;
-                        error_json["error"] = error_text;
-                        return error_json.ExtractValue();
-                      }());
-
+          } else {
             /// @note Messages must be destroyed, otherwise consumer won't stop
             /// and block forever
             polled_messages.clear();
@@ -108,6 +102,111 @@ void Consumer::StartMessageProcessing(ConsumerScope::Callback callback) {
       });
 }
 
+bool Consumer::ProcessBatch(const ConsumerScope::Callback& callback,
+                            std::vector<Message>& polled_messages) {
+  auto batch_processing_task =
+      utils::Async(main_task_processor_, "messages_processing", callback,
+                   utils::span{polled_messages});
+  try {
+    batch_processing_task.Get();
+
+    consumer_->AccountMessageBatchProccessingSucceeded(polled_messages);
+    return true;
+  } catch (const std::exception& e) {
+    consumer_->AccountMessageBatchProcessingFailed(polled_messages);
+    HandleProcessingError(e.what());
+    return false;
+  }
+}
+
+bool Consumer::ProcessPartitionsInParallel(
+    const ConsumerScope::Callback& callback,
+    std::vector<Message>& polled_messages) {
+  polled_messages = GroupByPartitions(std::move(polled_messages));
+  const auto partitions = SplitByPartitions(polled_messages);
+
+  struct PartitionResult final {
+    std::chrono::milliseconds processing_time{};
+    std::optional<std::string> error;
+  };
+  std::vector<PartitionResult> results(partitions.size());
+
+  /// @note Each partition is taken by a single worker, so its messages are
+  /// processed sequentially in polled order. Workers take the next partition
+  /// as soon as they are done with the previous one, so a slow partition does
+  /// not hold up the partitions behind it.
+  std::atomic<std::size_t> next_partition{0};
+  const auto workers_count =
+      std::min(partition_parallelism_, partitions.size());
+  std::vector<engine::TaskWithResult<void>> workers;
+  workers.reserve(workers_count);
+  for (std::size_t worker = 0; worker < workers_count; ++worker) {
+    workers.push_back(utils::Async(
+        main_task_processor_, "partitions_processing",
+        [this, &callback, &partitions, &results, &next_partition] {
+          for (auto i = next_partition++; i < partitions.size();
+               i = next_partition++) {
+            const auto start = std::chrono::steady_clock::now();
+            try {
+              callback(partitions[i]);
+            } catch (const std::exception& e) {
+              results[i].error.emplace(e.what());
+            }
+            results[i].processing_time =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start);
+
+            /// @note The partition offsets are committed without waiting for
+            /// the other partitions of the batch
+            if (!results[i].error.has_value() && !enable_auto_commit_) {
+              consumer_->CommitPartitions({partitions[i]}, /*async=*/true);
+            }
+          }
+        }));
+  }
+
+  try {
+    engine::WaitAllChecked(workers);
+  } catch (const std::exception& e) {
+    consumer_->AccountMessageBatchProcessingFailed(polled_messages);
+    HandleProcessingError(e.what());
+    return false;
+  }
+
+  std::vector<MessageBatchView> succeeded_partitions;
+  succeeded_partitions.reserve(partitions.size());
+  for (std::size_t i = 0; i < partitions.size(); ++i) {
+    consumer_->AccountPartitionProcessingTime(partitions[i][0],
+                                              results[i].processing_time);
+    if (results[i].error.has_value()) {
+      consumer_->AccountMessageBatchProcessingFailed(partitions[i]);
+      HandleProcessingError(*results[i].error);
+    } else {
+      consumer_->AccountMessageBatchProccessingSucceeded(partitions[i]);
+      succeeded_partitions.push_back(partitions[i]);
+    }
+  }
+
+  const bool all_succeeded = succeeded_partitions.size() == partitions.size();
+  if (!all_succeeded && !enable_auto_commit_) {
+    /// @note Failed partitions are reprocessed after resubscription, so
+    /// offsets of succeeded ones must be committed before it
+    consumer_->CommitPartitions(succeeded_partitions, /*async=*/false);
+  }
+
+  return all_succeeded;
+}
+
+void Consumer::HandleProcessingError(std::string_view error_text) {
+  LOG_ERROR() << fmt::format("Messages processing failed in consumer: {}",
+                             error_text);
+  TESTPOINT(fmt::format("tp_error_{}", component_name_), [&error_text] {
+    formats::json::ValueBuilder error_json;
+    error_json["error"] = std::string{error_text};
+    return error_json.ExtractValue();
+  }());
+}
+
 void Consumer::AsyncCommit() {
   UINVARIANT(processing_.load(), "Message processing is not currently started");
 
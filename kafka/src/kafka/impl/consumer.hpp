@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <string_view>
+#include <vector>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -29,12 +31,16 @@ class Consumer final {
   /// @param poll_timeout is a timeout for one message batch polling loop
   /// @param enable_auto_commit enables automatic periodically offsets
   /// committing. Note: if enabled, `AsyncCommit` should not be called manually
+  /// @param partition_parallelism stands for max number of tasks that
+  /// concurrently process the polled batch messages grouped by partitions.
+  /// If equals to 1, whole batch is processed by one callback invocation
   /// @param consumer_task_processor -- task processor for message batches
   /// polling
   /// All callbacks are invoked in `main_task_processor`
   Consumer(std::unique_ptr<Configuration> configuration,
            const std::vector<std::string>& topics, std::size_t max_batch_size,
            std::chrono::milliseconds poll_timeout, bool enable_auto_commit,
+           std::size_t partition_parallelism,
            engine::TaskProcessor& consumer_task_processor,
            engine::TaskProcessor& main_task_processor);
 
@@ -59,6 +65,24 @@ class Consumer final {
   /// periodically polls the message batches.
   void StartMessageProcessing(ConsumerScope::Callback callback);
 
+  /// @brief Invokes `callback` on the whole `polled_messages` batch.
+  /// @returns whether the processing succeeded
+  bool ProcessBatch(const ConsumerScope::Callback& callback,
+                    std::vector<Message>& polled_messages);
+
+  /// @brief Groups `polled_messages` by partitions and invokes `callback`
+  /// on each partition messages in no more than `partition_parallelism_`
+  /// concurrent tasks, preserving the messages order within partition.
+  /// Offsets of each partition are committed as soon as it is processed.
+  /// @note The next batch is polled after all the partitions are processed,
+  /// so the slowest partition of a batch delays the next batch
+  /// @returns whether all partitions processing succeeded
+  bool ProcessPartitionsInParallel(const ConsumerScope::Callback& callback,
+                                   std::vector<Message>& polled_messages);
+
+  /// @brief Accounts the processing error and calls the error testpoint.
+  void HandleProcessingError(std::string_view error_text);
+
   /// @brief Calls `poll_task_.SyncCancel()`
   void Stop() noexcept;
 
@@ -79,6 +103,7 @@ class Consumer final {
   const std::size_t max_batch_size_{};
   const std::chrono::milliseconds poll_timeout{};
   const bool enable_auto_commit_{};
+  const std::size_t partition_parallelism_{};
 
   engine::TaskProcessor& consumer_task_processor_;
   engine::TaskProcessor& main_task_processor_;
@@ -1,5 +1,6 @@
 #include <kafka/impl/consumer_impl.hpp>
 
+#include <algorithm>
 #include <chrono>
 
 #include <userver/logging/log.hpp>
@@ -342,6 +343,34 @@ void ConsumerImpl::AsyncCommit() {
   rd_kafka_commit(consumer_->Handle(), nullptr, /*async=*/1);
 }
 
+void ConsumerImpl::CommitPartitions(
+    const std::vector<MessageBatchView>& partitions, bool async) {
+  if (partitions.empty()) {
+    return;
+  }
+
+  TopicPartitionsListHolder offsets{
+      rd_kafka_topic_partition_list_new(static_cast<int>(partitions.size())),
+      &rd_kafka_topic_partition_list_destroy};
+  for (const auto& partition : partitions) {
+    UASSERT(!partition.empty());
+    const auto& last_message = partition[partition.size() - 1];
+
+    /// @note Committed offset is the offset of the next message to consume
+    rd_kafka_topic_partition_list_add(offsets.get(),
+                                      last_message.GetTopic().c_str(),
+                                      last_message.GetPartition())
+        ->offset = last_message.GetOffset() + 1;
+  }
+
+  const auto err =
+      rd_kafka_commit(consumer_->Handle(), offsets.get(), async ? 1 : 0);
+  if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
+    LOG_ERROR() << fmt::format("Failed to commit partitions offsets: {}",
+                               rd_kafka_err2str(err));
+  }
+}
+
 std::optional<Message> ConsumerImpl::PollMessage(engine::Deadline deadline) {
   if (deadline.IsReached()) {
     return std::nullopt;
@@ -405,6 +434,12 @@ std::shared_ptr<TopicStats> ConsumerImpl::GetTopicStats(
   return stats_.topics_stats[topic];
 }
 
+std::shared_ptr<PartitionStats> ConsumerImpl::GetPartitionStats(
+    const Message& message) {
+  return GetTopicStats(message.GetTopic())
+      ->partitions_stats[message.GetPartition()];
+}
+
 void ConsumerImpl::AccountPolledMessageStat(const Message& polled_message) {
   auto topic_stats = GetTopicStats(polled_message.GetTopic());
   ++topic_stats->messages_counts.messages_total;
@@ -428,7 +463,7 @@ void ConsumerImpl::AccountMessageProccessingSucceeded(const Message& message) {
 }
 
 void ConsumerImpl::AccountMessageBatchProccessingSucceeded(
-    const MessageBatch& batch) {
+    MessageBatchView batch) {
   for (const auto& message : batch) {
     AccountMessageProccessingSucceeded(message);
   }
@@ -438,12 +473,51 @@ void ConsumerImpl::AccountMessageProccessingFailed(const Message& message) {
 }
 
 void ConsumerImpl::AccountMessageBatchProcessingFailed(
-    const MessageBatch& batch) {
+    MessageBatchView batch) {
   for (const auto& message : batch) {
     AccountMessageProccessingFailed(message);
   }
 }
 
+void ConsumerImpl::AccountPartitionProcessingTime(
+    const Message& message, std::chrono::milliseconds duration) {
+  GetPartitionStats(message)
+      ->avg_ms_processing_time.GetCurrentCounter()
+      .Account(duration.count());
+}
+
+void ConsumerImpl::AccountConsumerLag(const MessageBatch& batch) {
+  const Message* partition_last_message{nullptr};
+  const auto account_lag = [this](const Message& message) {
+    std::int64_t low{RD_KAFKA_OFFSET_INVALID};
+    std::int64_t high{RD_KAFKA_OFFSET_INVALID};
+    /// @note Does not query the broker, uses the offsets cached by
+    /// the last fetch response
+    const auto err = rd_kafka_get_watermark_offsets(
+        consumer_->Handle(), message.GetTopic().c_str(),
+        message.GetPartition(), &low, &high);
+    if (err != RD_KAFKA_RESP_ERR_NO_ERROR || high < 0) {
+      return;
+    }
+
+    const auto lag = std::max<std::int64_t>(high - message.GetOffset() - 1, 0);
+    GetPartitionStats(message)->consumer_lag.store(lag,
+                                                   std::memory_order_relaxed);
+  };
+
+  for (const auto& message : batch) {
+    if (partition_last_message != nullptr &&
+        (partition_last_message->GetPartition() != message.GetPartition() ||
+         partition_last_message->GetTopic() != message.GetTopic())) {
+      account_lag(*partition_last_message);
+    }
+    partition_last_message = &message;
+  }
+  if (partition_last_message != nullptr) {
+    account_lag(*partition_last_message);
+  }
+}
+
 }  // namespace impl
 
 }  // namespace kafka
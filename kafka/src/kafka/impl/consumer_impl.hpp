@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
 #include <vector>
 
@@ -47,6 +48,13 @@ class ConsumerImpl final {
   /// @brief Schedules the committment task.
   void AsyncCommit();
 
+  /// @brief Commits the offset next to the last message of each of
+  /// `partitions`.
+  /// @note Each of `partitions` must contain messages of the single partition,
+  /// ordered by offset
+  void CommitPartitions(const std::vector<MessageBatchView>& partitions,
+                        bool async);
+
   /// @brief Polls the message until `deadline` is reached.
   /// If no message polled, returns `std::nullopt`
   /// @note Must be called periodically to maintain consumer group membership
@@ -59,9 +67,15 @@ class ConsumerImpl final {
   const Stats& GetStats() const;
 
   void AccountMessageProccessingSucceeded(const Message& message);
-  void AccountMessageBatchProccessingSucceeded(const MessageBatch& batch);
+  void AccountMessageBatchProccessingSucceeded(MessageBatchView batch);
   void AccountMessageProccessingFailed(const Message& message);
-  void AccountMessageBatchProcessingFailed(const MessageBatch& batch);
+  void AccountMessageBatchProcessingFailed(MessageBatchView batch);
+  void AccountPartitionProcessingTime(const Message& message,
+                                      std::chrono::milliseconds duration);
+
+  /// @brief Updates consumer lag of each `batch` messages partition using
+  /// the cached high watermark offsets.
+  void AccountConsumerLag(const MessageBatch& batch);
 
   void ErrorCallbackProxy(int error_code, const char* reason);
 
@@ -85,6 +99,7 @@ class ConsumerImpl final {
 
  private:
   std::shared_ptr<TopicStats> GetTopicStats(const std::string& topic);
+  std::shared_ptr<PartitionStats> GetPartitionStats(const Message& message);
 
   void AccountPolledMessageStat(const Message& polled_message);
 
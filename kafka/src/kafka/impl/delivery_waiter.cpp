@@ -1,5 +1,7 @@
 #include <kafka/impl/delivery_waiter.hpp>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace kafka::impl {
@@ -30,6 +32,13 @@ bool DeliveryResult::IsSuccess() const {
           *message_status_ == RD_KAFKA_MSG_STATUS_PERSISTED);
 }
 
+std::string DeliveryResult::GetErrorDescription() const {
+  if (message_error_ != RD_KAFKA_RESP_ERR_NO_ERROR) {
+    return rd_kafka_err2str(message_error_);
+  }
+  return "Message is not persisted by the broker";
+}
+
 DeliveryWaiter::DeliveryWaiter(std::uint32_t current_retry,
                                std::uint32_t max_retries)
     : current_retry_(current_retry), max_retries_(max_retries) {}
@@ -46,6 +55,87 @@ bool DeliveryWaiter::LastRetry() const {
 
 void DeliveryWaiter::SetDeliveryResult(DeliveryResult delivery_result) {
   wait_handle_.set_value(std::move(delivery_result));
+  delete this;
+}
+
+BatchDeliveryWaiter::MessageHandler::MessageHandler(
+    BatchDeliveryWaiter& waiter, std::size_t index)
+    : waiter_(waiter), index_(index) {}
+
+bool BatchDeliveryWaiter::MessageHandler::FirstSend() const {
+  return waiter_.current_retry_ == 0;
+}
+
+bool BatchDeliveryWaiter::MessageHandler::LastRetry() const {
+  return waiter_.current_retry_ == waiter_.max_retries_;
+}
+
+void BatchDeliveryWaiter::MessageHandler::SetDeliveryResult(
+    DeliveryResult delivery_result) {
+  if (waiter_.SetDeliveryResult(index_, std::move(delivery_result))) {
+    delete &waiter_;
+  }
+}
+
+BatchDeliveryWaiter::BatchDeliveryWaiter(std::vector<ProducerMessage> messages,
+                                         std::uint32_t current_retry,
+                                         std::uint32_t max_retries)
+    : current_retry_(current_retry),
+      max_retries_(max_retries),
+      messages_(std::move(messages)),
+      delivery_results_(messages_.size()),
+      pending_count_(messages_.size() + 1) {
+  handlers_.reserve(messages_.size());
+  for (std::size_t i = 0; i < messages_.size(); ++i) {
+    handlers_.emplace_back(*this, i);
+  }
+}
+
+engine::Future<BatchDeliveryResult> BatchDeliveryWaiter::GetFuture() {
+  return wait_handle_.get_future();
+}
+
+const std::vector<ProducerMessage>& BatchDeliveryWaiter::GetMessages() const {
+  return messages_;
+}
+
+DeliveryHandler& BatchDeliveryWaiter::GetMessageHandler(std::size_t index) {
+  UASSERT(index < handlers_.size());
+  return handlers_[index];
+}
+
+void BatchDeliveryWaiter::FinishEnqueue(
+    std::unique_ptr<BatchDeliveryWaiter> waiter) {
+  if (!waiter->CompleteOne()) {
+    /// @note Waiter is destroyed by the last delivery callback
+    [[maybe_unused]] auto* _ = waiter.release();
+  }
+}
+
+bool BatchDeliveryWaiter::SetDeliveryResult(std::size_t index,
+                                            DeliveryResult delivery_result) {
+  UASSERT(index < delivery_results_.size());
+  UASSERT(!delivery_results_[index].has_value());
+  delivery_results_[index].emplace(std::move(delivery_result));
+
+  return CompleteOne();
+}
+
+bool BatchDeliveryWaiter::CompleteOne() {
+  if (pending_count_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return false;
+  }
+
+  BatchDeliveryResult result;
+  result.messages = std::move(messages_);
+  result.delivery_results.reserve(delivery_results_.size());
+  for (auto& delivery_result : delivery_results_) {
+    UASSERT(delivery_result.has_value());
+    result.delivery_results.push_back(std::move(*delivery_result));
+  }
+  wait_handle_.set_value(std::move(result));
+
+  return true;
 }
 
 }  // namespace kafka::impl
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <userver/engine/future.hpp>
+#include <userver/kafka/producer.hpp>
 
 #include <librdkafka/rdkafka.h>
 
@@ -26,24 +32,45 @@ class DeliveryResult {
 
   bool IsSuccess() const;
 
+  /// @brief Returns the description of the delivery error
+  std::string GetErrorDescription() const;
+
  private:
   const rd_kafka_resp_err_t message_error_;
   const std::optional<rd_kafka_msg_status_t> message_status_;
 };
 
+/// @brief Message state passed as `opaque` to `librdkafka` produce functions
+/// and notified by the delivery report callback
+class DeliveryHandler {
+ public:
+  virtual bool FirstSend() const = 0;
+
+  virtual bool LastRetry() const = 0;
+
+  /// @brief Notifies the handler about the message delivery result.
+  /// @warning Handler may be destroyed in the call and must not be used after
+  virtual void SetDeliveryResult(DeliveryResult delivery_result) = 0;
+
+ protected:
+  ~DeliveryHandler() = default;
+};
+
 /// @brief State for waiting delivery callback invoked after producer send
 /// called
-class DeliveryWaiter {
+/// @note Must be allocated with `new`, because it destroys itself when the
+/// delivery result is set
+class DeliveryWaiter final : public DeliveryHandler {
  public:
   DeliveryWaiter(std::uint32_t current_retry, std::uint32_t max_retries);
 
   engine::Future<DeliveryResult> GetFuture();
 
-  bool FirstSend() const;
+  bool FirstSend() const override;
 
-  bool LastRetry() const;
+  bool LastRetry() const override;
 
-  void SetDeliveryResult(DeliveryResult delivery_result);
+  void SetDeliveryResult(DeliveryResult delivery_result) override;
 
  private:
   const std::uint32_t current_retry_;
@@ -52,6 +79,74 @@ class DeliveryWaiter {
   engine::Promise<DeliveryResult> wait_handle_;
 };
 
+struct BatchDeliveryResult final {
+  /// @brief Batch messages, which data is no more used by `librdkafka`
+  std::vector<ProducerMessage> messages;
+  /// @brief Delivery result of each of `messages`
+  std::vector<DeliveryResult> delivery_results;
+};
+
+/// @brief Shared state for waiting delivery of the whole messages batch.
+///
+/// Owns the batch messages data until all delivery callbacks are invoked, so
+/// `librdkafka` may use it without copying. Waiting task is woken up once,
+/// when the last message delivery result is set.
+class BatchDeliveryWaiter final {
+ public:
+  BatchDeliveryWaiter(std::vector<ProducerMessage> messages,
+                      std::uint32_t current_retry, std::uint32_t max_retries);
+
+  BatchDeliveryWaiter(const BatchDeliveryWaiter&) = delete;
+  BatchDeliveryWaiter& operator=(const BatchDeliveryWaiter&) = delete;
+
+  engine::Future<BatchDeliveryResult> GetFuture();
+
+  const std::vector<ProducerMessage>& GetMessages() const;
+
+  /// @brief Returns the state to pass as `opaque` for `index` message.
+  DeliveryHandler& GetMessageHandler(std::size_t index);
+
+  /// @brief Must be called after all messages are passed to `librdkafka`
+  /// (or their enqueue error is set). Then ownership is transferred to
+  /// delivery callbacks, the last of which destroys the waiter.
+  static void FinishEnqueue(std::unique_ptr<BatchDeliveryWaiter> waiter);
+
+ private:
+  class MessageHandler final : public DeliveryHandler {
+   public:
+    MessageHandler(BatchDeliveryWaiter& waiter, std::size_t index);
+
+    bool FirstSend() const override;
+
+    bool LastRetry() const override;
+
+    void SetDeliveryResult(DeliveryResult delivery_result) override;
+
+   private:
+    BatchDeliveryWaiter& waiter_;
+    const std::size_t index_;
+  };
+
+  /// @returns whether all results are set
+  bool SetDeliveryResult(std::size_t index, DeliveryResult delivery_result);
+
+  /// @brief Decrements the number of pending messages.
+  /// @returns whether all results are set
+  bool CompleteOne();
+
+  const std::uint32_t current_retry_;
+  const std::uint32_t max_retries_;
+
+  std::vector<ProducerMessage> messages_;
+  std::vector<std::optional<DeliveryResult>> delivery_results_;
+  std::vector<MessageHandler> handlers_;
+
+  /// @note Additionally holds one reference until `FinishEnqueue` call
+  std::atomic<std::size_t> pending_count_;
+
+  engine::Promise<BatchDeliveryResult> wait_handle_;
+};
+
 }  // namespace kafka::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace kafka::impl {
+
+/// @brief Reorders `messages` so that each topic partition messages are
+/// placed contiguously, preserving their relative order.
+/// @note `MessageType` must provide `GetTopic()` and `GetPartition()`
+template <typename MessageType>
+std::vector<MessageType> GroupByPartitions(std::vector<MessageType>&& messages) {
+  std::vector<std::size_t> order(messages.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&messages](std::size_t lhs, std::size_t rhs) {
+                     const auto& lhs_message = messages[lhs];
+                     const auto& rhs_message = messages[rhs];
+                     if (lhs_message.GetTopic() != rhs_message.GetTopic()) {
+                       return lhs_message.GetTopic() < rhs_message.GetTopic();
+                     }
+                     return lhs_message.GetPartition() <
+                            rhs_message.GetPartition();
+                   });
+
+  /// @note `Message` is not move assignable, so messages are moved into
+  /// the new storage
+  std::vector<MessageType> grouped;
+  grouped.reserve(messages.size());
+  for (const auto index : order) {
+    grouped.push_back(std::move(messages[index]));
+  }
+  return grouped;
+}
+
+/// @brief Splits messages grouped with `GroupByPartitions` into per partition
+/// views.
+template <typename MessageType>
+std::vector<utils::span<const MessageType>> SplitByPartitions(
+    const std::vector<MessageType>& grouped) {
+  std::vector<utils::span<const MessageType>> partitions;
+
+  std::size_t partition_begin{0};
+  for (std::size_t i = 1; i <= grouped.size(); ++i) {
+    if (i == grouped.size() ||
+        grouped[partition_begin].GetPartition() != grouped[i].GetPartition() ||
+        grouped[partition_begin].GetTopic() != grouped[i].GetTopic()) {
+      partitions.emplace_back(grouped.data() + partition_begin,
+                              grouped.data() + i);
+      partition_begin = i;
+    }
+  }
+
+  return partitions;
+}
+
+}  // namespace kafka::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#include <kafka/impl/partitions.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct TestMessage final {
+  const std::string& GetTopic() const { return topic; }
+  int GetPartition() const { return partition; }
+
+  std::string topic;
+  int partition{};
+  int offset{};
+};
+
+}  // namespace
+
+TEST(KafkaPartitions, Empty) {
+  auto grouped = kafka::impl::GroupByPartitions(std::vector<TestMessage>{});
+  EXPECT_TRUE(grouped.empty());
+  EXPECT_TRUE(kafka::impl::SplitByPartitions(grouped).empty());
+}
+
+TEST(KafkaPartitions, GroupsPreservingOrder) {
+  std::vector<TestMessage> messages{
+      {"b", 0, 0}, {"a", 1, 0}, {"a", 0, 0}, {"b", 0, 1},
+      {"a", 1, 1}, {"a", 0, 1}, {"a", 1, 2},
+  };
+
+  const auto grouped = kafka::impl::GroupByPartitions(std::move(messages));
+  const auto partitions = kafka::impl::SplitByPartitions(grouped);
+
+  ASSERT_EQ(partitions.size(), 3);
+  const std::vector<std::pair<std::string, int>> expected_partitions{
+      {"a", 0}, {"a", 1}, {"b", 0}};
+  const std::vector<std::size_t> expected_sizes{2, 3, 2};
+  for (std::size_t i = 0; i < partitions.size(); ++i) {
+    ASSERT_EQ(partitions[i].size(), expected_sizes[i]);
+    for (std::size_t j = 0; j < partitions[i].size(); ++j) {
+      const auto& message = partitions[i][j];
+      EXPECT_EQ(message.topic, expected_partitions[i].first);
+      EXPECT_EQ(message.partition, expected_partitions[i].second);
+      EXPECT_EQ(message.offset, static_cast<int>(j));
+    }
+  }
+}
+
+TEST(KafkaPartitions, SamePartitionNumberOfDifferentTopics) {
+  std::vector<TestMessage> messages{{"a", 0, 0}, {"b", 0, 0}, {"a", 0, 1}};
+
+  const auto grouped = kafka::impl::GroupByPartitions(std::move(messages));
+  const auto partitions = kafka::impl::SplitByPartitions(grouped);
+
+  ASSERT_EQ(partitions.size(), 2);
+  ASSERT_EQ(partitions[0].size(), 2);
+  EXPECT_EQ(partitions[0][0].topic, "a");
+  EXPECT_EQ(partitions[0][1].offset, 1);
+  ASSERT_EQ(partitions[1].size(), 1);
+  EXPECT_EQ(partitions[1][0].topic, "b");
+}
+
+TEST(KafkaPartitions, SinglePartition) {
+  std::vector<TestMessage> messages{{"a", 3, 0}, {"a", 3, 1}, {"a", 3, 2}};
+
+  const auto grouped = kafka::impl::GroupByPartitions(std::move(messages));
+  const auto partitions = kafka::impl::SplitByPartitions(grouped);
+
+  ASSERT_EQ(partitions.size(), 1);
+  EXPECT_EQ(partitions[0].size(), 3);
+  EXPECT_EQ(partitions[0].data(), grouped.data());
+}
+
+USERVER_NAMESPACE_END
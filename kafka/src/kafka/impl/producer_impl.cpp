@@ -8,6 +8,7 @@
 #include <kafka/impl/error_buffer.hpp>
 #include <kafka/impl/stats.hpp>
 
+#include <array>
 #include <utility>
 
 USERVER_NAMESPACE_BEGIN
@@ -43,6 +44,9 @@ std::chrono::milliseconds GetMessageLatencySeconds(
       message_latency_micro);
 }
 
+using TopicHolder =
+    std::unique_ptr<rd_kafka_topic_t, decltype(&rd_kafka_topic_destroy)>;
+
 }  // namespace
 
 ProducerImpl::ProducerHolder::ProducerHolder(rd_kafka_conf_t* conf) {
@@ -103,7 +107,7 @@ void ProducerImpl::DeliveryReportCallbackProxy(
 
   const char* topic_name = rd_kafka_topic_name(message->rkt);
 
-  auto* complete_handle = static_cast<DeliveryWaiter*>(message->_private);
+  auto* complete_handle = static_cast<DeliveryHandler*>(message->_private);
 
   auto& topic_stats = stats_.topics_stats[topic_name];
   if (complete_handle->FirstSend()) {
@@ -138,8 +142,8 @@ void ProducerImpl::DeliveryReportCallbackProxy(
                                  topic_name, rd_kafka_err2str(message->err));
   }
 
+  /// @note Handler may be destroyed in the call
   complete_handle->SetDeliveryResult(std::move(delivery_result));
-  delete complete_handle;
 }
 
 ProducerImpl::ProducerImpl(std::unique_ptr<Configuration> configuration)
@@ -150,7 +154,13 @@ ProducerImpl::ProducerImpl(std::unique_ptr<Configuration> configuration)
         rd_kafka_conf_set_dr_msg_cb(conf, &DeliveryReportCallback);
 
         return ProducerHolder{conf};
-      }()) {}
+      }()) {
+  /// @note `librdkafka` writes to the pipe each time the main queue, which
+  /// delivery reports are placed to, becomes non-empty
+  rd_kafka_queue_t* main_queue = rd_kafka_queue_get_main(producer_.Handle());
+  rd_kafka_queue_io_event_enable(main_queue, events_pipe_.writer.Fd(), "1", 1);
+  rd_kafka_queue_destroy(main_queue);
+}
 
 ProducerImpl::~ProducerImpl() = default;
 
@@ -183,8 +193,66 @@ void ProducerImpl::Send(const std::string& topic_name, std::string_view key,
   }
 }
 
+SendBatchResult ProducerImpl::SendBatch(
+    const std::string& topic_name, std::vector<ProducerMessage> messages,
+    const std::uint32_t max_retries) const {
+  LOG_INFO() << fmt::format(
+      "Batch of {} messages to topic '{}' is requested to send",
+      messages.size(), topic_name);
+
+  SendBatchResult result;
+  result.delivered_messages.reserve(messages.size());
+
+  for (std::uint32_t current_retry = 0; !messages.empty(); ++current_retry) {
+    auto [sent_messages, delivery_results] = SendBatchImpl(
+        topic_name, std::move(messages), current_retry, max_retries);
+
+    std::vector<ProducerMessage> retried_messages;
+    for (std::size_t i = 0; i < sent_messages.size(); ++i) {
+      if (delivery_results[i].IsSuccess()) {
+        result.delivered_messages.push_back(std::move(sent_messages[i]));
+        continue;
+      }
+      if (current_retry != max_retries && delivery_results[i].IsRetryable()) {
+        retried_messages.push_back(std::move(sent_messages[i]));
+        continue;
+      }
+      result.failed_messages.push_back(
+          {std::move(sent_messages[i]),
+           delivery_results[i].GetErrorDescription()});
+    }
+
+    if (!retried_messages.empty()) {
+      LOG_WARNING() << fmt::format(
+          "Failed to deliver {} of batch messages, but errors may be "
+          "transient, retrying... (retries left: {})",
+          retried_messages.size(), max_retries - current_retry);
+    }
+    messages = std::move(retried_messages);
+  }
+
+  if (!result.failed_messages.empty()) {
+    LOG_ERROR() << fmt::format(
+        "Failed to deliver {} of batch messages to topic '{}'",
+        result.failed_messages.size(), topic_name);
+  }
+
+  return result;
+}
+
 void ProducerImpl::Poll(std::chrono::milliseconds poll_timeout) const {
-  rd_kafka_poll(producer_.Handle(), static_cast<int>(poll_timeout.count()));
+  if (events_pipe_.reader.WaitReadable(
+          engine::Deadline::FromDuration(poll_timeout))) {
+    /// @note Pipe content does not matter, the non-empty pipe only signals
+    /// that there are events to handle. Bytes left in the pipe lead just to
+    /// a spurious wakeup
+    std::array<char, 64> buffer{};
+    [[maybe_unused]] const auto read_size = events_pipe_.reader.ReadSome(
+        buffer.data(), buffer.size(), engine::Deadline{});
+  }
+
+  /// @note Non-blocking call, that handles all queued events
+  rd_kafka_poll(producer_.Handle(), 0);
 }
 
 DeliveryResult ProducerImpl::SendImpl(const std::string& topic_name,
@@ -228,7 +296,8 @@ DeliveryResult ProducerImpl::SendImpl(const std::string& topic_name,
       RD_KAFKA_V_VALUE(const_cast<char*>(message.data()), message.size()),
       RD_KAFKA_V_MSGFLAGS(0),
       RD_KAFKA_V_PARTITION(partition.value_or(RD_KAFKA_PARTITION_UA)),
-      RD_KAFKA_V_OPAQUE(waiter.release()), RD_KAFKA_V_END);
+      RD_KAFKA_V_OPAQUE(static_cast<DeliveryHandler*>(waiter.release())),
+      RD_KAFKA_V_END);
   // NOLINTEND(clang-analyzer-cplusplus.NewDeleteLeaks,cppcoreguidelines-pro-type-const-cast)
 
 #ifdef __clang__
@@ -248,6 +317,83 @@ DeliveryResult ProducerImpl::SendImpl(const std::string& topic_name,
   return wait_handle.get();
 }
 
+BatchDeliveryResult ProducerImpl::SendBatchImpl(
+    const std::string& topic_name, std::vector<ProducerMessage> messages,
+    std::uint32_t current_retry, std::uint32_t max_retries) const {
+  const auto messages_count = messages.size();
+  auto waiter = std::make_unique<BatchDeliveryWaiter>(
+      std::move(messages), current_retry, max_retries);
+  auto wait_handle = waiter->GetFuture();
+
+  TopicHolder topic{
+      rd_kafka_topic_new(producer_.Handle(), topic_name.c_str(), nullptr),
+      &rd_kafka_topic_destroy};
+  if (topic == nullptr) {
+    const auto topic_error = rd_kafka_last_error();
+    LOG_WARNING() << fmt::format("Failed to create topic '{}' handle: {}",
+                                 topic_name, rd_kafka_err2str(topic_error));
+
+    for (std::size_t i = 0; i < messages_count; ++i) {
+      waiter->GetMessageHandler(i).SetDeliveryResult(
+          DeliveryResult{topic_error});
+    }
+    BatchDeliveryWaiter::FinishEnqueue(std::move(waiter));
+
+    return wait_handle.get();
+  }
+
+  /// As in `SendImpl`, 0 msgflags implies no message copying and freeing by
+  /// `librdkafka`. Messages data is owned by `waiter` until the last
+  /// delivery report callback is invoked.
+  /// `RD_KAFKA_MSG_F_PARTITION` makes `librdkafka` use the partition of each
+  /// message, or choose it by partitioner if unassigned
+  std::vector<rd_kafka_message_t> batch(messages_count);
+  const auto& waiter_messages = waiter->GetMessages();
+  for (std::size_t i = 0; i < messages_count; ++i) {
+    const auto& message = waiter_messages[i];
+    auto& batch_message = batch[i];
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    batch_message.payload = const_cast<char*>(message.payload.data());
+    batch_message.len = message.payload.size();
+    batch_message.key = const_cast<char*>(message.key.data());
+    batch_message.key_len = message.key.size();
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+    batch_message.partition =
+        message.partition.has_value()
+            ? static_cast<std::int32_t>(*message.partition)
+            : RD_KAFKA_PARTITION_UA;
+    batch_message._private =
+        static_cast<DeliveryHandler*>(&waiter->GetMessageHandler(i));
+  }
+
+  /// `rd_kafka_produce_batch` does not block, it enqueues all messages under
+  /// the single lock. Messages failed to enqueue have `err` set and do not
+  /// get the delivery report
+  const int enqueued_count =
+      rd_kafka_produce_batch(topic.get(), RD_KAFKA_PARTITION_UA,
+                             RD_KAFKA_MSG_F_PARTITION, batch.data(),
+                             static_cast<int>(messages_count));
+  if (static_cast<std::size_t>(enqueued_count) != messages_count) {
+    LOG_WARNING() << fmt::format(
+        "Failed to enqueue {} of {} messages to Kafka local queue",
+        messages_count - static_cast<std::size_t>(enqueued_count),
+        messages_count);
+
+    for (std::size_t i = 0; i < messages_count; ++i) {
+      if (batch[i].err != RD_KAFKA_RESP_ERR_NO_ERROR) {
+        waiter->GetMessageHandler(i).SetDeliveryResult(
+            DeliveryResult{batch[i].err});
+      }
+    }
+  }
+  BatchDeliveryWaiter::FinishEnqueue(std::move(waiter));
+
+  /// wait until delivery report callback is invoked for all messages:
+  /// @see DeliveryCallbackProxy
+  return wait_handle.get();
+}
+
 const Stats& ProducerImpl::GetStats() const { return stats_; }
 
 }  // namespace kafka::impl
@@ -4,6 +4,11 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/io/pipe.hpp>
+#include <userver/kafka/producer.hpp>
 
 #include <kafka/impl/delivery_waiter.hpp>
 #include <kafka/impl/stats.hpp>
@@ -16,6 +21,12 @@ namespace kafka::impl {
 
 class Configuration;
 
+struct SendBatchResult final {
+  /// @brief Messages, which data is no more used by `librdkafka`
+  std::vector<ProducerMessage> delivered_messages;
+  std::vector<SendBatchError::FailedMessage> failed_messages;
+};
+
 class ProducerImpl final {
  public:
   static constexpr std::chrono::milliseconds kCoolDownFlushTimeout{2000};
@@ -29,7 +40,17 @@ class ProducerImpl final {
             std::string_view message, std::optional<std::uint32_t> partition,
             std::uint32_t max_retries) const;
 
-  /// @brief Polls for delivery events for `poll_timeout_` milliseconds
+  /// @brief Sends the messages batch and waits for delivery of all messages.
+  /// Retries only undelivered messages.
+  /// @returns delivered messages and the messages failed with non-retryable
+  /// errors or after `max_retries` retries
+  SendBatchResult SendBatch(const std::string& topic_name,
+                            std::vector<ProducerMessage> messages,
+                            std::uint32_t max_retries) const;
+
+  /// @brief Waits until `librdkafka` signals about new delivery events, but no
+  /// more than `poll_timeout` milliseconds, and handles all queued events.
+  /// @note Does not block the current thread while waiting
   void Poll(std::chrono::milliseconds poll_timeout) const;
 
   const Stats& GetStats() const;
@@ -49,9 +70,20 @@ class ProducerImpl final {
                           std::uint32_t current_retry,
                           std::uint32_t max_retries) const;
 
+  BatchDeliveryResult SendBatchImpl(const std::string& topic_name,
+                                    std::vector<ProducerMessage> messages,
+                                    std::uint32_t current_retry,
+                                    std::uint32_t max_retries) const;
+
  private:
   Stats stats_;
 
+  /// @brief `librdkafka` writes to the pipe when delivery events queue
+  /// becomes non-empty.
+  /// @note Must outlive the `producer_`, because it flushes the
+  /// messages on destruction
+  mutable engine::io::Pipe events_pipe_;
+
   class ProducerHolder final {
    public:
     ProducerHolder(rd_kafka_conf_t* conf);
@@ -1,5 +1,6 @@
 #include <kafka/impl/stats.hpp>
 
+#include <string>
 #include <string_view>
 
 #include <userver/utils/statistics/metadata.hpp>
@@ -11,6 +12,7 @@ namespace kafka::impl {
 namespace {
 
 constexpr std::string_view kSolomonLabel{"solomon_label"};
+constexpr std::string_view kPartitionLabel{"partition"};
 
 }  // namespace
 
@@ -27,6 +29,22 @@ void DumpMetric(utils::statistics::Writer& writer, const Stats& stats) {
         topic_stats->messages_counts.messages_success.Load(), label);
     writer[topic]["messages_error"].ValueWithLabels(
         topic_stats->messages_counts.messages_error.Load(), label);
+
+    for (const auto& [partition, partition_stats] :
+         topic_stats->partitions_stats) {
+      const auto partition_name = std::to_string(partition);
+      const utils::statistics::LabelView partition_label{kPartitionLabel,
+                                                         partition_name};
+
+      writer[topic]["consumer_lag"].ValueWithLabels(
+          partition_stats->consumer_lag.load(std::memory_order_relaxed),
+          {label, partition_label});
+      writer[topic]["avg_ms_processing_time"].ValueWithLabels(
+          partition_stats->avg_ms_processing_time.GetStatsForPeriod()
+              .GetCurrent()
+              .average,
+          {label, partition_label});
+    }
   }
   writer["connections_error"].ValueWithLabels(
       stats.connections_error.Load(), {kSolomonLabel, "component_name"});
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/statistics/min_max_avg.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -18,11 +21,21 @@ struct MessagesCounts final {
   utils::statistics::RelaxedCounter<uint64_t> messages_error = 0;
 };
 
+using RecentMinMaxAvg =
+    utils::statistics::RecentPeriod<MinMaxAvg, MinMaxAvg,
+                                    utils::datetime::SteadyClock>;
+
+struct PartitionStats final {
+  /// Difference between the partition high watermark and the offset of the
+  /// last polled message
+  std::atomic<std::int64_t> consumer_lag{0};
+  RecentMinMaxAvg avg_ms_processing_time;
+};
+
 struct TopicStats final {
   MessagesCounts messages_counts;
-  utils::statistics::RecentPeriod<MinMaxAvg, MinMaxAvg,
-                                  utils::datetime::SteadyClock>
-      avg_ms_spent_time;
+  RecentMinMaxAvg avg_ms_spent_time;
+  rcu::RcuMap<std::int32_t, PartitionStats> partitions_stats;
 };
 
 struct Stats final {
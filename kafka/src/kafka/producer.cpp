@@ -14,6 +14,15 @@ USERVER_NAMESPACE_BEGIN
 
 namespace kafka {
 
+SendBatchError::SendBatchError(const std::string& what,
+                               std::vector<FailedMessage> failed_messages)
+    : std::runtime_error(what), failed_messages_(std::move(failed_messages)) {}
+
+const std::vector<SendBatchError::FailedMessage>&
+SendBatchError::GetFailedMessages() const noexcept {
+  return failed_messages_;
+}
+
 Producer::Producer(std::unique_ptr<impl::Configuration> configuration,
                    engine::TaskProcessor& producer_task_processor,
                    std::chrono::milliseconds poll_timeout,
@@ -99,6 +108,38 @@ engine::TaskWithResult<void> Producer::SendAsync(
       });
 }
 
+void Producer::SendBatch(const std::string& topic_name,
+                         std::vector<ProducerMessage> messages) const {
+  InitProducerAndStartPollingIfFirstSend();
+
+  const auto messages_count = messages.size();
+  auto result =
+      utils::Async(producer_task_processor_, "producer_send_batch",
+                   [this, &topic_name, &messages] {
+                     ExtendCurrentSpan();
+
+                     auto result = producer_->SendBatch(
+                         topic_name, std::move(messages), send_retries_);
+
+                     if (testsuite::AreTestpointsAvailable()) {
+                       for (const auto& message : result.delivered_messages) {
+                         SendToTestPoint(topic_name, message.key,
+                                         message.payload);
+                       }
+                     }
+
+                     return result;
+                   })
+          .Get();
+
+  if (!result.failed_messages.empty()) {
+    throw SendBatchError{
+        fmt::format("Failed to deliver {} of {} batch messages to topic '{}'",
+                    result.failed_messages.size(), messages_count, topic_name),
+        std::move(result.failed_messages)};
+  }
+}
+
 void Producer::DumpMetric(utils::statistics::Writer& writer) const {
   if (!first_send_.load()) {
     impl::DumpMetric(writer, producer_->GetStats());
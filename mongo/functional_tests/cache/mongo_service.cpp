@@ -0,0 +1,123 @@
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include <userver/cache/base_mongo_cache.hpp>
+#include <userver/clients/dns/component.hpp>
+#include <userver/clients/http/component.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/server/handlers/tests_control.hpp>
+#include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+#include <userver/utils/daemon_run.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace functional_tests {
+
+struct Item final {
+  std::string id;
+  int value{0};
+};
+
+struct ItemsCollections final {
+  storages::mongo::Collection items;
+};
+
+class ItemsCollectionsComponent final
+    : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "items-collections";
+
+  ItemsCollectionsComponent(const components::ComponentConfig& config,
+                            const components::ComponentContext& context)
+      : LoggableComponentBase(config, context),
+        collections_(std::make_shared<ItemsCollections>(ItemsCollections{
+            context.FindComponent<components::Mongo>("items-database")
+                .GetPool()
+                ->GetCollection("items")})) {}
+
+  template <typename Collections>
+  std::shared_ptr<Collections> GetCollectionForLibrary() const {
+    static_assert(std::is_same_v<Collections, ItemsCollections>);
+    return collections_;
+  }
+
+ private:
+  const std::shared_ptr<ItemsCollections> collections_;
+};
+
+struct ItemsCacheTraits {
+  static constexpr std::string_view kName = "items-cache";
+
+  static constexpr auto kMongoCollectionsField = &ItemsCollections::items;
+
+  using ObjectType = Item;
+  static constexpr auto kKeyField = &Item::id;
+  using KeyType = std::string;
+  using DataType = std::unordered_map<KeyType, ObjectType>;
+
+  static constexpr bool kIsSecondaryPreferred = false;
+
+  // `_id`s of different types are stored in the same collection
+  static ObjectType DeserializeObject(const formats::bson::Document& doc) {
+    const auto id = doc["_id"];
+    return {id.IsString() ? id.As<std::string>()
+                          : std::to_string(id.As<int>()),
+            doc["value"].As<int>()};
+  }
+
+  static constexpr bool kUseDefaultFindOperation = true;
+  static constexpr bool kAreInvalidDocumentsSkipped = false;
+
+  using MongoCollectionsComponent = ItemsCollectionsComponent;
+};
+
+using ItemsCache = components::MongoCache<ItemsCacheTraits>;
+
+class CacheItems final : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-cache-items";
+
+  CacheItems(const components::ComponentConfig& config,
+             const components::ComponentContext& context)
+      : HttpHandlerJsonBase(config, context),
+        cache_(context.FindComponent<ItemsCache>()) {}
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest&, const formats::json::Value&,
+      server::request::RequestContext&) const override {
+    const auto items = cache_.Get();
+
+    formats::json::ValueBuilder builder{formats::common::Type::kObject};
+    for (const auto& [id, item] : *items) {
+      builder[id] = item.value;
+    }
+    return builder.ExtractValue();
+  }
+
+ private:
+  const ItemsCache& cache_;
+};
+
+}  // namespace functional_tests
+
+int main(int argc, char* argv[]) {
+  const auto component_list =
+      components::MinimalServerComponentList()
+          .Append<clients::dns::Component>()
+          .Append<components::HttpClient>()
+          .Append<components::TestsuiteSupport>()
+          .Append<server::handlers::TestsControl>()
+          .Append<components::Mongo>("items-database")
+          .Append<functional_tests::ItemsCollectionsComponent>()
+          .Append<functional_tests::ItemsCache>()
+          .Append<functional_tests::CacheItems>();
+  return utils::DaemonMain(argc, argv, component_list);
+}
@@ -0,0 +1,20 @@
+import pytest
+
+
+pytest_plugins = ['pytest_userver.plugins.mongo']
+
+MONGO_COLLECTIONS = {
+    'items': {
+        'settings': {
+            'collection': 'items',
+            'connection': 'admin',
+            'database': 'admin',
+        },
+        'indexes': [],
+    },
+}
+
+
+@pytest.fixture(scope='session')
+def mongodb_settings():
+    return MONGO_COLLECTIONS
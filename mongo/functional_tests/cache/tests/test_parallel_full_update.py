@@ -0,0 +1,57 @@
+# The cache reads the collection with 4 concurrent `_id` range cursors and
+# merges the parsed documents by chunks of 1000
+
+
+async def _update_cache(service_client, mongodb, items: dict) -> dict:
+    mongodb.items.delete_many({})
+    if items:
+        mongodb.items.insert_many(
+            [{'_id': _id, 'value': value} for _id, value in items.items()],
+        )
+    await service_client.invalidate_caches()
+
+    response = await service_client.get('/v1/cache-items')
+    assert response.status == 200
+    return response.json()
+
+
+def _expected(items: dict) -> dict:
+    return {str(_id): value for _id, value in items.items()}
+
+
+async def test_split_by_id_ranges(service_client, mongodb):
+    items = {i: i * 2 for i in range(5000)}
+    assert await _update_cache(service_client, mongodb, items) == _expected(
+        items,
+    )
+
+
+async def test_rare_id_type(service_client, mongodb):
+    # The string `_id` is most likely not sampled, the first range picks up
+    # the `_id`s of the types other than the sampled one
+    items = {i: i for i in range(2000)}
+    items['rare'] = -1
+    assert await _update_cache(service_client, mongodb, items) == _expected(
+        items,
+    )
+
+
+async def test_mixed_id_types(service_client, mongodb):
+    # Sampled `_id`s have different types, the collection is read with
+    # a single cursor
+    items = {i: i for i in range(500)}
+    items.update({f'id-{i}': i for i in range(500)})
+    assert await _update_cache(service_client, mongodb, items) == _expected(
+        items,
+    )
+
+
+async def test_too_few_documents(service_client, mongodb):
+    items = {1: 1, 2: 2}
+    assert await _update_cache(service_client, mongodb, items) == _expected(
+        items,
+    )
+
+
+async def test_empty_collection(service_client, mongodb):
+    assert await _update_cache(service_client, mongodb, {}) == {}
@@ -4,6 +4,9 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,6 +14,8 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/wait_all_checked.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
@@ -18,6 +23,7 @@
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -30,10 +36,21 @@ inline const std::string kFetchAndParseStage = "fetch_and_parse";
 inline constexpr std::chrono::milliseconds kCpuRelaxThreshold{10};
 inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 
+// Parsed objects are merged into the new cache by chunks of this size during
+// parallel full updates
+inline constexpr std::size_t kParallelUpdateMergeChunkSize = 1000;
+
 namespace impl {
 
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
+std::size_t GetMongoCacheFullUpdateParallelism(const ComponentConfig&);
+
+// Returns `_id` range filters that cover the whole collection
+std::vector<formats::bson::Document> SplitMongoCacheCollection(
+    storages::mongo::Collection collection, std::size_t shard_count,
+    bool is_secondary_preferred);
+
 }
 
 // clang-format off
@@ -52,6 +69,17 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// update-correction | adjusts incremental updates window to overlap with previous update | 0
+/// full-update-parallelism | number of concurrent `_id` range cursors used for full updates | 1
+///
+/// ### Parallel full updates
+/// With `full-update-parallelism` greater than 1 the collection is split into
+/// `_id` ranges using a `$sample` aggregation, the ranges are read and parsed
+/// concurrently using separate connections and merged into the cache.
+/// Each range merges its parsed objects into the new cache by chunks of 1000
+/// under a mutex, so the update takes no more than 1000 extra objects per
+/// range in addition to the new cache. Only available with the default find
+/// operation. Collections with `_id`s of mixed types are read with a single
+/// cursor.
 ///
 /// ## Traits example:
 /// All fields below (except for function overrides) are mandatory.
@@ -139,9 +167,22 @@ class MongoCache
               const std::chrono::system_clock::time_point& now,
               cache::UpdateStatisticsScope& stats_scope) override;
 
+  void ParallelFullUpdate(cache::UpdateStatisticsScope& stats_scope);
+
   typename MongoCacheTraits::ObjectType DeserializeObject(
       const formats::bson::Document& doc) const;
 
+  // Returns the number of documents read
+  template <typename Consumer>
+  std::size_t ParseCursor(storages::mongo::Cursor& cursor,
+                          tracing::ScopeTime& scope,
+                          cache::UpdateStatisticsScope& stats_scope,
+                          Consumer&& consumer) const;
+
+  void UpdateCpuRelaxIterations(
+      std::size_t doc_count,
+      tracing::ScopeTime::DurationMillis elapsed_time);
+
   storages::mongo::operations::Find GetFindOperation(
       cache::UpdateType type,
       const std::chrono::system_clock::time_point& last_update,
@@ -154,6 +195,7 @@ class MongoCache
   const std::shared_ptr<CollectionsType> mongo_collections_;
   const storages::mongo::Collection* const mongo_collection_;
   const std::chrono::system_clock::duration correction_;
+  const std::size_t full_update_parallelism_;
   std::size_t cpu_relax_iterations_{0};
 };
 
@@ -172,7 +214,9 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
               .template GetCollectionForLibrary<CollectionsType>()),
       mongo_collection_(std::addressof(
           mongo_collections_.get()->*MongoCacheTraits::kMongoCollectionsField)),
-      correction_(impl::GetMongoCacheUpdateCorrection(config)) {
+      correction_(impl::GetMongoCacheUpdateCorrection(config)),
+      full_update_parallelism_(
+          impl::GetMongoCacheFullUpdateParallelism(config)) {
   [[maybe_unused]] mongo_cache::impl::CheckTraits<MongoCacheTraits>
       check_traits;
 
@@ -192,6 +236,13 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
         "config for '" +
         components::GetCurrentComponentName(config) + "' cache");
   }
+  if (full_update_parallelism_ > 1 &&
+      mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
+    throw std::logic_error(
+        "Parallel full updates are requested in config but a custom find "
+        "operation is specified in traits of '" +
+        components::GetCurrentComponentName(config) + "' cache");
+  }
 
   this->StartPeriodicUpdates();
 }
@@ -207,7 +258,10 @@ void MongoCache<MongoCacheTraits>::Update(
     const std::chrono::system_clock::time_point& last_update,
     const std::chrono::system_clock::time_point& now,
     cache::UpdateStatisticsScope& stats_scope) {
-  namespace sm = storages::mongo;
+  if (type == cache::UpdateType::kFull && full_update_parallelism_ > 1) {
+    ParallelFullUpdate(stats_scope);
+    return;
+  }
 
   const auto* collection = mongo_collection_;
   auto find_op = GetFindOperation(type, last_update, now, correction_);
@@ -225,6 +279,121 @@ void MongoCache<MongoCacheTraits>::Update(
   // No good way to identify whether cursor accesses DB or reads buffed data
   scope.Reset(kFetchAndParseStage);
 
+  const auto doc_count = ParseCursor(
+      cursor, scope, stats_scope,
+      [&](typename MongoCacheTraits::ObjectType&& object) {
+        auto key = (object.*MongoCacheTraits::kKeyField);
+
+        if (type == cache::UpdateType::kIncremental ||
+            new_cache->count(key) == 0) {
+          (*new_cache)[key] = std::move(object);
+        } else {
+          LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
+                              << MongoCacheTraits::kName << ", key=" << key;
+        }
+      });
+
+  UpdateCpuRelaxIterations(doc_count,
+                           scope.ElapsedTotal(kFetchAndParseStage));
+
+  scope.Reset();
+
+  const auto size = new_cache->size();
+  this->Set(std::move(new_cache));
+  stats_scope.Finish(size);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::ParallelFullUpdate(
+    cache::UpdateStatisticsScope& stats_scope) {
+  namespace sm = storages::mongo;
+  using ObjectType = typename MongoCacheTraits::ObjectType;
+
+  struct ShardStats {
+    std::size_t doc_count{0};
+    tracing::ScopeTime::DurationMillis elapsed_time{0};
+  };
+
+  auto scope = tracing::Span::CurrentSpan().CreateScopeTime("split_collection");
+  const auto filters = impl::SplitMongoCacheCollection(
+      *mongo_collection_, full_update_parallelism_,
+      MongoCacheTraits::kIsSecondaryPreferred);
+
+  scope.Reset(kFetchAndParseStage);
+  auto new_cache = GetData(cache::UpdateType::kFull);
+  engine::Mutex new_cache_mutex;
+  const auto merge = [&](std::vector<ObjectType>& objects) {
+    std::lock_guard lock(new_cache_mutex);
+    for (auto& object : objects) {
+      auto key = (object.*MongoCacheTraits::kKeyField);
+      if (new_cache->count(key) == 0) {
+        (*new_cache)[key] = std::move(object);
+      } else {
+        LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
+                            << MongoCacheTraits::kName << ", key=" << key;
+      }
+    }
+    objects.clear();
+  };
+
+  std::vector<engine::TaskWithResult<ShardStats>> tasks;
+  tasks.reserve(filters.size());
+  for (const auto& filter : filters) {
+    tasks.push_back(utils::Async("mongo_cache_shard", [&, this] {
+      sm::operations::Find find_op(filter);
+      if (MongoCacheTraits::kIsSecondaryPreferred) {
+        find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+      }
+      auto cursor = mongo_collection_->Execute(find_op);
+
+      auto shard_scope = tracing::Span::CurrentSpan().CreateScopeTime(
+          kFetchAndParseStage);
+      std::vector<ObjectType> chunk;
+      ShardStats stats;
+      stats.doc_count =
+          ParseCursor(cursor, shard_scope, stats_scope,
+                      [&](ObjectType&& object) {
+                        chunk.push_back(std::move(object));
+                        if (chunk.size() >= kParallelUpdateMergeChunkSize) {
+                          merge(chunk);
+                        }
+                      });
+      merge(chunk);
+      stats.elapsed_time = shard_scope.ElapsedTotal(kFetchAndParseStage);
+      return stats;
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  ShardStats slowest_shard;
+  std::string shard_timings;
+  for (auto& task : tasks) {
+    const auto stats = task.Get();
+    shard_timings += fmt::format("{}{}ms/{}", shard_timings.empty() ? "" : ", ",
+                                 stats.elapsed_time.count(), stats.doc_count);
+    if (stats.elapsed_time >= slowest_shard.elapsed_time) {
+      slowest_shard = stats;
+    }
+  }
+  LOG_INFO() << fmt::format(
+      "Full update of cache {} used {} shards, elapsed time/documents: {}",
+      kName, tasks.size(), shard_timings);
+
+  UpdateCpuRelaxIterations(slowest_shard.doc_count,
+                           slowest_shard.elapsed_time);
+
+  scope.Reset();
+
+  const auto size = new_cache->size();
+  this->Set(std::move(new_cache));
+  stats_scope.Finish(size);
+}
+
+template <class MongoCacheTraits>
+template <typename Consumer>
+std::size_t MongoCache<MongoCacheTraits>::ParseCursor(
+    storages::mongo::Cursor& cursor, tracing::ScopeTime& scope,
+    cache::UpdateStatisticsScope& stats_scope, Consumer&& consumer) const {
   utils::CpuRelax relax{cpu_relax_iterations_, &scope};
   std::size_t doc_count = 0;
 
@@ -236,16 +405,7 @@ void MongoCache<MongoCacheTraits>::Update(
     stats_scope.IncreaseDocumentsReadCount(1);
 
     try {
-      auto object = DeserializeObject(doc);
-      auto key = (object.*MongoCacheTraits::kKeyField);
-
-      if (type == cache::UpdateType::kIncremental ||
-          new_cache->count(key) == 0) {
-        (*new_cache)[key] = std::move(object);
-      } else {
-        LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
-                            << MongoCacheTraits::kName << ", key=" << key;
-      }
+      consumer(DeserializeObject(doc));
     } catch (const std::exception& e) {
       LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
                           << MongoCacheTraits::kName << ", _id="
@@ -256,8 +416,12 @@ void MongoCache<MongoCacheTraits>::Update(
       if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
     }
   }
+  return doc_count;
+}
 
-  const auto elapsed_time = scope.ElapsedTotal(kFetchAndParseStage);
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::UpdateCpuRelaxIterations(
+    std::size_t doc_count, tracing::ScopeTime::DurationMillis elapsed_time) {
   if (elapsed_time > kCpuRelaxThreshold) {
     cpu_relax_iterations_ = static_cast<std::size_t>(
         static_cast<double>(doc_count) / (elapsed_time / kCpuRelaxInterval));
@@ -266,12 +430,6 @@ void MongoCache<MongoCacheTraits>::Update(
         "Will relax CPU every {} iterations",
         kName, elapsed_time.count(), doc_count, cpu_relax_iterations_);
   }
-
-  scope.Reset();
-
-  const auto size = new_cache->size();
-  this->Set(std::move(new_cache));
-  stats_scope.Finish(size);
 }
 
 template <class MongoCacheTraits>
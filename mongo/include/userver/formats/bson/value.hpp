@@ -228,7 +228,9 @@ class Value {
   /// Should not be used normally.
   /// @details Should be called before the first field access. Only affects
   /// documents. Default policy is to throw an exception when duplicate fields
-  /// are encountered.
+  /// are encountered. Note that the first few member accesses scan the
+  /// document without parsing it, so duplicates may only be detected for the
+  /// accessed fields until the document is iterated over or parsed.
   /// @warning At most one value will be read, all others will be discarded and
   /// cannot be serialized back!
   void SetDuplicateFieldsPolicy(DuplicateFieldsPolicy);
@@ -1,17 +1,93 @@
 #include <userver/cache/base_mongo_cache.hpp>
 
+#include <algorithm>
+
 #include <userver/components/component_config.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace components::impl {
 
+namespace {
+
+// Number of sampled `_id`s per shard used to pick shard boundaries
+constexpr std::size_t kSamplesPerShard = 32;
+
+}  // namespace
+
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(
     const ComponentConfig& config) {
   return config["update-correction"].As<std::chrono::milliseconds>(0);
 }
 
+std::size_t GetMongoCacheFullUpdateParallelism(const ComponentConfig& config) {
+  return config["full-update-parallelism"].As<std::size_t>(1);
+}
+
+std::vector<formats::bson::Document> SplitMongoCacheCollection(
+    storages::mongo::Collection collection, std::size_t shard_count,
+    bool is_secondary_preferred) {
+  namespace bson = formats::bson;
+  namespace sm = storages::mongo;
+
+  std::vector<bson::Document> filters;
+  if (shard_count <= 1) {
+    filters.emplace_back();
+    return filters;
+  }
+
+  sm::operations::Aggregate aggregate(bson::MakeArray(
+      bson::MakeDoc("$sample",
+                    bson::MakeDoc("size", shard_count * kSamplesPerShard)),
+      bson::MakeDoc("$project",
+                    bson::MakeDoc("_id", 1, "type", bson::MakeDoc("$type",
+                                                                  "$_id"))),
+      bson::MakeDoc("$sort", bson::MakeDoc("_id", 1))));
+  if (is_secondary_preferred) {
+    aggregate.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+  }
+
+  std::vector<bson::Document> samples;
+  for (const auto& doc : collection.Execute(aggregate)) {
+    samples.push_back(doc);
+  }
+
+  // Range queries are type-bracketed in mongo, so shards built from
+  // boundaries of different types would overlap.
+  const bool is_single_type =
+      std::all_of(samples.begin(), samples.end(), [&](const auto& doc) {
+        return doc["type"] == samples.front()["type"];
+      });
+  if (samples.size() < shard_count || !is_single_type) {
+    LOG_WARNING() << "Cannot split collection into " << shard_count
+                  << " shards using " << samples.size()
+                  << " sampled _id values, reading it with a single cursor";
+    filters.emplace_back();
+    return filters;
+  }
+
+  std::vector<bson::Value> bounds;
+  bounds.reserve(shard_count - 1);
+  for (std::size_t i = 1; i < shard_count; ++i) {
+    bounds.push_back(samples[i * samples.size() / shard_count]["_id"]);
+  }
+
+  filters.reserve(shard_count);
+  // The first shard also picks up `_id`s of types other than the sampled one
+  filters.push_back(bson::MakeDoc(
+      "_id", bson::MakeDoc("$not", bson::MakeDoc("$gte", bounds.front()))));
+  for (std::size_t i = 1; i < bounds.size(); ++i) {
+    filters.push_back(bson::MakeDoc(
+        "_id", bson::MakeDoc("$gte", bounds[i - 1], "$lt", bounds[i])));
+  }
+  filters.push_back(
+      bson::MakeDoc("_id", bson::MakeDoc("$gte", bounds.back())));
+  return filters;
+}
+
 std::string GetMongoCacheSchema() {
   return R"(
 type: object
@@ -22,6 +98,13 @@ properties:
         type: string
         description: adjusts incremental updates window to overlap with previous update
         defaultDescription: 0
+    full-update-parallelism:
+        type: integer
+        description: |
+            number of concurrent `_id` range cursors used for full updates,
+            requires the default find operation
+        defaultDescription: 1
+        minimum: 1
 )";
 }
 
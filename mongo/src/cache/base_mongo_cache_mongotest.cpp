@@ -0,0 +1,106 @@
+#include <userver/cache/base_mongo_cache.hpp>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <storages/mongo/util_mongotest.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/serialize.hpp>
+#include <userver/storages/mongo/collection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+namespace {
+
+class MongoCacheSplit : public MongoPoolFixture {};
+
+// Documents have unique "n" fields, the filters must match each of them once
+void ExpectCoversOnce(mongo::Collection& coll,
+                      const std::vector<bson::Document>& filters,
+                      std::size_t doc_count) {
+  std::unordered_set<int> seen;
+  for (const auto& filter : filters) {
+    std::size_t shard_size = 0;
+    for (const auto& doc : coll.Find(filter)) {
+      EXPECT_TRUE(seen.insert(doc["n"].As<int>()).second)
+          << "Document is matched twice: " << bson::ToRelaxedJsonString(doc);
+      ++shard_size;
+    }
+    EXPECT_NE(shard_size, 0) << bson::ToRelaxedJsonString(filter);
+  }
+  EXPECT_EQ(seen.size(), doc_count);
+}
+
+void InsertIntIds(mongo::Collection& coll, int count) {
+  std::vector<bson::Document> docs;
+  docs.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    docs.push_back(bson::MakeDoc("_id", i, "n", i));
+  }
+  coll.InsertMany(std::move(docs));
+}
+
+}  // namespace
+
+UTEST_F(MongoCacheSplit, IdRanges) {
+  auto coll = GetDefaultPool().GetCollection("split_id_ranges");
+  InsertIntIds(coll, 1000);
+
+  const auto filters =
+      components::impl::SplitMongoCacheCollection(coll, 4, false);
+  EXPECT_EQ(filters.size(), 4);
+  ExpectCoversOnce(coll, filters, 1000);
+}
+
+UTEST_F(MongoCacheSplit, RareIdType) {
+  auto coll = GetDefaultPool().GetCollection("split_rare_id_type");
+  InsertIntIds(coll, 1000);
+  coll.InsertOne(bson::MakeDoc("_id", "rare", "n", 1000));
+
+  // The string `_id` may be sampled and disable the split, otherwise it is
+  // picked up by the first range
+  const auto filters =
+      components::impl::SplitMongoCacheCollection(coll, 4, false);
+  ExpectCoversOnce(coll, filters, 1001);
+}
+
+UTEST_F(MongoCacheSplit, MixedIdTypes) {
+  auto coll = GetDefaultPool().GetCollection("split_mixed_id_types");
+  InsertIntIds(coll, 500);
+  for (int i = 0; i < 500; ++i) {
+    coll.InsertOne(
+        bson::MakeDoc("_id", "id-" + std::to_string(i), "n", 500 + i));
+  }
+
+  const auto filters =
+      components::impl::SplitMongoCacheCollection(coll, 4, false);
+  ASSERT_EQ(filters.size(), 1);
+  EXPECT_TRUE(filters.front().IsEmpty());
+  ExpectCoversOnce(coll, filters, 1000);
+}
+
+UTEST_F(MongoCacheSplit, TooFewDocuments) {
+  auto coll = GetDefaultPool().GetCollection("split_too_few_documents");
+  InsertIntIds(coll, 2);
+
+  const auto filters =
+      components::impl::SplitMongoCacheCollection(coll, 4, false);
+  ASSERT_EQ(filters.size(), 1);
+  EXPECT_TRUE(filters.front().IsEmpty());
+}
+
+UTEST_F(MongoCacheSplit, SingleShard) {
+  auto coll = GetDefaultPool().GetCollection("split_single_shard");
+  InsertIntIds(coll, 100);
+
+  const auto filters =
+      components::impl::SplitMongoCacheCollection(coll, 1, false);
+  ASSERT_EQ(filters.size(), 1);
+  EXPECT_TRUE(filters.front().IsEmpty());
+}
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,9 @@
 #include <userver/formats/bson/serialize.hpp>
 #include <userver/formats/json.hpp>
 
+#include <string>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -115,4 +118,54 @@ void bson_path_first_access(benchmark::State& state) {
 }
 BENCHMARK(bson_path_first_access);
 
+namespace {
+
+formats::bson::Document MakeWideDocument(std::size_t fields) {
+  formats::bson::ValueBuilder builder(formats::common::Type::kObject);
+  for (std::size_t i = 0; i < fields; ++i) {
+    builder["field_" + std::to_string(i)] = "value_" + std::to_string(i);
+  }
+  return builder.ExtractValue();
+}
+
+}  // namespace
+
+void bson_wide_first_access(benchmark::State& state) {
+  const auto fields = static_cast<std::size_t>(state.range(0));
+  const auto source = MakeWideDocument(fields);
+  const auto first_key = std::string{"field_0"};
+  const auto last_key = "field_" + std::to_string(fields - 1);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    formats::bson::Document bson(source.GetBson());
+    state.ResumeTiming();
+
+    const auto res = bson[first_key].As<std::string>().size() +
+                     bson[last_key].As<std::string>().size();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_wide_first_access)->RangeMultiplier(4)->Range(4, 256);
+
+void bson_wide_repeated_access(benchmark::State& state) {
+  const auto fields = static_cast<std::size_t>(state.range(0));
+  const auto source = MakeWideDocument(fields);
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < fields; ++i) {
+    keys.push_back("field_" + std::to_string(i));
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    formats::bson::Document bson(source.GetBson());
+    state.ResumeTiming();
+
+    std::size_t res = 0;
+    for (const auto& key : keys) res += bson[key].As<std::string>().size();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_wide_repeated_access)->RangeMultiplier(4)->Range(4, 256);
+
 USERVER_NAMESPACE_END
@@ -233,4 +233,16 @@ void bson_parse_access(benchmark::State& state) {
 }
 BENCHMARK(bson_parse_access);
 
+void bson_parse_partial(benchmark::State& state) {
+  static unsigned i = 0;
+
+  for (auto _ : state) {
+    auto bson = formats::bson::Document(bench_bson_data[++i % kBenchRows]);
+
+    const auto res = bson.As<models::DriverId>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_parse_partial);
+
 USERVER_NAMESPACE_END
@@ -18,6 +18,11 @@ namespace {
 
 constexpr bson_value_t kDefaultBsonValue{BSON_TYPE_EOD, {}, {}};
 
+// Number of member lookups served by scanning the raw document before it gets
+// parsed into a hash map. Most documents are read field-by-field a few times,
+// so parsing (and allocating) all the members upfront is usually a waste.
+constexpr uint32_t kMaxUnparsedLookups = 8;
+
 void RelaxedSetParsedValue(std::atomic<ValueImpl::ParsedValue*>& parsed_value,
                            ValueImpl::ParsedValue&& value) {
   UASSERT(parsed_value.load(std::memory_order_relaxed) == nullptr);
@@ -364,6 +369,12 @@ void ValueImpl::SetDuplicateFieldsPolicy(Value::DuplicateFieldsPolicy policy) {
 ValueImplPtr ValueImpl::operator[](const std::string& name) {
   if (!IsMissing() && !IsNull()) {
     CheckIsDocument();
+    if (ShouldLookupUnparsed()) {
+      const auto value = FindUnparsedMember(name);
+      return std::make_shared<ValueImpl>(
+          EmplaceEnabler{}, value ? storage_ : nullptr, path_,
+          value.value_or(kDefaultBsonValue), duplicate_fields_policy_, name);
+    }
     EnsureParsed();
     const auto& parsed_doc = std::get<ParsedDocument>(*parsed_value_.load());
     auto it = parsed_doc.find(name);
@@ -389,6 +400,7 @@ bool ValueImpl::HasMember(const std::string& name) {
   if (IsMissing() || IsNull()) return false;
 
   CheckIsDocument();
+  if (ShouldLookupUnparsed()) return FindUnparsedMember(name).has_value();
   EnsureParsed();
   return std::get<ParsedDocument>(*parsed_value_.load()).count(name);
 }
@@ -675,6 +687,51 @@ void ValueImpl::EnsureParsed() {
   }
 }
 
+bool ValueImpl::ShouldLookupUnparsed() {
+  if (parsed_value_.load() != nullptr) return false;
+  return unparsed_lookups_.fetch_add(1, std::memory_order_relaxed) <
+         kMaxUnparsedLookups;
+}
+
+std::optional<bson_value_t> ValueImpl::FindUnparsedMember(
+    std::string_view name) const {
+  UASSERT(IsDocument());
+  std::optional<bson_value_t> result;
+  bson_iter_t it;
+  if (!bson_iter_init_from_data(&it, bson_value_.value.v_doc.data,
+                                bson_value_.value.v_doc.data_len)) {
+    throw ParseException(
+        fmt::format("malformed BSON at {}", path_.ToStringView()));
+  }
+  while (bson_iter_next(&it)) {
+    const std::string_view key(bson_iter_key(&it), bson_iter_key_len(&it));
+    if (key != name) continue;
+
+    const bson_value_t* iter_value = bson_iter_value(&it);
+    if (!iter_value) {
+      throw ParseException(fmt::format("malformed BSON element at {}.{}",
+                                       path_.ToStringView(), key));
+    }
+    if (result) {
+      switch (duplicate_fields_policy_) {
+        case Value::DuplicateFieldsPolicy::kForbid:
+          throw ParseException(fmt::format("duplicate key '{}' at {}", key,
+                                           path_.ToStringView()));
+        case Value::DuplicateFieldsPolicy::kUseFirst:
+          UASSERT_MSG(false, "lookup should have stopped on the first match");
+          break;
+        case Value::DuplicateFieldsPolicy::kUseLast:
+          break;
+      }
+    }
+    result = *iter_value;
+    if (duplicate_fields_policy_ == Value::DuplicateFieldsPolicy::kUseFirst) {
+      break;
+    }
+  }
+  return result;
+}
+
 void ValueImpl::SyncBsonValue() {
   // either primitive type or was never touched
   if (parsed_value_.load() == nullptr) return;
@@ -3,6 +3,8 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <variant>
 
 #include <bson/bson.h>
@@ -114,10 +116,16 @@ class ValueImpl {
  private:
   friend class BsonBuilder;
 
+  // Looks up a document member in the raw BSON without parsing the document.
+  // Returns true if such lookup should be used instead of the parsed index.
+  bool ShouldLookupUnparsed();
+  std::optional<bson_value_t> FindUnparsedMember(std::string_view name) const;
+
   Storage storage_;
   Path path_;
   bson_value_t bson_value_;
   std::atomic<ParsedValue*> parsed_value_{nullptr};
+  std::atomic<uint32_t> unparsed_lookups_{0};
   Value::DuplicateFieldsPolicy duplicate_fields_policy_{
       Value::DuplicateFieldsPolicy::kForbid};
 };
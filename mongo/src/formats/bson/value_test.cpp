@@ -218,6 +218,26 @@ TEST(BsonValue, DuplicateFieldsForbid) {
   UEXPECT_THROW(doc_forbid["a"], fb::ParseException);
 }
 
+TEST(BsonValue, UnparsedLookup) {
+  const auto doc = fb::MakeDoc("a", 1, "b", "two", "c", fb::MakeDoc("d", 3));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(1, doc["a"].As<int>());
+    EXPECT_EQ("two", doc["b"].As<std::string>());
+    EXPECT_EQ(3, doc["c"]["d"].As<int>());
+    EXPECT_TRUE(doc.HasMember("c"));
+    EXPECT_FALSE(doc.HasMember("d"));
+    EXPECT_TRUE(doc["d"].IsMissing());
+    EXPECT_EQ("c.d", doc["c"]["d"].GetPath());
+  }
+}
+
+TEST(BsonValue, DuplicateFieldsForbidUnparsed) {
+  auto doc_forbid = kDuplicateFieldsDoc;
+  EXPECT_EQ("end", doc_forbid["c"].As<std::string>());
+  UEXPECT_THROW(doc_forbid["a"], fb::ParseException);
+  UEXPECT_THROW(doc_forbid.HasMember("a"), fb::ParseException);
+}
+
 TEST(BsonValue, DuplicateFieldsUseFirst) {
   auto doc_use_first = kDuplicateFieldsDoc;
   doc_use_first.SetDuplicateFieldsPolicy(
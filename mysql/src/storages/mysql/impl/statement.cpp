@@ -166,6 +166,7 @@ void Statement::Reset(engine::Deadline deadline) {
     if (connection_->GetServerInfo().server_type ==
         metadata::ServerInfo::Type::kMySQL) {
       PrepareStatement(native_statement_, deadline);
+      ApplyBulkAttributes({}, true);
     }
     batch_size_.reset();
   }
@@ -180,28 +181,45 @@ void Statement::UpdateParamsBindings(io::ParamsBinderBase& params) {
       throw std::runtime_error("Failed to bind statements params");
     }
 
-    if (auto rows_count = params.GetRowsCount(); rows_count > 1) {
+    BulkAttributes attributes{};
+    if (const auto rows_count = params.GetRowsCount(); rows_count > 1) {
       const auto& server_info = connection_->GetServerInfo();
       if (server_info.server_type != metadata::ServerInfo::Type::kMariaDB ||
           server_info.server_version < metadata::SemVer{10, 2, 6}) {
         throw std::logic_error{"Batch insert requires MariaDB 10.2.6 or later"};
       }
 
-      mysql_stmt_attr_set(native_statement_.get(), STMT_ATTR_ARRAY_SIZE,
-                          &rows_count);
+      attributes.array_size = static_cast<unsigned int>(rows_count);
     }
+    attributes.user_data = binds.GetUserData();
+    attributes.params_cb = reinterpret_cast<void*>(binds.GetParamsCallback());
 
-    if (auto* user_data = binds.GetUserData()) {
-      mysql_stmt_attr_set(native_statement_.get(), STMT_ATTR_CB_USER_DATA,
-                          user_data);
-    }
-    if (auto* param_cb = binds.GetParamsCallback()) {
-      mysql_stmt_attr_set(native_statement_.get(), STMT_ATTR_CB_PARAM,
-                          reinterpret_cast<void*>(param_cb));
-    }
+    // A statement executed in bulk before might be reused for a single row
+    // execution, and we must not leave a stale array size or a callback
+    // pointing to an already destroyed binder there.
+    ApplyBulkAttributes(attributes, false);
   }
 }
 
+void Statement::ApplyBulkAttributes(const BulkAttributes& attributes,
+                                    bool force) {
+  auto* statement = native_statement_.get();
+
+  if (force || attributes.array_size != bulk_attributes_.array_size) {
+    mysql_stmt_attr_set(statement, STMT_ATTR_ARRAY_SIZE,
+                        &attributes.array_size);
+  }
+  if (force || attributes.user_data != bulk_attributes_.user_data) {
+    mysql_stmt_attr_set(statement, STMT_ATTR_CB_USER_DATA,
+                        attributes.user_data);
+  }
+  if (force || attributes.params_cb != bulk_attributes_.params_cb) {
+    mysql_stmt_attr_set(statement, STMT_ATTR_CB_PARAM, attributes.params_cb);
+  }
+
+  bulk_attributes_ = attributes;
+}
+
 std::size_t Statement::RowsCount() const {
   return mysql_stmt_num_rows(native_statement_.get());
 }
@@ -84,6 +84,16 @@ class Statement final {
 
   void UpdateParamsBindings(io::ParamsBinderBase& params);
 
+  // Attributes of the native statement used for bulk execution. Statements
+  // are cached and reused across executions, so we remember what is set
+  // to only touch the attributes when they actually change.
+  struct BulkAttributes final {
+    unsigned int array_size{0};
+    void* user_data{nullptr};
+    void* params_cb{nullptr};
+  };
+  void ApplyBulkAttributes(const BulkAttributes& attributes, bool force);
+
   class NativeStatementDeleter {
    public:
     explicit NativeStatementDeleter(Connection* connection);
@@ -110,6 +120,7 @@ class Statement final {
   NativeStatementPtr native_statement_;
 
   std::optional<std::size_t> batch_size_;
+  BulkAttributes bulk_attributes_{};
 };
 
 }  // namespace storages::mysql::impl
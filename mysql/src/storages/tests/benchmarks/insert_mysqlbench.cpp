@@ -1,6 +1,11 @@
 #include <benchmark/benchmark.h>
 #include "../utils_mysqltest.hpp"
 
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
+
 #include <userver/engine/run_standalone.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -105,6 +110,133 @@ void batch_insert(benchmark::State& state) {
 }
 BENCHMARK(batch_insert)->Range(1000, 100'000);
 
+namespace {
+
+struct InsertRow final {
+  std::int32_t id{};
+  std::string value;
+};
+
+constexpr std::string_view kInsertTableDefinition{
+    "Id INT NOT NULL PRIMARY KEY, Value TEXT NOT NULL"};
+
+// Keeps hand-built multi-values statements well below max_allowed_packet
+constexpr std::size_t kMultiValuesChunkSize = 1000;
+
+const CommandControl kInsertCommandControl{std::chrono::seconds{60}};
+
+std::vector<InsertRow> MakeRowsToInsert(std::int64_t rows_count) {
+  std::vector<InsertRow> rows;
+  rows.reserve(rows_count);
+  for (std::int32_t i = 0; i < rows_count; ++i) {
+    rows.push_back({i, "some string, i don't really care"});
+  }
+
+  return rows;
+}
+
+std::string MakeMultiValuesInsert(const tests::TmpTable& table,
+                                  const std::vector<InsertRow>& rows,
+                                  std::size_t offset) {
+  const auto end = std::min(rows.size(), offset + kMultiValuesChunkSize);
+
+  std::string result = table.FormatWithTableName("INSERT INTO {} VALUES");
+  for (std::size_t i = offset; i < end; ++i) {
+    fmt::format_to(std::back_inserter(result), "{}({}, '{}')",
+                   i == offset ? "" : ",", rows[i].id, rows[i].value);
+  }
+
+  return result;
+}
+
+}  // namespace
+
+// One round-trip per row, all of them in a single transaction
+void insert_compare_single(benchmark::State& state) {
+  engine::RunStandalone([&state] {
+    tests::ClusterWrapper cluster{};
+    const auto rows_to_insert = MakeRowsToInsert(state.range(0));
+
+    for (auto _ : state) {
+      state.PauseTiming();
+      tests::TmpTable table{cluster, kInsertTableDefinition};
+      const Query query{
+          table.FormatWithTableName("INSERT INTO {} VALUES(?, ?)")};
+      state.ResumeTiming();
+
+      auto transaction =
+          cluster->Begin(kInsertCommandControl, ClusterHostType::kPrimary);
+      for (const auto& row : rows_to_insert) {
+        transaction.ExecuteDecompose(query, row);
+      }
+      transaction.Commit();
+
+      state.PauseTiming();
+      table.DefaultExecute("DROP TABLE {}");
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(insert_compare_single)->Range(1 << 8, 1 << 14)->RangeMultiplier(4);
+
+// Hand-built multi-row SQL over the text protocol, including its formatting
+void insert_compare_multi_values(benchmark::State& state) {
+  engine::RunStandalone([&state] {
+    tests::ClusterWrapper cluster{};
+    const auto rows_to_insert = MakeRowsToInsert(state.range(0));
+
+    for (auto _ : state) {
+      state.PauseTiming();
+      tests::TmpTable table{cluster, kInsertTableDefinition};
+      state.ResumeTiming();
+
+      for (std::size_t offset = 0; offset < rows_to_insert.size();
+           offset += kMultiValuesChunkSize) {
+        cluster->ExecuteCommand(
+            kInsertCommandControl, ClusterHostType::kPrimary,
+            MakeMultiValuesInsert(table, rows_to_insert, offset));
+      }
+
+      state.PauseTiming();
+      table.DefaultExecute("DROP TABLE {}");
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(insert_compare_multi_values)
+    ->Range(1 << 8, 1 << 14)
+    ->RangeMultiplier(4);
+
+// Single round-trip with bulk array binding
+void insert_compare_bulk(benchmark::State& state) {
+  engine::RunStandalone([&state] {
+    tests::ClusterWrapper cluster{};
+    const auto rows_to_insert = MakeRowsToInsert(state.range(0));
+
+    for (auto _ : state) {
+      state.PauseTiming();
+      tests::TmpTable table{cluster, kInsertTableDefinition};
+      const Query query{
+          table.FormatWithTableName("INSERT INTO {} VALUES(?, ?)")};
+      state.ResumeTiming();
+
+      cluster->ExecuteBulk(kInsertCommandControl, ClusterHostType::kPrimary,
+                           query, rows_to_insert);
+
+      state.PauseTiming();
+      table.DefaultExecute("DROP TABLE {}");
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(insert_compare_bulk)->Range(1 << 8, 1 << 14)->RangeMultiplier(4);
+
 }  // namespace storages::mysql::benches
 
 USERVER_NAMESPACE_END
@@ -159,6 +159,28 @@ UTEST(Transaction, InsertMany) {
   }
 }
 
+UTEST(Transaction, InsertManyThenOne) {
+  auto meta = TableMeta::Create();
+
+  {
+    const std::vector<Row> rows{{1, "some text"}, {2, "other text"}};
+    const Row row{3, "more text"};
+
+    // Same statement on the same connection: the bulk attributes of
+    // the cached statement must not leak into the next execution
+    auto transaction = meta.table.Begin();
+    transaction.ExecuteBulk(meta.GetInsertQuery(), rows);
+    transaction.ExecuteDecompose(meta.GetInsertQuery(), row);
+    transaction.ExecuteBulk(meta.GetInsertQuery(), rows);
+
+    const std::vector<Row> expected{rows[0], rows[1], row, rows[0], rows[1]};
+    EXPECT_EQ(transaction.Execute(meta.GetSelectQuery()).AsVector<Row>(),
+              expected);
+
+    transaction.Rollback();
+  }
+}
+
 }  // namespace storages::mysql::tests
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,13 @@
+#include <chrono>
 #include <deque>
 #include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <storages/redis/client_impl.hpp>
+#include <storages/redis/impl/socket_connection.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/utils/rand.hpp>
@@ -69,6 +73,81 @@ BENCHMARK_DEFINE_TEMPLATE_F(Redis, PipelineGrind)(benchmark::State& state) {
   });
 }
 
+BENCHMARK_DEFINE_F(Redis, ConcurrentPing)(benchmark::State& state) {
+  RunStandalone([this, &state] {
+    USERVER_NAMESPACE::redis::CommandsBufferingSettings buffering_settings;
+    buffering_settings.buffering_enabled = state.range(1) != 0;
+    buffering_settings.watch_command_timer_interval =
+        std::chrono::microseconds{state.range(1)};
+    GetSentinel()->SetCommandsBufferingSettings(buffering_settings);
+
+    const auto client = GetClient();
+    const auto concurrency = state.range(0);
+    std::vector<RequestPing> requests;
+    requests.reserve(concurrency);
+
+    for (auto _ : state) {
+      for (auto i = 0; i < concurrency; ++i) {
+        requests.push_back(client->Ping(0, {}));
+      }
+      for (auto& request : requests) request.Get();
+      requests.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * concurrency);
+
+    const auto stats = GetSentinel()->GetStatistics({});
+    const auto total = stats.GetShardGroupTotalStatistics();
+    const auto& batch_sizes = total.commands_batch_size_percentile;
+    for (auto p : {50, 100}) {
+      state.counters["batch_p" + std::to_string(p)] =
+          batch_sizes.GetPercentile(p);
+    }
+  });
+}
+// Args: {in-flight requests, commands buffering interval in microseconds}
+BENCHMARK_REGISTER_F(Redis, ConcurrentPing)
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({64, 0})
+    ->Args({256, 0})
+    ->Args({1, 100})
+    ->Args({8, 100})
+    ->Args({64, 100})
+    ->Args({256, 100});
+
+// Same as ConcurrentPing, but without the ev threads: the requests are sent
+// and the replies are read by the coroutines of the task processor
+BENCHMARK_DEFINE_F(Redis, SocketConnectionPing)(benchmark::State& state) {
+  RunStandalone([this, &state] {
+    USERVER_NAMESPACE::redis::SocketConnection connection;
+    connection.Connect(GetMasterAddress(),
+                       USERVER_NAMESPACE::redis::Password(""), {});
+
+    const auto concurrency = state.range(0);
+    std::vector<engine::TaskWithResult<ReplyPtr>> requests;
+    requests.reserve(concurrency);
+
+    for (auto _ : state) {
+      for (auto i = 0; i < concurrency; ++i) {
+        requests.push_back(engine::AsyncNoSpan(
+            [&connection] { return connection.Execute({"PING"}, {}); }));
+      }
+      for (auto& request : requests) request.Get();
+      requests.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * concurrency);
+
+    const auto stats = connection.GetStatistics();
+    state.counters["batch_avg"] =
+        stats.sends ? static_cast<double>(stats.commands) / stats.sends : 0;
+  });
+}
+BENCHMARK_REGISTER_F(Redis, SocketConnectionPing)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(256);
+
 BENCHMARK_INSTANTIATE_TEMPLATE_F(Redis, PipelineGrind, Ping)
     ->RangeMultiplier(2)
     ->Range(4, 32);
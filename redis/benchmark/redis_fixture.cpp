@@ -7,6 +7,7 @@
 
 #include <storages/redis/client_impl.hpp>
 #include <storages/redis/impl/sentinel.hpp>
+#include <storages/redis/impl/socket_connection.hpp>
 #include <storages/redis/redis_secdist.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +22,7 @@ constexpr std::size_t kRedisThreadPoolSize = 3;
 
 constexpr const char* kTestsuiteSentinelPort = "TESTSUITE_REDIS_SENTINEL_PORT";
 constexpr const char* kDefaultSentinelPort = "26379";
+constexpr std::chrono::seconds kSentinelTimeout{1};
 
 constexpr std::string_view kRedisSettings = R"({{
   "redis_settings": {{
@@ -50,6 +52,24 @@ const USERVER_NAMESPACE::secdist::RedisSettings& GetTestsuiteRedisSettings() {
 
 }  // namespace
 
+engine::io::Sockaddr Redis::GetMasterAddress() const {
+  const auto& settings = GetTestsuiteRedisSettings();
+  // The testsuite runs redis on the local host
+  auto addr = engine::io::Sockaddr::MakeIPv4LoopbackAddress();
+  addr.SetPort(static_cast<std::uint16_t>(settings.sentinels.at(0).port));
+
+  USERVER_NAMESPACE::redis::SocketConnection sentinel;
+  sentinel.Connect(addr, USERVER_NAMESPACE::redis::Password(""),
+                   engine::Deadline::FromDuration(kSentinelTimeout));
+  const auto reply = sentinel.Execute(
+      {"SENTINEL", "get-master-addr-by-name", settings.shards.at(0)},
+      engine::Deadline::FromDuration(kSentinelTimeout));
+  reply->ExpectArray("SENTINEL get-master-addr-by-name");
+  addr.SetPort(
+      static_cast<std::uint16_t>(std::stoi(reply->data[1].GetString())));
+  return addr;
+}
+
 void Redis::RunStandalone(std::function<void()> payload) {
   engine::RunStandalone(kMainWorkerThreads, [&] {
     auto thread_pools = std::make_shared<USERVER_NAMESPACE::redis::ThreadPools>(
@@ -5,6 +5,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include <userver/engine/io/sockaddr.hpp>
+
 #include <storages/redis/client_impl.hpp>
 #include <storages/redis/impl/sentinel.hpp>
 
@@ -18,6 +20,9 @@ class Redis : public benchmark::Fixture {
  protected:
   ClientPtr GetClient() const noexcept { return client_; };
   SentinelPtr GetSentinel() const noexcept { return sentinel_; };
+  // Address of the master the sentinel is connected to, for the benchmarks
+  // that bypass the Sentinel
+  engine::io::Sockaddr GetMasterAddress() const;
 
   void RunStandalone(std::function<void()> payload);
 
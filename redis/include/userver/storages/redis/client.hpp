@@ -36,6 +36,11 @@ inline constexpr RetryNilFromMaster kRetryNilFromMaster{};
 ///
 /// Usually retrieved from components::Redis component.
 ///
+/// Multi-key commands (Mget, Mset and multi-key Del, Unlink, Exists) are
+/// automatically split between shards (hash slots in cluster mode) and their
+/// replies are merged. Such commands are not atomic if the keys belong to
+/// different shards.
+///
 /// ## Example usage:
 ///
 /// @snippet storages/redis/client_redistest.cpp  Sample Redis Client usage
@@ -29,6 +29,7 @@ namespace storages {}
 /// Redis client
 namespace storages::redis {
 class Client;
+class NearCache;
 class SubscribeClient;
 class SubscribeClientImpl;
 }  // namespace storages::redis
@@ -64,6 +65,10 @@ namespace components {
 /// groups.[].db | name to refer to the cluster in components::Redis::GetClient() | -
 /// groups.[].sharding_strategy | one of RedisCluster, KeyShardCrc32, KeyShardTaximeterCrc32 or KeyShardGpsStorageDriver | "KeyShardTaximeterCrc32"
 /// groups.[].allow_reads_from_master | allows read requests from master instance | false
+/// groups.[].socket_connection | serve the connections by coroutines of the component task processor instead of hiredis on the redis threads; TLS and host names of the instances are not supported, the instances must be reported by IP addresses | false
+/// groups.[].near_cache.max_size | enables in-process cache of GET replies with up to this number of keys, see below | -
+/// groups.[].near_cache.max_value_size | values larger than this are not cached | 4096
+/// groups.[].near_cache.prefixes | cache only keys with these prefixes | all keys are cached
 /// subscribe_groups | array of redis clusters to work with in subscribe mode | -
 /// subscribe_groups.[].config_name | key name in secdist with options for this cluster | -
 /// subscribe_groups.[].db | name to refer to the cluster in components::Redis::GetSubscribeClient() | -
@@ -122,6 +127,19 @@ namespace components {
 /// 1. `"shards"` field is ignored, you can specify an empty array there;
 /// 2. `"sentinels"` field should contain some of the cluster nodes. They are
 ///    only used for topology discovery; it is not necessary to list all nodes.
+///
+/// ## Near cache
+///
+/// With `near_cache` the replies to storages::redis::Client::Get() are cached
+/// in process. An additional subscriber connection per shard enables
+/// server-assisted client side caching (`CLIENT TRACKING ... BCAST`) and drops
+/// the keys modified by anyone, so the cache is eventually consistent: a value
+/// may be stale until the invalidation message arrives, even right after a
+/// write made by the same client. The invalidations are tracked on the master
+/// of each shard, so the GET requests for the cached keys are sent to the
+/// master regardless of the command control. The cache is bypassed while any
+/// shard is disconnected. Requires Redis 6.0+ and is not supported for RedisCluster.
+/// Hits, misses and invalidations are reported in `redis.near_cache` metrics.
 
 // clang-format on
 class Redis : public LoggableComponentBase {
@@ -163,6 +181,8 @@ class Redis : public LoggableComponentBase {
   std::unordered_map<std::string,
                      std::shared_ptr<storages::redis::SubscribeClientImpl>>
       subscribe_clients_;
+  std::unordered_map<std::string, std::shared_ptr<storages::redis::NearCache>>
+      near_caches_;
 
   dynamic_config::Source config_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
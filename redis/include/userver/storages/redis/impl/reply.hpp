@@ -124,6 +124,7 @@ class ReplyData final {
   ReplyData(Array&& array);
   ReplyData(std::string s);
   ReplyData(int value);
+  static ReplyData CreateInteger(int64_t value);
   static ReplyData CreateError(std::string&& error_msg);
   static ReplyData CreateStatus(std::string&& status_msg);
   static ReplyData CreateNil();
@@ -1,10 +1,16 @@
 #include "client_impl.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+#include <userver/storages/redis/impl/keyshard.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <storages/redis/impl/sentinel.hpp>
 
 #include "impl/command_control_impl.hpp"
+#include "near_cache.hpp"
 #include "request_impl.hpp"
 #include "transaction_impl.hpp"
 
@@ -35,12 +41,30 @@ void DoCheckShard(size_t shard, std::optional<size_t> force_shard_idx) {
         ')');
 }
 
+const std::string& GetKey(const std::string& key) { return key; }
+
+const std::string& GetKey(const std::pair<std::string, std::string>& kv) {
+  return kv.first;
+}
+
+template <typename T>
+std::vector<T> TakeByPositions(std::vector<T>& args,
+                               const std::vector<size_t>& positions) {
+  std::vector<T> result;
+  result.reserve(positions.size());
+  for (const auto pos : positions) result.push_back(std::move(args[pos]));
+  return result;
+}
+
 }  // namespace
 
 ClientImpl::ClientImpl(
     std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-    std::optional<size_t> force_shard_idx)
-    : redis_client_(std::move(sentinel)), force_shard_idx_(force_shard_idx) {}
+    std::optional<size_t> force_shard_idx,
+    std::shared_ptr<NearCache> near_cache)
+    : redis_client_(std::move(sentinel)),
+      force_shard_idx_(force_shard_idx),
+      near_cache_(std::move(near_cache)) {}
 
 void ClientImpl::WaitConnectedOnce(
     USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) {
@@ -61,7 +85,7 @@ const std::string& ClientImpl::GetAnyKeyForShard(size_t shard_idx) const {
 }
 
 std::shared_ptr<Client> ClientImpl::GetClientForShard(size_t shard_idx) {
-  return std::make_shared<ClientImpl>(redis_client_, shard_idx);
+  return std::make_shared<ClientImpl>(redis_client_, shard_idx, near_cache_);
 }
 
 std::optional<size_t> ClientImpl::GetForcedShardIdx() const {
@@ -118,10 +142,8 @@ RequestDel ClientImpl::Del(std::vector<std::string> keys,
                            const CommandControl& command_control) {
   if (keys.empty())
     return CreateDummyRequest<RequestDel>(std::make_shared<Reply>("del", 0));
-  auto shard = ShardByKey(keys.at(0), command_control);
-  return CreateRequest<RequestDel>(
-      MakeRequest(CmdArgs{"del", std::move(keys)}, shard, true,
-                  GetCommandControl(command_control)));
+  return MakeMultiKeyRequest<RequestDel>("del", std::move(keys), true,
+                                         command_control);
 }
 
 RequestUnlink ClientImpl::Unlink(std::string key,
@@ -137,10 +159,8 @@ RequestUnlink ClientImpl::Unlink(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestUnlink>(
         std::make_shared<Reply>("unlink", 0));
-  auto shard = ShardByKey(keys.at(0), command_control);
-  return CreateRequest<RequestUnlink>(
-      MakeRequest(CmdArgs{"unlink", std::move(keys)}, shard, true,
-                  GetCommandControl(command_control)));
+  return MakeMultiKeyRequest<RequestUnlink>("unlink", std::move(keys), true,
+                                            command_control);
 }
 
 RequestEvalCommon ClientImpl::EvalCommon(
@@ -187,10 +207,8 @@ RequestExists ClientImpl::Exists(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestExists>(
         std::make_shared<Reply>("exists", 0));
-  auto shard = ShardByKey(keys.at(0), command_control);
-  return CreateRequest<RequestExists>(
-      MakeRequest(CmdArgs{"exists", std::move(keys)}, shard, false,
-                  GetCommandControl(command_control)));
+  return MakeMultiKeyRequest<RequestExists>("exists", std::move(keys), false,
+                                            command_control);
 }
 
 RequestExpire ClientImpl::Expire(std::string key, std::chrono::seconds ttl,
@@ -278,6 +296,20 @@ RequestGeosearch ClientImpl::Geosearch(
 RequestGet ClientImpl::Get(std::string key,
                            const CommandControl& command_control) {
   auto shard = ShardByKey(key, command_control);
+  if (near_cache_ && near_cache_->IsTracked(key)) {
+    if (auto value = near_cache_->Get(key)) {
+      return CreateDummyRequest<RequestGet>(
+          std::make_shared<Reply>("get", std::move(*value)));
+    }
+    // The epoch must be taken before the request is sent. The invalidations
+    // are tracked on the master only, a replica may reply with a value whose
+    // invalidation was already delivered.
+    const auto epoch = near_cache_->GetEpoch(key);
+    return CreateNearCacheRequest<RequestGet>(
+        MakeRequest(CmdArgs{"get", key}, shard, true,
+                    GetCommandControl(command_control)),
+        near_cache_, std::move(key), epoch);
+  }
   return CreateRequest<RequestGet>(
       MakeRequest(CmdArgs{"get", std::move(key)}, shard, false,
                   GetCommandControl(command_control)));
@@ -519,21 +551,45 @@ RequestMget ClientImpl::Mget(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestMget>(
         std::make_shared<Reply>("mget", ReplyData::Array{}));
-  const auto shard = ShardByKey(keys.at(0), command_control);
   auto max_chunk_size = CommandControlImpl{command_control}.chunk_size;
   if (max_chunk_size == 0) {
     max_chunk_size = keys.size();
   }
-  auto make_request = [this, shard,
-                       cc = GetCommandControl(command_control)](auto keys) {
+  auto make_request = [this, cc = GetCommandControl(command_control)](
+                          auto keys, size_t shard) {
     return MakeRequest(CmdArgs{"mget", std::move(keys)}, shard, false, cc);
   };
-  if (max_chunk_size >= keys.size()) {
-    return CreateRequest<RequestMget>(make_request(std::move(keys)));
+
+  const auto groups = GroupByShard(keys, command_control);
+  if (groups.size() == 1) {
+    const auto shard = groups.front().shard;
+    if (max_chunk_size >= keys.size()) {
+      return CreateRequest<RequestMget>(make_request(std::move(keys), shard));
+    }
+    return CreateAggregateRequest<RequestMget>(MakeRequestChunks(
+        max_chunk_size, std::move(keys), [&make_request, shard](auto keys) {
+          return make_request(std::move(keys), shard);
+        }));
+  }
+
+  // Keys belong to different shards (or hash slots in cluster mode): send a
+  // separate MGET to each of them and restore the original order of replies.
+  std::vector<USERVER_NAMESPACE::redis::Request> requests;
+  std::vector<std::vector<size_t>> positions;
+  for (const auto& group : groups) {
+    const auto& group_positions = group.positions;
+    for (size_t begin = 0; begin < group_positions.size();
+         begin += max_chunk_size) {
+      const auto end = std::min(begin + max_chunk_size, group_positions.size());
+      std::vector<size_t> chunk_positions(group_positions.begin() + begin,
+                                          group_positions.begin() + end);
+      requests.push_back(
+          make_request(TakeByPositions(keys, chunk_positions), group.shard));
+      positions.push_back(std::move(chunk_positions));
+    }
   }
-  return CreateAggregateRequest<RequestMget>(MakeRequestChunks(
-      max_chunk_size, std::move(keys),
-      [&make_request](auto keys) { return make_request(std::move(keys)); }));
+  return CreateScatteredRequest<RequestMget>(std::move(requests),
+                                             std::move(positions));
 }
 
 RequestMset ClientImpl::Mset(
@@ -543,10 +599,8 @@ RequestMset ClientImpl::Mset(
     return CreateDummyRequest<RequestMset>(
         std::make_shared<USERVER_NAMESPACE::redis::Reply>(
             "mset", USERVER_NAMESPACE::redis::ReplyData::CreateStatus("OK")));
-  auto shard = ShardByKey(key_values.at(0).first, command_control);
-  return CreateRequest<RequestMset>(
-      MakeRequest(CmdArgs{"mset", std::move(key_values)}, shard, true,
-                  GetCommandControl(command_control)));
+  return MakeMultiKeyRequest<RequestMset>("mset", std::move(key_values), true,
+                                          command_control);
 }
 
 TransactionPtr ClientImpl::Multi() {
@@ -1133,6 +1187,55 @@ size_t ClientImpl::ShardByKey(const std::string& key,
   return cc.force_shard_idx.value_or(ShardByKey(key));
 }
 
+template <typename T>
+std::vector<ClientImpl::ShardPositions> ClientImpl::GroupByShard(
+    const std::vector<T>& args, const CommandControl& cc) const {
+  UASSERT(!args.empty());
+  if (force_shard_idx_ || cc.force_shard_idx) {
+    std::vector<size_t> positions(args.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    return {{ShardByKey(GetKey(args.front()), cc), std::move(positions)}};
+  }
+
+  // In cluster mode multi-key commands are allowed only for keys from the same
+  // hash slot, so the keys are grouped by slots rather than by shards.
+  const bool cluster_mode = IsInClusterMode();
+  std::vector<ShardPositions> groups;
+  std::unordered_map<size_t, size_t> group_by_route;
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto& key = GetKey(args[i]);
+    const auto shard = ShardByKey(key);
+    const auto route =
+        cluster_mode ? USERVER_NAMESPACE::redis::HashSlot(key) : shard;
+    const auto [it, inserted] = group_by_route.emplace(route, groups.size());
+    if (inserted) groups.push_back({shard, {}});
+    groups[it->second].positions.push_back(i);
+  }
+  return groups;
+}
+
+template <typename RequestType, typename T>
+RequestType ClientImpl::MakeMultiKeyRequest(
+    const char* command, std::vector<T>&& args, bool master,
+    const CommandControl& command_control) {
+  const auto groups = GroupByShard(args, command_control);
+  const auto cc = GetCommandControl(command_control);
+  if (groups.size() == 1) {
+    return CreateRequest<RequestType>(
+        MakeRequest(CmdArgs{command, std::move(args)}, groups.front().shard,
+                    master, cc));
+  }
+
+  std::vector<USERVER_NAMESPACE::redis::Request> requests;
+  requests.reserve(groups.size());
+  for (const auto& group : groups) {
+    requests.push_back(
+        MakeRequest(CmdArgs{command, TakeByPositions(args, group.positions)},
+                    group.shard, master, cc));
+  }
+  return CreateAggregateRequest<RequestType>(std::move(requests));
+}
+
 void ClientImpl::CheckShard(size_t shard, const CommandControl& cc) const {
   DoCheckShard(shard, force_shard_idx_);
   DoCheckShard(shard, cc.force_shard_idx);
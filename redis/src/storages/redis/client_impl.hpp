@@ -23,6 +23,7 @@ class Sentinel;
 
 namespace storages::redis {
 
+class NearCache;
 class TransactionImpl;
 
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
@@ -31,7 +32,8 @@ class ClientImpl final : public Client,
  public:
   explicit ClientImpl(
       std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-      std::optional<size_t> force_shard_idx = std::nullopt);
+      std::optional<size_t> force_shard_idx = std::nullopt,
+      std::shared_ptr<NearCache> near_cache = nullptr);
 
   void WaitConnectedOnce(
       USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) override;
@@ -463,6 +465,24 @@ class ClientImpl final : public Client,
     return requests;
   }
 
+  struct ShardPositions {
+    size_t shard;
+    std::vector<size_t> positions;
+  };
+
+  // Splits the positions of `args` into groups of keys that may be sent to
+  // Redis within a single multi-key command.
+  template <typename T>
+  std::vector<ShardPositions> GroupByShard(const std::vector<T>& args,
+                                           const CommandControl& cc) const;
+
+  // Makes a multi-key command, splitting it into per shard commands if the
+  // keys belong to different shards.
+  template <typename RequestType, typename T>
+  RequestType MakeMultiKeyRequest(const char* command, std::vector<T>&& args,
+                                  bool master,
+                                  const CommandControl& command_control);
+
   CommandControl GetCommandControl(const CommandControl& cc) const;
 
   size_t GetPublishShard(
@@ -476,6 +496,7 @@ class ClientImpl final : public Client,
   std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> redis_client_;
   std::atomic<int> publish_shard_{0};
   const std::optional<size_t> force_shard_idx_;
+  const std::shared_ptr<NearCache> near_cache_;
 };
 
 }  // namespace storages::redis
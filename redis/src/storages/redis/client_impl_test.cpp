@@ -0,0 +1,74 @@
+#include <storages/redis/client_impl.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+#include <storages/redis/impl/server_common_sentinel_test.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kShardCount = 2;
+
+// Finds a key for each of the shards
+std::vector<std::string> MakeKeyPerShard(
+    const storages::redis::ClientImpl& client) {
+  std::vector<std::string> keys(client.ShardsCount());
+  std::size_t found = 0;
+  for (std::size_t i = 0; found < keys.size(); ++i) {
+    auto key = "key" + std::to_string(i);
+    auto& shard_key = keys[client.ShardByKey(key)];
+    if (shard_key.empty()) {
+      shard_key = std::move(key);
+      ++found;
+    }
+  }
+  return keys;
+}
+
+}  // namespace
+
+UTEST(RedisClient, MultiKeyCommandsSplitBetweenShards) {
+  SentinelShardTest sentinel_test(1, kShardCount);
+  for (std::size_t shard = 0; shard < kShardCount; ++shard) {
+    ASSERT_TRUE(sentinel_test.Master(shard).WaitForFirstPingReply(kSmallPeriod));
+  }
+  const auto client = std::make_shared<storages::redis::ClientImpl>(
+      sentinel_test.SentinelClientPtr());
+  ASSERT_EQ(client->ShardsCount(), kShardCount);
+
+  const auto keys = MakeKeyPerShard(*client);
+  std::vector<MockRedisServer::HandlerPtr> handlers;
+  for (std::size_t shard = 0; shard < kShardCount; ++shard) {
+    auto& master = sentinel_test.Master(shard);
+    handlers.push_back(master.RegisterHandlerWithConstReply(
+        "MGET", {keys[shard]},
+        redis::ReplyData::Array{
+            redis::ReplyData{"value" + std::to_string(shard)}}));
+    handlers.push_back(
+        master.RegisterHandlerWithConstReply("DEL", {keys[shard]}, 1));
+  }
+
+  // The keys of the last shard go first, the replies keep the order of keys
+  const std::vector<std::string> request_keys{keys.rbegin(), keys.rend()};
+  storages::redis::CommandControl cc;
+  cc.force_request_to_master = true;
+
+  const auto values = client->Mget(request_keys, cc).Get();
+  ASSERT_EQ(values.size(), kShardCount);
+  EXPECT_EQ(values[0], std::optional<std::string>{"value1"});
+  EXPECT_EQ(values[1], std::optional<std::string>{"value0"});
+
+  EXPECT_EQ(client->Del(request_keys, cc).Get(), kShardCount);
+
+  for (const auto& handler : handlers) {
+    EXPECT_EQ(handler->GetReplyCount(), 1);
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <userver/storages/redis/component.hpp>
 
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
@@ -7,6 +8,7 @@
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
+#include <userver/engine/task/task_base.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/storages/redis/impl/thread_pools.hpp>
@@ -29,6 +31,7 @@
 #include <storages/redis/impl/subscribe_sentinel.hpp>
 
 #include "client_impl.hpp"
+#include "near_cache.hpp"
 #include "redis_secdist.hpp"
 #include "subscribe_client_impl.hpp"
 #include "userver/storages/redis/impl/base.hpp"
@@ -73,6 +76,8 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  bool socket_connection{false};
+  std::optional<storages::redis::NearCacheSettings> near_cache;
 };
 
 RedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -83,9 +88,40 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  config.socket_connection = value["socket_connection"].As<bool>(false);
+  config.near_cache =
+      value["near_cache"]
+          .As<std::optional<storages::redis::NearCacheSettings>>();
   return config;
 }
 
+std::shared_ptr<storages::redis::NearCache> CreateNearCache(
+    const std::shared_ptr<redis::ThreadPools>& thread_pools,
+    const USERVER_NAMESPACE::secdist::RedisSettings& settings,
+    const RedisGroup& redis_group, dynamic_config::Source config_source,
+    const redis::CommandControl& cc,
+    const testsuite::RedisControl& testsuite_redis_control) {
+  if (USERVER_NAMESPACE::redis::IsClusterStrategy(
+          redis_group.sharding_strategy)) {
+    throw std::runtime_error(
+        "near_cache is not supported in cluster mode, db=" + redis_group.db);
+  }
+
+  auto near_cache = std::make_shared<storages::redis::NearCache>(
+      *redis_group.near_cache, settings.shards.size());
+  // The cache owns the sentinel, so the callback never outlives it
+  auto ready_callback = [cache = near_cache.get()](
+                            size_t shard, const std::string&, bool ready) {
+    cache->OnShardReadyChange(shard, ready);
+  };
+  near_cache->StartTracking(redis::SubscribeSentinel::Create(
+      thread_pools, settings, redis_group.config_name, config_source,
+      redis_group.db, std::move(ready_callback), false, cc,
+      testsuite_redis_control,
+      redis::ClientTrackingSettings{redis_group.near_cache->prefixes}));
+  return near_cache;
+}
+
 struct SubscribeRedisGroup {
   std::string db;
   std::string config_name;
@@ -221,14 +257,43 @@ void Redis::Connect(const ComponentConfig& config,
     redis::CommandControl cc{};
     cc.allow_reads_from_master = redis_group.allow_reads_from_master;
 
+    engine::TaskProcessor* socket_connection_task_processor = nullptr;
+    if (redis_group.socket_connection) {
+      if (USERVER_NAMESPACE::redis::IsClusterStrategy(
+              redis_group.sharding_strategy)) {
+        throw std::runtime_error(
+            "socket_connection is not supported in cluster mode, db=" +
+            redis_group.db);
+      }
+      if (redis_group.near_cache) {
+        throw std::runtime_error(
+            "socket_connection is not supported with near_cache, db=" +
+            redis_group.db);
+      }
+      if (settings.secure_connection != redis::ConnectionSecurity::kNone) {
+        throw std::runtime_error(
+            "socket_connection is not supported with secure_connection, db=" +
+            redis_group.db);
+      }
+      socket_connection_task_processor =
+          &engine::current_task::GetTaskProcessor();
+    }
+
     auto sentinel = redis::Sentinel::CreateSentinel(
         thread_pools_, settings, redis_group.config_name, config_source,
         redis_group.db, redis::KeyShardFactory{redis_group.sharding_strategy},
-        cc, testsuite_redis_control);
+        cc, testsuite_redis_control, socket_connection_task_processor);
     if (sentinel) {
       sentinels_.emplace(redis_group.db, sentinel);
-      const auto& client =
-          std::make_shared<storages::redis::ClientImpl>(sentinel);
+      std::shared_ptr<storages::redis::NearCache> near_cache;
+      if (redis_group.near_cache) {
+        near_cache = CreateNearCache(thread_pools_, settings, redis_group,
+                                     config_source, cc,
+                                     testsuite_redis_control);
+        near_caches_.emplace(redis_group.db, near_cache);
+      }
+      const auto& client = std::make_shared<storages::redis::ClientImpl>(
+          sentinel, std::nullopt, std::move(near_cache));
       clients_.emplace(redis_group.db, client);
     } else {
       LOG_WARNING() << "skip redis client for " << redis_group.db;
@@ -287,6 +352,10 @@ void Redis::WriteStatistics(utils::statistics::Writer& writer) {
     writer.ValueWithLabels(redis->GetStatistics(*settings),
                            {"redis_database", name});
   }
+  for (const auto& [name, near_cache] : near_caches_) {
+    writer["near_cache"].ValueWithLabels(*near_cache,
+                                         {"redis_database", name});
+  }
   auto threads_writer = writer["ev_threads"]["cpu_load_percent"];
   DumpThreadPoolMetric(threads_writer, *thread_pools_->GetRedisThreadPool());
   DumpThreadPoolMetric(threads_writer, thread_pools_->GetSentinelThreadPool());
@@ -386,6 +455,30 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                socket_connection:
+                    type: boolean
+                    description: serve the connections by coroutines of the component task processor instead of hiredis on the redis threads; not supported in cluster mode, with near_cache or with secure_connection
+                    defaultDescription: false
+                near_cache:
+                    type: object
+                    description: cache GET replies in process, invalidated by the server via CLIENT TRACKING
+                    additionalProperties: false
+                    properties:
+                        max_size:
+                            type: integer
+                            description: maximum number of cached keys
+                            minimum: 1
+                        max_value_size:
+                            type: integer
+                            description: values larger than this are not cached
+                            defaultDescription: 4096
+                        prefixes:
+                            type: array
+                            description: cache only keys with these prefixes
+                            defaultDescription: all keys are cached
+                            items:
+                                type: string
+                                description: key prefix
     metrics_level:
         type: string
         description: set metrics detail level
@@ -4,7 +4,6 @@
 
 #include <fmt/format.h>
 #include <boost/container_hash/hash.hpp>
-#include <boost/crc.hpp>
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -63,15 +62,6 @@ using NodesAddressesSet =
     std::unordered_set<NodeAddresses, NodeAddressesHasher>;
 using HostPort = std::string;
 
-size_t HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
-
 std::string ParseMovedShard(const std::string& err_string) {
   static const auto kUnknownShard = std::string("");
   size_t pos = err_string.find(' ');  // skip "MOVED" or "ASK"
@@ -1041,6 +1031,17 @@ void ClusterSentinelImpl::SetCommandsBufferingSettings(
   }
 }
 
+void ClusterSentinelImpl::SetClientTrackingSettings(
+    const ClientTrackingSettings& /*client_tracking_settings*/) {
+  throw std::runtime_error("Client tracking is not supported in cluster mode");
+}
+
+void ClusterSentinelImpl::SetSocketConnectionTaskProcessor(
+    engine::TaskProcessor& /*task_processor*/) {
+  throw std::runtime_error(
+      "Socket connections are not supported in cluster mode");
+}
+
 void ClusterSentinelImpl::SetReplicationMonitoringSettings(
     const ReplicationMonitoringSettings& monitoring_settings) {
   if (topology_holder_) {
@@ -72,6 +72,10 @@ class ClusterSentinelImpl : public SentinelImplBase {
       override;
   void SetRetryBudgetSettings(
       const utils::RetryBudgetSettings& settings) override;
+  void SetClientTrackingSettings(
+      const ClientTrackingSettings& client_tracking_settings) override;
+  void SetSocketConnectionTaskProcessor(
+      engine::TaskProcessor& task_processor) override;
   PublishSettings GetPublishSettings() override;
 
   static size_t GetClusterSlotsCalledCounter();
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,7 @@
 #include <storages/redis/impl/ev_wrapper.hpp>
 #include <storages/redis/impl/redis_info.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
+#include <storages/redis/impl/socket_redis_impl.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
 
@@ -233,7 +235,9 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   void ProcessCommand(const CommandPtr& command);
 
   void Authenticate();
+  void OnAuthenticated();
   void SendReadOnly();
+  void SendClientTracking();
   void FreeCommands();
 
   static void LogSocketErrorReply(const CommandPtr& command,
@@ -292,6 +296,7 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   std::atomic_bool forbid_requests_to_syncing_replicas_ = false;
   const bool send_readonly_;
   const ConnectionSecurity connection_security_;
+  const std::optional<ClientTrackingSettings> client_tracking_;
   std::chrono::milliseconds ping_interval_{2000};
   std::chrono::milliseconds ping_timeout_{4000};
   std::chrono::milliseconds info_replication_interval_{2000};
@@ -323,11 +328,24 @@ std::string_view StateToString(RedisState state) {
 Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
              const RedisCreationSettings& redis_settings)
     : thread_control_(thread_pool->NextThread()) {
+  if (redis_settings.socket_connection_task_processor) {
+    UASSERT_MSG(
+        !redis_settings.send_readonly && !redis_settings.client_tracking,
+        "Not supported by socket connections");
+    socket_impl_ = std::make_shared<SocketRedisImpl>(
+        *redis_settings.socket_connection_task_processor, *this);
+    return;
+  }
   impl_ = std::make_shared<RedisImpl>(thread_pool, thread_control_, *this,
                                       redis_settings);
 }
 
 Redis::~Redis() {
+  if (socket_impl_) {
+    socket_impl_->Disconnect();
+    socket_impl_->ResetRedisObj();
+    return;
+  }
   thread_control_.RunInEvLoopBlocking([this]() {
     impl_->Disconnect();
     impl_->ResetRedisObj();
@@ -337,50 +355,88 @@ Redis::~Redis() {
 
 void Redis::Connect(const ConnectionInfo::HostVector& host_addrs, int port,
                     const Password& password) {
+  if (socket_impl_) return socket_impl_->Connect(host_addrs, port, password);
   impl_->Connect(host_addrs, port, password);
 }
 
 bool Redis::AsyncCommand(const CommandPtr& command) {
+  if (socket_impl_) return socket_impl_->AsyncCommand(command);
   return impl_->AsyncCommand(command);
 }
 
-Redis::State Redis::GetState() const { return impl_->GetState(); }
+Redis::State Redis::GetState() const {
+  if (socket_impl_) return socket_impl_->GetState();
+  return impl_->GetState();
+}
 
 const Statistics& Redis::GetStatistics() const {
+  if (socket_impl_) return socket_impl_->GetStatistics();
   return impl_->GetStatistics();
 }
 
-ServerId Redis::GetServerId() const { return impl_->GetServerId(); }
+ServerId Redis::GetServerId() const {
+  if (socket_impl_) return socket_impl_->GetServerId();
+  return impl_->GetServerId();
+}
 
-size_t Redis::GetRunningCommands() const { return impl_->GetRunningCommands(); }
+size_t Redis::GetRunningCommands() const {
+  if (socket_impl_) return socket_impl_->GetRunningCommands();
+  return impl_->GetRunningCommands();
+}
 
 std::chrono::milliseconds Redis::GetPingLatency() const {
+  if (socket_impl_) return socket_impl_->GetPingLatency();
   return impl_->GetPingLatency();
 }
 
-bool Redis::IsDestroying() const { return impl_->IsDestroying(); }
+bool Redis::IsDestroying() const {
+  if (socket_impl_) return socket_impl_->IsDestroying();
+  return impl_->IsDestroying();
+}
 
-bool Redis::IsSyncing() const { return impl_->IsSyncing(); }
+bool Redis::IsSyncing() const {
+  if (socket_impl_) return socket_impl_->IsSyncing();
+  return impl_->IsSyncing();
+}
 
-bool Redis::IsAvailable() const { return impl_->IsAvailable(); }
+bool Redis::IsAvailable() const {
+  if (socket_impl_) return socket_impl_->IsAvailable();
+  return impl_->IsAvailable();
+}
 
-bool Redis::CanRetry() const { return impl_->CanRetry(); }
+bool Redis::CanRetry() const {
+  if (socket_impl_) return socket_impl_->CanRetry();
+  return impl_->CanRetry();
+}
 
-std::string Redis::GetServerHost() const { return impl_->GetHost(); }
+std::string Redis::GetServerHost() const {
+  if (socket_impl_) return socket_impl_->GetHost();
+  return impl_->GetHost();
+}
 
-uint16_t Redis::GetServerPort() const { return impl_->GetPort(); }
+uint16_t Redis::GetServerPort() const {
+  if (socket_impl_) return socket_impl_->GetPort();
+  return impl_->GetPort();
+}
 
 void Redis::SetCommandsBufferingSettings(
     CommandsBufferingSettings commands_buffering_settings) {
+  // Socket connections always write all the queued commands at once
+  if (socket_impl_) return;
   impl_->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
 void Redis::SetRetryBudgetSettings(const utils::RetryBudgetSettings& settings) {
+  if (socket_impl_) return socket_impl_->SetRetryBudgetSettings(settings);
   impl_->SetRetryBudgetSettings(settings);
 }
 
 void Redis::SetReplicationMonitoringSettings(
     const ReplicationMonitoringSettings& replication_monitoring_settings) {
+  if (socket_impl_) {
+    return socket_impl_->SetReplicationMonitoringSettings(
+        replication_monitoring_settings);
+  }
   impl_->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
@@ -393,6 +449,7 @@ Redis::RedisImpl::RedisImpl(
       thread_pool_(thread_pool),
       send_readonly_(redis_settings.send_readonly),
       connection_security_(redis_settings.connection_security),
+      client_tracking_(redis_settings.client_tracking),
       server_id_(ServerId::Generate()),
       retry_budget_(utils::RetryBudgetSettings{100, 0.1, false}) {
   SetCommandsBufferingSettings(CommandsBufferingSettings{});
@@ -939,6 +996,9 @@ void Redis::RedisImpl::CommandLoopImpl() {
     std::swap(commands_, commands);
   }
   LOG_TRACE() << "commands size=" << commands.size();
+  // All the commands of the batch are written to the socket within a single
+  // ev-loop iteration, i.e. pipelined.
+  if (!commands.empty()) statistics_.AccountCommandsBatch(commands.size());
   for (auto& command : commands) {
     ProcessCommand(command);
   }
@@ -1040,19 +1100,13 @@ bool Redis::RedisImpl::InitSecureConnection() {
 
 void Redis::RedisImpl::Authenticate() {
   if (password_.GetUnderlying().empty()) {
-    if (send_readonly_)
-      SendReadOnly();
-    else
-      SetState(State::kConnected);
+    OnAuthenticated();
   } else {
     ProcessCommand(PrepareCommand(
         CmdArgs{"AUTH", password_.GetUnderlying()},
         [this](const CommandPtr&, ReplyPtr reply) {
           if (*reply && reply->data.IsStatus()) {
-            if (send_readonly_)
-              SendReadOnly();
-            else
-              SetState(State::kConnected);
+            OnAuthenticated();
           } else {
             if (*reply) {
               if (reply->IsUnknownCommandError()) {
@@ -1078,6 +1132,15 @@ void Redis::RedisImpl::Authenticate() {
   }
 }
 
+void Redis::RedisImpl::OnAuthenticated() {
+  if (send_readonly_)
+    SendReadOnly();
+  else if (client_tracking_)
+    SendClientTracking();
+  else
+    SetState(State::kConnected);
+}
+
 void Redis::RedisImpl::SendReadOnly() {
   LOG_DEBUG() << "Send READONLY command to slave "
               << GetServerId().GetDescription() << " in cluster mode";
@@ -1101,6 +1164,46 @@ void Redis::RedisImpl::SendReadOnly() {
   }));
 }
 
+void Redis::RedisImpl::SendClientTracking() {
+  UASSERT(client_tracking_);
+  // RESP2 clients receive invalidation messages only via redirection, so the
+  // connection redirects them to itself and gets them as `__redis__:invalidate`
+  // pubsub messages after subscribing to that channel.
+  ProcessCommand(PrepareCommand(
+      CmdArgs{"CLIENT", "ID"}, [this](const CommandPtr&, ReplyPtr reply) {
+        if (!*reply || !reply->data.IsInt()) {
+          LOG_LIMITED_ERROR()
+              << log_extra_ << "CLIENT ID failed: status=" << reply->status
+              << " msg="
+              << (*reply ? reply->data.ToDebugString() : reply->status_string);
+          Disconnect();
+          return;
+        }
+
+        CmdArgs::CmdArgsArray prefixes;
+        prefixes.reserve(client_tracking_->prefixes.size() * 2);
+        for (const auto& prefix : client_tracking_->prefixes) {
+          prefixes.emplace_back("PREFIX");
+          prefixes.push_back(prefix);
+        }
+        ProcessCommand(PrepareCommand(
+            CmdArgs{"CLIENT", "TRACKING", "ON", "REDIRECT",
+                    reply->data.GetInt(), "BCAST", prefixes},
+            [this](const CommandPtr&, ReplyPtr reply) {
+              if (*reply && reply->data.IsStatus()) {
+                SetState(State::kConnected);
+                return;
+              }
+              LOG_LIMITED_ERROR() << log_extra_
+                                  << "CLIENT TRACKING failed: status="
+                                  << reply->status << " msg="
+                                  << (*reply ? reply->data.ToDebugString()
+                                             : reply->status_string);
+              Disconnect();
+            }));
+      }));
+}
+
 void Redis::RedisImpl::OnRedisReply(redisAsyncContext* c, void* r,
                                     void* privdata) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(c->data);
@@ -20,6 +20,7 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
+class SocketRedisImpl;
 class Statistics;
 
 class Redis {
@@ -63,7 +64,9 @@ class Redis {
  private:
   class RedisImpl;
   engine::ev::ThreadControl thread_control_;
+  // Exactly one of the implementations is set
   std::shared_ptr<RedisImpl> impl_;
+  std::shared_ptr<SocketRedisImpl> socket_impl_;
 };
 
 template <typename Rep, typename Period>
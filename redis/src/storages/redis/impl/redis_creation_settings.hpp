@@ -1,16 +1,42 @@
 #pragma once
 
+#include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/storages/redis/impl/base.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
+/// Server-assisted client side caching: the connection enables
+/// `CLIENT TRACKING` in broadcasting mode redirected to itself, so after
+/// subscribing to `__redis__:invalidate` it receives keys modified by anyone.
+/// The subscriptions of such a shard are kept on the master, the reads that
+/// rely on the invalidations must be sent to the master too.
+struct ClientTrackingSettings {
+  /// Only keys starting with one of the prefixes are tracked, all keys are
+  /// tracked if empty
+  std::vector<std::string> prefixes;
+};
+
+/// Channel to subscribe to for invalidation messages. Invalidation of all
+/// keys is not delivered to the subscribers, see
+/// SubscribeSentinel::SetClientTrackingResetCallback().
+inline constexpr std::string_view kClientTrackingInvalidateChannel =
+    "__redis__:invalidate";
+
 struct RedisCreationSettings {
   ConnectionSecurity connection_security = ConnectionSecurity::kNone;
   bool send_readonly{false};
+  std::optional<ClientTrackingSettings> client_tracking;
+  /// If set, the connection is served by redis::SocketConnection from the
+  /// coroutines of this task processor instead of hiredis on the ev threads
+  engine::TaskProcessor* socket_connection_task_processor{nullptr};
 };
 
 }  // namespace redis
@@ -164,6 +164,10 @@ void Statistics::AccountCommandSent(const CommandPtr& cmd) {
   }
 }
 
+void Statistics::AccountCommandsBatch(size_t commands_count) {
+  commands_batch_size_percentile.GetCurrentCounter().Account(commands_count);
+}
+
 void Statistics::AccountReplyReceived(const ReplyPtr& reply,
                                       const CommandPtr& cmd) {
   reply_size_percentile.GetCurrentCounter().Account(reply->data.GetSize());
@@ -209,6 +213,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   if (stats.settings.IsRequestSizesEnabled()) {
     writer["request_sizes"] = stats.request_size_percentile;
   }
+  writer["commands_batch_sizes"] = stats.commands_batch_size_percentile;
   if (stats.settings.IsReplySizesEnabled()) {
     writer["reply_sizes"] = stats.reply_size_percentile;
   }
@@ -31,6 +31,7 @@ class Statistics {
 
   void AccountStateChanged(RedisState new_state);
   void AccountCommandSent(const CommandPtr& cmd);
+  void AccountCommandsBatch(size_t commands_count);
   void AccountReplyReceived(const ReplyPtr& reply, const CommandPtr& cmd);
   void AccountPing(std::chrono::milliseconds ping);
   void AccountError(ReplyStatus code);
@@ -45,6 +46,7 @@ class Statistics {
   std::atomic<std::chrono::milliseconds> session_start_time{};
   RecentPeriod request_size_percentile;
   RecentPeriod reply_size_percentile;
+  RecentPeriod commands_batch_size_percentile;
   RecentPeriod timings_percentile;
   std::unordered_map<std::string_view, RecentPeriod> command_timings_percentile;
   std::atomic_llong last_ping_ms{};
@@ -65,6 +67,8 @@ struct InstanceStatistics {
         other.session_start_time.load(std::memory_order_relaxed);
     request_size_percentile = other.request_size_percentile.GetStatsForPeriod();
     reply_size_percentile = other.reply_size_percentile.GetStatsForPeriod();
+    commands_batch_size_percentile =
+        other.commands_batch_size_percentile.GetStatsForPeriod();
     timings_percentile = other.timings_percentile.GetStatsForPeriod();
     last_ping_ms = other.last_ping_ms.load(std::memory_order_relaxed);
     is_syncing = other.is_syncing.load(std::memory_order_relaxed);
@@ -83,6 +87,7 @@ struct InstanceStatistics {
     reconnects += other.reconnects;
     request_size_percentile.Add(other.request_size_percentile);
     reply_size_percentile.Add(other.reply_size_percentile);
+    commands_batch_size_percentile.Add(other.commands_batch_size_percentile);
     timings_percentile.Add(other.timings_percentile);
 
     for (size_t i = 0; i < error_count.size(); i++)
@@ -98,6 +103,7 @@ struct InstanceStatistics {
   std::chrono::milliseconds session_start_time{};
   Statistics::Percentile request_size_percentile;
   Statistics::Percentile reply_size_percentile;
+  Statistics::Percentile commands_batch_size_percentile;
   Statistics::Percentile timings_percentile;
   std::unordered_map<std::string, Statistics::Percentile>
       command_timings_percentile;
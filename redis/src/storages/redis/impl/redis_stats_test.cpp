@@ -0,0 +1,32 @@
+#include <storages/redis/impl/redis_stats.hpp>
+
+#include <userver/utest/assert_macros.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(RedisStatistics, CommandsBatchSizesWithoutRequestSizes) {
+  redis::MetricsSettings settings;
+  ASSERT_FALSE(settings.IsRequestSizesEnabled());
+
+  redis::InstanceStatistics stats{settings};
+  stats.commands_batch_size_percentile.Account(3);
+
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "redis", [&stats](utils::statistics::Writer& writer) {
+        redis::DumpMetric(writer, stats);
+      });
+
+  const utils::statistics::Snapshot snapshot{storage, "redis"};
+  EXPECT_EQ(snapshot
+                .SingleMetric("commands_batch_sizes", {{"percentile", "p100"}})
+                .AsInt(),
+            3);
+  UEXPECT_THROW(snapshot.SingleMetric("request_sizes"),
+                utils::statistics::MetricQueryError);
+}
+
+USERVER_NAMESPACE_END
@@ -57,6 +57,13 @@ ReplyData::ReplyData(std::string s)
 
 ReplyData::ReplyData(int value) : type_(Type::kInteger), integer_(value) {}
 
+ReplyData ReplyData::CreateInteger(int64_t value) {
+  ReplyData data;
+  data.type_ = Type::kInteger;
+  data.integer_ = value;
+  return data;
+}
+
 ReplyData ReplyData::CreateError(std::string&& error_msg) {
   ReplyData data(std::move(error_msg));
   data.type_ = Type::kError;
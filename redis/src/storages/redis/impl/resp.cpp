@@ -0,0 +1,152 @@
+#include <storages/redis/impl/resp.hpp>
+
+#include <algorithm>
+#include <charconv>
+
+#include <fmt/format.h>
+
+#include <userver/storages/redis/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+namespace {
+
+constexpr std::string_view kCrlf = "\r\n";
+
+// Do not keep already parsed data in the buffer if it takes more than that
+constexpr size_t kCompactThreshold = 4096;
+
+// Array size comes from the network, do not trust it too much
+constexpr int64_t kMaxReserve = 1024;
+
+int64_t ParseInteger(std::string_view line) {
+  int64_t value = 0;
+  const auto* end = line.data() + line.size();
+  const auto [ptr, ec] = std::from_chars(line.data(), end, value);
+  if (ec != std::errc{} || ptr != end) {
+    throw ParseReplyException(
+        fmt::format("Invalid integer in RESP reply: '{}'", line));
+  }
+  return value;
+}
+
+void AppendBulkString(std::string& out, std::string_view str) {
+  out += '$';
+  out += std::to_string(str.size());
+  out += kCrlf;
+  out += str;
+  out += kCrlf;
+}
+
+}  // namespace
+
+void AppendRespCommand(std::string& out, const CmdArgs::CmdArgsArray& args) {
+  out += '*';
+  out += std::to_string(args.size());
+  out += kCrlf;
+  for (const auto& arg : args) AppendBulkString(out, arg);
+}
+
+void RespParser::Feed(std::string_view data) {
+  if (pos_ == buffer_.size()) {
+    buffer_.clear();
+    pos_ = 0;
+    line_scan_pos_ = 0;
+  } else if (pos_ > kCompactThreshold) {
+    buffer_.erase(0, pos_);
+    line_scan_pos_ -= std::min(line_scan_pos_, pos_);
+    pos_ = 0;
+  }
+  buffer_.append(data);
+}
+
+std::optional<ReplyData> RespParser::Next() {
+  while (true) {
+    std::optional<ReplyData> value;
+    if (!ParseValue(value)) return std::nullopt;
+    if (!value) continue;
+
+    while (!arrays_.empty()) {
+      auto& array = arrays_.back();
+      array.elements.push_back(std::move(*value));
+      if (array.elements.size() < array.size) break;
+      value = ReplyData{std::move(array.elements)};
+      arrays_.pop_back();
+    }
+    if (arrays_.empty()) return value;
+  }
+}
+
+bool RespParser::ReadLine(size_t& pos, std::string_view& line) {
+  const auto end = buffer_.find(kCrlf, std::max(pos, line_scan_pos_));
+  if (end == std::string::npos) {
+    // The last byte may be the first half of CRLF
+    line_scan_pos_ = buffer_.size() - 1;
+    return false;
+  }
+  line = std::string_view{buffer_}.substr(pos, end - pos);
+  pos = end + kCrlf.size();
+  return true;
+}
+
+bool RespParser::ParseValue(std::optional<ReplyData>& value) {
+  if (pos_ >= buffer_.size()) return false;
+
+  auto pos = pos_;
+  const auto type = buffer_[pos++];
+  std::string_view line;
+  if (!ReadLine(pos, line)) return false;
+
+  switch (type) {
+    case '+':
+      value = ReplyData::CreateStatus(std::string{line});
+      break;
+    case '-':
+      value = ReplyData::CreateError(std::string{line});
+      break;
+    case ':':
+      value = ReplyData::CreateInteger(ParseInteger(line));
+      break;
+    case '$': {
+      const auto size = ParseInteger(line);
+      if (size < 0) {
+        value = ReplyData::CreateNil();
+        break;
+      }
+      // Only the header is parsed again until the whole string is received
+      if (buffer_.size() - pos < static_cast<size_t>(size) + kCrlf.size()) {
+        return false;
+      }
+      value = ReplyData{buffer_.substr(pos, size)};
+      pos += size + kCrlf.size();
+      break;
+    }
+    case '*': {
+      const auto size = ParseInteger(line);
+      if (size < 0) {
+        value = ReplyData::CreateNil();
+      } else if (size == 0) {
+        value = ReplyData{ReplyData::Array{}};
+      } else {
+        PartialArray array;
+        array.elements.reserve(std::min<int64_t>(size, kMaxReserve));
+        array.size = static_cast<size_t>(size);
+        arrays_.push_back(std::move(array));
+      }
+      break;
+    }
+    default:
+      throw ParseReplyException(
+          fmt::format("Unexpected RESP reply type '{}'", type));
+  }
+
+  pos_ = pos;
+  line_scan_pos_ = 0;
+  return true;
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
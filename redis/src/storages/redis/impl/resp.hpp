@@ -0,0 +1,52 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// Appends the command in RESP format (array of bulk strings) to `out`
+void AppendRespCommand(std::string& out, const CmdArgs::CmdArgsArray& args);
+
+/// Incremental parser of RESP2 replies. The parsed values and the arrays
+/// that are not received completely are kept between the calls, so the
+/// received bytes are parsed only once.
+class RespParser final {
+ public:
+  /// Appends the received bytes
+  void Feed(std::string_view data);
+
+  /// Returns the next complete reply or std::nullopt if more data is needed.
+  /// @throws ParseReplyException on malformed input, the parser must not be
+  /// used after that.
+  std::optional<ReplyData> Next();
+
+ private:
+  struct PartialArray {
+    ReplyData::Array elements;
+    size_t size{0};
+  };
+
+  // Parses a scalar or an array header at pos_. Returns false if the value is
+  // incomplete, `value` stays empty for the header of a non-empty array.
+  bool ParseValue(std::optional<ReplyData>& value);
+  bool ReadLine(size_t& pos, std::string_view& line);
+
+  std::string buffer_;
+  size_t pos_{0};
+  // Where to continue looking for the end of an incomplete line
+  size_t line_scan_pos_{0};
+  // Arrays being received, the innermost one is the last
+  std::vector<PartialArray> arrays_;
+};
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
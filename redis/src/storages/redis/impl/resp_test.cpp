@@ -0,0 +1,120 @@
+#include <storages/redis/impl/resp.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/storages/redis/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Resp, AppendCommand) {
+  std::string out;
+  redis::AppendRespCommand(out, {"SET", "key", ""});
+  EXPECT_EQ(out, "*3\r\n$3\r\nSET\r\n$3\r\nkey\r\n$0\r\n\r\n");
+}
+
+TEST(Resp, Scalars) {
+  redis::RespParser parser;
+  parser.Feed("+OK\r\n-ERR oops\r\n:-42\r\n$5\r\nhe\r\no\r\n$-1\r\n");
+
+  auto reply = parser.Next();
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(reply->GetStatus(), "OK");
+
+  reply = parser.Next();
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(reply->GetError(), "ERR oops");
+
+  reply = parser.Next();
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(reply->GetInt(), -42);
+
+  reply = parser.Next();
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(reply->GetString(), "he\r\no");
+
+  reply = parser.Next();
+  ASSERT_TRUE(reply);
+  EXPECT_TRUE(reply->IsNil());
+
+  EXPECT_FALSE(parser.Next());
+}
+
+TEST(Resp, NestedArray) {
+  redis::RespParser parser;
+  parser.Feed("*3\r\n$1\r\na\r\n*2\r\n:1\r\n$-1\r\n*0\r\n");
+
+  const auto reply = parser.Next();
+  ASSERT_TRUE(reply);
+  ASSERT_EQ(reply->GetArray().size(), 3U);
+  EXPECT_EQ((*reply)[0].GetString(), "a");
+  EXPECT_EQ((*reply)[1][0].GetInt(), 1);
+  EXPECT_TRUE((*reply)[1][1].IsNil());
+  EXPECT_TRUE((*reply)[2].GetArray().empty());
+}
+
+TEST(Resp, ByteByByte) {
+  const std::string data = "*2\r\n$3\r\nfoo\r\n:7\r\n+PONG\r\n";
+  redis::RespParser parser;
+  std::vector<redis::ReplyData> replies;
+  for (const char c : data) {
+    parser.Feed({&c, 1});
+    while (auto reply = parser.Next()) replies.push_back(std::move(*reply));
+  }
+
+  ASSERT_EQ(replies.size(), 2U);
+  EXPECT_EQ(replies[0][0].GetString(), "foo");
+  EXPECT_EQ(replies[0][1].GetInt(), 7);
+  EXPECT_EQ(replies[1].GetStatus(), "PONG");
+}
+
+TEST(Resp, SplitReplies) {
+  const std::string data = "*3\r\n$5\r\nhello\r\n*1\r\n+OK\r\n:1\r\n";
+  // Every split point, including the ones inside CRLF
+  for (size_t split = 0; split <= data.size(); ++split) {
+    redis::RespParser parser;
+    parser.Feed(std::string_view{data}.substr(0, split));
+    auto reply = parser.Next();
+    if (split < data.size()) {
+      EXPECT_FALSE(reply) << split;
+      parser.Feed(std::string_view{data}.substr(split));
+      reply = parser.Next();
+    }
+    ASSERT_TRUE(reply) << split;
+    EXPECT_EQ((*reply)[0].GetString(), "hello");
+    EXPECT_EQ((*reply)[1][0].GetStatus(), "OK");
+    EXPECT_EQ((*reply)[2].GetInt(), 1);
+    EXPECT_FALSE(parser.Next());
+  }
+}
+
+TEST(Resp, LargeBulkString) {
+  const std::string value(100'000, 'x');
+  const std::string data =
+      "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n+OK\r\n";
+
+  redis::RespParser parser;
+  std::vector<redis::ReplyData> replies;
+  constexpr size_t kChunkSize = 1000;
+  for (size_t pos = 0; pos < data.size(); pos += kChunkSize) {
+    parser.Feed(std::string_view{data}.substr(pos, kChunkSize));
+    while (auto reply = parser.Next()) replies.push_back(std::move(*reply));
+  }
+
+  ASSERT_EQ(replies.size(), 2U);
+  EXPECT_EQ(replies[0].GetString(), value);
+  EXPECT_EQ(replies[1].GetStatus(), "OK");
+}
+
+TEST(Resp, Malformed) {
+  redis::RespParser parser;
+  parser.Feed("?what\r\n");
+  EXPECT_THROW(parser.Next(), redis::ParseReplyException);
+
+  redis::RespParser int_parser;
+  int_parser.Feed(":12a\r\n");
+  EXPECT_THROW(int_parser.Next(), redis::ParseReplyException);
+}
+
+USERVER_NAMESPACE_END
@@ -56,8 +56,19 @@ void OnSubscribeImpl(std::string_view message_type,
                          reply_array[2].GetInt());
   } else if (!strcasecmp(reply_array[0].GetString().c_str(),
                          message_type.data())) {
-    message_callback(reply->server_id, reply_array[1].GetString(),
-                     reply_array[2].GetString());
+    const auto& message = reply_array[2];
+    if (message.IsString()) {
+      message_callback(reply->server_id, reply_array[1].GetString(),
+                       message.GetString());
+    } else if (message.IsArray()) {
+      // Client tracking invalidation of several keys
+      for (const auto& key : message.GetArray()) {
+        if (key.IsString()) {
+          message_callback(reply->server_id, reply_array[1].GetString(),
+                           key.GetString());
+        }
+      }
+    }
   }
 }
 
@@ -126,7 +137,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
     dynamic_config::Source dynamic_config_source,
     const std::string& client_name, KeyShardFactory key_shard_factory,
     const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    engine::TaskProcessor* socket_connection_task_processor) {
   auto ready_callback = [](size_t shard, const std::string& shard_name,
                            bool ready) {
     LOG_INFO() << "redis: ready_callback:"
@@ -136,7 +148,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
   return CreateSentinel(thread_pools, settings, std::move(shard_group_name),
                         dynamic_config_source, client_name,
                         std::move(ready_callback), std::move(key_shard_factory),
-                        command_control, testsuite_redis_control);
+                        command_control, testsuite_redis_control,
+                        socket_connection_task_processor);
 }
 
 std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
@@ -146,7 +159,8 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
     const std::string& client_name,
     Sentinel::ReadyChangeCallback ready_callback,
     KeyShardFactory key_shard_factory, const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    engine::TaskProcessor* socket_connection_task_processor) {
   const auto& password = settings.password;
 
   const std::vector<std::string>& shards = settings.shards;
@@ -177,6 +191,10 @@ std::shared_ptr<Sentinel> Sentinel::CreateSentinel(
         password, settings.secure_connection, std::move(ready_callback),
         dynamic_config_source, std::move(key_shard), command_control,
         testsuite_redis_control);
+    if (socket_connection_task_processor) {
+      client->SetSocketConnectionTaskProcessor(
+          *socket_connection_task_processor);
+    }
     client->Start();
   }
 
@@ -315,6 +333,16 @@ void Sentinel::SetCommandsBufferingSettings(
   return impl_->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void Sentinel::SetClientTrackingSettings(
+    const ClientTrackingSettings& client_tracking_settings) {
+  impl_->SetClientTrackingSettings(client_tracking_settings);
+}
+
+void Sentinel::SetSocketConnectionTaskProcessor(
+    engine::TaskProcessor& task_processor) {
+  impl_->SetSocketConnectionTaskProcessor(task_processor);
+}
+
 void Sentinel::SetReplicationMonitoringSettings(
     const ReplicationMonitoringSettings& replication_monitoring_settings) {
   impl_->SetReplicationMonitoringSettings(replication_monitoring_settings);
@@ -19,6 +19,7 @@
 #include <userver/storages/redis/impl/types.hpp>
 #include <userver/storages/redis/impl/wait_connected_mode.hpp>
 
+#include <storages/redis/impl/redis_creation_settings.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -98,7 +99,8 @@ class Sentinel {
       dynamic_config::Source dynamic_config_source,
       const std::string& client_name, KeyShardFactory key_shard_factory,
       const CommandControl& command_control = {},
-      const testsuite::RedisControl& testsuite_redis_control = {});
+      const testsuite::RedisControl& testsuite_redis_control = {},
+      engine::TaskProcessor* socket_connection_task_processor = nullptr);
   static std::shared_ptr<redis::Sentinel> CreateSentinel(
       const std::shared_ptr<ThreadPools>& thread_pools,
       const secdist::RedisSettings& settings, std::string shard_group_name,
@@ -106,7 +108,8 @@ class Sentinel {
       const std::string& client_name, ReadyChangeCallback ready_callback,
       KeyShardFactory key_shard_factory,
       const CommandControl& command_control = {},
-      const testsuite::RedisControl& testsuite_redis_control = {});
+      const testsuite::RedisControl& testsuite_redis_control = {},
+      engine::TaskProcessor* socket_connection_task_processor = nullptr);
 
   void Restart();
 
@@ -140,6 +143,12 @@ class Sentinel {
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
   void SetRetryBudgetSettings(const utils::RetryBudgetSettings& settings);
+  // Must be called before Start(), see ClientTrackingSettings
+  void SetClientTrackingSettings(
+      const ClientTrackingSettings& client_tracking_settings);
+  // Must be called before Start(), see
+  // RedisCreationSettings::socket_connection_task_processor
+  void SetSocketConnectionTaskProcessor(engine::TaskProcessor& task_processor);
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(size_t shard)> signal_instances_changed;
@@ -5,7 +5,6 @@
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/crc.hpp>
 
 #include <fmt/format.h>
 
@@ -193,6 +192,12 @@ void SentinelImpl::InitShards(
       if (ready_callback) ready_callback(i, shard, ready);
     };
     auto object = std::make_shared<Shard>(std::move(shard_options));
+    if (client_tracking_settings_)
+      object->SetClientTrackingSettings(*client_tracking_settings_);
+    if (socket_connection_task_processor_) {
+      object->SetSocketConnectionTaskProcessor(
+          *socket_connection_task_processor_);
+    }
     object->SignalInstanceStateChange().connect(
         [this](ServerId, Redis::State state) {
           if (state != Redis::State::kInit) ev_thread_.Send(watch_state_);
@@ -544,6 +549,20 @@ void SentinelImpl::SetCommandsBufferingSettings(
     shard->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void SentinelImpl::SetClientTrackingSettings(
+    const ClientTrackingSettings& client_tracking_settings) {
+  client_tracking_settings_ = client_tracking_settings;
+  for (auto& shard : master_shards_)
+    shard->SetClientTrackingSettings(client_tracking_settings);
+}
+
+void SentinelImpl::SetSocketConnectionTaskProcessor(
+    engine::TaskProcessor& task_processor) {
+  socket_connection_task_processor_ = &task_processor;
+  for (auto& shard : master_shards_)
+    shard->SetSocketConnectionTaskProcessor(task_processor);
+}
+
 void SentinelImpl::SetReplicationMonitoringSettings(
     const ReplicationMonitoringSettings& replication_monitoring_settings) {
   for (auto& shard : master_shards_)
@@ -941,15 +960,6 @@ size_t SentinelImpl::ParseMovedShard(const std::string& err_string) {
   return shard_info_.GetShard(host, port);
 }
 
-size_t SentinelImpl::HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
-
 SentinelImpl::SlotInfo::SlotInfo() {
   for (size_t i = 0; i < kClusterHashSlots; ++i) {
     slot_to_shard_[i] = kUnknownShard;
@@ -91,6 +91,10 @@ class SentinelImplBase {
       const ReplicationMonitoringSettings& replication_monitoring_settings) = 0;
   virtual void SetRetryBudgetSettings(
       const utils::RetryBudgetSettings& retry_budget_settings) = 0;
+  virtual void SetClientTrackingSettings(
+      const ClientTrackingSettings& client_tracking_settings) = 0;
+  virtual void SetSocketConnectionTaskProcessor(
+      engine::TaskProcessor& task_processor) = 0;
 
   virtual PublishSettings GetPublishSettings() = 0;
 };
@@ -148,6 +152,10 @@ class SentinelImpl : public SentinelImplBase {
       override;
   void SetRetryBudgetSettings(
       const utils::RetryBudgetSettings& retry_budget_settings) override;
+  void SetClientTrackingSettings(
+      const ClientTrackingSettings& client_tracking_settings) override;
+  void SetSocketConnectionTaskProcessor(
+      engine::TaskProcessor& task_processor) override;
   PublishSettings GetPublishSettings() override;
 
  private:
@@ -242,8 +250,6 @@ class SentinelImpl : public SentinelImplBase {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
@@ -283,6 +289,8 @@ class SentinelImpl : public SentinelImplBase {
   SentinelStatisticsInternal statistics_internal_;
   utils::SwappingSmart<KeysForShards> keys_for_shards_;
   std::optional<CommandsBufferingSettings> commands_buffering_settings_;
+  std::optional<ClientTrackingSettings> client_tracking_settings_;
+  engine::TaskProcessor* socket_connection_task_processor_{nullptr};
   dynamic_config::Source dynamic_config_source_;
   std::atomic<int> publish_shard_{0};
 };
@@ -80,13 +80,18 @@ std::unordered_map<ServerId, size_t, ServerIdHasher>
 Shard::GetAvailableServersWeighted(
     bool with_master, const CommandControl& command_control) const {
   std::unordered_map<ServerId, size_t, ServerIdHasher> server_weights;
+  // The near cache reads from the master, so the invalidations must be
+  // tracked there too
+  const bool master_only = client_tracking_settings_.Get() != nullptr;
   std::shared_lock lock(mutex_);
-  auto available = GetAvailableServers(command_control, with_master, true);
+  auto available = GetAvailableServers(
+      command_control, with_master || master_only, !master_only);
   for (size_t i = 0; i < instances_.size(); i++) {
     const auto& instance = *instances_[i].instance;
     const auto& info = instances_[i].info;
-    if (available.at(i) && instance.IsAvailable() &&
-        (with_master || info.IsReadOnly())) {
+    const bool suitable =
+        master_only ? !info.IsReadOnly() : (with_master || info.IsReadOnly());
+    if (available.at(i) && instance.IsAvailable() && suitable) {
       server_weights.emplace(instance.GetServerId(), 1);
     }
   }
@@ -292,8 +297,12 @@ bool Shard::ProcessCreation(
   // https://github.com/boostorg/signals2/issues/59
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
   for (const auto& id : need_to_create) {
-    const auto redis_settings = RedisCreationSettings{
+    auto redis_settings = RedisCreationSettings{
         id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly()};
+    if (auto client_tracking_settings = client_tracking_settings_.Get())
+      redis_settings.client_tracking = *client_tracking_settings;
+    redis_settings.socket_connection_task_processor =
+        socket_connection_task_processor_.load();
     ConnectionStatus entry{
         id, std::make_shared<Redis>(
                 redis_thread_pool,
@@ -450,6 +459,17 @@ void Shard::SetCommandsBufferingSettings(
       std::make_shared<CommandsBufferingSettings>(commands_buffering_settings));
 }
 
+void Shard::SetClientTrackingSettings(
+    ClientTrackingSettings client_tracking_settings) {
+  client_tracking_settings_.Set(std::make_shared<ClientTrackingSettings>(
+      std::move(client_tracking_settings)));
+}
+
+void Shard::SetSocketConnectionTaskProcessor(
+    engine::TaskProcessor& task_processor) {
+  socket_connection_task_processor_ = &task_processor;
+}
+
 void Shard::SetReplicationMonitoringSettings(
     const ReplicationMonitoringSettings& replication_monitoring_settings) {
   std::shared_lock lock(mutex_);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -10,6 +11,7 @@
 #include <userver/utils/swappingsmart.hpp>
 
 #include <storages/redis/impl/redis.hpp>
+#include <storages/redis/impl/redis_creation_settings.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -101,6 +103,11 @@ class Shard {
       const ReplicationMonitoringSettings& replication_monitoring_settings);
   void SetRetryBudgetSettings(
       const utils::RetryBudgetSettings& replication_monitoring_settings);
+  // Applied to the connections created afterwards
+  void SetClientTrackingSettings(
+      ClientTrackingSettings client_tracking_settings);
+  // Applied to the connections created afterwards
+  void SetSocketConnectionTaskProcessor(engine::TaskProcessor& task_processor);
 
  private:
   std::vector<unsigned char> GetAvailableServers(
@@ -135,6 +142,9 @@ class Shard {
 
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
   utils::SwappingSmart<utils::RetryBudgetSettings> retry_budet_settings_;
+  utils::SwappingSmart<ClientTrackingSettings> client_tracking_settings_;
+  std::atomic<engine::TaskProcessor*> socket_connection_task_processor_{
+      nullptr};
 
   bool prev_connected_ = false;
   const bool cluster_mode_ = false;
@@ -0,0 +1,293 @@
+#include <storages/redis/impl/socket_connection.hpp>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/exception.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/redis/impl/resp.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+namespace {
+
+constexpr size_t kReadBufferSize = 16 * 1024;
+
+}  // namespace
+
+SocketConnection::~SocketConnection() {
+  Fail(ReplyStatus::kEndOfFileError, "Connection is closed");
+  if (writer_.IsValid()) writer_.SyncCancel();
+  if (reader_.IsValid()) reader_.SyncCancel();
+}
+
+void SocketConnection::Connect(const engine::io::Sockaddr& addr,
+                               const Password& password,
+                               engine::Deadline deadline) {
+  UASSERT_MSG(!reader_.IsValid(), "SocketConnection can't be reused");
+  try {
+    socket_ =
+        engine::io::Socket{addr.Domain(), engine::io::SocketType::kStream};
+    socket_.Connect(addr, deadline);
+    socket_.SetOption(IPPROTO_TCP, TCP_NODELAY, 1);
+  } catch (const engine::io::IoException& ex) {
+    throw ClientNotConnectedException(
+        fmt::format("Failed to connect to redis at {}:{}: {}",
+                    addr.PrimaryAddressString(), addr.Port(), ex.what()));
+  }
+
+  {
+    std::lock_guard lock(mutex_);
+    broken_ = false;
+  }
+  // The connection must keep working under overload
+  reader_ = engine::CriticalAsyncNoSpan([this] { ReadLoop(); });
+  writer_ = engine::CriticalAsyncNoSpan([this] { WriteLoop(); });
+
+  if (!password.GetUnderlying().empty()) {
+    auto reply = Execute({"AUTH", password.GetUnderlying()}, deadline);
+    if (!reply->IsOk() || !reply->data.IsStatus()) {
+      throw ClientNotConnectedException(
+          "AUTH failed: " + (reply->IsOk() ? reply->data.ToDebugString()
+                                           : reply->status_string));
+    }
+  }
+}
+
+ReplyPtr SocketConnection::Execute(CmdArgs::CmdArgsArray args,
+                                   engine::Deadline deadline) {
+  UASSERT(!args.empty());
+  auto command = args.front();
+  auto promise = std::make_shared<engine::Promise<ReplyPtr>>();
+  auto future = promise->get_future();
+  // The caller waits for the deadline itself
+  const bool queued = Enqueue(
+      {std::move(args)}, deadline,
+      [promise](ReplyPtr reply) { promise->set_value(std::move(reply)); },
+      /*expire_replies=*/false);
+  if (!queued) {
+    return std::make_shared<Reply>(std::move(command), nullptr,
+                                   ReplyStatus::kEndOfFileError,
+                                   "Not connected");
+  }
+  Flush();
+
+  switch (future.wait_until(deadline)) {
+    case engine::FutureStatus::kReady:
+      return future.get();
+    case engine::FutureStatus::kTimeout:
+      return std::make_shared<Reply>(std::move(command), nullptr,
+                                     ReplyStatus::kTimeoutError, "Timeout");
+    case engine::FutureStatus::kCancelled:
+      break;
+  }
+  throw RequestCancelledException("Redis request was cancelled");
+}
+
+bool SocketConnection::AsyncExecute(
+    const std::vector<CmdArgs::CmdArgsArray>& commands,
+    engine::Deadline deadline, const ReplyCallback& callback) {
+  if (!Enqueue(commands, deadline, callback, /*expire_replies=*/true)) {
+    return false;
+  }
+  // Also re-arms the expiration timer of the writer
+  write_event_.Send();
+  return true;
+}
+
+void SocketConnection::Close() {
+  Fail(ReplyStatus::kEndOfFileError, "Connection is closed");
+}
+
+bool SocketConnection::IsConnected() const {
+  std::lock_guard lock(mutex_);
+  return !broken_;
+}
+
+SocketConnection::Statistics SocketConnection::GetStatistics() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+bool SocketConnection::Enqueue(
+    const std::vector<CmdArgs::CmdArgsArray>& commands,
+    engine::Deadline deadline, const ReplyCallback& callback,
+    bool expire_replies) {
+  std::lock_guard lock(mutex_);
+  if (broken_) return false;
+  for (const auto& args : commands) {
+    UASSERT(!args.empty());
+    AppendRespCommand(out_buffer_, args);
+    auto pending =
+        std::make_shared<PendingReply>(PendingReply{args.front(), callback});
+    if (expire_replies && deadline.IsReachable()) {
+      expirations_.push({deadline, pending});
+    }
+    pending_.push_back(std::move(pending));
+  }
+  out_commands_ += commands.size();
+  out_deadline_ = std::min(out_deadline_, deadline);
+  return true;
+}
+
+std::shared_ptr<SocketConnection::PendingReply>
+SocketConnection::PopPending() {
+  std::lock_guard lock(mutex_);
+  if (pending_.empty()) {
+    // The commands were failed by Close()
+    if (broken_) return nullptr;
+    throw ParseReplyException("Reply without a command");
+  }
+  auto front = std::move(pending_.front());
+  pending_.pop_front();
+  // Timed out already
+  if (std::exchange(front->done, true)) return nullptr;
+  return front;
+}
+
+void SocketConnection::Flush() {
+  // Commands of other coroutines are written here as well, do not leave them
+  // half-sent
+  engine::TaskCancellationBlocker cancellation_blocker;
+  std::string buffer;
+  engine::Deadline deadline;
+  {
+    std::lock_guard lock(mutex_);
+    // The one who is already flushing hands our commands to the writer task
+    if (flushing_ || out_buffer_.empty() || broken_) return;
+    flushing_ = true;
+    buffer.swap(out_buffer_);
+    deadline = std::exchange(out_deadline_, {});
+    ++stats_.sends;
+    stats_.commands += std::exchange(out_commands_, 0);
+  }
+
+  try {
+    if (socket_.SendAll(buffer.data(), buffer.size(), deadline) !=
+        buffer.size()) {
+      Fail(ReplyStatus::kEndOfFileError, "Connection is closed by peer");
+    }
+  } catch (const engine::io::IoTimeout&) {
+    // A part of a command may have been sent, the connection is unusable
+    Fail(ReplyStatus::kTimeoutError, "Timeout while sending the commands");
+  } catch (const engine::io::IoException& ex) {
+    Fail(ReplyStatus::kInputOutputError, ex.what());
+  }
+
+  bool has_more = false;
+  {
+    std::lock_guard lock(mutex_);
+    flushing_ = false;
+    has_more = !out_buffer_.empty() && !broken_;
+  }
+  // Do not write the commands of the others under our own deadline
+  if (has_more) write_event_.Send();
+}
+
+void SocketConnection::WriteLoop() {
+  while (true) {
+    engine::Deadline next_expiration;
+    {
+      std::lock_guard lock(mutex_);
+      if (!expirations_.empty()) {
+        next_expiration = expirations_.top().deadline;
+      }
+    }
+    const bool signaled = write_event_.WaitForEventUntil(next_expiration);
+    if (engine::current_task::ShouldCancel()) return;
+    if (signaled) Flush();
+    ExpireReplies();
+  }
+}
+
+void SocketConnection::ExpireReplies() {
+  std::vector<std::shared_ptr<PendingReply>> expired;
+  {
+    std::lock_guard lock(mutex_);
+    while (!expirations_.empty() && expirations_.top().deadline.IsReached()) {
+      auto reply = expirations_.top().reply.lock();
+      expirations_.pop();
+      if (reply && !std::exchange(reply->done, true)) {
+        expired.push_back(std::move(reply));
+      }
+    }
+  }
+  // The replies still arrive later and are dropped by the reader
+  for (const auto& reply : expired) {
+    reply->callback(std::make_shared<Reply>(reply->command, nullptr,
+                                            ReplyStatus::kTimeoutError,
+                                            "Timeout"));
+  }
+}
+
+void SocketConnection::ReadLoop() {
+  RespParser parser;
+  std::string buffer(kReadBufferSize, '\0');
+  try {
+    while (true) {
+      const auto size = socket_.RecvSome(buffer.data(), buffer.size(), {});
+      if (size == 0) {
+        Fail(ReplyStatus::kEndOfFileError, "Connection is closed by peer");
+        return;
+      }
+
+      parser.Feed({buffer.data(), size});
+      while (auto data = parser.Next()) {
+        if (auto pending = PopPending()) {
+          pending->callback(std::make_shared<Reply>(
+              std::move(pending->command), std::move(*data)));
+        }
+      }
+    }
+  } catch (const engine::io::IoCancelled&) {
+    Fail(ReplyStatus::kEndOfFileError, "Connection is closed");
+  } catch (const engine::io::IoException& ex) {
+    Fail(ReplyStatus::kInputOutputError, ex.what());
+  } catch (const ParseReplyException& ex) {
+    LOG_ERROR() << "Failed to parse redis reply: " << ex;
+    Fail(ReplyStatus::kProtocolError, ex.what());
+  }
+}
+
+void SocketConnection::Fail(ReplyStatus status, const std::string& reason) {
+  std::vector<std::shared_ptr<PendingReply>> failed;
+  {
+    std::lock_guard lock(mutex_);
+    if (!broken_) {
+      broken_ = true;
+      // Wakes up the reader and the writer, the socket itself is closed in
+      // the destructor when nobody uses it
+      ::shutdown(socket_.Fd(), SHUT_RDWR);
+    }
+    for (auto& reply : pending_) {
+      if (!std::exchange(reply->done, true)) failed.push_back(std::move(reply));
+    }
+    pending_.clear();
+    expirations_ = {};
+    out_buffer_.clear();
+    out_commands_ = 0;
+    out_deadline_ = {};
+  }
+  for (const auto& reply : failed) {
+    reply->callback(std::make_shared<Reply>(std::move(reply->command), nullptr,
+                                            status, reason));
+  }
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// Redis connection that reads and writes its socket right from the
+/// coroutines of the current task processor, an alternative to the hiredis
+/// async context served by redis::ThreadPools.
+///
+/// Any number of coroutines may call Execute() concurrently. Their commands
+/// are pipelined: the first caller writes all the commands accumulated by the
+/// moment in a single send, bounded by the earliest deadline among them, a
+/// dedicated reader task parses the replies and wakes up the callers without
+/// a hop through the ev threads. The commands queued during that send and the
+/// commands of AsyncExecute(), which may be called from any thread, are
+/// written by a dedicated writer task.
+class SocketConnection final {
+ public:
+  /// Called once for every command, must not throw
+  using ReplyCallback = std::function<void(ReplyPtr reply)>;
+
+  SocketConnection() = default;
+  SocketConnection(const SocketConnection&) = delete;
+  SocketConnection& operator=(const SocketConnection&) = delete;
+  ~SocketConnection();
+
+  /// Connects to the server and authenticates if the password is not empty.
+  /// @throws ClientNotConnectedException
+  void Connect(const engine::io::Sockaddr& addr, const Password& password,
+               engine::Deadline deadline);
+
+  /// Sends a single command and waits for its reply. Reply status is
+  /// ReplyStatus::kTimeoutError if the deadline is reached and
+  /// ReplyStatus::kEndOfFileError if the connection is broken.
+  ReplyPtr Execute(CmdArgs::CmdArgsArray args, engine::Deadline deadline);
+
+  /// Queues the commands back to back, so that the commands of the other
+  /// callers do not get in between, e.g. for MULTI/EXEC. The callback is
+  /// called from the connection tasks, with ReplyStatus::kTimeoutError for the
+  /// commands that got no reply by the deadline.
+  /// @returns false without calling the callback if the connection is broken
+  bool AsyncExecute(const std::vector<CmdArgs::CmdArgsArray>& commands,
+                    engine::Deadline deadline, const ReplyCallback& callback);
+
+  /// Breaks the connection and fails the commands waiting for replies, may be
+  /// called from any thread
+  void Close();
+
+  bool IsConnected() const;
+
+  /// Number of sends made and commands written, the ratio is the average
+  /// pipeline depth
+  struct Statistics {
+    size_t sends{0};
+    size_t commands{0};
+  };
+  Statistics GetStatistics() const;
+
+ private:
+  struct PendingReply {
+    std::string command;
+    ReplyCallback callback;
+    // Set by the one who calls the callback
+    bool done{false};
+  };
+
+  struct Expiration {
+    engine::Deadline deadline;
+    std::weak_ptr<PendingReply> reply;
+
+    bool operator>(const Expiration& other) const {
+      return other.deadline < deadline;
+    }
+  };
+
+  // With `expire_replies` the callback gets a timeout reply at the deadline,
+  // otherwise the deadline only bounds the send
+  bool Enqueue(const std::vector<CmdArgs::CmdArgsArray>& commands,
+               engine::Deadline deadline, const ReplyCallback& callback,
+               bool expire_replies);
+  std::shared_ptr<PendingReply> PopPending();
+  void Flush();
+  void WriteLoop();
+  void ReadLoop();
+  void ExpireReplies();
+  void Fail(ReplyStatus status, const std::string& reason);
+
+  engine::io::Socket socket_;
+  engine::TaskWithResult<void> reader_;
+  engine::TaskWithResult<void> writer_;
+  engine::SingleConsumerEvent write_event_;
+
+  mutable std::mutex mutex_;
+  std::deque<std::shared_ptr<PendingReply>> pending_;
+  std::priority_queue<Expiration, std::vector<Expiration>, std::greater<>>
+      expirations_;
+  std::string out_buffer_;
+  size_t out_commands_{0};
+  // The earliest deadline of the commands in 'out_buffer_'
+  engine::Deadline out_deadline_;
+  bool flushing_{false};
+  bool broken_{true};
+  Statistics stats_;
+};
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,171 @@
+#include <userver/utest/utest.hpp>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/storages/redis/exception.hpp>
+
+#include <storages/redis/impl/socket_connection.hpp>
+#include "mock_server_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::seconds kMaxTestWait{10};
+
+engine::io::Sockaddr MakeAddr(const MockRedisServer& server) {
+  auto addr = engine::io::Sockaddr::MakeIPv4LoopbackAddress();
+  addr.SetPort(static_cast<std::uint16_t>(server.GetPort()));
+  return addr;
+}
+
+engine::Deadline MakeDeadline() {
+  return engine::Deadline::FromDuration(kMaxTestWait);
+}
+
+}  // namespace
+
+UTEST(SocketConnection, Ping) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+
+  redis::SocketConnection connection;
+  connection.Connect(MakeAddr(server), redis::Password(""), MakeDeadline());
+  EXPECT_TRUE(connection.IsConnected());
+
+  const auto reply = connection.Execute({"PING"}, MakeDeadline());
+  ASSERT_TRUE(reply->IsOk());
+  EXPECT_EQ(reply->data.GetStatus(), "PONG");
+  EXPECT_EQ(ping_handler->GetReplyCount(), 1U);
+}
+
+UTEST(SocketConnection, Auth) {
+  MockRedisServer server;
+  auto auth_handler = server.RegisterStatusReplyHandler("AUTH", "OK");
+
+  redis::SocketConnection connection;
+  connection.Connect(MakeAddr(server), redis::Password("password"),
+                     MakeDeadline());
+  EXPECT_EQ(auth_handler->GetReplyCount(), 1U);
+}
+
+UTEST(SocketConnection, AuthFail) {
+  MockRedisServer server;
+  server.RegisterErrorReplyHandler("AUTH", "NO PASARAN");
+
+  redis::SocketConnection connection;
+  EXPECT_THROW(connection.Connect(MakeAddr(server), redis::Password("password"),
+                                  MakeDeadline()),
+               redis::ClientNotConnectedException);
+}
+
+UTEST(SocketConnection, Timeout) {
+  MockRedisServer server;
+  server.RegisterTimeoutHandler("GET", std::chrono::milliseconds{500});
+
+  redis::SocketConnection connection;
+  connection.Connect(MakeAddr(server), redis::Password(""), MakeDeadline());
+
+  const auto reply = connection.Execute(
+      {"GET", "key"},
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10}));
+  EXPECT_EQ(reply->status, redis::ReplyStatus::kTimeoutError);
+}
+
+UTEST_MT(SocketConnection, Pipelining, 4) {
+  constexpr size_t kTasks = 100;
+  MockRedisServer server;
+  server.RegisterHandlerWithConstReply("GET", redis::ReplyData{"value"});
+
+  redis::SocketConnection connection;
+  connection.Connect(MakeAddr(server), redis::Password(""), MakeDeadline());
+
+  std::vector<engine::TaskWithResult<redis::ReplyPtr>> tasks;
+  tasks.reserve(kTasks);
+  for (size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&connection, i] {
+      return connection.Execute({"GET", "key" + std::to_string(i)},
+                                MakeDeadline());
+    }));
+  }
+  for (auto& task : tasks) {
+    const auto reply = task.Get();
+    ASSERT_TRUE(reply->IsOk());
+    EXPECT_EQ(reply->data.GetString(), "value");
+  }
+
+  const auto stats = connection.GetStatistics();
+  EXPECT_EQ(stats.commands, kTasks);
+  EXPECT_LE(stats.sends, kTasks);
+}
+
+UTEST(SocketConnection, AsyncExecute) {
+  MockRedisServer server;
+  server.RegisterHandlerWithConstReply("GET", redis::ReplyData{"value"});
+  server.RegisterTimeoutHandler("HGET", std::chrono::milliseconds{500});
+
+  redis::SocketConnection connection;
+  connection.Connect(MakeAddr(server), redis::Password(""), MakeDeadline());
+
+  // Replies and expirations are reported by different connection tasks
+  std::mutex mutex;
+  std::vector<redis::ReplyPtr> replies;
+  engine::SingleConsumerEvent done;
+  const auto callback = [&](redis::ReplyPtr reply) {
+    std::lock_guard lock(mutex);
+    replies.push_back(std::move(reply));
+    if (replies.size() == 2) done.Send();
+  };
+  EXPECT_TRUE(connection.AsyncExecute({{"GET", "key"}}, MakeDeadline(),
+                                      callback));
+  EXPECT_TRUE(connection.AsyncExecute(
+      {{"HGET", "key", "field"}},
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10}),
+      callback));
+  ASSERT_TRUE(done.WaitForEventFor(kMaxTestWait));
+
+  std::lock_guard lock(mutex);
+  ASSERT_EQ(replies.size(), 2U);
+  if (replies[0]->status != redis::ReplyStatus::kOk) {
+    std::swap(replies[0], replies[1]);
+  }
+  ASSERT_TRUE(replies[0]->IsOk());
+  EXPECT_EQ(replies[0]->data.GetString(), "value");
+  EXPECT_EQ(replies[1]->status, redis::ReplyStatus::kTimeoutError);
+}
+
+UTEST(SocketConnection, SendTimeout) {
+  // The peer never reads, the send gets stuck once the socket buffers fill up
+  engine::io::Socket listener{engine::io::AddrDomain::kInet,
+                              engine::io::SocketType::kStream};
+  listener.Bind(engine::io::Sockaddr::MakeIPv4LoopbackAddress());
+  listener.Listen();
+
+  redis::SocketConnection connection;
+  connection.Connect(listener.Getsockname(), redis::Password(""),
+                     MakeDeadline());
+
+  const std::string value(64 * 1024 * 1024, 'x');
+  const auto reply = connection.Execute(
+      {"SET", "key", value},
+      engine::Deadline::FromDuration(std::chrono::milliseconds{100}));
+  EXPECT_EQ(reply->status, redis::ReplyStatus::kTimeoutError);
+  // A part of the command is sent, the connection can't be used anymore
+  EXPECT_FALSE(connection.IsConnected());
+}
+
+UTEST(SocketConnection, NotConnected) {
+  redis::SocketConnection connection;
+  EXPECT_FALSE(connection.IsConnected());
+
+  const auto reply = connection.Execute({"PING"}, MakeDeadline());
+  EXPECT_EQ(reply->status, redis::ReplyStatus::kEndOfFileError);
+}
+
+USERVER_NAMESPACE_END
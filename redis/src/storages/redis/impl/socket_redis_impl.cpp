@@ -0,0 +1,299 @@
+#include <storages/redis/impl/socket_redis_impl.hpp>
+
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include <optional>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/exception.hpp>
+#include <userver/storages/redis/impl/reply.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/redis_info.hpp>
+#include <storages/redis/impl/socket_connection.hpp>
+
+#include "command_control_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+namespace {
+
+constexpr double kPingLatencyExp = 0.7;
+constexpr double kInitialPingLatencyMs = 1000;
+constexpr size_t kMissedPingStreakThreshold = 3;
+constexpr std::chrono::milliseconds kPingInterval{2000};
+constexpr std::chrono::milliseconds kPingTimeout{4000};
+constexpr std::chrono::milliseconds kConnectTimeout{2000};
+
+std::optional<engine::io::Sockaddr> MakeSockaddr(const std::string& host,
+                                                 int port) {
+  addrinfo hints{};
+  hints.ai_flags = AI_NUMERICHOST;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  // Numeric hosts only, the lookup does not block
+  if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0) {
+    return std::nullopt;
+  }
+  engine::io::Sockaddr addr{result->ai_addr};
+  ::freeaddrinfo(result);
+  addr.SetPort(static_cast<std::uint16_t>(port));
+  return addr;
+}
+
+bool IsFinalState(Redis::State state) {
+  return state == Redis::State::kDisconnected ||
+         state == Redis::State::kDisconnectError ||
+         state == Redis::State::kInitError;
+}
+
+}  // namespace
+
+SocketRedisImpl::SocketRedisImpl(engine::TaskProcessor& task_processor,
+                                 Redis& redis_obj)
+    : task_processor_(task_processor),
+      redis_obj_(&redis_obj),
+      ping_latency_ms_(kInitialPingLatencyMs),
+      server_id_(ServerId::Generate()),
+      retry_budget_(utils::RetryBudgetSettings{100, 0.1, false}) {
+  LOG_DEBUG() << "SocketRedisImpl() server_id=" << GetServerId().GetId();
+}
+
+SocketRedisImpl::~SocketRedisImpl() {
+  LOG_DEBUG() << "~SocketRedisImpl() server_id=" << GetServerId().GetId()
+              << " server=" << server_;
+  server_id_.RemoveDescription();
+}
+
+void SocketRedisImpl::Connect(const ConnectionInfo::HostVector& host_addrs,
+                              int port, const Password& password) {
+  UASSERT(!host_addrs.empty());
+  host_ = host_addrs.front();
+  port_ = port;
+  server_ = host_ + ":" + std::to_string(port);
+  server_id_.SetDescription(server_);
+  log_extra_.Extend("redis_server", server_);
+  log_extra_.Extend("server_id", GetServerId().GetId());
+
+  // Sentinel calls this from the ev threads, the task keeps the impl alive
+  engine::CriticalAsyncNoSpan(task_processor_, [self = shared_from_this(),
+                                                host_addrs, port, password] {
+    self->Run(host_addrs, port, password);
+  }).Detach();
+}
+
+void SocketRedisImpl::Disconnect() {
+  if (destroying_.exchange(true)) return;
+  stop_event_.Send();
+}
+
+bool SocketRedisImpl::AsyncCommand(const CommandPtr& command) {
+  const CommandControlImpl cc{command->control};
+  const auto deadline = engine::Deadline::FromDuration(cc.timeout_single);
+
+  std::lock_guard lock(connection_mutex_);
+  if (!connection_ || destroying_) return false;
+
+  command->ResetStartHandlingTime();
+  statistics_.AccountCommandSent(command);
+  running_commands_ += command->args.args.size();
+  const bool queued = connection_->AsyncExecute(
+      command->args.args, deadline,
+      [self = shared_from_this(), command](ReplyPtr reply) {
+        self->InvokeCommand(command, std::move(reply));
+      });
+  if (!queued) running_commands_ -= command->args.args.size();
+  return queued;
+}
+
+void SocketRedisImpl::SetReplicationMonitoringSettings(
+    const ReplicationMonitoringSettings& replication_monitoring_settings) {
+  enable_replication_monitoring_ =
+      replication_monitoring_settings.enable_monitoring;
+  forbid_requests_to_syncing_replicas_ =
+      replication_monitoring_settings.restrict_requests;
+}
+
+void SocketRedisImpl::SetRetryBudgetSettings(
+    const utils::RetryBudgetSettings& settings) {
+  retry_budget_.SetSettings(settings);
+}
+
+void SocketRedisImpl::ResetRedisObj() {
+  std::lock_guard lock(redis_obj_mutex_);
+  redis_obj_ = nullptr;
+}
+
+void SocketRedisImpl::Run(const ConnectionInfo::HostVector& host_addrs,
+                          int port, const Password& password) {
+  SocketConnection connection;
+  if (!ConnectAny(connection, host_addrs, port, password)) {
+    SetState(State::kDisconnectError);
+    return;
+  }
+
+  {
+    std::lock_guard lock(connection_mutex_);
+    connection_ = &connection;
+  }
+  if (!destroying_) SetState(State::kConnected);
+
+  size_t missed_ping_streak = 0;
+  try {
+    while (!stop_event_.WaitForEventFor(kPingInterval) &&
+           !engine::current_task::ShouldCancel() && connection.IsConnected()) {
+      if (Ping(connection)) {
+        missed_ping_streak = 0;
+      } else if (++missed_ping_streak >= kMissedPingStreakThreshold) {
+        break;
+      }
+      UpdateReplicationInfo(connection);
+    }
+  } catch (const RequestCancelledException&) {
+    // Task processor is stopping
+  }
+
+  {
+    std::lock_guard lock(connection_mutex_);
+    connection_ = nullptr;
+  }
+  connection.Close();
+  SetState(destroying_ ? State::kDisconnected : State::kDisconnectError);
+}
+
+bool SocketRedisImpl::ConnectAny(SocketConnection& connection,
+                                 const ConnectionInfo::HostVector& host_addrs,
+                                 int port, const Password& password) {
+  LOG_INFO() << log_extra_ << "Connect to Redis server=" << server_;
+  for (const auto& host : host_addrs) {
+    const auto addr = MakeSockaddr(host, port);
+    if (!addr) {
+      LOG_ERROR() << log_extra_ << "Host name '" << host
+                  << "' is not resolved for socket connections, specify the "
+                     "instance by IP address";
+      continue;
+    }
+    try {
+      connection.Connect(*addr, password,
+                         engine::Deadline::FromDuration(kConnectTimeout));
+      LOG_INFO() << log_extra_ << "Connected to Redis successfully";
+      return true;
+    } catch (const ClientNotConnectedException& ex) {
+      // SocketConnection can't be reused after a failed attempt
+      LOG_WARNING() << log_extra_ << ex;
+      return false;
+    }
+  }
+  return false;
+}
+
+bool SocketRedisImpl::Ping(SocketConnection& connection) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto reply = connection.Execute(
+      {"PING"}, engine::Deadline::FromDuration(kPingTimeout));
+  if (!reply->IsOk() || !reply->data.IsStatus()) return false;
+
+  const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  statistics_.AccountPing(latency);
+  ping_latency_ms_ = ping_latency_ms_.load() * kPingLatencyExp +
+                     latency.count() * (1 - kPingLatencyExp);
+  return true;
+}
+
+void SocketRedisImpl::UpdateReplicationInfo(SocketConnection& connection) {
+  if (!enable_replication_monitoring_.load(std::memory_order_relaxed)) {
+    /// pretend we never syncing
+    is_syncing_ = false;
+    return;
+  }
+
+  const auto reply = connection.Execute(
+      {"INFO", "REPLICATION"}, engine::Deadline::FromDuration(kPingTimeout));
+  if (!reply->IsOk() || !reply->data.IsString()) {
+    LOG_DEBUG() << "Failed to get INFO for server_id=" << GetServerId().GetId()
+                << ", host=" << GetHost();
+    return;
+  }
+  const auto redis_info = ParseReplicationInfo(reply->data.GetString());
+  is_syncing_ =
+      forbid_requests_to_syncing_replicas_.load(std::memory_order_relaxed) &&
+      redis_info.is_syncing;
+  statistics_.is_syncing = redis_info.is_syncing;
+  statistics_.offset_from_master_bytes =
+      redis_info.slave_read_repl_offset - redis_info.slave_repl_offset;
+}
+
+void SocketRedisImpl::InvokeCommand(const CommandPtr& command,
+                                    ReplyPtr&& reply) {
+  UASSERT(reply);
+  --running_commands_;
+
+  const CommandControlImpl cc{command->control};
+  if (cc.account_in_statistics) {
+    statistics_.AccountReplyReceived(reply, command);
+  }
+  reply->server = server_;
+  if (reply->status == ReplyStatus::kTimeoutError) {
+    reply->log_extra.Extend("timeout_ms", cc.timeout_single.count());
+    retry_budget_.AccountFail();
+  }
+  if (reply->status == ReplyStatus::kOk) {
+    retry_budget_.AccountOk();
+  }
+
+  reply->server_id = server_id_;
+  reply->log_extra.Extend("redis_server", server_);
+  reply->log_extra.Extend("reply_status", ToString(reply->status));
+
+  if (reply->IsLoggableError()) {
+    LOG_WARNING() << "Request to Redis server " << reply->server
+                  << " failed with status " << reply->status << " ("
+                  << reply->status_string << ")" << reply->GetLogExtra()
+                  << command->GetLogExtra();
+  }
+
+  const bool need_disconnect =
+      reply->IsUnusableInstanceError() || reply->IsReadonlyError();
+  if (need_disconnect) {
+    LOG_ERROR() << "Request to Redis server " << reply->server
+                << " failed with Redis error reply: "
+                << reply->data.ToDebugString() << reply->GetLogExtra()
+                << command->GetLogExtra();
+  }
+
+  try {
+    command->callback(command, reply);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "exception in callback handler (" << command->args << ") "
+                  << ex;
+  }
+
+  if (need_disconnect) Disconnect();
+}
+
+void SocketRedisImpl::SetState(State state) {
+  auto old_state = state_.load();
+  do {
+    if (old_state == state || IsFinalState(old_state)) return;
+  } while (!state_.compare_exchange_weak(old_state, state));
+
+  LOG_INFO() << log_extra_ << "Redis server connection state for server="
+             << server_ << " (server_id=" << GetServerId().GetId()
+             << ") changed from " << StateToString(old_state) << " to "
+             << StateToString(state);
+  statistics_.AccountStateChanged(state);
+
+  std::lock_guard lock(redis_obj_mutex_);
+  if (redis_obj_) redis_obj_->signal_state_change(state);
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
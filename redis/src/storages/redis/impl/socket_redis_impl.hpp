@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/utils/retry_budget.hpp>
+
+#include <storages/redis/impl/redis.hpp>
+#include <storages/redis/impl/redis_stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+class SocketConnection;
+
+/// Implementation of redis::Redis on top of redis::SocketConnection: the
+/// connection is served by the coroutines of a task processor instead of
+/// hiredis on the ev threads, see
+/// RedisCreationSettings::socket_connection_task_processor.
+///
+/// Subscriptions, RedisCluster and TLS are not supported. Host names are not
+/// resolved, the instances must be specified by IP addresses as the sentinels
+/// report them.
+class SocketRedisImpl final
+    : public std::enable_shared_from_this<SocketRedisImpl> {
+ public:
+  using State = Redis::State;
+
+  SocketRedisImpl(engine::TaskProcessor& task_processor, Redis& redis_obj);
+  ~SocketRedisImpl();
+
+  void Connect(const ConnectionInfo::HostVector& host_addrs, int port,
+               const Password& password);
+  // May be called from any thread
+  void Disconnect();
+
+  bool AsyncCommand(const CommandPtr& command);
+
+  State GetState() const { return state_; }
+  const std::string& GetHost() const { return host_; }
+  uint16_t GetPort() const { return port_; }
+  const Statistics& GetStatistics() const { return statistics_; }
+  ServerId GetServerId() const { return server_id_; }
+  size_t GetRunningCommands() const { return running_commands_; }
+  bool IsDestroying() const { return destroying_; }
+  bool IsSyncing() const { return is_syncing_; }
+  bool IsAvailable() const {
+    return GetState() == State::kConnected && !IsDestroying() && !IsSyncing();
+  }
+  bool CanRetry() const { return retry_budget_.CanRetry(); }
+  std::chrono::milliseconds GetPingLatency() const {
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(ping_latency_ms_.load()));
+  }
+  void SetReplicationMonitoringSettings(
+      const ReplicationMonitoringSettings& replication_monitoring_settings);
+  void SetRetryBudgetSettings(const utils::RetryBudgetSettings& settings);
+
+  void ResetRedisObj();
+
+ private:
+  void Run(const ConnectionInfo::HostVector& host_addrs, int port,
+           const Password& password);
+  bool ConnectAny(SocketConnection& connection,
+                  const ConnectionInfo::HostVector& host_addrs, int port,
+                  const Password& password);
+  bool Ping(SocketConnection& connection);
+  void UpdateReplicationInfo(SocketConnection& connection);
+  void InvokeCommand(const CommandPtr& command, ReplyPtr&& reply);
+  void SetState(State state);
+
+  engine::TaskProcessor& task_processor_;
+
+  std::mutex redis_obj_mutex_;
+  Redis* redis_obj_;
+
+  // Owned by Run(), commands are queued under the lock
+  std::mutex connection_mutex_;
+  SocketConnection* connection_{nullptr};
+  engine::SingleConsumerEvent stop_event_;
+
+  std::atomic<bool> destroying_{false};
+  std::atomic<State> state_{State::kInit};
+  std::atomic<size_t> running_commands_{0};
+  std::atomic<bool> is_syncing_{false};
+  std::atomic<bool> enable_replication_monitoring_{false};
+  std::atomic<bool> forbid_requests_to_syncing_replicas_{false};
+  std::atomic<double> ping_latency_ms_;
+  std::string host_;
+  uint16_t port_{0};
+  std::string server_;
+  logging::LogExtra log_extra_;
+  Statistics statistics_;
+  ServerId server_id_;
+  utils::RetryBudget retry_budget_;
+};
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "subscribe_sentinel.hpp"
 
+#include <strings.h>
+
 #include <memory>
 
 #include <userver/logging/log.hpp>
@@ -9,6 +11,7 @@
 
 #include <storages/redis/dynamic_config.hpp>
 #include <storages/redis/impl/cluster_subscription_storage.hpp>
+#include <storages/redis/impl/command.hpp>
 
 #include "sentinel_impl.hpp"
 
@@ -32,6 +35,20 @@ std::shared_ptr<SubscriptionStorageBase> CreateSubscriptionStorage(
       thread_pools, shards_count, is_cluster_mode, std::move(shard_names));
 }
 
+bool IsClientTrackingReset(const ReplyPtr& reply) {
+  if (!reply || !reply->data.IsArray()) return false;
+  const auto& reply_array = reply->data.GetArray();
+  if (reply_array.size() != 3 || !reply_array[0].IsString() ||
+      !reply_array[1].IsString() ||
+      reply_array[1].GetString() != kClientTrackingInvalidateChannel) {
+    return false;
+  }
+  const auto& type = reply_array[0].GetString();
+  // Invalidation of all keys, e.g. after FLUSHALL, is a nil message
+  return !strcasecmp(type.c_str(), "subscribe") ||
+         (!strcasecmp(type.c_str(), "message") && reply_array[2].IsNil());
+}
+
 }  // namespace
 
 SubscribeSentinel::SubscribeSentinel(
@@ -108,7 +125,8 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
     dynamic_config::Source dynamic_config_source,
     const std::string& client_name, ReadyChangeCallback ready_callback,
     bool is_cluster_mode, const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    const std::optional<ClientTrackingSettings>& client_tracking_settings) {
   const auto& password = settings.password;
 
   const std::vector<std::string>& shards = settings.shards;
@@ -137,6 +155,9 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
       std::move(ready_callback),
       (is_cluster_mode ? nullptr : std::make_unique<KeyShardZero>()),
       is_cluster_mode, command_control, testsuite_redis_control);
+  if (client_tracking_settings) {
+    subscribe_sentinel->SetClientTrackingSettings(*client_tracking_settings);
+  }
   subscribe_sentinel->Start();
   return subscribe_sentinel;
 }
@@ -197,12 +218,25 @@ void SubscribeSentinel::SetRebalanceMinInterval(
   storage_->SetRebalanceMinInterval(interval);
 }
 
+void SubscribeSentinel::SetClientTrackingResetCallback(
+    std::function<void(size_t shard)> callback) {
+  client_tracking_reset_callback_ = std::move(callback);
+}
+
 void SubscribeSentinel::InitStorage() {
   storage_->SetCommandControl(GetCommandControl({}));
   storage_->SetUnsubscribeCallback([this](size_t shard, CommandPtr cmd) {
     AsyncCommand(cmd, false, shard);
   });
   storage_->SetSubscribeCallback([this](size_t shard, CommandPtr cmd) {
+    if (client_tracking_reset_callback_) {
+      cmd->callback = [callback = std::move(cmd->callback),
+                       reset_callback = client_tracking_reset_callback_,
+                       shard](const CommandPtr& command, ReplyPtr reply) {
+        if (IsClientTrackingReset(reply)) reset_callback(shard);
+        callback(command, std::move(reply));
+      };
+    }
     AsyncCommand(cmd, false, shard);
   });
   storage_->SetShardedUnsubscribeCallback(
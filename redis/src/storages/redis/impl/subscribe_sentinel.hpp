@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include <userver/testsuite/testsuite_support.hpp>
@@ -41,7 +43,9 @@ class SubscribeSentinel : protected Sentinel {
       dynamic_config::Source dynamic_config_source,
       const std::string& client_name, ReadyChangeCallback ready_callback,
       bool is_cluster_mode, const CommandControl& command_control,
-      const testsuite::RedisControl& testsuite_redis_control);
+      const testsuite::RedisControl& testsuite_redis_control,
+      const std::optional<ClientTrackingSettings>& client_tracking_settings =
+          std::nullopt);
 
   SubscriptionToken Subscribe(
       const std::string& channel,
@@ -66,6 +70,13 @@ class SubscribeSentinel : protected Sentinel {
 
   void SetRebalanceMinInterval(std::chrono::milliseconds interval);
 
+  /// Called with the shard index when the client tracking invalidations of
+  /// the shard might have been missed: on every (re)subscription to
+  /// kClientTrackingInvalidateChannel and on the invalidation of all keys.
+  /// Must be set before subscribing to the channel.
+  void SetClientTrackingResetCallback(
+      std::function<void(size_t shard)> callback);
+
   using Sentinel::IsInClusterMode;
   using Sentinel::Restart;
   using Sentinel::SetConfigDefaultCommandControl;
@@ -84,6 +95,7 @@ class SubscribeSentinel : protected Sentinel {
   std::shared_ptr<ThreadPools> thread_pools_;
   std::shared_ptr<redis::SubscriptionStorageBase> storage_;
   std::shared_ptr<Stopper> stopper_;
+  std::function<void(size_t shard)> client_tracking_reset_callback_;
 };
 
 }  // namespace redis
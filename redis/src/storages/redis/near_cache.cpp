@@ -0,0 +1,179 @@
+#include "near_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <storages/redis/impl/subscribe_sentinel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+constexpr size_t kWaysCount = 16;
+constexpr size_t kDefaultMaxValueSize = 4096;
+
+bool AllSet(const std::vector<bool>& flags) {
+  return std::all_of(flags.begin(), flags.end(), [](bool flag) { return flag; });
+}
+
+}  // namespace
+
+NearCacheSettings Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<NearCacheSettings>) {
+  NearCacheSettings settings;
+  settings.max_size = value["max_size"].As<size_t>();
+  settings.max_value_size =
+      value["max_value_size"].As<size_t>(kDefaultMaxValueSize);
+  settings.prefixes = value["prefixes"].As<std::vector<std::string>>({});
+  return settings;
+}
+
+NearCache::NearCache(NearCacheSettings settings, size_t shards_count)
+    : settings_(std::move(settings)),
+      shards_ready_(shards_count, false),
+      shards_subscribed_(shards_count, false) {
+  const auto way_size = std::max<size_t>(settings_.max_size / kWaysCount, 1);
+  ways_.reserve(kWaysCount);
+  for (size_t i = 0; i < kWaysCount; ++i) {
+    ways_.push_back(std::make_unique<Way>(way_size));
+  }
+}
+
+NearCache::~NearCache() {
+  // Callbacks of the sentinel refer to this
+  invalidation_token_.Unsubscribe();
+  sentinel_.reset();
+}
+
+void NearCache::StartTracking(
+    std::shared_ptr<USERVER_NAMESPACE::redis::SubscribeSentinel> sentinel) {
+  UASSERT(!sentinel_);
+  sentinel_ = std::move(sentinel);
+  sentinel_->SetClientTrackingResetCallback(
+      [this](size_t shard) { OnInvalidateAll(shard); });
+  invalidation_token_ = sentinel_->Subscribe(
+      std::string{USERVER_NAMESPACE::redis::kClientTrackingInvalidateChannel},
+      [this](const std::string&, const std::string& key) {
+        OnInvalidate(key);
+        return USERVER_NAMESPACE::redis::Sentinel::Outcome::kOk;
+      });
+}
+
+const NearCacheSettings& NearCache::GetSettings() const { return settings_; }
+
+bool NearCache::IsTracked(const std::string& key) const {
+  if (settings_.prefixes.empty()) return true;
+  return std::any_of(settings_.prefixes.begin(), settings_.prefixes.end(),
+                     [&key](const std::string& prefix) {
+                       return utils::text::StartsWith(key, prefix);
+                     });
+}
+
+std::optional<std::string> NearCache::Get(const std::string& key) {
+  if (enabled_) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+    if (const auto* value = way.cache.Get(key)) {
+      ++stats_.hits;
+      return *value;
+    }
+  }
+  ++stats_.misses;
+  return std::nullopt;
+}
+
+NearCache::Epoch NearCache::GetEpoch(const std::string& key) {
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  return way.epoch;
+}
+
+void NearCache::Put(const std::string& key, std::string value, Epoch epoch) {
+  if (!enabled_ || value.size() > settings_.max_value_size) return;
+
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  // The epoch changes together with the erase, so the value is either
+  // rejected here or erased after we release the lock.
+  if (way.epoch != epoch) return;
+  way.cache.Put(key, std::move(value));
+}
+
+void NearCache::OnInvalidate(const std::string& key) {
+  ++stats_.invalidations;
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  ++way.epoch;
+  way.cache.Erase(key);
+}
+
+void NearCache::OnInvalidateAll(size_t shard) {
+  ++stats_.invalidations;
+  std::lock_guard lock(ready_mutex_);
+  UASSERT(shard < shards_subscribed_.size());
+  // The cached keys are not tracked by shards, drop them all
+  InvalidateAll();
+  // Also called on subscription to the invalidation channel, no
+  // invalidations of the shard are missed after that
+  shards_subscribed_[shard] = true;
+  UpdateEnabled();
+}
+
+void NearCache::OnShardReadyChange(size_t shard, bool ready) {
+  std::lock_guard lock(ready_mutex_);
+  UASSERT(shard < shards_ready_.size());
+  shards_ready_[shard] = ready;
+  if (!ready) {
+    enabled_ = false;
+    // The shard resubscribes after the reconnection
+    shards_subscribed_[shard] = false;
+    InvalidateAll();
+  }
+  UpdateEnabled();
+}
+
+size_t NearCache::GetSize() const {
+  size_t size = 0;
+  for (const auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    size += way->cache.GetSize();
+  }
+  return size;
+}
+
+const NearCacheStatistics& NearCache::GetStatistics() const { return stats_; }
+
+NearCache::Way& NearCache::GetWay(const std::string& key) {
+  return *ways_[std::hash<std::string>{}(key) % ways_.size()];
+}
+
+void NearCache::InvalidateAll() {
+  for (auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    ++way->epoch;
+    way->cache.Clear();
+  }
+}
+
+void NearCache::UpdateEnabled() {
+  enabled_ = AllSet(shards_ready_) && AllSet(shards_subscribed_);
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const NearCache& cache) {
+  const auto& stats = cache.GetStatistics();
+  writer["hits"] = stats.hits;
+  writer["misses"] = stats.misses;
+  writer["invalidations"] = stats.invalidations;
+  writer["size"] = cache.GetSize();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/striped_rate_counter.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include <storages/redis/impl/subscription_storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+class SubscribeSentinel;
+}  // namespace redis
+
+namespace storages::redis {
+
+struct NearCacheSettings {
+  /// Maximum number of cached keys
+  size_t max_size{0};
+  /// Values larger than this are not cached
+  size_t max_value_size{0};
+  /// Only keys starting with one of the prefixes are cached, all keys are
+  /// cached if empty
+  std::vector<std::string> prefixes;
+};
+
+NearCacheSettings Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<NearCacheSettings>);
+
+struct NearCacheStatistics {
+  utils::statistics::StripedRateCounter hits;
+  utils::statistics::StripedRateCounter misses;
+  utils::statistics::RateCounter invalidations;
+};
+
+/// In-process cache of GET replies kept consistent with the server by the
+/// `CLIENT TRACKING` invalidation messages, see redis::ClientTrackingSettings.
+///
+/// The cache is disabled until every shard is connected and subscribed to the
+/// invalidation channel. Values may be stale for the time it takes the
+/// invalidation message to arrive, including writes made by the same client.
+class NearCache final {
+ public:
+  /// Changes on every invalidation of the keys that share a lock with the
+  /// key, used to drop replies to the requests that were sent before an
+  /// invalidation
+  using Epoch = uint64_t;
+
+  NearCache(NearCacheSettings settings, size_t shards_count);
+  ~NearCache();
+
+  /// Subscribes to the invalidation channel. The sentinel must be created with
+  /// redis::ClientTrackingSettings and with OnShardReadyChange() as the ready
+  /// callback, it is owned by the cache from now on.
+  void StartTracking(
+      std::shared_ptr<USERVER_NAMESPACE::redis::SubscribeSentinel> sentinel);
+
+  const NearCacheSettings& GetSettings() const;
+
+  bool IsTracked(const std::string& key) const;
+
+  /// Returns the cached value and accounts a hit or a miss
+  std::optional<std::string> Get(const std::string& key);
+
+  Epoch GetEpoch(const std::string& key);
+
+  /// Stores the value unless the key was invalidated after `epoch`
+  void Put(const std::string& key, std::string value, Epoch epoch);
+
+  /// Handles a message from the invalidation channel
+  void OnInvalidate(const std::string& key);
+
+  /// Handles a (re)subscription of the shard to the invalidation channel and
+  /// the invalidation of all keys
+  void OnInvalidateAll(size_t shard);
+
+  void OnShardReadyChange(size_t shard, bool ready);
+
+  size_t GetSize() const;
+  const NearCacheStatistics& GetStatistics() const;
+
+ private:
+  struct Way {
+    explicit Way(size_t max_size) : cache(max_size) {}
+
+    std::mutex mutex;
+    cache::LruMap<std::string, std::string> cache;
+    Epoch epoch{0};
+  };
+
+  Way& GetWay(const std::string& key);
+  void InvalidateAll();
+  void UpdateEnabled();
+
+  const NearCacheSettings settings_;
+  std::vector<std::unique_ptr<Way>> ways_;
+  std::atomic<bool> enabled_{false};
+
+  std::mutex ready_mutex_;
+  std::vector<bool> shards_ready_;
+  std::vector<bool> shards_subscribed_;
+
+  NearCacheStatistics stats_;
+
+  std::shared_ptr<USERVER_NAMESPACE::redis::SubscribeSentinel> sentinel_;
+  USERVER_NAMESPACE::redis::SubscriptionToken invalidation_token_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const NearCache& cache);
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,133 @@
+#include "near_cache.hpp"
+
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+storages::redis::NearCacheSettings MakeSettings() {
+  storages::redis::NearCacheSettings settings;
+  settings.max_size = 1024;
+  settings.max_value_size = 8;
+  settings.prefixes = {"user:", "item:"};
+  return settings;
+}
+
+void Enable(storages::redis::NearCache& cache) {
+  cache.OnShardReadyChange(0, true);
+  cache.OnShardReadyChange(1, true);
+  cache.OnInvalidateAll(0);
+  cache.OnInvalidateAll(1);
+}
+
+}  // namespace
+
+TEST(NearCache, Prefixes) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  EXPECT_TRUE(cache.IsTracked("user:1"));
+  EXPECT_TRUE(cache.IsTracked("item:1"));
+  EXPECT_FALSE(cache.IsTracked("order:1"));
+  EXPECT_FALSE(cache.IsTracked("use"));
+}
+
+TEST(NearCache, DisabledUntilSubscribed) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+
+  cache.OnShardReadyChange(0, true);
+  cache.OnInvalidateAll(0);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+
+  cache.OnShardReadyChange(1, true);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+
+  cache.OnInvalidateAll(1);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), "value");
+
+  cache.OnShardReadyChange(1, false);
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+  EXPECT_EQ(cache.GetSize(), 0U);
+}
+
+TEST(NearCache, Invalidate) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  Enable(cache);
+
+  cache.Put("user:1", "1", cache.GetEpoch("user:1"));
+  cache.Put("user:2", "2", cache.GetEpoch("user:2"));
+  cache.Put("user:3", "too long value", cache.GetEpoch("user:3"));
+  EXPECT_EQ(cache.GetSize(), 2U);
+
+  cache.OnInvalidate("user:1");
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+  EXPECT_EQ(cache.Get("user:2"), "2");
+  EXPECT_EQ(cache.Get("user:3"), std::nullopt);
+
+  cache.OnInvalidateAll(0);
+  EXPECT_EQ(cache.Get("user:2"), std::nullopt);
+
+  const auto& stats = cache.GetStatistics();
+  EXPECT_EQ(stats.hits.Load().value, 1U);
+  EXPECT_EQ(stats.misses.Load().value, 3U);
+}
+
+TEST(NearCache, StaleReply) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  Enable(cache);
+
+  // The value was modified while the GET request was in flight
+  const auto epoch = cache.GetEpoch("user:1");
+  cache.OnInvalidate("user:1");
+  cache.Put("user:1", "old", epoch);
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+
+  cache.Put("user:1", "new", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), "new");
+}
+
+TEST(NearCache, UnrelatedInvalidation) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  Enable(cache);
+
+  // Find a key that does not share the epoch with "user:1"
+  std::optional<std::string> other_key;
+  for (int i = 2; i < 100 && !other_key; ++i) {
+    const auto key = "user:" + std::to_string(i);
+    const auto epoch = cache.GetEpoch("user:1");
+    cache.OnInvalidate(key);
+    if (cache.GetEpoch("user:1") == epoch) other_key = key;
+  }
+  ASSERT_TRUE(other_key);
+
+  // Writes to the other keys do not drop the fills in flight
+  const auto epoch = cache.GetEpoch("user:1");
+  cache.OnInvalidate(*other_key);
+  cache.Put("user:1", "value", epoch);
+  EXPECT_EQ(cache.Get("user:1"), "value");
+}
+
+TEST(NearCache, ShardResubscription) {
+  storages::redis::NearCache cache(MakeSettings(), 2);
+  Enable(cache);
+
+  cache.OnShardReadyChange(0, false);
+  cache.OnShardReadyChange(0, true);
+  // Another shard resubscribes, the first one has not resubscribed yet
+  cache.OnInvalidateAll(1);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), std::nullopt);
+
+  cache.OnInvalidateAll(0);
+  cache.Put("user:1", "value", cache.GetEpoch("user:1"));
+  EXPECT_EQ(cache.Get("user:1"), "value");
+}
+
+USERVER_NAMESPACE_END
@@ -2,16 +2,20 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/request.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/exception.hpp>
 #include <userver/storages/redis/parse_reply.hpp>
 #include <userver/storages/redis/request_data_base.hpp>
 
 #include "client_impl.hpp"
+#include "near_cache.hpp"
 #include "scan_reply.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -77,6 +81,41 @@ class RequestDataImpl final : public RequestDataImplBase,
   }
 };
 
+/// Same as RequestDataImpl, but also puts the string reply into the NearCache
+template <typename Result, typename ReplyType>
+class NearCacheRequestDataImpl final : public RequestDataImplBase,
+                                       public RequestDataBase<ReplyType> {
+ public:
+  NearCacheRequestDataImpl(USERVER_NAMESPACE::redis::Request&& request,
+                           std::shared_ptr<NearCache> near_cache,
+                           std::string key, NearCache::Epoch epoch)
+      : RequestDataImplBase(std::move(request)),
+        near_cache_(std::move(near_cache)),
+        key_(std::move(key)),
+        epoch_(epoch) {}
+
+  void Wait() override { impl::Wait(GetRequest()); }
+
+  ReplyType Get(const std::string& request_description) override {
+    auto reply = GetReply();
+    if (reply->IsOk() && reply->data.IsString()) {
+      near_cache_->Put(key_, reply->data.GetString(), epoch_);
+    }
+    return ParseReply<Result, ReplyType>(std::move(reply), request_description);
+  }
+
+  ReplyPtr GetRaw() override { return GetReply(); }
+
+  engine::impl::ContextAccessor* TryGetContextAccessor() noexcept override {
+    return GetRequest().TryGetContextAccessor();
+  }
+
+ private:
+  const std::shared_ptr<NearCache> near_cache_;
+  const std::string key_;
+  const NearCache::Epoch epoch_;
+};
+
 template <typename Result, typename ReplyType>
 class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   using RequestDataPtr = std::unique_ptr<RequestDataBase<ReplyType>>;
@@ -92,10 +131,77 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   }
 
   ReplyType Get(const std::string& request_description) override {
-    std::vector<typename ReplyType::value_type> result;
+    if constexpr (std::is_void_v<ReplyType>) {
+      for (auto& request : requests_) {
+        request->Get(request_description);
+      }
+    } else if constexpr (std::is_arithmetic_v<ReplyType>) {
+      ReplyType result{};
+      for (auto& request : requests_) {
+        result += request->Get(request_description);
+      }
+      return result;
+    } else {
+      std::vector<typename ReplyType::value_type> result;
+      for (auto& request : requests_) {
+        auto data = request->Get(request_description);
+        std::move(data.begin(), data.end(), std::back_inserter(result));
+      }
+      return result;
+    }
+  }
+
+  ReplyPtr GetRaw() override {
+    UASSERT_MSG(false, "Unsupported");
+    return {};
+  }
+
+  engine::impl::ContextAccessor* TryGetContextAccessor() noexcept override {
+    UASSERT_MSG(false, "Not implemented");
+    return nullptr;
+  }
+
+ private:
+  std::vector<RequestDataPtr> requests_;
+};
+
+/// Same as AggregateRequestDataImpl, but the reply of the i-th request is
+/// scattered into the resulting array at `positions[i]`. Used to restore the
+/// original order of keys after splitting them between shards.
+template <typename Result, typename ReplyType>
+class ScatteredRequestDataImpl final : public RequestDataBase<ReplyType> {
+  using RequestDataPtr = std::unique_ptr<RequestDataBase<ReplyType>>;
+
+ public:
+  ScatteredRequestDataImpl(std::vector<RequestDataPtr>&& requests,
+                           std::vector<std::vector<size_t>>&& positions)
+      : requests_(std::move(requests)), positions_(std::move(positions)) {
+    UASSERT(requests_.size() == positions_.size());
+  }
+
+  void Wait() override {
     for (auto& request : requests_) {
-      auto data = request->Get(request_description);
-      std::move(data.begin(), data.end(), std::back_inserter(result));
+      request->Wait();
+    }
+  }
+
+  ReplyType Get(const std::string& request_description) override {
+    size_t size = 0;
+    for (const auto& positions : positions_) size += positions.size();
+
+    ReplyType result(size);
+    for (size_t i = 0; i < requests_.size(); ++i) {
+      auto data = requests_[i]->Get(request_description);
+      const auto& positions = positions_[i];
+      if (data.size() != positions.size()) {
+        throw USERVER_NAMESPACE::redis::ParseReplyException(
+            "Unexpected reply size for " + request_description + ": " +
+            std::to_string(data.size()) +
+            " != " + std::to_string(positions.size()));
+      }
+      for (size_t j = 0; j < data.size(); ++j) {
+        result[positions[j]] = std::move(data[j]);
+      }
     }
     return result;
   }
@@ -112,6 +218,7 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
 
  private:
   std::vector<RequestDataPtr> requests_;
+  std::vector<std::vector<size_t>> positions_;
 };
 
 template <typename Result, typename ReplyType>
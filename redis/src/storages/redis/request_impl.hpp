@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <userver/storages/redis/request.hpp>
 
@@ -19,6 +20,16 @@ Request<Result, ReplyType> CreateRequest(
       std::make_unique<RequestDataImpl<Result, ReplyType>>(std::move(request)));
 }
 
+template <typename Result, typename ReplyType = Result>
+Request<Result, ReplyType> CreateNearCacheRequest(
+    USERVER_NAMESPACE::redis::Request&& request,
+    std::shared_ptr<NearCache> near_cache, std::string key,
+    NearCache::Epoch epoch, Request<Result, ReplyType>* /* for ADL */) {
+  return Request<Result, ReplyType>(
+      std::make_unique<NearCacheRequestDataImpl<Result, ReplyType>>(
+          std::move(request), std::move(near_cache), std::move(key), epoch));
+}
+
 template <typename Result, typename ReplyType = Result>
 Request<Result, ReplyType> CreateAggregateRequest(
     std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
@@ -34,6 +45,22 @@ Request<Result, ReplyType> CreateAggregateRequest(
           std::move(req_data)));
 }
 
+template <typename Result, typename ReplyType = Result>
+Request<Result, ReplyType> CreateScatteredRequest(
+    std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
+    std::vector<std::vector<size_t>>&& positions,
+    Request<Result, ReplyType>* /* for ADL */) {
+  std::vector<std::unique_ptr<RequestDataBase<ReplyType>>> req_data;
+  req_data.reserve(requests.size());
+  for (auto& request : requests) {
+    req_data.push_back(std::make_unique<RequestDataImpl<Result, ReplyType>>(
+        std::move(request)));
+  }
+  return Request<Result, ReplyType>(
+      std::make_unique<ScatteredRequestDataImpl<Result, ReplyType>>(
+          std::move(req_data), std::move(positions)));
+}
+
 template <typename Result, typename ReplyType = Result>
 Request<Result, ReplyType> CreateDummyRequest(
     ReplyPtr&& reply, Request<Result, ReplyType>* /* for ADL */) {
@@ -50,6 +77,15 @@ Request CreateRequest(USERVER_NAMESPACE::redis::Request&& request) {
   return impl::CreateRequest(std::move(request), tmp);
 }
 
+template <typename Request>
+Request CreateNearCacheRequest(USERVER_NAMESPACE::redis::Request&& request,
+                               std::shared_ptr<NearCache> near_cache,
+                               std::string key, NearCache::Epoch epoch) {
+  Request* tmp = nullptr;
+  return impl::CreateNearCacheRequest(std::move(request), std::move(near_cache),
+                                      std::move(key), epoch, tmp);
+}
+
 template <typename Request>
 Request CreateAggregateRequest(
     std::vector<USERVER_NAMESPACE::redis::Request>&& requests) {
@@ -57,6 +93,15 @@ Request CreateAggregateRequest(
   return impl::CreateAggregateRequest(std::move(requests), tmp);
 }
 
+template <typename Request>
+Request CreateScatteredRequest(
+    std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
+    std::vector<std::vector<size_t>>&& positions) {
+  Request* tmp = nullptr;
+  return impl::CreateScatteredRequest(std::move(requests), std::move(positions),
+                                      tmp);
+}
+
 template <typename Request>
 Request CreateDummyRequest(ReplyPtr reply) {
   Request* tmp = nullptr;